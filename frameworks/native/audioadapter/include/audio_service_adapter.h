@@ -16,7 +16,10 @@
 #ifndef ST_AUDIO_SERVICE_ADAPTER_H
 #define ST_AUDIO_SERVICE_ADAPTER_H
 
+#include <future>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <unistd.h>
 #include <vector>
@@ -131,6 +134,16 @@ public:
      */
     virtual int32_t SetVolumeDb(AudioStreamType streamType, float volume) = 0;
 
+    /**
+     * @brief sets audio volume db of several stream types at once
+     *
+     * @param streamTypes the streamTypes whose volume is set, streamType defined in{@link audio_info.h}. The volume
+     * of each stream type is read back through {@link AudioServiceAdapterCallback#OnGetVolumeDbCb}.
+     * @return Returns {@link SUCCESS} if volume is set successfully; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     */
+    virtual int32_t SetVolumeDbBatch(const std::set<AudioStreamType> &streamTypes) = 0;
+
     /**
      * @brief set mute for give output streamType
      *
@@ -194,6 +207,43 @@ public:
      */
     virtual int32_t MoveSinkInputByIndexOrName(uint32_t sinkInputId, uint32_t sinkIndex, std::string sinkName) = 0;
 
+    /**
+     * @brief Move several streams, all the moves are sent before waiting for the first reply.
+     *
+     * @param sinkInputIds the streams to move
+     * @param sinkIndex the target sink, used when the name of the target sink is empty
+     * @param sinkNames the name of the target sink of each stream, sinkNames[i] for sinkInputIds[i]
+     * @return Returns {@link SUCCESS} if all the moves are done; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     */
+    virtual int32_t MoveSinkInputsByIndexOrName(const std::vector<uint32_t> &sinkInputIds, uint32_t sinkIndex,
+        const std::vector<std::string> &sinkNames) = 0;
+
+    /**
+     * @brief Move one stream to target sink without waiting for the audio server.
+     *
+     * @return Returns the future result of the move, {@link SUCCESS} or an error code
+     * defined in {@link audio_errors.h}.
+     */
+    virtual std::future<int32_t> MoveSinkInputByIndexOrNameAsync(uint32_t sinkInputId, uint32_t sinkIndex,
+        std::string sinkName) = 0;
+
+    /**
+     * @brief get all sinks without waiting for the audio server. A call made while the same query is in flight,
+     * and nothing has changed since it was sent, shares its result.
+     *
+     * @return Returns : the future list of all sinks
+     */
+    virtual std::shared_future<std::vector<SinkInfo>> GetAllSinksAsync() = 0;
+
+    /**
+     * @brief returns the list of all sink inputs without waiting for the audio server. Coalesced like
+     * GetAllSinksAsync.
+     *
+     * @return Returns : the future list of all sink inputs
+     */
+    virtual std::shared_future<std::vector<SinkInput>> GetAllSinkInputsAsync() = 0;
+
     virtual ~AudioServiceAdapter();
 };
 } // namespace AudioStandard
@@ -15,7 +15,11 @@
 
 #ifndef ST_PULSEAUDIO_AUDIO_SERVICE_ADAPTER_H
 #define ST_PULSEAUDIO_AUDIO_SERVICE_ADAPTER_H
+#include <future>
+#include <map>
 #include <mutex>
+#include <set>
+#include <unordered_map>
 #include "safe_map.h"
 
 #include <pulse/pulseaudio.h>
@@ -36,6 +40,7 @@ public:
     int32_t SetDefaultSink(std::string name) override;
     int32_t SetDefaultSource(std::string name) override;
     int32_t SetVolumeDb(AudioStreamType streamType, float volumeDb) override;
+    int32_t SetVolumeDbBatch(const std::set<AudioStreamType> &streamTypes) override;
     int32_t SetSourceOutputMute(int32_t uid, bool setMute) override;
     int32_t SuspendAudioDevice(std::string &audioPortName, bool isSuspend) override;
     bool SetSinkMute(const std::string &sinkName, bool isMute, bool isSync = false) override;
@@ -47,6 +52,12 @@ public:
     std::vector<SinkInfo> GetAllSinks() override;
     int32_t SetLocalDefaultSink(std::string name) override;
     int32_t MoveSinkInputByIndexOrName(uint32_t sinkInputId, uint32_t sinkIndex, std::string sinkName) override;
+    int32_t MoveSinkInputsByIndexOrName(const std::vector<uint32_t> &sinkInputIds, uint32_t sinkIndex,
+        const std::vector<std::string> &sinkNames) override;
+    std::future<int32_t> MoveSinkInputByIndexOrNameAsync(uint32_t sinkInputId, uint32_t sinkIndex,
+        std::string sinkName) override;
+    std::shared_future<std::vector<SinkInfo>> GetAllSinksAsync() override;
+    std::shared_future<std::vector<SinkInput>> GetAllSinkInputsAsync() override;
     int32_t MoveSourceOutputByIndexOrName(uint32_t sourceOutputId,
         uint32_t sourceIndex, std::string sourceName) override;
 
@@ -58,8 +69,10 @@ public:
     static void PaModuleLoadCb(pa_context *c, uint32_t idx, void *userdata);
     static void PaGetSinkInputInfoVolumeCb(pa_context *c, const pa_sink_input_info *i, int eol, void *userdata);
     static void HandleSinkInputInfoVolume(pa_context *c, const pa_sink_input_info *i, void *userdata);
+    static void PaRefreshSinkInputVolumeCb(pa_context *c, const pa_sink_input_info *i, int eol, void *userdata);
     static void PaSubscribeCb(pa_context *c, pa_subscription_event_type_t t, uint32_t idx, void *userdata);
     static void PaGetAllSinkInputsCb(pa_context *c, const pa_sink_input_info *i, int eol, void *userdata);
+    static void PaGetSinkInputsSinksCb(pa_context *c, const pa_sink_info *i, int eol, void *userdata);
     static void PaGetAllSourceOutputsCb(pa_context *c, const pa_source_output_info *i, int eol, void *userdata);
     static void PaGetSourceOutputCb(pa_context *c, const pa_source_output_info *i, int eol, void *userdata);
     static void ProcessSourceOutputEvent(pa_context *c, pa_subscription_event_type_t t, uint32_t idx, void *userdata);
@@ -68,17 +81,79 @@ private:
     struct UserData {
         PulseAudioServiceAdapterImpl *thiz;
         AudioStreamType streamType;
-        float volume;
         bool mute;
         bool isCorked;
         uint32_t idx;
-        std::vector<SinkInput> sinkInputList;
         std::vector<SourceOutput> sourceOutputList;
-        std::vector<SinkInfo> sinkInfos;
         int32_t moveResult;
         bool isSubscribingCb = false;
+        std::set<AudioStreamType> streamTypes; // set the volume of these stream types too
+    };
+
+    // What the volume of a sink input is computed from, kept from the sink input events.
+    struct SinkInputVolumeInfo {
+        uint32_t paIndex;
+        uint32_t sessionID;
+        AudioStreamType streamType;
+        uint8_t channels;
+        int32_t uid;
+        int32_t pid;
+        int32_t streamUsage;
+        float volumeFactor;
+        float powerVolumeFactor;
+        float duckVolumeFactor;
+        pa_volume_t volume; // last volume set on or read from the sink input
+    };
+
+    // A request sent to the audio server and not answered yet. Owned by pendingOperations_ and only used with the
+    // mainloop lock held, the callbacks of pa run on the mainloop.
+    struct PendingOperation {
+        explicit PendingOperation(PulseAudioServiceAdapterImpl *adapter) : thiz(adapter) {}
+        virtual ~PendingOperation() = default;
+        // The context is gone, pa will not call back.
+        virtual void Fail() = 0;
+        PulseAudioServiceAdapterImpl *thiz;
+    };
+
+    struct MoveOperation : public PendingOperation {
+        using PendingOperation::PendingOperation;
+        void Fail() override;
+        std::promise<int32_t> promise;
     };
 
+    struct SinksQuery : public PendingOperation {
+        using PendingOperation::PendingOperation;
+        void Fail() override;
+        uint64_t generation = 0;
+        std::vector<SinkInfo> sinkInfos;
+        std::promise<std::vector<SinkInfo>> promise;
+        std::shared_future<std::vector<SinkInfo>> future;
+    };
+
+    // The sinks are listed together with the sink inputs, to name the sink of each sink input.
+    struct SinkInputsQuery : public PendingOperation {
+        using PendingOperation::PendingOperation;
+        void Fail() override;
+        uint64_t generation = 0;
+        uint32_t pendingReplies = 0;
+        std::vector<SinkInfo> sinkInfos;
+        std::vector<SinkInput> sinkInputList;
+        std::promise<std::vector<SinkInput>> promise;
+        std::shared_future<std::vector<SinkInput>> future;
+    };
+
+    template <typename T>
+    T *AddOperation();
+    void RemoveOperation(PendingOperation *operation);
+    void FailPendingOperations();
+    std::future<int32_t> SendMoveSinkInput(uint32_t sinkInputId, uint32_t sinkIndex, const std::string &sinkName);
+    static void CompleteSinkInputsQuery(SinkInputsQuery *query);
+    static bool ParseSinkInfo(const pa_sink_info *i, SinkInfo &sinkInfo);
+
+    bool ParseSinkInputVolumeInfo(const pa_sink_input_info *i, SinkInputVolumeInfo &info);
+    void ApplySinkInputVolume(pa_context *c, SinkInputVolumeInfo &info, bool setVolume);
+    void RefreshSinkInputVolumeCache(pa_context *c, uint32_t paIndex);
+
     bool ConnectToPulseAudio();
     AudioStreamType GetIdByStreamType(std::string streamType);
 
@@ -90,6 +165,20 @@ private:
     std::mutex lock_;
     bool isSetDefaultSink_ = false;
     bool isSetDefaultSource_ = false;
+    // Sink inputs by session id, only used with the mainloop lock held. Valid once a full enumeration of the
+    // sink inputs has completed since the context was connected, it then replaces the enumeration on volume set.
+    std::map<uint32_t, SinkInputVolumeInfo> sinkInputVolumeCache_;
+    bool sinkInputCacheValid_ = false;
+    // The change events of a sink input, most of them caused by our own volume set, are folded into one query of
+    // it: while a query is in flight the events only ask for another one once it ends. By pa index, true if asked
+    // again.
+    std::unordered_map<uint32_t, bool> sinkInputRefreshes_;
+    std::unordered_map<PendingOperation *, std::unique_ptr<PendingOperation>> pendingOperations_;
+    // Bumped on each change of the sinks or of the sink inputs. A query in flight is only shared by the callers
+    // coming before the next change, so that a caller never gets a list older than its own last change.
+    uint64_t generation_ = 0;
+    SinksQuery *sinksQuery_ = nullptr;
+    SinkInputsQuery *sinkInputsQuery_ = nullptr;
 };
 }  // namespace AudioStandard
 }  // namespace OHOS
@@ -75,6 +75,67 @@ static const unordered_map<std::string, AudioStreamType> STREAM_TYPE_STRING_ENUM
 AudioServiceAdapter::~AudioServiceAdapter() = default;
 PulseAudioServiceAdapterImpl::~PulseAudioServiceAdapterImpl() = default;
 
+template <typename T>
+static std::future<T> MakeReadyFuture(T value)
+{
+    std::promise<T> promise;
+    promise.set_value(std::move(value));
+    return promise.get_future();
+}
+
+// Never called with the mainloop lock held, the reply is delivered on the mainloop.
+template <typename F>
+static bool WaitForReply(const F &future)
+{
+    return future.wait_for(std::chrono::seconds(PA_SERVICE_IMPL_TIMEOUT)) == std::future_status::ready;
+}
+
+template <typename T>
+T *PulseAudioServiceAdapterImpl::AddOperation()
+{
+    std::unique_ptr<T> operation = std::make_unique<T>(this);
+    T *pending = operation.get();
+    pendingOperations_.emplace(pending, std::move(operation));
+    return pending;
+}
+
+void PulseAudioServiceAdapterImpl::RemoveOperation(PendingOperation *operation)
+{
+    if (operation == sinksQuery_) {
+        sinksQuery_ = nullptr;
+    }
+    if (operation == sinkInputsQuery_) {
+        sinkInputsQuery_ = nullptr;
+    }
+    pendingOperations_.erase(operation);
+}
+
+void PulseAudioServiceAdapterImpl::FailPendingOperations()
+{
+    AUDIO_INFO_LOG("%{public}zu operations failed", pendingOperations_.size());
+    for (auto &[pending, operation] : pendingOperations_) {
+        operation->Fail();
+    }
+    pendingOperations_.clear();
+    sinksQuery_ = nullptr;
+    sinkInputsQuery_ = nullptr;
+}
+
+void PulseAudioServiceAdapterImpl::MoveOperation::Fail()
+{
+    promise.set_value(ERROR);
+}
+
+void PulseAudioServiceAdapterImpl::SinksQuery::Fail()
+{
+    promise.set_value({});
+}
+
+void PulseAudioServiceAdapterImpl::SinkInputsQuery::Fail()
+{
+    promise.set_value({});
+}
+
 unique_ptr<AudioServiceAdapter> AudioServiceAdapter::CreateAudioAdapter(unique_ptr<AudioServiceAdapterCallback> cb)
 {
     CHECK_AND_RETURN_RET_LOG(cb != nullptr, nullptr, "CreateAudioAdapter cb is nullptr!");
@@ -139,7 +200,13 @@ bool PulseAudioServiceAdapterImpl::ConnectToPulseAudio()
         pa_context_set_state_callback(mContext, nullptr, nullptr);
         pa_context_set_subscribe_callback(mContext, nullptr, nullptr);
         pa_context_unref(mContext);
+        mContext = nullptr;
     }
+    FailPendingOperations();
+    // the sink inputs of the previous context are unknown until enumerated again
+    sinkInputVolumeCache_.clear();
+    sinkInputCacheValid_ = false;
+    sinkInputRefreshes_.clear();
     pa_proplist *proplist = pa_proplist_new();
     if (proplist == nullptr) {
         AUDIO_ERR_LOG("Connect to pulseAudio and new proplist return nullptr!");
@@ -197,6 +264,7 @@ uint32_t PulseAudioServiceAdapterImpl::OpenAudioPort(string audioPortName, strin
         AUDIO_ERR_LOG("pa_context_load_module returned nullptr");
         return PA_INVALID_INDEX;
     }
+    generation_++;
 
     while (pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
         pa_threaded_mainloop_wait(mMainLoop);
@@ -225,6 +293,7 @@ int32_t PulseAudioServiceAdapterImpl::CloseAudioPort(int32_t audioHandleIndex)
         AUDIO_ERR_LOG("pa_context_unload_module returned nullptr!");
         return ERROR;
     }
+    generation_++;
 
     pa_operation_unref(operation);
     return SUCCESS;
@@ -332,23 +401,9 @@ int32_t PulseAudioServiceAdapterImpl::SetDefaultSource(string name)
     return SUCCESS;
 }
 
-void PulseAudioServiceAdapterImpl::PaGetSinksCb(pa_context *c, const pa_sink_info *i, int eol, void *userdata)
+bool PulseAudioServiceAdapterImpl::ParseSinkInfo(const pa_sink_info *i, SinkInfo &sinkInfo)
 {
-    UserData *userData = reinterpret_cast<UserData *>(userdata);
-    PulseAudioServiceAdapterImpl *thiz = userData->thiz;
-
-    if (eol < 0) {
-        AUDIO_ERR_LOG("Failed to get sink information: %{public}s", pa_strerror(pa_context_errno(c)));
-        pa_threaded_mainloop_signal(thiz->mMainLoop, 0);
-        return;
-    }
-
-    if (eol) {
-        pa_threaded_mainloop_signal(thiz->mMainLoop, 0);
-        return;
-    }
-
-    CHECK_AND_RETURN_LOG(i->proplist != nullptr, "Invalid Proplist for sink (%{public}d).", i->index);
+    CHECK_AND_RETURN_RET_LOG(i->proplist != nullptr, false, "Invalid Proplist for sink (%{public}d).", i->index);
 
     const char *adapterCStr = pa_proplist_gets(i->proplist, PA_PROP_DEVICE_STRING);
     if (adapterCStr == nullptr) {
@@ -356,48 +411,71 @@ void PulseAudioServiceAdapterImpl::PaGetSinksCb(pa_context *c, const pa_sink_inf
     }
     AUDIO_DEBUG_LOG("sink[%{public}d] device[%{public}s] name[%{public}s]", i->index, adapterCStr,
         i->name);
-    std::string sinkDeviceName(adapterCStr);
-    std::string sinkName(i->name);
-    SinkInfo sinkInfo = {};
     sinkInfo.sinkId = i->index;
-    sinkInfo.sinkName = sinkName;
-    sinkInfo.adapterName = sinkDeviceName;
-    userData->sinkInfos.push_back(sinkInfo);
+    sinkInfo.sinkName = std::string(i->name);
+    sinkInfo.adapterName = std::string(adapterCStr);
+    return true;
 }
 
-std::vector<SinkInfo> PulseAudioServiceAdapterImpl::GetAllSinks()
+void PulseAudioServiceAdapterImpl::PaGetSinksCb(pa_context *c, const pa_sink_info *i, int eol, void *userdata)
 {
-    AUDIO_PRERELEASE_LOGI("GetAllSinks enter.");
-    int32_t XcollieFlag = 2; // flag 1 generate log file, flag 2 die when timeout, restart server
-    AudioXCollie audioXCollie("PulseAudioServiceAdapterImpl::GetAllSinks", PA_SERVICE_IMPL_TIMEOUT,
-        [this](void *) {
-            AUDIO_ERR_LOG("GetAllSinks timeout, trigger signal");
-            pa_threaded_mainloop_signal(this->mMainLoop, 0);
-        }, nullptr, XcollieFlag);
-    lock_guard<mutex> lock(lock_);
-    unique_ptr<UserData> userData = make_unique<UserData>();
-    userData->thiz = this;
-    userData->sinkInfos = {};
+    SinksQuery *query = reinterpret_cast<SinksQuery *>(userdata);
 
-    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, userData->sinkInfos, "mContext is nullptr");
+    if (eol < 0) {
+        AUDIO_ERR_LOG("Failed to get sink information: %{public}s", pa_strerror(pa_context_errno(c)));
+    }
+    if (eol) {
+        query->promise.set_value(std::move(query->sinkInfos));
+        query->thiz->RemoveOperation(query);
+        return;
+    }
+
+    SinkInfo sinkInfo = {};
+    if (ParseSinkInfo(i, sinkInfo)) {
+        query->sinkInfos.push_back(sinkInfo);
+    }
+}
 
+std::shared_future<std::vector<SinkInfo>> PulseAudioServiceAdapterImpl::GetAllSinksAsync()
+{
     PaLockGuard palock(mMainLoop);
+    // the context is replaced on the mainloop when the audio server reconnects
+    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, MakeReadyFuture(std::vector<SinkInfo>()).share(),
+        "mContext is nullptr");
+    if (sinksQuery_ != nullptr && sinksQuery_->generation == generation_) {
+        return sinksQuery_->future;
+    }
 
+    SinksQuery *query = AddOperation<SinksQuery>();
+    query->generation = generation_;
+    query->future = query->promise.get_future().share();
+    std::shared_future<std::vector<SinkInfo>> future = query->future;
     pa_operation *operation = pa_context_get_sink_info_list(mContext,
-        PulseAudioServiceAdapterImpl::PaGetSinksCb, reinterpret_cast<void*>(userData.get()));
+        PulseAudioServiceAdapterImpl::PaGetSinksCb, reinterpret_cast<void*>(query));
     if (operation == nullptr) {
         AUDIO_ERR_LOG("pa_context_get_sink_info_list returned nullptr");
-        return userData->sinkInfos;
+        query->Fail();
+        RemoveOperation(query);
+        return future;
     }
-
-    while (pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
-        pa_threaded_mainloop_wait(mMainLoop);
-    }
-
     pa_operation_unref(operation);
+    sinksQuery_ = query;
+    return future;
+}
+
+std::vector<SinkInfo> PulseAudioServiceAdapterImpl::GetAllSinks()
+{
+    AUDIO_PRERELEASE_LOGI("GetAllSinks enter.");
+    int32_t XcollieFlag = 2; // flag 1 generate log file, flag 2 die when timeout, restart server
+    AudioXCollie audioXCollie("PulseAudioServiceAdapterImpl::GetAllSinks", PA_SERVICE_IMPL_TIMEOUT,
+        [](void *) {
+            AUDIO_ERR_LOG("GetAllSinks timeout");
+        }, nullptr, XcollieFlag);
+    std::shared_future<std::vector<SinkInfo>> sinkInfos = GetAllSinksAsync();
+    CHECK_AND_RETURN_RET_LOG(WaitForReply(sinkInfos), {}, "GetAllSinks timeout");
 
-    AUDIO_DEBUG_LOG("end, get [%{public}zu] sinks.", userData->sinkInfos.size());
-    return userData->sinkInfos;
+    AUDIO_DEBUG_LOG("end, get [%{public}zu] sinks.", sinkInfos.get().size());
+    return sinkInfos.get();
 }
 
 std::vector<uint32_t> PulseAudioServiceAdapterImpl::GetTargetSinks(std::string adapterName)
@@ -414,64 +492,100 @@ std::vector<uint32_t> PulseAudioServiceAdapterImpl::GetTargetSinks(std::string a
 
 int32_t PulseAudioServiceAdapterImpl::SetLocalDefaultSink(std::string name)
 {
-    std::vector<SinkInput> allSinkInputs = GetAllSinkInputs();
+    // both lists are queried at once
+    std::shared_future<std::vector<SinkInput>> allSinkInputs = GetAllSinkInputsAsync();
 
     std::string remoteDevice = "remote";
     std::vector<uint32_t> remoteSinks = GetTargetSinks(remoteDevice);
+    CHECK_AND_RETURN_RET_LOG(WaitForReply(allSinkInputs), ERROR, "GetAllSinkInputs timeout");
 
     // filter sink-inputs which are not connected with remote sinks.
-    for (auto sinkInput : allSinkInputs) {
+    std::vector<uint32_t> sinkInputIds;
+    for (auto sinkInput : allSinkInputs.get()) {
         uint32_t sink = sinkInput.deviceSinkId;
         // the sink inputs connected to remote device remain the same
         CHECK_AND_CONTINUE_LOG(std::find(remoteSinks.begin(), remoteSinks.end(), sink) == remoteSinks.end(),
             "sink-input[%{public}d] connects with remote device[%{public}d]",
             sinkInput.paStreamId, sinkInput.deviceSinkId);
-        // move the remaining sink inputs to the default sink
-        uint32_t invalidSinkId = PA_INVALID_INDEX;
-        MoveSinkInputByIndexOrName(sinkInput.paStreamId, invalidSinkId, name);
+        sinkInputIds.push_back(sinkInput.paStreamId);
     }
 
-    return SUCCESS;
+    // move the remaining sink inputs to the default sink
+    uint32_t invalidSinkId = PA_INVALID_INDEX;
+    std::vector<std::string> sinkNames(sinkInputIds.size(), name);
+    return MoveSinkInputsByIndexOrName(sinkInputIds, invalidSinkId, sinkNames);
 }
 
 int32_t PulseAudioServiceAdapterImpl::MoveSinkInputByIndexOrName(uint32_t sinkInputId, uint32_t sinkIndex,
     std::string sinkName)
 {
-    lock_guard<mutex> lock(lock_);
+    return MoveSinkInputsByIndexOrName({sinkInputId}, sinkIndex, {sinkName});
+}
 
-    unique_ptr<UserData> userData = make_unique<UserData>();
-    userData->thiz = this;
+int32_t PulseAudioServiceAdapterImpl::MoveSinkInputsByIndexOrName(const std::vector<uint32_t> &sinkInputIds,
+    uint32_t sinkIndex, const std::vector<std::string> &sinkNames)
+{
+    CHECK_AND_RETURN_RET_LOG(sinkInputIds.size() == sinkNames.size(), ERR_INVALID_PARAM,
+        "%{public}zu sink inputs for %{public}zu sinks", sinkInputIds.size(), sinkNames.size());
     int32_t XcollieFlag = (1 | 2); // flag 1 generate log file, flag 2 die when timeout, restart server
+    AudioXCollie audioXCollie("PulseAudioServiceAdapterImpl::MoveSinkInputsByIndexOrName", PA_SERVICE_IMPL_TIMEOUT,
+        [](void *) {
+            AUDIO_ERR_LOG("MoveSinkInputsByIndexOrName timeout");
+        }, nullptr, XcollieFlag);
 
-    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, ERROR, "mContext is nullptr");
+    // the replies of all the moves come in one round trip
+    std::vector<std::future<int32_t>> results;
+    {
+        PaLockGuard palock(mMainLoop);
+        for (size_t i = 0; i < sinkInputIds.size(); i++) {
+            results.push_back(SendMoveSinkInput(sinkInputIds[i], sinkIndex, sinkNames[i]));
+        }
+    }
+
+    int32_t ret = SUCCESS;
+    for (size_t i = 0; i < results.size(); i++) {
+        CHECK_AND_RETURN_RET_LOG(WaitForReply(results[i]), ERROR, "move [%{public}u] timeout", sinkInputIds[i]);
+        int32_t result = results[i].get();
+        AUDIO_DEBUG_LOG("move [%{public}u] result:[%{public}d]", sinkInputIds[i], result);
+        // a move refused by the audio server is only logged, as it always was
+        if (result != SUCCESS && result != ERR_OPERATION_FAILED) {
+            ret = result;
+        }
+    }
+    return ret;
+}
+
+std::future<int32_t> PulseAudioServiceAdapterImpl::MoveSinkInputByIndexOrNameAsync(uint32_t sinkInputId,
+    uint32_t sinkIndex, std::string sinkName)
+{
     PaLockGuard palock(mMainLoop);
+    return SendMoveSinkInput(sinkInputId, sinkIndex, sinkName);
+}
+
+std::future<int32_t> PulseAudioServiceAdapterImpl::SendMoveSinkInput(uint32_t sinkInputId, uint32_t sinkIndex,
+    const std::string &sinkName)
+{
+    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, MakeReadyFuture<int32_t>(ERROR), "mContext is nullptr");
+    MoveOperation *move = AddOperation<MoveOperation>();
+    std::future<int32_t> future = move->promise.get_future();
     pa_operation *operation = nullptr;
     if (sinkName.empty()) {
         operation = pa_context_move_sink_input_by_index(mContext, sinkInputId, sinkIndex,
-            PulseAudioServiceAdapterImpl::PaMoveSinkInputCb, reinterpret_cast<void *>(userData.get()));
+            PulseAudioServiceAdapterImpl::PaMoveSinkInputCb, reinterpret_cast<void *>(move));
     } else {
         operation = pa_context_move_sink_input_by_name(mContext, sinkInputId, sinkName.c_str(),
-            PulseAudioServiceAdapterImpl::PaMoveSinkInputCb, reinterpret_cast<void *>(userData.get()));
+            PulseAudioServiceAdapterImpl::PaMoveSinkInputCb, reinterpret_cast<void *>(move));
     }
 
     if (operation == nullptr) {
-        AUDIO_ERR_LOG("pa_context_get_sink_input_info_list nullptr");
-        return ERROR;
-    }
-    while (pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
-        AudioXCollie audioXCollie("PulseAudioServiceAdapterImpl::MoveSinkInputByIndexOrName", PA_SERVICE_IMPL_TIMEOUT,
-            [this](void *) {
-                AUDIO_ERR_LOG("MoveSinkInputByIndexOrName timeout, trigger signal");
-                pa_threaded_mainloop_signal(this->mMainLoop, 0);
-            }, nullptr, XcollieFlag);
-        pa_threaded_mainloop_wait(mMainLoop);
+        AUDIO_ERR_LOG("move sink input [%{public}u] failed", sinkInputId);
+        move->Fail();
+        RemoveOperation(move);
+        return future;
     }
+    generation_++;
     pa_operation_unref(operation);
-
-    int result = userData->moveResult;
-    AUDIO_DEBUG_LOG("move result:[%{public}d]", result);
-
-    return SUCCESS;
+    return future;
 }
 
 int32_t PulseAudioServiceAdapterImpl::MoveSourceOutputByIndexOrName(uint32_t sourceOutputId, uint32_t sourceIndex,
@@ -519,17 +633,32 @@ int32_t PulseAudioServiceAdapterImpl::MoveSourceOutputByIndexOrName(uint32_t sou
 
 int32_t PulseAudioServiceAdapterImpl::SetVolumeDb(AudioStreamType streamType, float volumeDb)
 {
+    return SetVolumeDbBatch({streamType});
+}
+
+int32_t PulseAudioServiceAdapterImpl::SetVolumeDbBatch(const std::set<AudioStreamType> &streamTypes)
+{
+    CHECK_AND_RETURN_RET_LOG(!streamTypes.empty(), SUCCESS, "no stream type to set");
     lock_guard<mutex> lock(lock_);
 
+    PaLockGuard palock(mMainLoop);
+    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, ERROR, "SetVolumeDb mContext is nullptr");
+    if (sinkInputCacheValid_) {
+        for (auto &[sessionID, info] : sinkInputVolumeCache_) {
+            if (streamTypes.count(info.streamType) > 0) {
+                ApplySinkInputVolume(mContext, info, true);
+            }
+        }
+        return SUCCESS;
+    }
+
     unique_ptr<UserData> userData = make_unique<UserData>();
     CHECK_AND_RETURN_RET_LOG(userData != nullptr, ERROR, "userData memory alloc failed");
 
     userData->thiz = this;
-    userData->volume = volumeDb;
-    userData->streamType = streamType;
+    userData->streamType = STREAM_DEFAULT;
+    userData->streamTypes = streamTypes;
 
-    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, ERROR, "SetVolumeDb mContext is nullptr");
-    PaLockGuard palock(mMainLoop);
     pa_operation *operation = pa_context_get_sink_input_info_list(mContext,
         PulseAudioServiceAdapterImpl::PaGetSinkInputInfoVolumeCb, reinterpret_cast<void*>(userData.get()));
     if (operation == nullptr) {
@@ -564,39 +693,56 @@ int32_t PulseAudioServiceAdapterImpl::SetSourceOutputMute(int32_t uid, bool setM
     return streamSet;
 }
 
-vector<SinkInput> PulseAudioServiceAdapterImpl::GetAllSinkInputs()
+std::shared_future<std::vector<SinkInput>> PulseAudioServiceAdapterImpl::GetAllSinkInputsAsync()
 {
-    AUDIO_PRERELEASE_LOGI("GetAllSinkInputs enter");
-    unique_ptr<UserData> userData = make_unique<UserData>();
-    userData->thiz = this;
-    userData->sinkInfos = GetAllSinks();
-    int32_t XcollieFlag = (1 | 2); // flag 1 generate log file, flag 2 die when timeout, restart server
-
-    lock_guard<mutex> lock(lock_);
-    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, userData->sinkInputList, "mContext is nullptr");
-
     PaLockGuard palock(mMainLoop);
+    CHECK_AND_RETURN_RET_LOG(mContext != nullptr, MakeReadyFuture(std::vector<SinkInput>()).share(),
+        "mContext is nullptr");
+    if (sinkInputsQuery_ != nullptr && sinkInputsQuery_->generation == generation_) {
+        return sinkInputsQuery_->future;
+    }
+
+    SinkInputsQuery *query = AddOperation<SinkInputsQuery>();
+    query->generation = generation_;
+    query->future = query->promise.get_future().share();
+    std::shared_future<std::vector<SinkInput>> future = query->future;
+    pa_operation *sinksOperation = pa_context_get_sink_info_list(mContext,
+        PulseAudioServiceAdapterImpl::PaGetSinkInputsSinksCb, reinterpret_cast<void*>(query));
+    if (sinksOperation == nullptr) {
+        AUDIO_ERR_LOG("pa_context_get_sink_info_list returned nullptr");
+        query->Fail();
+        RemoveOperation(query);
+        return future;
+    }
+    pa_operation_unref(sinksOperation);
+    query->pendingReplies++;
 
     pa_operation *operation = pa_context_get_sink_input_info_list(mContext,
-        PulseAudioServiceAdapterImpl::PaGetAllSinkInputsCb, reinterpret_cast<void*>(userData.get()));
+        PulseAudioServiceAdapterImpl::PaGetAllSinkInputsCb, reinterpret_cast<void*>(query));
     if (operation == nullptr) {
+        // completed with no sink input by the reply to the sinks query
         AUDIO_ERR_LOG("pa_context_get_sink_input_info_list returned nullptr");
-        return userData->sinkInputList;
+        return future;
     }
-
-    while (pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
-        AudioXCollie audioXCollie("PulseAudioServiceAdapterImpl::GetAllSinkInputs", PA_SERVICE_IMPL_TIMEOUT,
-            [this](void *) {
-                AUDIO_ERR_LOG("GetAllSinkInputs timeout, trigger signal");
-                pa_threaded_mainloop_signal(this->mMainLoop, 0);
-            }, nullptr, XcollieFlag);
-        pa_threaded_mainloop_wait(mMainLoop);
-    }
-
     pa_operation_unref(operation);
+    query->pendingReplies++;
+    sinkInputsQuery_ = query;
+    return future;
+}
 
-    AUDIO_DEBUG_LOG("get:[%{public}zu]", userData->sinkInputList.size());
-    return userData->sinkInputList;
+vector<SinkInput> PulseAudioServiceAdapterImpl::GetAllSinkInputs()
+{
+    AUDIO_PRERELEASE_LOGI("GetAllSinkInputs enter");
+    int32_t XcollieFlag = (1 | 2); // flag 1 generate log file, flag 2 die when timeout, restart server
+    AudioXCollie audioXCollie("PulseAudioServiceAdapterImpl::GetAllSinkInputs", PA_SERVICE_IMPL_TIMEOUT,
+        [](void *) {
+            AUDIO_ERR_LOG("GetAllSinkInputs timeout");
+        }, nullptr, XcollieFlag);
+    std::shared_future<std::vector<SinkInput>> sinkInputList = GetAllSinkInputsAsync();
+    CHECK_AND_RETURN_RET_LOG(WaitForReply(sinkInputList), {}, "GetAllSinkInputs timeout");
+
+    AUDIO_DEBUG_LOG("get:[%{public}zu]", sinkInputList.get().size());
+    return sinkInputList.get();
 }
 
 vector<SourceOutput> PulseAudioServiceAdapterImpl::GetAllSourceOutputs()
@@ -650,6 +796,7 @@ void PulseAudioServiceAdapterImpl::Disconnect()
         pa_threaded_mainloop_stop(mMainLoop);
         pa_threaded_mainloop_free(mMainLoop);
     }
+    FailPendingOperations();
 }
 
 AudioStreamType PulseAudioServiceAdapterImpl::GetIdByStreamType(string streamType)
@@ -665,14 +812,11 @@ AudioStreamType PulseAudioServiceAdapterImpl::GetIdByStreamType(string streamTyp
 
 void PulseAudioServiceAdapterImpl::PaMoveSinkInputCb(pa_context *c, int success, void *userdata)
 {
-    UserData *userData = reinterpret_cast<UserData *>(userdata);
+    MoveOperation *move = reinterpret_cast<MoveOperation *>(userdata);
 
     AUDIO_DEBUG_LOG("result[%{public}d]", success);
-    userData->moveResult = success;
-
-    pa_threaded_mainloop_signal(userData->thiz->mMainLoop, 0);
-
-    return;
+    move->promise.set_value(success ? SUCCESS : ERR_OPERATION_FAILED);
+    move->thiz->RemoveOperation(move);
 }
 
 void PulseAudioServiceAdapterImpl::PaMoveSourceOutputCb(pa_context *c, int success, void *userdata)
@@ -722,6 +866,8 @@ void PulseAudioServiceAdapterImpl::PaContextStateCb(pa_context *c, void *userdat
         }
 
         case PA_CONTEXT_FAILED:
+            // pa cancels the operations of the context without calling back
+            thiz->FailPendingOperations();
             pa_threaded_mainloop_signal(thiz->mMainLoop, 0);
             return;
 
@@ -771,6 +917,10 @@ void PulseAudioServiceAdapterImpl::PaGetSinkInputInfoVolumeCb(pa_context *c, con
     }
 
     if (eol) {
+        if (!userData->isSubscribingCb) {
+            // every sink input has been seen, the events keep the cache up to date from now on
+            thiz->sinkInputCacheValid_ = true;
+        }
         pa_threaded_mainloop_signal(thiz->mMainLoop, 1);
         delete userData;
         return;
@@ -788,58 +938,138 @@ void PulseAudioServiceAdapterImpl::HandleSinkInputInfoVolume(pa_context *c, cons
     void *userdata)
 {
     UserData *userData = reinterpret_cast<UserData*>(userdata);
+    PulseAudioServiceAdapterImpl *thiz = userData->thiz;
+    SinkInputVolumeInfo info;
+    CHECK_AND_RETURN_LOG(thiz->ParseSinkInputVolumeInfo(i, info), "Invalid Stream parameter info.");
+    sinkIndexSessionIDMap.Insert(i->index, info.sessionID);
+    SinkInputVolumeInfo &cached = thiz->sinkInputVolumeCache_[info.sessionID];
+    cached = info;
+
+    bool setVolume = info.streamType == userData->streamType || userData->streamTypes.count(info.streamType) > 0 ||
+        userData->isSubscribingCb;
+    thiz->ApplySinkInputVolume(c, cached, setVolume);
+}
+
+bool PulseAudioServiceAdapterImpl::ParseSinkInputVolumeInfo(const pa_sink_input_info *i, SinkInputVolumeInfo &info)
+{
     const char *streamtype = pa_proplist_gets(i->proplist, "stream.type");
     const char *streamVolume = pa_proplist_gets(i->proplist, "stream.volumeFactor");
     const char *streamPowerVolume = pa_proplist_gets(i->proplist, "stream.powerVolumeFactor");
     const char *streamDuckVolume = pa_proplist_gets(i->proplist, "stream.duckVolumeFactor");
     const char *sessionCStr = pa_proplist_gets(i->proplist, "stream.sessionID");
-    int32_t uid = -1;
-    int32_t pid = -1;
-    CastValue<int32_t>(uid, pa_proplist_gets(i->proplist, "stream.client.uid"));
-    CastValue<int32_t>(pid, pa_proplist_gets(i->proplist, "stream.client.pid"));
-    CHECK_AND_RETURN_LOG((streamtype != nullptr) && (streamVolume != nullptr) && (streamPowerVolume != nullptr) &&
-        (streamDuckVolume != nullptr) && (sessionCStr != nullptr), "Invalid Stream parameter info.");
-
-    uint32_t sessionID = 0;
-    CastValue<uint32_t>(sessionID, sessionCStr);
-    sinkIndexSessionIDMap.Insert(i->index, sessionID);
-    int32_t streamUsage = 0;
-    CastValue<int32_t>(streamUsage, pa_proplist_gets(i->proplist, "stream.usage"));
-    float volumeFactor = atof(streamVolume);
-    float powerVolumeFactor = atof(streamPowerVolume);
-    float duckVolumeFactor = atof(streamDuckVolume);
-    AudioStreamType streamTypeID = userData->thiz->GetIdByStreamType(streamtype);
-    auto volumePair = g_audioServiceAdapterCallback->OnGetVolumeDbCb(streamTypeID);
-    float volumeDbCb = volumePair.first;
-    int32_t volumeLevel = volumePair.second;
-    float vol = volumeDbCb * volumeFactor * powerVolumeFactor * duckVolumeFactor;
+    if ((streamtype == nullptr) || (streamVolume == nullptr) || (streamPowerVolume == nullptr) ||
+        (streamDuckVolume == nullptr) || (sessionCStr == nullptr)) {
+        return false;
+    }
 
-    pa_cvolume cv = i->volume;
-    uint32_t volume = pa_sw_volume_from_linear(vol);
-    pa_cvolume_set(&cv, i->channel_map.channels, volume);
+    info.paIndex = i->index;
+    info.sessionID = 0;
+    CastValue<uint32_t>(info.sessionID, sessionCStr);
+    info.streamType = GetIdByStreamType(streamtype);
+    info.channels = i->channel_map.channels;
+    info.uid = -1;
+    info.pid = -1;
+    CastValue<int32_t>(info.uid, pa_proplist_gets(i->proplist, "stream.client.uid"));
+    CastValue<int32_t>(info.pid, pa_proplist_gets(i->proplist, "stream.client.pid"));
+    info.streamUsage = 0;
+    CastValue<int32_t>(info.streamUsage, pa_proplist_gets(i->proplist, "stream.usage"));
+    info.volumeFactor = atof(streamVolume);
+    info.powerVolumeFactor = atof(streamPowerVolume);
+    info.duckVolumeFactor = atof(streamDuckVolume);
+    info.volume = pa_cvolume_max(&i->volume);
+    return true;
+}
 
-    if (streamTypeID == userData->streamType || userData->isSubscribingCb) {
+void PulseAudioServiceAdapterImpl::ApplySinkInputVolume(pa_context *c, SinkInputVolumeInfo &info,
+    bool setVolume)
+{
+    auto volumePair = g_audioServiceAdapterCallback->OnGetVolumeDbCb(info.streamType);
+    float volumeDbCb = volumePair.first;
+    int32_t volumeLevel = volumePair.second;
+    float vol = volumeDbCb * info.volumeFactor * info.powerVolumeFactor * info.duckVolumeFactor;
+
+    pa_volume_t paVolume = pa_sw_volume_from_linear(vol);
+    if (setVolume && paVolume != info.volume) {
+        // an unchanged volume is not sent, it would only come back as a change event of the sink input
+        info.volume = paVolume;
+        pa_cvolume cv;
+        pa_cvolume_set(&cv, info.channels, paVolume);
         AUDIO_INFO_LOG("set pa volume type:%{public}d id:%{public}d vol:%{public}f db:%{public}f stream:%{public}f " \
-            "power:%{public}f duck:%{public}f", streamTypeID, sessionID, vol, volumeDbCb, volumeFactor,
-            powerVolumeFactor, duckVolumeFactor);
-        pa_operation_unref(pa_context_set_sink_input_volume(c, i->index, &cv, nullptr, nullptr));
+            "power:%{public}f duck:%{public}f", info.streamType, info.sessionID, vol, volumeDbCb, info.volumeFactor,
+            info.powerVolumeFactor, info.duckVolumeFactor);
+        pa_operation_unref(pa_context_set_sink_input_volume(c, info.paIndex, &cv, nullptr, nullptr));
     }
     std::shared_ptr<Media::MediaMonitor::EventBean> bean = std::make_shared<Media::MediaMonitor::EventBean>(
         Media::MediaMonitor::AUDIO, Media::MediaMonitor::VOLUME_CHANGE,
         Media::MediaMonitor::BEHAVIOR_EVENT);
     bean->Add("ISOUTPUT", 1);
-    bean->Add("STREAMID", static_cast<int32_t>(sessionID));
-    bean->Add("APP_UID", uid);
-    bean->Add("APP_PID", pid);
-    bean->Add("STREAMTYPE", streamTypeID);
-    bean->Add("STREAM_TYPE", streamUsage);
+    bean->Add("STREAMID", static_cast<int32_t>(info.sessionID));
+    bean->Add("APP_UID", info.uid);
+    bean->Add("APP_PID", info.pid);
+    bean->Add("STREAMTYPE", info.streamType);
+    bean->Add("STREAM_TYPE", info.streamUsage);
     bean->Add("VOLUME", vol);
     bean->Add("SYSVOLUME", volumeLevel);
-    bean->Add("VOLUMEFACTOR", volumeFactor);
-    bean->Add("POWERVOLUMEFACTOR", powerVolumeFactor);
+    bean->Add("VOLUMEFACTOR", info.volumeFactor);
+    bean->Add("POWERVOLUMEFACTOR", info.powerVolumeFactor);
     Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteLogMsg(bean);
 }
 
+void PulseAudioServiceAdapterImpl::PaRefreshSinkInputVolumeCb(pa_context *c, const pa_sink_input_info *i, int eol,
+    void *userdata)
+{
+    UserData *userData = reinterpret_cast<UserData*>(userdata);
+    PulseAudioServiceAdapterImpl *thiz = userData->thiz;
+    if (eol != 0) {
+        // a sink input removed meanwhile fails the query, the remove event drops it from the cache
+        if (eol < 0) {
+            AUDIO_WARNING_LOG("Failed to refresh sink input %{public}u: %{public}s", userData->idx,
+                pa_strerror(pa_context_errno(c)));
+        }
+        uint32_t paIndex = userData->idx;
+        delete userData;
+        auto refresh = thiz->sinkInputRefreshes_.find(paIndex);
+        if (refresh == thiz->sinkInputRefreshes_.end()) {
+            return;
+        }
+        bool again = refresh->second;
+        thiz->sinkInputRefreshes_.erase(refresh);
+        if (again) {
+            thiz->RefreshSinkInputVolumeCache(c, paIndex);
+        }
+        return;
+    }
+    if (i->proplist == nullptr) {
+        return;
+    }
+    const char *streamMode = pa_proplist_gets(i->proplist, "stream.mode");
+    if (streamMode != nullptr && streamMode == DUP_STREAM) { return; }
+
+    SinkInputVolumeInfo info;
+    if (thiz->ParseSinkInputVolumeInfo(i, info)) {
+        thiz->sinkInputVolumeCache_[info.sessionID] = info;
+    }
+}
+
+void PulseAudioServiceAdapterImpl::RefreshSinkInputVolumeCache(pa_context *c, uint32_t paIndex)
+{
+    auto refresh = sinkInputRefreshes_.find(paIndex);
+    if (refresh != sinkInputRefreshes_.end()) {
+        // the query in flight may have been answered before this change, query once more when it ends
+        refresh->second = true;
+        return;
+    }
+    unique_ptr<UserData> userData = make_unique<UserData>();
+    userData->thiz = this;
+    userData->idx = paIndex;
+    pa_operation *operation = pa_context_get_sink_input_info(c, paIndex,
+        PulseAudioServiceAdapterImpl::PaRefreshSinkInputVolumeCb, reinterpret_cast<void*>(userData.get()));
+    CHECK_AND_RETURN_LOG(operation != nullptr, "refresh sink input %{public}u failed", paIndex);
+    userData.release();
+    sinkInputRefreshes_[paIndex] = false;
+    pa_operation_unref(operation);
+}
+
 void PulseAudioServiceAdapterImpl::PaGetSourceOutputCb(pa_context *c, const pa_source_output_info *i, int eol,
     void *userdata)
 {
@@ -873,21 +1103,55 @@ void PulseAudioServiceAdapterImpl::PaGetSourceOutputCb(pa_context *c, const pa_s
     sourceIndexSessionIDMap.Insert(i->index, sessionID);
 }
 
+void PulseAudioServiceAdapterImpl::PaGetSinkInputsSinksCb(pa_context *c, const pa_sink_info *i, int eol,
+    void *userdata)
+{
+    SinkInputsQuery *query = reinterpret_cast<SinkInputsQuery *>(userdata);
+
+    if (eol < 0) {
+        AUDIO_ERR_LOG("Failed to get sink information: %{public}s", pa_strerror(pa_context_errno(c)));
+    }
+    if (eol) {
+        CompleteSinkInputsQuery(query);
+        return;
+    }
+
+    SinkInfo sinkInfo = {};
+    if (ParseSinkInfo(i, sinkInfo)) {
+        query->sinkInfos.push_back(sinkInfo);
+    }
+}
+
+void PulseAudioServiceAdapterImpl::CompleteSinkInputsQuery(SinkInputsQuery *query)
+{
+    if (--query->pendingReplies > 0) {
+        return;
+    }
+
+    for (auto &sinkInput : query->sinkInputList) {
+        for (auto &sinkInfo : query->sinkInfos) {
+            if (sinkInput.deviceSinkId == sinkInfo.sinkId) {
+                sinkInput.sinkName = sinkInfo.sinkName;
+                break;
+            }
+        }
+    }
+    query->promise.set_value(std::move(query->sinkInputList));
+    query->thiz->RemoveOperation(query);
+}
+
 void PulseAudioServiceAdapterImpl::PaGetAllSinkInputsCb(pa_context *c, const pa_sink_input_info *i, int eol,
     void *userdata)
 {
     AUDIO_DEBUG_LOG("in eol[%{public}d]", eol);
-    UserData *userData = reinterpret_cast<UserData *>(userdata);
-    PulseAudioServiceAdapterImpl *thiz = userData->thiz;
+    SinkInputsQuery *query = reinterpret_cast<SinkInputsQuery *>(userdata);
+    PulseAudioServiceAdapterImpl *thiz = query->thiz;
 
     if (eol < 0) {
         AUDIO_ERR_LOG("Failed to get sink input information: %{public}s", pa_strerror(pa_context_errno(c)));
-        pa_threaded_mainloop_signal(thiz->mMainLoop, 0);
-        return;
     }
-
     if (eol) {
-        pa_threaded_mainloop_signal(thiz->mMainLoop, 0);
+        CompleteSinkInputsQuery(query);
         return;
     }
 
@@ -910,19 +1174,13 @@ void PulseAudioServiceAdapterImpl::PaGetAllSinkInputsCb(pa_context *c, const pa_
     sinkInput.streamType = audioStreamType;
 
     sinkInput.deviceSinkId = i->sink;
-    for (auto sinkInfo : userData->sinkInfos) {
-        if (sinkInput.deviceSinkId == sinkInfo.sinkId) {
-            sinkInput.sinkName = sinkInfo.sinkName;
-            break;
-        }
-    }
     sinkInput.paStreamId = i->index;
     CastValue<int32_t>(sinkInput.streamId, pa_proplist_gets(i->proplist, "stream.sessionID"));
     CastValue<int32_t>(sinkInput.uid, pa_proplist_gets(i->proplist, "stream.client.uid"));
     CastValue<int32_t>(sinkInput.pid, pa_proplist_gets(i->proplist, "stream.client.pid"));
     CastValue<uint64_t>(sinkInput.startTime, pa_proplist_gets(i->proplist, "stream.startTime"));
 
-    userData->sinkInputList.push_back(sinkInput);
+    query->sinkInputList.push_back(sinkInput);
 }
 
 void PulseAudioServiceAdapterImpl::PaGetAllSourceOutputsCb(pa_context *c, const pa_source_output_info *i, int eol,
@@ -1005,12 +1263,14 @@ void PulseAudioServiceAdapterImpl::PaSubscribeCb(pa_context *c, pa_subscription_
     userData->isSubscribingCb = true;
     switch (t & PA_SUBSCRIPTION_EVENT_FACILITY_MASK) {
         case PA_SUBSCRIPTION_EVENT_SINK:
+            thiz->generation_++;
             break;
 
         case PA_SUBSCRIPTION_EVENT_SOURCE:
             break;
 
         case PA_SUBSCRIPTION_EVENT_SINK_INPUT:
+            thiz->generation_++;
             if ((t & PA_SUBSCRIPTION_EVENT_TYPE_MASK) == PA_SUBSCRIPTION_EVENT_NEW) {
                 PaLockGuard lock(thiz->mMainLoop);
                 pa_operation *operation = pa_context_get_sink_input_info(c, idx,
@@ -1022,8 +1282,15 @@ void PulseAudioServiceAdapterImpl::PaSubscribeCb(pa_context *c, pa_subscription_
                 userData.release();
                 pa_threaded_mainloop_accept(thiz->mMainLoop);
                 pa_operation_unref(operation);
+            } else if ((t & PA_SUBSCRIPTION_EVENT_TYPE_MASK) == PA_SUBSCRIPTION_EVENT_CHANGE) {
+                // the volume factors are updated through the proplist, no need to wait for the reply
+                thiz->RefreshSinkInputVolumeCache(c, idx);
             } else if ((t & PA_SUBSCRIPTION_EVENT_TYPE_MASK) == PA_SUBSCRIPTION_EVENT_REMOVE) {
                 const uint32_t sessionID = sinkIndexSessionIDMap.ReadVal(idx);
+                auto cached = thiz->sinkInputVolumeCache_.find(sessionID);
+                if (cached != thiz->sinkInputVolumeCache_.end() && cached->second.paIndex == idx) {
+                    thiz->sinkInputVolumeCache_.erase(cached);
+                }
                 AUDIO_INFO_LOG("sessionID: %{public}d  removed", sessionID);
             }
             break;
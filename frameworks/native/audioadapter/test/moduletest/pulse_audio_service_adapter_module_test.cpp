@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <pulse/pulseaudio.h>
+#include "audio_errors.h"
+#include "audio_service_adapter.h"
+
+using namespace testing::ext;
+using namespace std;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr uint32_t WAIT_STEP_US = 10000; // 10ms
+constexpr uint32_t WAIT_STEPS = 100; // 1s at most
+constexpr uint32_t OTHER_CLIENTS_WAIT_US = 200000; // 200ms
+constexpr uint32_t MUSIC_SESSION_ID = 900001;
+constexpr uint32_t RING_SESSION_ID = 900002;
+constexpr int32_t TEST_VOLUME_LEVEL = 5;
+
+mutex g_volumeMutex;
+map<AudioStreamType, float> g_volumeDb;
+map<AudioStreamType, uint32_t> g_volumeDbReads;
+
+void SetTestVolumeDb(AudioStreamType streamType, float volumeDb)
+{
+    lock_guard<mutex> lock(g_volumeMutex);
+    g_volumeDb[streamType] = volumeDb;
+}
+
+class TestAdapterCallback : public AudioServiceAdapterCallback {
+public:
+    pair<float, int32_t> OnGetVolumeDbCb(AudioStreamType streamType) override
+    {
+        lock_guard<mutex> lock(g_volumeMutex);
+        g_volumeDbReads[streamType]++;
+        auto it = g_volumeDb.find(streamType);
+        return {it == g_volumeDb.end() ? 1.0f : it->second, TEST_VOLUME_LEVEL};
+    }
+
+    void OnAudioStreamRemoved(const uint64_t sessionID) override {}
+};
+
+// A playback stream of its own pa context, seen by the adapter as a sink input.
+class TestSinkInput {
+public:
+    ~TestSinkInput()
+    {
+        Close();
+    }
+
+    bool Open(const string &streamType, uint32_t sessionID)
+    {
+        mainLoop_ = pa_threaded_mainloop_new();
+        if (mainLoop_ == nullptr || pa_threaded_mainloop_start(mainLoop_) < 0) {
+            return false;
+        }
+        pa_threaded_mainloop_lock(mainLoop_);
+        context_ = pa_context_new(pa_threaded_mainloop_get_api(mainLoop_), "pulse_audio_service_adapter_module_test");
+        bool connected = context_ != nullptr && pa_context_connect(context_, nullptr, PA_CONTEXT_NOFLAGS, nullptr) >= 0;
+        pa_threaded_mainloop_unlock(mainLoop_);
+        if (!connected || !WaitFor([this] { return GetContextState() == PA_CONTEXT_READY; })) {
+            return false;
+        }
+
+        pa_threaded_mainloop_lock(mainLoop_);
+        pa_sample_spec spec = { PA_SAMPLE_S16LE, 48000, 2 }; // 48000 hz stereo
+        pa_proplist *propList = pa_proplist_new();
+        pa_proplist_sets(propList, "stream.type", streamType.c_str());
+        pa_proplist_sets(propList, "stream.sessionID", to_string(sessionID).c_str());
+        pa_proplist_sets(propList, "stream.volumeFactor", "1.0");
+        pa_proplist_sets(propList, "stream.powerVolumeFactor", "1.0");
+        pa_proplist_sets(propList, "stream.duckVolumeFactor", "1.0");
+        stream_ = pa_stream_new_with_proplist(context_, streamType.c_str(), &spec, nullptr, propList);
+        pa_proplist_free(propList);
+        connected = stream_ != nullptr && pa_stream_connect_playback(stream_, nullptr, nullptr,
+            PA_STREAM_START_CORKED, nullptr, nullptr) >= 0;
+        pa_threaded_mainloop_unlock(mainLoop_);
+        if (!connected || !WaitFor([this] { return GetStreamState() == PA_STREAM_READY; })) {
+            return false;
+        }
+        // the other clients of the server set the volume of a new sink input too, let them be done with it
+        usleep(OTHER_CLIENTS_WAIT_US);
+        return true;
+    }
+
+    void Close()
+    {
+        if (mainLoop_ == nullptr) {
+            return;
+        }
+        pa_threaded_mainloop_lock(mainLoop_);
+        if (stream_ != nullptr) {
+            pa_stream_disconnect(stream_);
+            pa_stream_unref(stream_);
+            stream_ = nullptr;
+        }
+        if (context_ != nullptr) {
+            pa_context_disconnect(context_);
+            pa_context_unref(context_);
+            context_ = nullptr;
+        }
+        pa_threaded_mainloop_unlock(mainLoop_);
+        pa_threaded_mainloop_stop(mainLoop_);
+        pa_threaded_mainloop_free(mainLoop_);
+        mainLoop_ = nullptr;
+    }
+
+    pa_volume_t GetVolume()
+    {
+        struct Query {
+            pa_threaded_mainloop *mainLoop;
+            pa_volume_t volume;
+        } query = { mainLoop_, PA_VOLUME_INVALID };
+        pa_threaded_mainloop_lock(mainLoop_);
+        pa_operation *operation = pa_context_get_sink_input_info(context_, pa_stream_get_index(stream_),
+            [](pa_context *c, const pa_sink_input_info *i, int eol, void *userdata) {
+                Query *query = reinterpret_cast<Query *>(userdata);
+                if (eol == 0 && i != nullptr) {
+                    query->volume = pa_cvolume_max(&i->volume);
+                }
+                pa_threaded_mainloop_signal(query->mainLoop, 0);
+            }, &query);
+        while (operation != nullptr && pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
+            pa_threaded_mainloop_wait(mainLoop_);
+        }
+        if (operation != nullptr) {
+            pa_operation_unref(operation);
+        }
+        pa_threaded_mainloop_unlock(mainLoop_);
+        return query.volume;
+    }
+
+    void SetVolumeFactor(float volumeFactor)
+    {
+        pa_threaded_mainloop_lock(mainLoop_);
+        pa_proplist *propList = pa_proplist_new();
+        pa_proplist_sets(propList, "stream.volumeFactor", to_string(volumeFactor).c_str());
+        pa_operation *operation = pa_stream_proplist_update(stream_, PA_UPDATE_REPLACE, propList, nullptr, nullptr);
+        if (operation != nullptr) {
+            pa_operation_unref(operation);
+        }
+        pa_proplist_free(propList);
+        pa_threaded_mainloop_unlock(mainLoop_);
+    }
+
+    uint32_t GetIndex()
+    {
+        pa_threaded_mainloop_lock(mainLoop_);
+        uint32_t index = pa_stream_get_index(stream_);
+        pa_threaded_mainloop_unlock(mainLoop_);
+        return index;
+    }
+
+    bool WaitForVolume(float linear)
+    {
+        pa_volume_t expected = pa_sw_volume_from_linear(linear);
+        return WaitFor([this, expected] { return GetVolume() == expected; });
+    }
+
+private:
+    template <typename Condition>
+    static bool WaitFor(Condition condition)
+    {
+        for (uint32_t i = 0; i < WAIT_STEPS; i++) {
+            if (condition()) {
+                return true;
+            }
+            usleep(WAIT_STEP_US);
+        }
+        return false;
+    }
+
+    pa_context_state_t GetContextState()
+    {
+        pa_threaded_mainloop_lock(mainLoop_);
+        pa_context_state_t state = pa_context_get_state(context_);
+        pa_threaded_mainloop_unlock(mainLoop_);
+        return state;
+    }
+
+    pa_stream_state_t GetStreamState()
+    {
+        pa_threaded_mainloop_lock(mainLoop_);
+        pa_stream_state_t state = pa_stream_get_state(stream_);
+        pa_threaded_mainloop_unlock(mainLoop_);
+        return state;
+    }
+
+    pa_threaded_mainloop *mainLoop_ = nullptr;
+    pa_context *context_ = nullptr;
+    pa_stream *stream_ = nullptr;
+};
+} // namespace
+
+// Runs against the pulseaudio server of the device: the adapter and the test streams are clients of it, and the
+// volume changes are waited for as they go through the server.
+class PulseAudioServiceAdapterModuleTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    static unique_ptr<AudioServiceAdapter> adapter_;
+};
+
+unique_ptr<AudioServiceAdapter> PulseAudioServiceAdapterModuleTest::adapter_ = nullptr;
+
+void PulseAudioServiceAdapterModuleTest::SetUpTestCase(void)
+{
+    adapter_ = AudioServiceAdapter::CreateAudioAdapter(make_unique<TestAdapterCallback>());
+    ASSERT_NE(adapter_, nullptr);
+    ASSERT_TRUE(adapter_->Connect());
+}
+
+void PulseAudioServiceAdapterModuleTest::TearDownTestCase(void)
+{
+    adapter_->Disconnect();
+    adapter_ = nullptr;
+}
+
+void PulseAudioServiceAdapterModuleTest::SetUp(void)
+{
+    lock_guard<mutex> lock(g_volumeMutex);
+    g_volumeDb.clear();
+    g_volumeDbReads.clear();
+}
+
+void PulseAudioServiceAdapterModuleTest::TearDown(void) {}
+
+/**
+* @tc.name  : Test SetVolumeDbBatch API
+* @tc.type  : FUNC
+* @tc.number: SetVolumeDbBatch_001
+* @tc.desc  : Test SetVolumeDbBatch with no stream type, nothing is read nor set.
+*/
+HWTEST_F(PulseAudioServiceAdapterModuleTest, SetVolumeDbBatch_001, TestSize.Level1)
+{
+    EXPECT_EQ(SUCCESS, adapter_->SetVolumeDbBatch({}));
+    lock_guard<mutex> lock(g_volumeMutex);
+    EXPECT_TRUE(g_volumeDbReads.empty());
+}
+
+/**
+* @tc.name  : Test SetVolumeDbBatch API
+* @tc.type  : FUNC
+* @tc.number: SetVolumeDbBatch_002
+* @tc.desc  : Test SetVolumeDbBatch sets the sink inputs of every stream type of the batch, and only those.
+*/
+HWTEST_F(PulseAudioServiceAdapterModuleTest, SetVolumeDbBatch_002, TestSize.Level1)
+{
+    TestSinkInput music;
+    TestSinkInput ring;
+    ASSERT_TRUE(music.Open("music", MUSIC_SESSION_ID));
+    ASSERT_TRUE(ring.Open("ring", RING_SESSION_ID));
+
+    SetTestVolumeDb(STREAM_MUSIC, 0.5f);
+    SetTestVolumeDb(STREAM_RING, 0.25f);
+    EXPECT_EQ(SUCCESS, adapter_->SetVolumeDbBatch({STREAM_MUSIC, STREAM_RING}));
+    EXPECT_TRUE(music.WaitForVolume(0.5f));
+    EXPECT_TRUE(ring.WaitForVolume(0.25f));
+
+    // the ring volume read now is not part of the batch and must not reach its sink input
+    SetTestVolumeDb(STREAM_MUSIC, 0.125f);
+    SetTestVolumeDb(STREAM_RING, 1.0f);
+    EXPECT_EQ(SUCCESS, adapter_->SetVolumeDbBatch({STREAM_MUSIC}));
+    EXPECT_TRUE(music.WaitForVolume(0.125f));
+    EXPECT_EQ(pa_sw_volume_from_linear(0.25f), ring.GetVolume());
+}
+
+/**
+* @tc.name  : Test SetVolumeDbBatch API
+* @tc.type  : FUNC
+* @tc.number: SetVolumeDbBatch_003
+* @tc.desc  : Test the change events caused by a batch do not hide a later change of the volume factors.
+*/
+HWTEST_F(PulseAudioServiceAdapterModuleTest, SetVolumeDbBatch_003, TestSize.Level1)
+{
+    TestSinkInput music;
+    ASSERT_TRUE(music.Open("music", MUSIC_SESSION_ID));
+
+    SetTestVolumeDb(STREAM_MUSIC, 0.5f);
+    EXPECT_EQ(SUCCESS, adapter_->SetVolumeDbBatch({STREAM_MUSIC, STREAM_RING, STREAM_VOICE_CALL}));
+    EXPECT_TRUE(music.WaitForVolume(0.5f));
+
+    music.SetVolumeFactor(0.5f);
+    bool applied = false;
+    for (uint32_t i = 0; i < WAIT_STEPS && !applied; i++) {
+        EXPECT_EQ(SUCCESS, adapter_->SetVolumeDbBatch({STREAM_MUSIC}));
+        applied = music.GetVolume() == pa_sw_volume_from_linear(0.25f);
+        usleep(WAIT_STEP_US);
+    }
+    EXPECT_TRUE(applied);
+}
+
+/**
+* @tc.name  : Test GetAllSinksAsync API
+* @tc.type  : FUNC
+* @tc.number: GetAllSinksAsync_001
+* @tc.desc  : Test the callers coming while a query is in flight share its reply.
+*/
+HWTEST_F(PulseAudioServiceAdapterModuleTest, GetAllSinksAsync_001, TestSize.Level1)
+{
+    shared_future<vector<SinkInfo>> first = adapter_->GetAllSinksAsync();
+    shared_future<vector<SinkInfo>> second = adapter_->GetAllSinksAsync();
+    // a query answered before the second call is not shared any more, there is nothing to check then
+    bool firstInFlight = first.wait_for(chrono::seconds(0)) != future_status::ready;
+    ASSERT_EQ(future_status::ready, first.wait_for(chrono::seconds(1)));
+    ASSERT_EQ(future_status::ready, second.wait_for(chrono::seconds(1)));
+    EXPECT_FALSE(first.get().empty());
+    if (firstInFlight) {
+        EXPECT_EQ(&first.get(), &second.get());
+    }
+}
+
+/**
+* @tc.name  : Test GetAllSinkInputsAsync API
+* @tc.type  : FUNC
+* @tc.number: GetAllSinkInputsAsync_001
+* @tc.desc  : Test a caller after its own move gets a new query, never the one sent before the move.
+*/
+HWTEST_F(PulseAudioServiceAdapterModuleTest, GetAllSinkInputsAsync_001, TestSize.Level1)
+{
+    TestSinkInput music;
+    ASSERT_TRUE(music.Open("music", MUSIC_SESSION_ID));
+    uint32_t index = music.GetIndex();
+
+    shared_future<vector<SinkInput>> beforeMove = adapter_->GetAllSinkInputsAsync();
+    ASSERT_EQ(future_status::ready, beforeMove.wait_for(chrono::seconds(1)));
+    auto it = find_if(beforeMove.get().begin(), beforeMove.get().end(),
+        [index](const SinkInput &sinkInput) { return sinkInput.paStreamId == index; });
+    ASSERT_NE(beforeMove.get().end(), it);
+
+    shared_future<vector<SinkInput>> inFlight = adapter_->GetAllSinkInputsAsync();
+    future<int32_t> move = adapter_->MoveSinkInputByIndexOrNameAsync(index, it->deviceSinkId, "");
+    shared_future<vector<SinkInput>> afterMove = adapter_->GetAllSinkInputsAsync();
+    ASSERT_EQ(future_status::ready, move.wait_for(chrono::seconds(1)));
+    EXPECT_EQ(SUCCESS, move.get());
+    ASSERT_EQ(future_status::ready, inFlight.wait_for(chrono::seconds(1)));
+    ASSERT_EQ(future_status::ready, afterMove.wait_for(chrono::seconds(1)));
+    EXPECT_NE(&inFlight.get(), &afterMove.get());
+    EXPECT_NE(afterMove.get().end(), find_if(afterMove.get().begin(), afterMove.get().end(),
+        [index](const SinkInput &sinkInput) { return sinkInput.paStreamId == index; }));
+}
+} // namespace AudioStandard
+} // namespace OHOS
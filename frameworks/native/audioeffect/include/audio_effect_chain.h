@@ -16,7 +16,10 @@
 #ifndef AUDIO_EFFECT_CHAIN_H
 #define AUDIO_EFFECT_CHAIN_H
 
+#include <atomic>
+
 #include "audio_effect.h"
+#include "audio_effect_profiler.h"
 #include "audio_utils.h"
 
 #ifdef SENSOR_ENABLE
@@ -35,6 +38,29 @@ struct AudioEffectProcInfo {
     bool btOffloadEnabled;
 };
 
+// Commands for the handles in use by the render thread, sent by the render thread before its next process so that a
+// handle is never commanded and processed at the same time. Every command is idempotent, a newer one merges into the
+// one not sent yet.
+struct AudioEffectChainCommand {
+    bool enable = false;
+    bool setParam = false;
+    bool setConfig = false;
+    bool disableHeadTracking = false;
+    std::vector<uint8_t> paramBuffer;
+    AudioEffectConfig ioBufferConfig = {};
+};
+
+// What the render thread needs of the chain, never changed once published.
+struct AudioEffectChainSnapshot {
+    std::vector<AudioEffectHandle> handles;
+    std::vector<AudioEffectProfileSlot *> profileSlots; // one for each handle
+    uint32_t inChannels = 0;
+    uint32_t outChannels = 0;
+    uint32_t sampleRate = 0;
+    uint64_t commandSeq = 0;
+    AudioEffectChainCommand command;
+};
+
 class AudioEffectChain {
 public:
 #ifdef SENSOR_ENABLE
@@ -63,17 +89,38 @@ public:
 private:
     AudioEffectConfig GetIoBufferConfig();
     void ReleaseEffectChain();
-    int32_t SetEffectParamToHandle(AudioEffectHandle handle, int32_t &replyData);
+    std::vector<uint8_t> BuildEffectParam();
+    int32_t SendEffectParam(AudioEffectHandle handle, const std::vector<uint8_t> &paramBuffer,
+        std::vector<uint8_t> &sendBuffer, int32_t &replyData);
+    int32_t SendIoBufferConfig(const std::vector<AudioEffectHandle> &handles, const AudioEffectConfig &config);
+    void SendPendingCommand(const AudioEffectChainSnapshot &snapshot);
+    void PublishSnapshot(const AudioEffectChainCommand *command);
+    void WaitForRenderQuiescent();
+    uint32_t EnterRender();
+    void ExitRender(uint32_t readerIndex);
+    void ProcessSnapshot(const AudioEffectChainSnapshot &snapshot, float *bufIn, float *bufOut, uint32_t frameLen,
+        AudioEffectProcInfo procInfo);
     void DumpEffectProcessData(std::string fileName, void *buffer, size_t len);
 
+    // Serializes the control side only, the render thread reads snapshot_ without lock. A replaced snapshot and the
+    // handles dropped from it are freed after every render that may still see them is done, see PublishSnapshot.
     std::mutex reloadMutex_;
+    std::atomic<AudioEffectChainSnapshot *> snapshot_ = nullptr;
+    std::atomic<uint32_t> readerEpoch_ = 0;
+    std::atomic<uint32_t> readers_[2] = {}; // renders in progress, indexed by the reader epoch they started in
+    std::atomic<uint64_t> sentCommandSeq_ = 0;
+    std::vector<uint8_t> renderParamBuffer_; // render thread only
+    uint32_t profilePeriodCount_ = 0; // render thread only
+    AudioEffectProfileSlot *totalProfileSlot_ = nullptr;
     std::string sceneType_ = "";
     std::string effectMode_ = "";
-    uint32_t latency_ = 0;
+    std::atomic<uint32_t> latency_ = 0;
     uint32_t extraEffectChainType_ = 0;
     AudioEffectScene currSceneType_ = SCENE_MUSIC;
+    // control side copies of the handle list, under reloadMutex_
     std::vector<AudioEffectHandle> standByEffectHandles_;
     std::vector<AudioEffectLibrary *> libHandles_;
+    std::vector<AudioEffectProfileSlot *> profileSlots_;
     AudioEffectConfig ioBufferConfig_ = {};
     AudioBuffer audioBufIn_ = {};
     AudioBuffer audioBufOut_ = {};
@@ -31,7 +31,6 @@ typedef struct BufferAttr {
     int numChanIn;
     int numChanOut;
     int frameLen;
-    float *tempBufIn;
     float *tempBufOut;
     bool bufOutUsed;
 } BufferAttr;
@@ -45,6 +44,8 @@ typedef struct SessionInfoPack {
 } SessionInfoPack;
 
 int32_t EffectChainManagerProcess(char *sceneType, BufferAttr *bufferAttr);
+// Processes the scenes in parallel on the effect workers, the buffers of each scene must not be shared.
+int32_t EffectChainManagerProcessScenes(char *const *sceneTypes, BufferAttr *const *bufferAttrs, uint32_t sceneNum);
 bool EffectChainManagerExist(const char *sceneType, const char *effectMode, const char *spatializationEnabled);
 int32_t EffectChainManagerCreateCb(const char *sceneType, const char *sessionID);
 int32_t EffectChainManagerReleaseCb(const char *sceneType, const char *sessionID);
@@ -62,6 +63,10 @@ bool EffectChainManagerGetSpatializationEnabled();
 void EffectChainManagerFlush(void);
 void EffectChainManagerEffectUpdate(void);
 bool EffectChainManagerSceneCheck(const char *sinkSceneType, const char *sceneType);
+// Results of EffectChainManagerExist and EffectChainManagerSceneCheck only change along with the route generation.
+uint32_t EffectChainManagerGetRouteGeneration(void);
+// For changes the manager does not see, such as the scene properties of a sink input.
+void EffectChainManagerInvalidateRoute(void);
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,8 @@
 #ifndef AUDIO_EFFECT_CHAIN_MANAGER_H
 #define AUDIO_EFFECT_CHAIN_MANAGER_H
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstdint>
 #include <cassert>
@@ -40,6 +42,7 @@
 #include "audio_effect_rotation.h"
 #endif
 #include "audio_effect_volume.h"
+#include "audio_effect_worker_pool.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -103,7 +106,11 @@ public:
     int32_t ReleaseAudioEffectChainDynamic(const std::string &sceneType);
     bool ExistAudioEffectChain(const std::string &sceneType, const std::string &effectMode,
         const std::string &spatializationEnabled);
-    int32_t ApplyAudioEffectChain(const std::string &sceneType, const std::unique_ptr<EffectBufferAttr> &bufferAttr);
+    int32_t ApplyAudioEffectChain(const std::string &sceneType, const EffectBufferAttr &bufferAttr);
+    // Applies the chains of several scenes on the effect workers and returns when all are done. Scenes sharing an
+    // effect chain are applied one after another in the given order.
+    int32_t ApplyAudioEffectChains(const std::vector<std::string> &sceneTypes,
+        const std::vector<EffectBufferAttr> &bufferAttrs);
     void SetOutputDeviceSink(int32_t device, const std::string &sinkName);
     std::string GetDeviceTypeName();
     std::string GetDeviceSinkName();
@@ -128,6 +135,10 @@ public:
     void ResetInfo();  // Use for testing temporarily.
     void UpdateRealAudioEffect();
     bool CheckSceneTypeMatch(const std::string &sinkSceneType, const std::string &sceneType);
+    // Changes whenever the result of ExistAudioEffectChain or CheckSceneTypeMatch may change, so that the render
+    // loop can cache them. Bumped after a change is made, or while it is made under dynamicMutex_.
+    uint32_t GetRouteGeneration();
+    void InvalidateRoute();
     void UpdateSpatializationEnabled(AudioSpatializationState spatializationState);
     void UpdateSpkOffloadEnabled(); // Used for AISS scene temporarily
     void UpdateExtraSceneType(const std::string &extraSceneType);
@@ -153,6 +164,9 @@ private:
     std::shared_ptr<AudioEffectChain> CreateAudioEffectChain(const std::string &sceneType);
     bool CheckIfSpkDsp();
     void CheckAndReleaseCommonEffectChain(const std::string &sceneType);
+    std::shared_ptr<AudioEffectChain> GetAppliedEffectChain(const std::string &sceneType);
+    const std::string &GetAppliedSceneTypeAndDeviceKey(const std::string &sceneType);
+    AudioEffectWorkerPool *GetWorkerPool();
 #ifdef WINDOW_MANAGER_ENABLE
     int32_t EffectDspRotationUpdate(std::shared_ptr<AudioEffectRotation> audioEffectRotation,
         const uint32_t rotationState);
@@ -176,6 +190,7 @@ private:
     std::string extraSceneType_ = "0";
     bool isInitialized_ = false;
     std::recursive_mutex dynamicMutex_;
+    std::atomic<uint32_t> routeGeneration_ = 0;
     bool spatializationEnabled_ = false;
     bool headTrackingEnabled_ = false;
     bool btOffloadEnabled_ = false;
@@ -195,6 +210,8 @@ private:
 #endif
 
     std::shared_ptr<AudioEffectHdiParam> audioEffectHdiParam_;
+    std::mutex workerPoolMutex_;
+    std::unique_ptr<AudioEffectWorkerPool> workerPool_ = nullptr;
     int8_t effectHdiInput_[SEND_HDI_COMMAND_LEN];
 };
 }  // namespace AudioStandard
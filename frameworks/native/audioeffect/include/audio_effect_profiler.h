@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_EFFECT_PROFILER_H
+#define AUDIO_EFFECT_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace AudioStandard {
+// Bucket i counts the process calls taking [2^(i-1), 2^i) us, bucket 0 the ones under 1 us.
+constexpr uint32_t EFFECT_PROFILE_BUCKET_NUM = 16;
+// The name of the slot timing a whole chain.
+const std::string EFFECT_PROFILE_CHAIN_TOTAL = "total";
+
+// Updated by the render thread without lock, read by the dump.
+struct AudioEffectProfileSlot {
+    std::string sceneType;
+    std::string effectName;
+    std::atomic<uint64_t> count = 0;
+    std::atomic<uint64_t> totalNs = 0;
+    std::atomic<uint64_t> maxNs = 0;
+    std::atomic<uint64_t> overruns = 0; // calls longer than the period they process
+    std::array<std::atomic<uint64_t>, EFFECT_PROFILE_BUCKET_NUM> buckets = {};
+};
+
+struct AudioEffectProfileInfo {
+    std::string sceneType;
+    std::string effectName;
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+    uint64_t overruns;
+    std::array<uint64_t, EFFECT_PROFILE_BUCKET_NUM> buckets;
+};
+
+/**
+ * Process time of each effect of each chain. Only one render period out of the sample interval is timed, so that it
+ * can stay on in production. Slots are registered from the control side and kept for the life of the process, the
+ * render thread holds a pointer to them and records with relaxed atomics.
+*/
+class AudioEffectProfiler {
+public:
+    static AudioEffectProfiler &GetInstance();
+
+    AudioEffectProfileSlot *GetSlot(const std::string &sceneType, const std::string &effectName);
+    // A sample interval of 0 turns the profiling off.
+    void SetSampleInterval(uint32_t sampleInterval);
+    uint32_t GetSampleInterval() const;
+    // Takes the sample interval from persist.multimedia.audio.effect.profileinterval if it is set.
+    void LoadSampleInterval();
+    // To be called once per render period by each chain, with its own counter.
+    bool IsSampled(uint32_t &periodCount) const;
+    static void Record(AudioEffectProfileSlot *slot, uint64_t costNs, uint64_t periodNs);
+
+    std::vector<AudioEffectProfileInfo> GetProfileInfo();
+    void Reset();
+    void Dump(std::string &dumpString);
+
+private:
+    AudioEffectProfiler();
+
+    std::mutex slotMutex_;
+    std::deque<AudioEffectProfileSlot> slots_; // deque, pointers to the slots stay valid while adding more
+    std::atomic<uint32_t> sampleInterval_;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_EFFECT_PROFILER_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_EFFECT_WORKER_POOL_H
+#define AUDIO_EFFECT_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace AudioStandard {
+/**
+ * A few threads scheduled like the render thread, to run the independent effect chains of one render period in
+ * parallel. Run hands out the tasks to the workers and the calling thread and returns after all of them are done,
+ * it does not allocate.
+*/
+class AudioEffectWorkerPool {
+public:
+    using Task = void (*)(void *context, uint32_t index);
+
+    explicit AudioEffectWorkerPool(uint32_t workerNum);
+    ~AudioEffectWorkerPool();
+
+    // Runs task(context, index) for each index in [0, taskNum), only one Run is served at a time.
+    void Run(Task task, void *context, uint32_t taskNum);
+
+    uint32_t GetWorkerNum() const noexcept;
+
+private:
+    void WorkerLoop();
+    void RunTasks();
+
+    std::vector<std::thread> workers_;
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable startCv_;
+    std::condition_variable doneCv_;
+    uint64_t round_ = 0;
+    uint32_t activeWorkers_ = 0; // workers in RunTasks
+    bool quit_ = false;
+
+    // set under mutex_ while no worker is active
+    Task task_ = nullptr;
+    void *context_ = nullptr;
+    uint32_t taskNum_ = 0;
+    std::atomic<uint32_t> nextTask_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_EFFECT_WORKER_POOL_H
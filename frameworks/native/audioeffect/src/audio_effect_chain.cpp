@@ -17,6 +17,10 @@
 #endif
 
 #include "audio_effect_chain.h"
+
+#include <chrono>
+#include <thread>
+
 #include "audio_effect_chain_adapter.h"
 #include "audio_effect.h"
 #include "audio_errors.h"
@@ -32,6 +36,8 @@ const uint32_t NUM_SET_EFFECT_PARAM = 7;
 const uint32_t DEFAULT_SAMPLE_RATE = 48000;
 const uint32_t DEFAULT_NUM_CHANNEL = STEREO;
 const uint64_t DEFAULT_NUM_CHANNELLAYOUT = CH_LAYOUT_STEREO;
+const int64_t RENDER_QUIESCENT_WAIT_US = 100;
+const uint32_t READER_SLOT_NUM = 2;
 
 template <typename T>
 static void Swap(T &a, T &b)
@@ -65,6 +71,9 @@ AudioEffectChain::AudioEffectChain(std::string scene, std::shared_ptr<HeadTracke
         + std::to_string(ioBufferConfig_.outputCfg.channels) + "_4.pcm";
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, dumpNameIn_, &dumpFileInput_);
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, dumpNameOut_, &dumpFileOutput_);
+    renderParamBuffer_.reserve(sizeof(AudioEffectParam) + NUM_SET_EFFECT_PARAM * sizeof(int32_t));
+    totalProfileSlot_ = AudioEffectProfiler::GetInstance().GetSlot(sceneType_, EFFECT_PROFILE_CHAIN_TOTAL);
+    PublishSnapshot(nullptr);
 }
 #else
 AudioEffectChain::AudioEffectChain(std::string scene)
@@ -89,12 +98,16 @@ AudioEffectChain::AudioEffectChain(std::string scene)
         + std::to_string(ioBufferConfig_.outputCfg.channels) + "_4.pcm";
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, dumpNameIn_, &dumpFileInput_);
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, dumpNameOut_, &dumpFileOutput_);
+    renderParamBuffer_.reserve(sizeof(AudioEffectParam) + NUM_SET_EFFECT_PARAM * sizeof(int32_t));
+    totalProfileSlot_ = AudioEffectProfiler::GetInstance().GetSlot(sceneType_, EFFECT_PROFILE_CHAIN_TOTAL);
+    PublishSnapshot(nullptr);
 }
 #endif
 
 AudioEffectChain::~AudioEffectChain()
 {
     ReleaseEffectChain();
+    delete snapshot_.exchange(nullptr);
     DumpFileUtil::CloseDumpFile(&dumpFileInput_);
     DumpFileUtil::CloseDumpFile(&dumpFileOutput_);
 }
@@ -130,26 +143,91 @@ void AudioEffectChain::SetEffectCurrSceneType(AudioEffectScene currSceneType)
 
 void AudioEffectChain::ReleaseEffectChain()
 {
-    for (uint32_t i = 0; i < standByEffectHandles_.size() && i < libHandles_.size(); ++i) {
-        if (!libHandles_[i]) {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    std::vector<AudioEffectHandle> handles;
+    std::vector<AudioEffectLibrary *> libHandles;
+    handles.swap(standByEffectHandles_);
+    libHandles.swap(libHandles_);
+    profileSlots_.clear();
+    PublishSnapshot(nullptr);
+    for (uint32_t i = 0; i < handles.size() && i < libHandles.size(); ++i) {
+        if (!libHandles[i]) {
             continue;
         }
-        if (!standByEffectHandles_[i]) {
+        if (!handles[i]) {
             continue;
         }
-        if (!libHandles_[i]->releaseEffect) {
+        if (!libHandles[i]->releaseEffect) {
             continue;
         }
-        libHandles_[i]->releaseEffect(standByEffectHandles_[i]);
+        libHandles[i]->releaseEffect(handles[i]);
     }
-    standByEffectHandles_.clear();
-    libHandles_.clear();
 }
 
-int32_t AudioEffectChain::SetEffectParamToHandle(AudioEffectHandle handle, int32_t &replyData)
+// Called with reloadMutex_ held. Publishes the control side state, merged with the command not sent yet, and
+// returns after no render can see the old snapshot any more.
+void AudioEffectChain::PublishSnapshot(const AudioEffectChainCommand *command)
+{
+    auto snapshot = std::make_unique<AudioEffectChainSnapshot>();
+    snapshot->handles = standByEffectHandles_;
+    snapshot->profileSlots = profileSlots_;
+    snapshot->inChannels = ioBufferConfig_.inputCfg.channels;
+    snapshot->outChannels = ioBufferConfig_.outputCfg.channels;
+    snapshot->sampleRate = ioBufferConfig_.inputCfg.samplingRate;
+    AudioEffectChainSnapshot *oldSnapshot = snapshot_.load();
+    if (oldSnapshot != nullptr) {
+        snapshot->commandSeq = oldSnapshot->commandSeq;
+        // the render thread may send it in the meantime, then it is sent twice which does no harm
+        if (sentCommandSeq_.load() != oldSnapshot->commandSeq) {
+            snapshot->command = oldSnapshot->command;
+        }
+    }
+    if (command != nullptr) {
+        AudioEffectChainCommand &merged = snapshot->command;
+        merged.enable = merged.enable || command->enable;
+        merged.disableHeadTracking = merged.disableHeadTracking || command->disableHeadTracking;
+        if (command->setParam) {
+            merged.setParam = true;
+            merged.paramBuffer = command->paramBuffer;
+        }
+        if (command->setConfig) {
+            merged.setConfig = true;
+            merged.ioBufferConfig = command->ioBufferConfig;
+        }
+        snapshot->commandSeq++;
+    }
+    snapshot_.store(snapshot.release());
+    WaitForRenderQuiescent();
+    delete oldSnapshot;
+}
+
+uint32_t AudioEffectChain::EnterRender()
+{
+    uint32_t readerIndex = readerEpoch_.load() % READER_SLOT_NUM;
+    readers_[readerIndex].fetch_add(1);
+    return readerIndex;
+}
+
+void AudioEffectChain::ExitRender(uint32_t readerIndex)
+{
+    readers_[readerIndex].fetch_sub(1);
+}
+
+// A render entering after an epoch flip counts in the other slot and sees the new snapshot, so only the renders
+// already in progress are waited for. They take one period at most, the render thread itself never waits. Both slots
+// are drained in turn: a render that read the epoch before the previous flip may count in either of them.
+void AudioEffectChain::WaitForRenderQuiescent()
+{
+    for (uint32_t flip = 0; flip < READER_SLOT_NUM; flip++) {
+        uint32_t readerIndex = readerEpoch_.fetch_add(1) % READER_SLOT_NUM;
+        while (readers_[readerIndex].load() != 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(RENDER_QUIESCENT_WAIT_US));
+        }
+    }
+}
+
+std::vector<uint8_t> AudioEffectChain::BuildEffectParam()
 {
-    AudioEffectTransInfo cmdInfo = {sizeof(AudioEffectConfig), &ioBufferConfig_};
-    AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
     std::vector<uint8_t> paramBuffer(sizeof(AudioEffectParam) + NUM_SET_EFFECT_PARAM * sizeof(int32_t));
     // Set param
     AudioEffectParam *effectParam = reinterpret_cast<AudioEffectParam*>(paramBuffer.data());
@@ -183,14 +261,24 @@ int32_t AudioEffectChain::SetEffectParamToHandle(AudioEffectHandle handle, int32
     AUDIO_DEBUG_LOG("set extra effect chain type: %{public}d", extraEffectChainType_);
     data[6] = spatialDeviceType_; // 6:spatial device type index
     AUDIO_DEBUG_LOG("set ap integration spatial device type: %{public}d", data[6]); // 6:spatial device type index
-    cmdInfo = {sizeof(AudioEffectParam) + sizeof(int32_t) * NUM_SET_EFFECT_PARAM, effectParam};
-    int32_t ret = (*handle)->command(handle, EFFECT_CMD_SET_PARAM, &cmdInfo, &replyInfo);
-    return ret;
+    return paramBuffer;
+}
+
+// The library may write to the param, so it gets a copy in sendBuffer instead of the shared paramBuffer.
+int32_t AudioEffectChain::SendEffectParam(AudioEffectHandle handle, const std::vector<uint8_t> &paramBuffer,
+    std::vector<uint8_t> &sendBuffer, int32_t &replyData)
+{
+    sendBuffer.assign(paramBuffer.begin(), paramBuffer.end());
+    AudioEffectTransInfo cmdInfo = {static_cast<uint32_t>(sendBuffer.size()), sendBuffer.data()};
+    AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
+    return (*handle)->command(handle, EFFECT_CMD_SET_PARAM, &cmdInfo, &replyInfo);
 }
 
+// The handle is not published yet, so it is set up here on the control thread.
 void AudioEffectChain::AddEffectHandle(AudioEffectHandle handle, AudioEffectLibrary *libHandle,
     AudioEffectScene currSceneType)
 {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
     int32_t ret;
     int32_t replyData = 0;
     currSceneType_ = currSceneType;
@@ -203,7 +291,8 @@ void AudioEffectChain::AddEffectHandle(AudioEffectHandle handle, AudioEffectLibr
     CHECK_AND_RETURN_LOG(ret == 0, "[%{public}s] with mode [%{public}s], %{public}s lib EFFECT_CMD_ENABLE fail",
         sceneType_.c_str(), effectMode_.c_str(), libHandle->name);
 
-    CHECK_AND_RETURN_LOG(SetEffectParamToHandle(handle, replyData) == 0,
+    std::vector<uint8_t> sendBuffer;
+    CHECK_AND_RETURN_LOG(SendEffectParam(handle, BuildEffectParam(), sendBuffer, replyData) == 0,
         "[%{public}s] with mode [%{public}s], %{public}s lib EFFECT_CMD_SET_PARAM fail", sceneType_.c_str(),
         effectMode_.c_str(), libHandle->name);
 
@@ -219,31 +308,87 @@ void AudioEffectChain::AddEffectHandle(AudioEffectHandle handle, AudioEffectLibr
 
     standByEffectHandles_.emplace_back(handle);
     libHandles_.emplace_back(libHandle);
+    profileSlots_.emplace_back(AudioEffectProfiler::GetInstance().GetSlot(sceneType_, libHandle->name));
     latency_ += static_cast<uint32_t>(replyData);
+    PublishSnapshot(nullptr);
 }
 
+// Sent by the render thread before its next process, the latency is updated from the replies then.
 int32_t AudioEffectChain::UpdateEffectParam()
 {
     std::lock_guard<std::mutex> lock(reloadMutex_);
-    latency_ = 0;
-    for (AudioEffectHandle handle : standByEffectHandles_) {
-        int32_t replyData;
-        int32_t ret = SetEffectParamToHandle(handle, replyData);
-        CHECK_AND_RETURN_RET_LOG(ret == 0, ret, "set EFFECT_CMD_SET_PARAM fail");
-        AUDIO_DEBUG_LOG("Set Effect Param Scene Type: %{public}d Success", currSceneType_);
-        latency_ += static_cast<uint32_t>(replyData);
-    }
+    AudioEffectChainCommand command;
+    command.setParam = true;
+    command.paramBuffer = BuildEffectParam();
+    PublishSnapshot(&command);
+    AUDIO_DEBUG_LOG("Set Effect Param Scene Type: %{public}d queued", currSceneType_);
     return SUCCESS;
 }
 
+void AudioEffectChain::SendPendingCommand(const AudioEffectChainSnapshot &snapshot)
+{
+    if (sentCommandSeq_.load() == snapshot.commandSeq) {
+        return;
+    }
+    const AudioEffectChainCommand &command = snapshot.command;
+    if (command.setConfig && SendIoBufferConfig(snapshot.handles, command.ioBufferConfig) != SUCCESS) {
+        AUDIO_ERR_LOG("[%{public}s] update io buffer config fail", sceneType_.c_str());
+    }
+    for (AudioEffectHandle handle : snapshot.handles) {
+        if (!command.enable) {
+            break;
+        }
+        int32_t replyData = 0;
+        AudioEffectTransInfo cmdInfo = {sizeof(int32_t), &replyData};
+        AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
+        int32_t ret = (*handle)->command(handle, EFFECT_CMD_ENABLE, &cmdInfo, &replyInfo);
+        CHECK_AND_BREAK_LOG(ret == 0, "[%{public}s] with mode [%{public}s], either one of libs EFFECT_CMD_ENABLE fail",
+            sceneType_.c_str(), effectMode_.c_str());
+    }
+    if (command.setParam) {
+        uint32_t latency = 0;
+        for (AudioEffectHandle handle : snapshot.handles) {
+            int32_t replyData = 0;
+            int32_t ret = SendEffectParam(handle, command.paramBuffer, renderParamBuffer_, replyData);
+            CHECK_AND_CONTINUE_LOG(ret == 0, "[%{public}s] set EFFECT_CMD_SET_PARAM fail", sceneType_.c_str());
+            latency += static_cast<uint32_t>(replyData);
+        }
+        latency_.store(latency);
+    }
+#ifdef SENSOR_ENABLE
+    for (AudioEffectHandle handle : snapshot.handles) {
+        if (!command.disableHeadTracking) {
+            break;
+        }
+        int32_t replyData = 0;
+        HeadPostureData imuDataDisabled = {1, 1.0, 0.0, 0.0, 0.0};
+        AudioEffectTransInfo cmdInfo = {sizeof(HeadPostureData), &imuDataDisabled};
+        AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
+        int32_t ret = (*handle)->command(handle, EFFECT_CMD_SET_IMU, &cmdInfo, &replyInfo);
+        if (ret != SUCCESS) {
+            AUDIO_WARNING_LOG("SetHeadTrackingDisabled failed");
+        }
+    }
+#endif
+    sentCommandSeq_.store(snapshot.commandSeq);
+}
+
 void AudioEffectChain::ApplyEffectChain(float *bufIn, float *bufOut, uint32_t frameLen, AudioEffectProcInfo procInfo)
 {
-    size_t inTotlen = frameLen * ioBufferConfig_.inputCfg.channels * sizeof(float);
-    size_t outTotlen = frameLen * ioBufferConfig_.outputCfg.channels * sizeof(float);
+    uint32_t readerIndex = EnterRender();
+    ProcessSnapshot(*snapshot_.load(), bufIn, bufOut, frameLen, procInfo);
+    ExitRender(readerIndex);
+}
+
+void AudioEffectChain::ProcessSnapshot(const AudioEffectChainSnapshot &snapshot, float *bufIn, float *bufOut,
+    uint32_t frameLen, AudioEffectProcInfo procInfo)
+{
+    size_t inTotlen = frameLen * snapshot.inChannels * sizeof(float);
+    size_t outTotlen = frameLen * snapshot.outChannels * sizeof(float);
     DumpFileUtil::WriteDumpFile(dumpFileInput_, static_cast<void *>(bufIn), inTotlen);
     DumpEffectProcessData(dumpNameIn_, static_cast<void *>(bufIn), inTotlen);
 
-    if (IsEmptyEffectHandles()) {
+    if (snapshot.handles.empty()) {
         CHECK_AND_RETURN_LOG(memcpy_s(bufOut, outTotlen, bufIn, outTotlen) == 0, "memcpy error in apply effect");
         DumpFileUtil::WriteDumpFile(dumpFileOutput_, static_cast<void *>(bufOut), outTotlen);
         DumpEffectProcessData(dumpNameOut_, static_cast<void *>(bufOut), outTotlen);
@@ -257,11 +402,16 @@ void AudioEffectChain::ApplyEffectChain(float *bufIn, float *bufOut, uint32_t fr
     AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
 #endif
 
+    SendPendingCommand(snapshot);
     audioBufIn_.frameLength = frameLen;
     audioBufOut_.frameLength = frameLen;
     uint32_t count = 0;
-    std::lock_guard<std::mutex> lock(reloadMutex_);
-    for (AudioEffectHandle handle : standByEffectHandles_) {
+    bool profiled = AudioEffectProfiler::GetInstance().IsSampled(profilePeriodCount_);
+    uint64_t periodNs = snapshot.sampleRate == 0 ? 0 : static_cast<uint64_t>(frameLen) * AUDIO_NS_PER_SECOND /
+        snapshot.sampleRate;
+    int64_t chainStartNs = profiled ? ClockTime::GetCurNano() : 0;
+    for (size_t i = 0; i < snapshot.handles.size(); i++) {
+        AudioEffectHandle handle = snapshot.handles[i];
 #ifdef SENSOR_ENABLE
         if ((!procInfo.btOffloadEnabled) && procInfo.headTrackingEnabled) {
             (*handle)->command(handle, EFFECT_CMD_SET_IMU, &cmdInfo, &replyInfo);
@@ -274,11 +424,20 @@ void AudioEffectChain::ApplyEffectChain(float *bufIn, float *bufOut, uint32_t fr
             audioBufOut_.raw = bufIn;
             audioBufIn_.raw = bufOut;
         }
+        int64_t startNs = profiled ? ClockTime::GetCurNano() : 0;
         int32_t ret = (*handle)->process(handle, &audioBufIn_, &audioBufOut_);
+        if (profiled) {
+            AudioEffectProfiler::Record(snapshot.profileSlots[i],
+                static_cast<uint64_t>(ClockTime::GetCurNano() - startNs), periodNs);
+        }
         CHECK_AND_CONTINUE_LOG(ret == 0, "[%{public}s] with mode [%{public}s], either one of libs process fail",
             sceneType_.c_str(), effectMode_.c_str());
         count++;
     }
+    if (profiled) {
+        AudioEffectProfiler::Record(totalProfileSlot_, static_cast<uint64_t>(ClockTime::GetCurNano() - chainStartNs),
+            periodNs);
+    }
     if ((count & 1) == 0) {
         CHECK_AND_RETURN_LOG(memcpy_s(bufOut, outTotlen, bufIn, outTotlen) == 0, "memcpy error when last copy");
     }
@@ -289,58 +448,77 @@ void AudioEffectChain::ApplyEffectChain(float *bufIn, float *bufOut, uint32_t fr
 
 bool AudioEffectChain::IsEmptyEffectHandles()
 {
-    std::lock_guard<std::mutex> lock(reloadMutex_);
-    return standByEffectHandles_.size() == 0;
+    uint32_t readerIndex = EnterRender();
+    bool isEmpty = snapshot_.load()->handles.empty();
+    ExitRender(readerIndex);
+    return isEmpty;
 }
 
 int32_t AudioEffectChain::UpdateMultichannelIoBufferConfig(const uint32_t &channels, const uint64_t &channelLayout)
 {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
     if (ioBufferConfig_.inputCfg.channels == channels && ioBufferConfig_.inputCfg.channelLayout == channelLayout) {
         return SUCCESS;
     }
     ioBufferConfig_.inputCfg.channels = channels;
     ioBufferConfig_.inputCfg.channelLayout = channelLayout;
-    if (IsEmptyEffectHandles()) {
+    if (standByEffectHandles_.empty()) {
+        PublishSnapshot(nullptr);
         return SUCCESS;
     }
-    std::lock_guard<std::mutex> lock(reloadMutex_);
+    AudioEffectChainCommand command;
+    command.setConfig = true;
+    command.ioBufferConfig = ioBufferConfig_;
+    // what the last handle is set to by SendIoBufferConfig
+    ioBufferConfig_.outputCfg.channels = DEFAULT_NUM_CHANNEL;
+    ioBufferConfig_.outputCfg.channelLayout = DEFAULT_NUM_CHANNELLAYOUT;
+    PublishSnapshot(&command);
+    return SUCCESS;
+}
+
+// Render thread only, the config of each handle is the output config of the one before.
+int32_t AudioEffectChain::SendIoBufferConfig(const std::vector<AudioEffectHandle> &handles,
+    const AudioEffectConfig &config)
+{
+    CHECK_AND_RETURN_RET(!handles.empty(), SUCCESS);
+    AudioEffectConfig ioBufferConfig = config;
     int32_t replyData = 0;
-    AudioEffectTransInfo cmdInfo = {sizeof(AudioEffectConfig), &ioBufferConfig_};
+    AudioEffectTransInfo cmdInfo = {sizeof(AudioEffectConfig), &ioBufferConfig};
     AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
     AudioEffectHandle preHandle = nullptr;
-    ioBufferConfig_.outputCfg.channels = 0;
-    ioBufferConfig_.outputCfg.channelLayout = 0;
-    for (AudioEffectHandle handle : standByEffectHandles_) {
+    ioBufferConfig.outputCfg.channels = 0;
+    ioBufferConfig.outputCfg.channelLayout = 0;
+    for (AudioEffectHandle handle : handles) {
         if (preHandle != nullptr) {
             int32_t ret = (*preHandle)->command(preHandle, EFFECT_CMD_SET_CONFIG, &cmdInfo, &replyInfo);
             CHECK_AND_RETURN_RET_LOG(ret == 0, ERROR, "Multichannel effect chain update EFFECT_CMD_SET_CONFIG fail");
 
             ret = (*preHandle)->command(preHandle, EFFECT_CMD_GET_CONFIG, &cmdInfo, &cmdInfo);
             CHECK_AND_RETURN_RET_LOG(ret == 0, ERROR, "Multichannel effect chain update EFFECT_CMD_GET_CONFIG fail");
-            Swap(ioBufferConfig_.inputCfg, ioBufferConfig_.outputCfg); // pass outputCfg to next algo as inputCfg
+            Swap(ioBufferConfig.inputCfg, ioBufferConfig.outputCfg); // pass outputCfg to next algo as inputCfg
         }
         preHandle = handle;
     }
-    ioBufferConfig_.outputCfg.channels = DEFAULT_NUM_CHANNEL;
-    ioBufferConfig_.outputCfg.channelLayout = DEFAULT_NUM_CHANNELLAYOUT;
+    ioBufferConfig.outputCfg.channels = DEFAULT_NUM_CHANNEL;
+    ioBufferConfig.outputCfg.channelLayout = DEFAULT_NUM_CHANNELLAYOUT;
     int32_t ret = (*preHandle)->command(preHandle, EFFECT_CMD_SET_CONFIG, &cmdInfo, &replyInfo);
     CHECK_AND_RETURN_RET_LOG(ret == 0, ERROR, "last effect update EFFECT_CMD_SET_CONFIG fail");
-    // recover bufferconfig
-    ioBufferConfig_.inputCfg.channels = channels;
-    ioBufferConfig_.inputCfg.channelLayout = channelLayout;
     return SUCCESS;
 }
 
 void AudioEffectChain::ResetIoBufferConfig()
 {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
     ioBufferConfig_.inputCfg.channels = DEFAULT_NUM_CHANNEL;
     ioBufferConfig_.inputCfg.channelLayout = DEFAULT_NUM_CHANNELLAYOUT;
     ioBufferConfig_.outputCfg.channels = DEFAULT_NUM_CHANNEL;
     ioBufferConfig_.outputCfg.channelLayout = DEFAULT_NUM_CHANNELLAYOUT;
+    PublishSnapshot(nullptr);
 }
 
 AudioEffectConfig AudioEffectChain::GetIoBufferConfig()
 {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
     return ioBufferConfig_;
 }
 
@@ -353,7 +531,7 @@ void AudioEffectChain::StoreOldEffectChainInfo(std::string &sceneMode, AudioEffe
 
 uint32_t AudioEffectChain::GetLatency()
 {
-    return latency_;
+    return latency_.load();
 }
 
 void AudioEffectChain::DumpEffectProcessData(std::string fileName, void *buffer, size_t len)
@@ -366,38 +544,25 @@ void AudioEffectChain::DumpEffectProcessData(std::string fileName, void *buffer,
 #ifdef SENSOR_ENABLE
 void AudioEffectChain::SetHeadTrackingDisabled()
 {
-    if (IsEmptyEffectHandles()) {
-        return;
-    }
-
     std::lock_guard<std::mutex> lock(reloadMutex_);
-    for (AudioEffectHandle handle : standByEffectHandles_) {
-        int32_t replyData = 0;
-        HeadPostureData imuDataDisabled = {1, 1.0, 0.0, 0.0, 0.0};
-        AudioEffectTransInfo cmdInfo = {sizeof(HeadPostureData), &imuDataDisabled};
-        AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
-        int32_t ret = (*handle)->command(handle, EFFECT_CMD_SET_IMU, &cmdInfo, &replyInfo);
-        if (ret != SUCCESS) {
-            AUDIO_WARNING_LOG("SetHeadTrackingDisabled failed");
-        }
+    if (standByEffectHandles_.empty()) {
+        return;
     }
+    AudioEffectChainCommand command;
+    command.disableHeadTracking = true;
+    PublishSnapshot(&command);
 }
 #endif
 
 void AudioEffectChain::InitEffectChain()
 {
-    if (IsEmptyEffectHandles()) {
-        return;
-    }
     std::lock_guard<std::mutex> lock(reloadMutex_);
-    for (AudioEffectHandle handle : standByEffectHandles_) {
-        int32_t replyData = 0;
-        AudioEffectTransInfo cmdInfo = {sizeof(int32_t), &replyData};
-        AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
-        int32_t ret = (*handle)->command(handle, EFFECT_CMD_ENABLE, &cmdInfo, &replyInfo);
-        CHECK_AND_RETURN_LOG(ret == 0, "[%{public}s] with mode [%{public}s], either one of libs EFFECT_CMD_ENABLE fail",
-            sceneType_.c_str(), effectMode_.c_str());
+    if (standByEffectHandles_.empty()) {
+        return;
     }
+    AudioEffectChainCommand command;
+    command.enable = true;
+    PublishSnapshot(&command);
 }
 
 void AudioEffectChain::SetSpatialDeviceType(AudioSpatialDeviceType spatialDeviceType)
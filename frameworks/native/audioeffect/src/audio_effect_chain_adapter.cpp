@@ -63,18 +63,34 @@ int32_t EffectChainManagerProcess(char *sceneType, BufferAttr *bufferAttr)
 {
     AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
     CHECK_AND_RETURN_RET_LOG(audioEffectChainManager != nullptr, ERR_INVALID_HANDLE, "null audioEffectChainManager");
-    std::string sceneTypeString = "";
-    if (sceneType) {
-        sceneTypeString = sceneType;
-    }
-    auto eBufferAttr = std::make_unique<EffectBufferAttr>(bufferAttr->bufIn, bufferAttr->bufOut, bufferAttr->numChanIn,
-        bufferAttr->frameLen);
+    // only called by the render thread of the sink, it keeps its capacity from one period to the next
+    thread_local std::string sceneTypeString;
+    sceneTypeString.assign(sceneType == nullptr ? "" : sceneType);
+    EffectBufferAttr eBufferAttr(bufferAttr->bufIn, bufferAttr->bufOut, bufferAttr->numChanIn, bufferAttr->frameLen);
     if (audioEffectChainManager->ApplyAudioEffectChain(sceneTypeString, eBufferAttr) != SUCCESS) {
         return ERROR;
     }
     return SUCCESS;
 }
 
+int32_t EffectChainManagerProcessScenes(char *const *sceneTypes, BufferAttr *const *bufferAttrs, uint32_t sceneNum)
+{
+    AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
+    CHECK_AND_RETURN_RET_LOG(audioEffectChainManager != nullptr, ERR_INVALID_HANDLE, "null audioEffectChainManager");
+    CHECK_AND_RETURN_RET_LOG(sceneTypes != nullptr && bufferAttrs != nullptr, ERR_INVALID_PARAM, "null scenes");
+    // only called by the render thread of the sink, they keep their capacity from one period to the next
+    thread_local std::vector<std::string> sceneTypeStrings;
+    thread_local std::vector<EffectBufferAttr> eBufferAttrs;
+    sceneTypeStrings.resize(sceneNum);
+    eBufferAttrs.clear();
+    for (uint32_t i = 0; i < sceneNum; i++) {
+        sceneTypeStrings[i] = sceneTypes[i] == nullptr ? "" : sceneTypes[i];
+        eBufferAttrs.emplace_back(bufferAttrs[i]->bufIn, bufferAttrs[i]->bufOut, bufferAttrs[i]->numChanIn,
+            bufferAttrs[i]->frameLen);
+    }
+    return audioEffectChainManager->ApplyAudioEffectChains(sceneTypeStrings, eBufferAttrs);
+}
+
 bool EffectChainManagerExist(const char *sceneType, const char *effectMode, const char *spatializationEnabled)
 {
     AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
@@ -362,3 +378,17 @@ bool EffectChainManagerSceneCheck(const char *sinkSceneType, const char *sceneTy
     std::string sinkSceneTypeString = sinkSceneType;
     return audioEffectChainManager->CheckSceneTypeMatch(sinkSceneType, sceneType);
 }
+
+uint32_t EffectChainManagerGetRouteGeneration(void)
+{
+    AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
+    CHECK_AND_RETURN_RET_LOG(audioEffectChainManager != nullptr, 0, "null audioEffectChainManager");
+    return audioEffectChainManager->GetRouteGeneration();
+}
+
+void EffectChainManagerInvalidateRoute(void)
+{
+    AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
+    CHECK_AND_RETURN_LOG(audioEffectChainManager != nullptr, "null audioEffectChainManager");
+    audioEffectChainManager->InvalidateRoute();
+}
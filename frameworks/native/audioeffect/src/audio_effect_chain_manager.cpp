@@ -27,6 +27,18 @@
 
 namespace OHOS {
 namespace AudioStandard {
+namespace {
+// with the render thread, three chains are applied at a time
+constexpr uint32_t EFFECT_WORKER_NUM = 2;
+
+struct EffectChainApplyContext {
+    const std::vector<std::shared_ptr<AudioEffectChain>> *chains; // nullptr for a scene without effect chain
+    const std::vector<EffectBufferAttr> *bufferAttrs;
+    const std::vector<uint32_t> *firstJobs; // the first job of each distinct chain
+    AudioEffectProcInfo procInfo;
+};
+}
+
 static int32_t CheckValidEffectLibEntry(const std::shared_ptr<AudioEffectLibEntry> &libEntry, const std::string &effect,
     const std::string &libName)
 {
@@ -179,6 +191,7 @@ void AudioEffectChainManager::SetSpkOffloadState()
 void AudioEffectChainManager::SetOutputDeviceSink(int32_t device, const std::string &sinkName)
 {
     std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+    InvalidateRoute();
     if (UpdateDeviceInfo(device, sinkName) != SUCCESS) {
         return;
     }
@@ -201,6 +214,7 @@ void AudioEffectChainManager::UpdateSpkOffloadEnabled()
 {
     if (debugArmFlag_ && spkOffloadEnabled_) {
         std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+        InvalidateRoute();
         RecoverAllChains();
         spkOffloadEnabled_ = false;
         return;
@@ -244,6 +258,7 @@ void AudioEffectChainManager::InitHdiState()
         AUDIO_INFO_LOG("set hdi init succeeded, normal speaker entered");
         spkOffloadEnabled_ = true;
     }
+    InvalidateRoute();
 }
 
 // Boot initialize
@@ -293,6 +308,7 @@ void AudioEffectChainManager::InitAudioEffectChainManager(std::vector<EffectChai
     AUDIO_DEBUG_LOG("Call RegisterDisplayListener.");
 #endif
     isInitialized_ = true;
+    InvalidateRoute();
 }
 
 bool AudioEffectChainManager::CheckAndAddSessionID(const std::string &sessionID)
@@ -308,6 +324,7 @@ bool AudioEffectChainManager::CheckAndAddSessionID(const std::string &sessionID)
 int32_t AudioEffectChainManager::CreateAudioEffectChainDynamic(const std::string &sceneType)
 {
     std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+    InvalidateRoute();
     CHECK_AND_RETURN_RET_LOG(isInitialized_, ERROR, "has not been initialized");
     CHECK_AND_RETURN_RET_LOG(sceneType != "", ERROR, "null sceneType");
 
@@ -421,6 +438,7 @@ bool AudioEffectChainManager::CheckAndRemoveSessionID(const std::string &session
 int32_t AudioEffectChainManager::ReleaseAudioEffectChainDynamic(const std::string &sceneType)
 {
     std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+    InvalidateRoute();
     CHECK_AND_RETURN_RET_LOG(isInitialized_, ERROR, "has not been initialized");
     CHECK_AND_RETURN_RET_LOG(sceneType != "", ERROR, "null sceneType");
 
@@ -512,32 +530,107 @@ bool AudioEffectChainManager::ExistAudioEffectChain(const std::string &sceneType
     return !audioEffectChain->IsEmptyEffectHandles();
 }
 
+// Called by the render threads each period, the key of a scene is only built again when the device changes.
+const std::string &AudioEffectChainManager::GetAppliedSceneTypeAndDeviceKey(const std::string &sceneType)
+{
+    thread_local std::unordered_map<std::string, std::pair<DeviceType, std::string>> sceneTypeToKey;
+    auto &key = sceneTypeToKey[sceneType];
+    if (key.second.empty() || key.first != deviceType_) {
+        key.first = deviceType_;
+        key.second = sceneType + "_&_" + GetDeviceTypeName();
+    }
+    return key.second;
+}
+
 int32_t AudioEffectChainManager::ApplyAudioEffectChain(const std::string &sceneType,
-    const std::unique_ptr<EffectBufferAttr> &bufferAttr)
+    const EffectBufferAttr &bufferAttr)
 {
-    std::string sceneTypeAndDeviceKey = sceneType + "_&_" + GetDeviceTypeName();
-    size_t totLen = static_cast<size_t>(bufferAttr->frameLen * bufferAttr->numChans * sizeof(float));
+    auto chain = SceneTypeToEffectChainMap_.find(GetAppliedSceneTypeAndDeviceKey(sceneType));
+    size_t totLen = static_cast<size_t>(bufferAttr.frameLen * bufferAttr.numChans * sizeof(float));
 #ifdef DEVICE_FLAG
-    if (!SceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
-        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr->bufOut, totLen, bufferAttr->bufIn, totLen) == 0, ERROR,
+    if (chain == SceneTypeToEffectChainMap_.end()) {
+        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr.bufOut, totLen, bufferAttr.bufIn, totLen) == 0, ERROR,
             "memcpy error when no effect applied");
         return ERROR;
     }
 #else
-    if (deviceType_ != DEVICE_TYPE_SPEAKER || !SceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
-        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr->bufOut, totLen, bufferAttr->bufIn, totLen) == 0, ERROR,
+    if (deviceType_ != DEVICE_TYPE_SPEAKER || chain == SceneTypeToEffectChainMap_.end()) {
+        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr.bufOut, totLen, bufferAttr.bufIn, totLen) == 0, ERROR,
             "memcpy error when no effect applied");
         return SUCCESS;
     }
 #endif
-    auto audioEffectChain = SceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+    std::shared_ptr<AudioEffectChain> audioEffectChain = chain->second;
     if (audioEffectChain != nullptr) {
         AudioEffectProcInfo procInfo = {headTrackingEnabled_, btOffloadEnabled_};
-        audioEffectChain->ApplyEffectChain(bufferAttr->bufIn, bufferAttr->bufOut, bufferAttr->frameLen, procInfo);
+        audioEffectChain->ApplyEffectChain(bufferAttr.bufIn, bufferAttr.bufOut, bufferAttr.frameLen, procInfo);
+    }
+    return SUCCESS;
+}
+
+// A chain keeps state between calls, so every job of one chain runs in order in the same task.
+static void ApplyEffectChainTask(void *context, uint32_t index)
+{
+    EffectChainApplyContext *applyContext = static_cast<EffectChainApplyContext *>(context);
+    const std::vector<std::shared_ptr<AudioEffectChain>> &chains = *applyContext->chains;
+    uint32_t firstJob = (*applyContext->firstJobs)[index];
+    for (size_t job = firstJob; job < chains.size(); job++) {
+        if (chains[job] != chains[firstJob]) {
+            continue;
+        }
+        const EffectBufferAttr &bufferAttr = (*applyContext->bufferAttrs)[job];
+        if (chains[job] == nullptr) {
+            size_t totLen = static_cast<size_t>(bufferAttr.frameLen * bufferAttr.numChans * sizeof(float));
+            CHECK_AND_CONTINUE_LOG(memcpy_s(bufferAttr.bufOut, totLen, bufferAttr.bufIn, totLen) == 0,
+                "memcpy error when no effect applied");
+            continue;
+        }
+        chains[job]->ApplyEffectChain(bufferAttr.bufIn, bufferAttr.bufOut, bufferAttr.frameLen,
+            applyContext->procInfo);
+    }
+}
+
+int32_t AudioEffectChainManager::ApplyAudioEffectChains(const std::vector<std::string> &sceneTypes,
+    const std::vector<EffectBufferAttr> &bufferAttrs)
+{
+    CHECK_AND_RETURN_RET_LOG(sceneTypes.size() == bufferAttrs.size(), ERR_INVALID_PARAM, "scene num not match");
+    // kept by the render thread, so that no period allocates once they have grown to the number of scenes
+    thread_local std::vector<std::shared_ptr<AudioEffectChain>> chains;
+    thread_local std::vector<uint32_t> firstJobs;
+    chains.clear();
+    firstJobs.clear();
+    for (uint32_t job = 0; job < sceneTypes.size(); job++) {
+        std::shared_ptr<AudioEffectChain> chain = GetAppliedEffectChain(sceneTypes[job]);
+        if (std::find(chains.begin(), chains.end(), chain) == chains.end()) {
+            firstJobs.push_back(job);
+        }
+        chains.push_back(chain);
     }
+    EffectChainApplyContext context = { &chains, &bufferAttrs, &firstJobs, {headTrackingEnabled_, btOffloadEnabled_} };
+    GetWorkerPool()->Run(ApplyEffectChainTask, &context, static_cast<uint32_t>(firstJobs.size()));
     return SUCCESS;
 }
 
+std::shared_ptr<AudioEffectChain> AudioEffectChainManager::GetAppliedEffectChain(const std::string &sceneType)
+{
+#ifndef DEVICE_FLAG
+    if (deviceType_ != DEVICE_TYPE_SPEAKER) {
+        return nullptr;
+    }
+#endif
+    auto chain = SceneTypeToEffectChainMap_.find(GetAppliedSceneTypeAndDeviceKey(sceneType));
+    return chain == SceneTypeToEffectChainMap_.end() ? nullptr : chain->second;
+}
+
+AudioEffectWorkerPool *AudioEffectChainManager::GetWorkerPool()
+{
+    std::lock_guard<std::mutex> lock(workerPoolMutex_);
+    if (workerPool_ == nullptr) {
+        workerPool_ = std::make_unique<AudioEffectWorkerPool>(EFFECT_WORKER_NUM);
+    }
+    return workerPool_.get();
+}
+
 void AudioEffectChainManager::Dump()
 {
     AUDIO_INFO_LOG("Dump START");
@@ -1144,6 +1237,7 @@ void AudioEffectChainManager::ResetInfo()
     hdiSceneType_ = 0;
     hdiEffectMode_ = 0;
     isCommonEffectChainExisted_ = false;
+    InvalidateRoute();
 }
 
 void AudioEffectChainManager::UpdateRealAudioEffect()
@@ -1167,6 +1261,16 @@ void AudioEffectChainManager::UpdateRealAudioEffect()
     }
 }
 
+uint32_t AudioEffectChainManager::GetRouteGeneration()
+{
+    return routeGeneration_.load();
+}
+
+void AudioEffectChainManager::InvalidateRoute()
+{
+    routeGeneration_++;
+}
+
 bool AudioEffectChainManager::CheckSceneTypeMatch(const std::string &sinkSceneType, const std::string &sceneType)
 {
     std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
@@ -1297,6 +1401,7 @@ void AudioEffectChainManager::CheckAndReleaseCommonEffectChain(const std::string
 void AudioEffectChainManager::UpdateSpatializationEnabled(AudioSpatializationState spatializationState)
 {
     std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+    InvalidateRoute();
     spatializationEnabled_ = spatializationState.spatializationEnabled;
 
     memset_s(static_cast<void *>(effectHdiInput_), sizeof(effectHdiInput_), 0, sizeof(effectHdiInput_));
@@ -1351,6 +1456,7 @@ bool AudioEffectChainManager::CheckIfSpkDsp()
 void AudioEffectChainManager::UpdateEffectBtOffloadSupported(const bool &isSupported)
 {
     std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+    InvalidateRoute();
     if (isSupported == btOffloadSupported_) {
         return;
     }
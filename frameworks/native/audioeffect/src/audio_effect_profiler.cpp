@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioEffectProfiler"
+#endif
+
+#include "audio_effect_profiler.h"
+
+#include "audio_effect_log.h"
+#include "audio_utils.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const uint32_t DEFAULT_SAMPLE_INTERVAL = 16;
+const char *SAMPLE_INTERVAL_PARA = "persist.multimedia.audio.effect.profileinterval";
+const uint64_t NS_PER_US = 1000;
+const uint32_t PERCENT = 100;
+
+uint32_t GetBucket(uint64_t costNs)
+{
+    uint64_t costUs = costNs / NS_PER_US;
+    uint32_t bucket = 0;
+    while (costUs != 0 && bucket < EFFECT_PROFILE_BUCKET_NUM - 1) {
+        costUs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// the upper bound of bucket i in us, a percentile is reported as the bucket it falls in
+uint64_t GetPercentileUs(const AudioEffectProfileInfo &info, uint32_t percent)
+{
+    uint64_t target = (info.count * percent + PERCENT - 1) / PERCENT;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < EFFECT_PROFILE_BUCKET_NUM; i++) {
+        sum += info.buckets[i];
+        if (sum >= target) {
+            return 1ULL << i;
+        }
+    }
+    return 1ULL << (EFFECT_PROFILE_BUCKET_NUM - 1);
+}
+}
+
+AudioEffectProfiler &AudioEffectProfiler::GetInstance()
+{
+    static AudioEffectProfiler instance;
+    return instance;
+}
+
+AudioEffectProfiler::AudioEffectProfiler() : sampleInterval_(DEFAULT_SAMPLE_INTERVAL)
+{
+    LoadSampleInterval();
+}
+
+AudioEffectProfileSlot *AudioEffectProfiler::GetSlot(const std::string &sceneType, const std::string &effectName)
+{
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    for (AudioEffectProfileSlot &slot : slots_) {
+        if (slot.sceneType == sceneType && slot.effectName == effectName) {
+            return &slot;
+        }
+    }
+    AudioEffectProfileSlot &slot = slots_.emplace_back();
+    slot.sceneType = sceneType;
+    slot.effectName = effectName;
+    return &slot;
+}
+
+void AudioEffectProfiler::SetSampleInterval(uint32_t sampleInterval)
+{
+    AUDIO_INFO_LOG("sample interval %{public}u", sampleInterval);
+    sampleInterval_.store(sampleInterval);
+}
+
+uint32_t AudioEffectProfiler::GetSampleInterval() const
+{
+    return sampleInterval_.load();
+}
+
+void AudioEffectProfiler::LoadSampleInterval()
+{
+    int32_t sampleInterval = -1;
+    if (GetSysPara(SAMPLE_INTERVAL_PARA, sampleInterval) && sampleInterval >= 0 &&
+        static_cast<uint32_t>(sampleInterval) != GetSampleInterval()) {
+        SetSampleInterval(static_cast<uint32_t>(sampleInterval));
+    }
+}
+
+bool AudioEffectProfiler::IsSampled(uint32_t &periodCount) const
+{
+    uint32_t sampleInterval = sampleInterval_.load(std::memory_order_relaxed);
+    if (sampleInterval == 0) {
+        return false;
+    }
+    if (++periodCount < sampleInterval) {
+        return false;
+    }
+    periodCount = 0;
+    return true;
+}
+
+void AudioEffectProfiler::Record(AudioEffectProfileSlot *slot, uint64_t costNs, uint64_t periodNs)
+{
+    if (slot == nullptr) {
+        return;
+    }
+    slot->count.fetch_add(1, std::memory_order_relaxed);
+    slot->totalNs.fetch_add(costNs, std::memory_order_relaxed);
+    slot->buckets[GetBucket(costNs)].fetch_add(1, std::memory_order_relaxed);
+    if (periodNs != 0 && costNs > periodNs) {
+        slot->overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    // a slot is recorded by one render thread at a time, no compare exchange loop needed
+    if (costNs > slot->maxNs.load(std::memory_order_relaxed)) {
+        slot->maxNs.store(costNs, std::memory_order_relaxed);
+    }
+}
+
+std::vector<AudioEffectProfileInfo> AudioEffectProfiler::GetProfileInfo()
+{
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    std::vector<AudioEffectProfileInfo> infos;
+    for (const AudioEffectProfileSlot &slot : slots_) {
+        AudioEffectProfileInfo info = {slot.sceneType, slot.effectName, slot.count.load(), slot.totalNs.load(),
+            slot.maxNs.load(), slot.overruns.load(), {}};
+        for (uint32_t i = 0; i < EFFECT_PROFILE_BUCKET_NUM; i++) {
+            info.buckets[i] = slot.buckets[i].load();
+        }
+        infos.push_back(info);
+    }
+    return infos;
+}
+
+void AudioEffectProfiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    for (AudioEffectProfileSlot &slot : slots_) {
+        slot.count.store(0);
+        slot.totalNs.store(0);
+        slot.maxNs.store(0);
+        slot.overruns.store(0);
+        for (std::atomic<uint64_t> &bucket : slot.buckets) {
+            bucket.store(0);
+        }
+    }
+}
+
+void AudioEffectProfiler::Dump(std::string &dumpString)
+{
+    const uint32_t p50 = 50;
+    const uint32_t p99 = 99;
+    AppendFormat(dumpString, "Effect profile, one of every %u periods sampled\n", GetSampleInterval());
+    AppendFormat(dumpString, "  %-24s %-32s %10s %10s %10s %10s %10s %10s\n", "scene", "effect", "samples",
+        "avg(us)", "p50(us)", "p99(us)", "max(us)", "overruns");
+    for (const AudioEffectProfileInfo &info : GetProfileInfo()) {
+        if (info.count == 0) {
+            continue;
+        }
+        AppendFormat(dumpString, "  %-24s %-32s %10llu %10llu %10llu %10llu %10llu %10llu\n",
+            info.sceneType.c_str(), info.effectName.c_str(), static_cast<unsigned long long>(info.count),
+            static_cast<unsigned long long>(info.totalNs / info.count / NS_PER_US),
+            static_cast<unsigned long long>(GetPercentileUs(info, p50)),
+            static_cast<unsigned long long>(GetPercentileUs(info, p99)),
+            static_cast<unsigned long long>(info.maxNs / NS_PER_US),
+            static_cast<unsigned long long>(info.overruns));
+    }
+}
+} // namespace AudioStandard
+} // namespace OHOS
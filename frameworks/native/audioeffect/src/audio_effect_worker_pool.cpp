@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioEffectWorkerPool"
+#endif
+
+#include "audio_effect_worker_pool.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "audio_effect_log.h"
+#include "audio_schedule.h"
+
+namespace OHOS {
+namespace AudioStandard {
+AudioEffectWorkerPool::AudioEffectWorkerPool(uint32_t workerNum)
+{
+    for (uint32_t i = 0; i < workerNum; i++) {
+        workers_.emplace_back([this] { this->WorkerLoop(); });
+        pthread_setname_np(workers_.back().native_handle(), "OS_EffectWorker");
+    }
+    AUDIO_INFO_LOG("%{public}u workers created", workerNum);
+}
+
+AudioEffectWorkerPool::~AudioEffectWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    startCv_.notify_all();
+    for (std::thread &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+uint32_t AudioEffectWorkerPool::GetWorkerNum() const noexcept
+{
+    return static_cast<uint32_t>(workers_.size());
+}
+
+void AudioEffectWorkerPool::Run(Task task, void *context, uint32_t taskNum)
+{
+    if (task == nullptr || taskNum == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    if (workers_.empty() || taskNum == 1) {
+        for (uint32_t i = 0; i < taskNum; i++) {
+            task(context, i);
+        }
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // a worker woken late for the last round may still be looking for tasks
+        doneCv_.wait(lock, [this] { return activeWorkers_ == 0; });
+        task_ = task;
+        context_ = context;
+        taskNum_ = taskNum;
+        nextTask_.store(0);
+        round_++;
+    }
+    startCv_.notify_all();
+    RunTasks();
+    // all tasks are taken once the calling thread is out of RunTasks, the ones not done yet are on active workers
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [this] { return activeWorkers_ == 0; });
+}
+
+void AudioEffectWorkerPool::RunTasks()
+{
+    uint32_t index = nextTask_.fetch_add(1);
+    while (index < taskNum_) {
+        task_(context_, index);
+        index = nextTask_.fetch_add(1);
+    }
+}
+
+void AudioEffectWorkerPool::WorkerLoop()
+{
+    // scheduled as the render threads are, a worker is on their critical path
+    ScheduleThreadInServer(getpid(), gettid());
+    uint64_t seenRound = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        startCv_.wait(lock, [this, &seenRound] { return quit_ || round_ != seenRound; });
+        if (quit_) {
+            break;
+        }
+        seenRound = round_;
+        activeWorkers_++;
+        lock.unlock();
+        RunTasks();
+        lock.lock();
+        activeWorkers_--;
+        if (activeWorkers_ == 0) {
+            doneCv_.notify_one();
+        }
+    }
+    lock.unlock();
+    UnscheduleThreadInServer(getpid(), gettid());
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -29,6 +29,7 @@
 #include "audio_utils.h"
 #include "audio_effect_log.h"
 #include "audio_effect_chain_manager.h"
+#include "audio_effect_profiler.h"
 #include "audio_errors.h"
 
 using namespace std;
@@ -340,7 +341,7 @@ HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_001, TestSize.Leve
     bufOut = bufOutVector.data();
     int numChans = 2;
     int frameLen = 960;
-    auto eBufferAttr = make_unique<EffectBufferAttr>(bufIn, bufOut, numChans, frameLen);
+    EffectBufferAttr eBufferAttr(bufIn, bufOut, numChans, frameLen);
     string sceneType = "";
 
     AudioEffectChainManager::GetInstance()->InitAudioEffectChainManager(DEFAULT_EFFECT_CHAINS, DEFAULT_MAP,
@@ -368,7 +369,7 @@ HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_002, TestSize.Leve
     bufOut = bufOutVector.data();
     int numChans = 2;
     int frameLen = 960;
-    auto eBufferAttr = make_unique<EffectBufferAttr>(bufIn, bufOut, numChans, frameLen);
+    EffectBufferAttr eBufferAttr(bufIn, bufOut, numChans, frameLen);
     string sceneType = "SCENE_MOVIE";
 
     AudioEffectChainManager::GetInstance()->InitAudioEffectChainManager(DEFAULT_EFFECT_CHAINS, DEFAULT_MAP,
@@ -396,7 +397,7 @@ HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_003, TestSize.Leve
     bufOut = bufOutVector.data();
     int numChans = 2;
     int frameLen = 960;
-    auto eBufferAttr = make_unique<EffectBufferAttr>(bufIn, bufOut, numChans, frameLen);
+    EffectBufferAttr eBufferAttr(bufIn, bufOut, numChans, frameLen);
     string sceneType = "123";
 
     AudioEffectChainManager::GetInstance()->InitAudioEffectChainManager(DEFAULT_EFFECT_CHAINS, DEFAULT_MAP,
@@ -424,7 +425,7 @@ HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_004, TestSize.Leve
     bufOut = bufOutVector.data();
     int numChans = 2;
     int frameLen = 960;
-    auto eBufferAttr = make_unique<EffectBufferAttr>(bufIn, bufOut, numChans, frameLen);
+    EffectBufferAttr eBufferAttr(bufIn, bufOut, numChans, frameLen);
     string sceneType = "SCENE_MOVIE";
 
     AudioEffectChainManager::GetInstance()->InitAudioEffectChainManager(DEFAULT_EFFECT_CHAINS, DEFAULT_MAP,
@@ -1132,5 +1133,71 @@ HWTEST(AudioEffectChainManagerUnitTest, ResetEffectBuffer_001, TestSize.Level1)
 {
     AudioEffectChainManager::GetInstance()->ResetEffectBuffer();
 }
+
+/**
+* @tc.name   : Test AudioEffectProfiler API
+* @tc.number : AudioEffectProfiler_001
+* @tc.desc   : Test IsSampled samples one period out of the interval, and never when the interval is 0.
+*/
+HWTEST(AudioEffectChainManagerUnitTest, AudioEffectProfiler_001, TestSize.Level1)
+{
+    const uint32_t sampleInterval = 4;
+    const uint32_t periodNum = 16;
+    AudioEffectProfiler &profiler = AudioEffectProfiler::GetInstance();
+    uint32_t oldInterval = profiler.GetSampleInterval();
+    profiler.SetSampleInterval(sampleInterval);
+    uint32_t periodCount = 0;
+    uint32_t sampled = 0;
+    for (uint32_t i = 0; i < periodNum; i++) {
+        sampled += profiler.IsSampled(periodCount) ? 1 : 0;
+    }
+    EXPECT_EQ(periodNum / sampleInterval, sampled);
+
+    profiler.SetSampleInterval(0);
+    for (uint32_t i = 0; i < periodNum; i++) {
+        EXPECT_EQ(false, profiler.IsSampled(periodCount));
+    }
+    profiler.SetSampleInterval(oldInterval);
+}
+
+/**
+* @tc.name   : Test AudioEffectProfiler API
+* @tc.number : AudioEffectProfiler_002
+* @tc.desc   : Test Record fills the histogram, max and overruns of a slot, and the slot is shared by name.
+*/
+HWTEST(AudioEffectChainManagerUnitTest, AudioEffectProfiler_002, TestSize.Level1)
+{
+    const uint64_t periodNs = 20000000; // 20ms
+    const uint64_t shortCostNs = 3000; // 3us, in bucket 2
+    const uint64_t longCostNs = 30000000; // 30ms, over the period
+    AudioEffectProfiler &profiler = AudioEffectProfiler::GetInstance();
+    AudioEffectProfileSlot *slot = profiler.GetSlot("SCENE_UNIT_TEST", "unit_test_effect");
+    ASSERT_NE(nullptr, slot);
+    EXPECT_EQ(slot, profiler.GetSlot("SCENE_UNIT_TEST", "unit_test_effect"));
+    profiler.Reset();
+
+    AudioEffectProfiler::Record(slot, shortCostNs, periodNs);
+    AudioEffectProfiler::Record(slot, longCostNs, periodNs);
+    AudioEffectProfiler::Record(nullptr, longCostNs, periodNs);
+    bool found = false;
+    for (const AudioEffectProfileInfo &info : profiler.GetProfileInfo()) {
+        if (info.sceneType != "SCENE_UNIT_TEST" || info.effectName != "unit_test_effect") {
+            continue;
+        }
+        found = true;
+        EXPECT_EQ(2, info.count);
+        EXPECT_EQ(shortCostNs + longCostNs, info.totalNs);
+        EXPECT_EQ(longCostNs, info.maxNs);
+        EXPECT_EQ(1, info.overruns);
+        EXPECT_EQ(1, info.buckets[2]); // 2:[2, 4) us
+        EXPECT_EQ(1, info.buckets[EFFECT_PROFILE_BUCKET_NUM - 1]);
+    }
+    EXPECT_EQ(true, found);
+
+    std::string dumpString;
+    profiler.Dump(dumpString);
+    EXPECT_NE(std::string::npos, dumpString.find("unit_test_effect"));
+    profiler.Reset();
+}
 } // namespace AudioStandard
 } // namespace OHOS
\ No newline at end of file
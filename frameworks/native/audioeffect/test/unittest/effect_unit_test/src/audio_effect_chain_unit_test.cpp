@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOG_TAG
+#define LOG_TAG "AudioEffectChainUnitTest"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "audio_effect.h"
+#define private public
+#include "audio_effect_chain.h"
+#undef private
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr uint32_t FRAME_LEN = 480; // 10ms at 48k
+constexpr uint32_t SWAP_ROUNDS = 200;
+constexpr uint32_t HANDLES_PER_ROUND = 3;
+constexpr int64_t PUBLISH_WAIT_MS = 20;
+const string SCENE_TYPE = "SCENE_MUSIC";
+
+// The handle points at the interface pointer, the first member, as the effect libraries lay it out.
+struct MockEffect {
+    AudioEffectInterface *itf = nullptr;
+    atomic<bool> released = false;
+};
+
+atomic<uint32_t> g_processCount = 0;
+atomic<uint32_t> g_releasedProcessCount = 0;
+
+int32_t MockProcess(AudioEffectHandle self, AudioBuffer *inBuffer, AudioBuffer *outBuffer)
+{
+    MockEffect *effect = reinterpret_cast<MockEffect *>(self);
+    if (effect->released.load()) {
+        g_releasedProcessCount++;
+    }
+    g_processCount++;
+    return 0;
+}
+
+int32_t MockCommand(AudioEffectHandle self, uint32_t cmdCode, AudioEffectTransInfo *cmdInfo,
+    AudioEffectTransInfo *replyInfo)
+{
+    return 0;
+}
+
+int32_t MockReleaseEffect(AudioEffectHandle handle)
+{
+    reinterpret_cast<MockEffect *>(handle)->released.store(true);
+    return 0;
+}
+
+AudioEffectInterface g_mockInterface = {MockProcess, MockCommand};
+AudioEffectLibrary g_mockLibrary = {0, "mock", "mock", nullptr, nullptr, MockReleaseEffect};
+
+shared_ptr<AudioEffectChain> CreateChain()
+{
+#ifdef SENSOR_ENABLE
+    return make_shared<AudioEffectChain>(SCENE_TYPE, make_shared<HeadTracker>());
+#else
+    return make_shared<AudioEffectChain>(SCENE_TYPE);
+#endif
+}
+}
+
+class AudioEffectChainUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+    void SetUp(void)
+    {
+        g_processCount = 0;
+        g_releasedProcessCount = 0;
+    }
+    void TearDown(void) {}
+};
+
+/**
+* @tc.name   : Test ApplyEffectChain API
+* @tc.number : ApplyEffectChain_001
+* @tc.desc   : Test the handles are added and released while the render thread processes the chain,
+*              a released handle is never processed.
+*/
+HWTEST_F(AudioEffectChainUnitTest, ApplyEffectChain_001, TestSize.Level1)
+{
+    shared_ptr<AudioEffectChain> chain = CreateChain();
+    vector<MockEffect> effects(SWAP_ROUNDS * HANDLES_PER_ROUND);
+    for (MockEffect &effect : effects) {
+        effect.itf = &g_mockInterface;
+    }
+
+    atomic<bool> running = true;
+    thread renderThread([&chain, &running]() {
+        vector<float> bufIn(FRAME_LEN * STEREO, 0.0f);
+        vector<float> bufOut(FRAME_LEN * STEREO, 0.0f);
+        AudioEffectProcInfo procInfo = {false, false};
+        while (running.load()) {
+            chain->ApplyEffectChain(bufIn.data(), bufOut.data(), FRAME_LEN, procInfo);
+        }
+    });
+
+    for (uint32_t round = 0; round < SWAP_ROUNDS; round++) {
+        for (uint32_t i = 0; i < HANDLES_PER_ROUND; i++) {
+            MockEffect &effect = effects[round * HANDLES_PER_ROUND + i];
+            chain->AddEffectHandle(reinterpret_cast<AudioEffectHandle>(&effect), &g_mockLibrary, SCENE_MUSIC);
+        }
+        this_thread::yield();
+        chain->ReleaseEffectChain();
+    }
+    running.store(false);
+    renderThread.join();
+
+    for (const MockEffect &effect : effects) {
+        EXPECT_TRUE(effect.released.load());
+    }
+    EXPECT_GT(g_processCount.load(), 0);
+    EXPECT_EQ(0, g_releasedProcessCount.load());
+}
+
+/**
+* @tc.name   : Test PublishSnapshot API
+* @tc.number : PublishSnapshot_001
+* @tc.desc   : Test the old snapshot is freed only after the renders counted in both reader slots are done.
+*/
+HWTEST_F(AudioEffectChainUnitTest, PublishSnapshot_001, TestSize.Level1)
+{
+    shared_ptr<AudioEffectChain> chain = CreateChain();
+    AudioEffectChainSnapshot *oldSnapshot = chain->snapshot_.load();
+    ASSERT_NE(nullptr, oldSnapshot);
+
+    // one render started before an epoch flip, one after it, so each reader slot counts one
+    uint32_t firstReader = chain->EnterRender();
+    chain->readerEpoch_++;
+    uint32_t secondReader = chain->EnterRender();
+    ASSERT_NE(firstReader, secondReader);
+
+    atomic<bool> published = false;
+    thread controlThread([&chain, &published]() {
+        chain->ResetIoBufferConfig();
+        published.store(true);
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(PUBLISH_WAIT_MS));
+    EXPECT_NE(oldSnapshot, chain->snapshot_.load());
+    EXPECT_FALSE(published.load());
+
+    chain->ExitRender(firstReader);
+    this_thread::sleep_for(chrono::milliseconds(PUBLISH_WAIT_MS));
+    EXPECT_FALSE(published.load());
+
+    chain->ExitRender(secondReader);
+    controlThread.join();
+    EXPECT_TRUE(published.load());
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -82,6 +82,8 @@ public:
     int32_t Enqueue(const BufferDesc &bufDesc) const override;
     int32_t Clear() const override;
     int32_t GetBufQueueState(BufferQueueState &bufState) const override;
+    int32_t AcquireWriteSpan(BufferDesc &bufDesc) override;
+    int32_t CommitWriteSpan(const BufferDesc &bufDesc) override;
     void SetApplicationCachePath(const std::string cachePath) override;
     void SetInterruptMode(InterruptMode mode) override;
     int32_t SetParallelPlayFlag(bool parallelPlayFlag) override;
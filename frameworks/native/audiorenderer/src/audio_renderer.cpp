@@ -1176,6 +1176,31 @@ int32_t AudioRendererPrivate::GetBufQueueState(BufferQueueState &bufState) const
     return audioStream_->GetBufQueueState(bufState);
 }
 
+int32_t AudioRendererPrivate::AcquireWriteSpan(BufferDesc &bufDesc)
+{
+    if (!switchStreamMutex_.try_lock_shared()) {
+        AUDIO_ERR_LOG("In switch stream process, return");
+        return ERR_ILLEGAL_STATE;
+    }
+    int32_t ret = audioStream_->AcquireWriteSpan(bufDesc);
+    switchStreamMutex_.unlock_shared();
+    return ret;
+}
+
+int32_t AudioRendererPrivate::CommitWriteSpan(const BufferDesc &bufDesc)
+{
+    Trace trace("AudioRenderer::CommitWriteSpan");
+    MockPcmData(bufDesc.buffer, bufDesc.dataLength);
+    DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(bufDesc.buffer), bufDesc.dataLength);
+    if (!switchStreamMutex_.try_lock_shared()) {
+        AUDIO_ERR_LOG("In switch stream process, return");
+        return ERR_ILLEGAL_STATE;
+    }
+    int32_t ret = audioStream_->CommitWriteSpan(bufDesc);
+    switchStreamMutex_.unlock_shared();
+    return ret;
+}
+
 void AudioRendererPrivate::SetApplicationCachePath(const std::string cachePath)
 {
     cachePath_ = cachePath;
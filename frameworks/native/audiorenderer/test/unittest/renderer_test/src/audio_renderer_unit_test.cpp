@@ -15,6 +15,7 @@
 
 #include "audio_renderer_unit_test.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -1024,6 +1025,93 @@ HWTEST(AudioRendererUnitTest, Audio_Renderer_GetBufQueueState_001, TestSize.Leve
     audioRenderer->Release();
 }
 
+/**
+ * @tc.name  : Test AcquireWriteSpan and CommitWriteSpan
+ * @tc.number: Audio_Renderer_AcquireWriteSpan_001
+ * @tc.desc  : Test AcquireWriteSpan interface. Returns SUCCESS, if pcm is written in place successfully.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_AcquireWriteSpan_001, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+
+    bool isStarted = audioRenderer->Start();
+    EXPECT_EQ(true, isStarted);
+
+    int32_t numBuffersToRender = WRITE_BUFFERS_COUNT;
+    while (numBuffersToRender--) {
+        BufferDesc bufDesc = {};
+        int32_t ret = audioRenderer->AcquireWriteSpan(bufDesc);
+        EXPECT_EQ(SUCCESS, ret);
+        if (ret != SUCCESS) {
+            break;
+        }
+        ASSERT_NE(nullptr, bufDesc.buffer);
+        std::fill(bufDesc.buffer, bufDesc.buffer + bufDesc.bufLength, 0);
+        bufDesc.dataLength = bufDesc.bufLength;
+        EXPECT_EQ(SUCCESS, audioRenderer->CommitWriteSpan(bufDesc));
+    }
+
+    audioRenderer->Stop();
+    audioRenderer->Release();
+}
+
+/**
+ * @tc.name  : Test AcquireWriteSpan and CommitWriteSpan via illegal state
+ * @tc.number: Audio_Renderer_AcquireWriteSpan_002
+ * @tc.desc  : Test AcquireWriteSpan interface. Returns error, if it is called in callback mode or not acquired.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_AcquireWriteSpan_002, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+
+    BufferDesc bufDesc = {};
+    EXPECT_NE(SUCCESS, audioRenderer->CommitWriteSpan(bufDesc));
+
+    int32_t ret = audioRenderer->SetRenderMode(RENDER_MODE_CALLBACK);
+    EXPECT_EQ(SUCCESS, ret);
+    EXPECT_NE(SUCCESS, audioRenderer->AcquireWriteSpan(bufDesc));
+    audioRenderer->Release();
+}
+
+/**
+ * @tc.name  : Test Write while a span is acquired
+ * @tc.number: Audio_Renderer_AcquireWriteSpan_003
+ * @tc.desc  : Test Write interface. Returns ERR_ILLEGAL_STATE, if the span from AcquireWriteSpan is not committed.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_AcquireWriteSpan_003, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+
+    bool isStarted = audioRenderer->Start();
+    EXPECT_EQ(true, isStarted);
+
+    BufferDesc bufDesc = {};
+    int32_t ret = audioRenderer->AcquireWriteSpan(bufDesc);
+    EXPECT_EQ(SUCCESS, ret);
+    if (ret == SUCCESS) {
+        std::vector<uint8_t> buffer(bufDesc.bufLength, 0);
+        EXPECT_EQ(ERR_ILLEGAL_STATE, audioRenderer->Write(buffer.data(), buffer.size()));
+        bufDesc.dataLength = 0;
+        EXPECT_EQ(SUCCESS, audioRenderer->CommitWriteSpan(bufDesc));
+        EXPECT_GT(audioRenderer->Write(buffer.data(), buffer.size()), 0);
+    }
+
+    audioRenderer->Stop();
+    audioRenderer->Release();
+}
+
 /**
  * @tc.name  : Test GetParams API stability.
  * @tc.number: Audio_Renderer_GetParams_Stability_001
@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include "timestamp.h"
+#include "audio_errors.h"
 #include "audio_info.h"
 #include "audio_capturer.h"
 #include "audio_renderer.h"
@@ -170,6 +171,17 @@ public:
     virtual int32_t Enqueue(const BufferDesc &bufDesc) = 0;
     virtual int32_t Clear() = 0;
 
+    // Write pcm in place to the span in shared buffer. Only renderer stream with shared buffer supports this.
+    virtual int32_t AcquireWriteSpan(BufferDesc &bufDesc)
+    {
+        return ERR_NOT_SUPPORTED;
+    }
+
+    virtual int32_t CommitWriteSpan(const BufferDesc &bufDesc)
+    {
+        return ERR_NOT_SUPPORTED;
+    }
+
     virtual int32_t SetLowPowerVolume(float volume) = 0;
     virtual float GetLowPowerVolume() = 0;
     virtual float GetSingleStreamVolume() = 0;
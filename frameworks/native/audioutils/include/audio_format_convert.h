@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_FORMAT_CONVERT_H
+#define AUDIO_FORMAT_CONVERT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * Sample format conversion kernels shared by the pulseaudio modules and the audio service. Integer samples are
+ * little endian, S24 is packed in 3 bytes. Float samples are in [-1.0, 1.0], a float out of range is clamped and
+ * the integer result saturates, so 1.0 gives the max value of the format, NaN converts as 0.0. The best kernel set is
+ * chosen on first use according to the cpu features, all kernel sets produce bit-exact results with the scalar one.
+*/
+typedef enum AudioConvertIsa {
+    AUDIO_CONVERT_ISA_SCALAR = 0,
+    AUDIO_CONVERT_ISA_NEON,
+    AUDIO_CONVERT_ISA_SSE41,
+} AudioConvertIsa;
+
+AudioConvertIsa AudioConvertGetIsa(void);
+// Force a kernel set, used by test and benchmark. Return false if the isa is not supported on this cpu.
+bool AudioConvertSetIsa(AudioConvertIsa isa);
+
+void AudioConvertS16ToF32(const int16_t *src, float *dst, size_t count);
+void AudioConvertS24ToF32(const uint8_t *src, float *dst, size_t count);
+void AudioConvertS32ToF32(const int32_t *src, float *dst, size_t count);
+
+// Truncated toward zero if ditherSeed is NULL. Otherwise a triangular dither of +-1 lsb is added and the result is
+// rounded, ditherSeed holds the state of the noise between calls and can start with any value.
+void AudioConvertF32ToS16(const float *src, int16_t *dst, size_t count, uint32_t *ditherSeed);
+void AudioConvertF32ToS24(const float *src, uint8_t *dst, size_t count, uint32_t *ditherSeed);
+void AudioConvertF32ToS32(const float *src, int32_t *dst, size_t count);
+
+// dst[i] += src[i], the conversion is fused into the sum for the integer formats.
+void AudioAccumulateF32(const float *src, float *dst, size_t count);
+void AudioAccumulateS16ToF32(const int16_t *src, float *dst, size_t count);
+void AudioAccumulateS24ToF32(const uint8_t *src, float *dst, size_t count);
+void AudioAccumulateS32ToF32(const int32_t *src, float *dst, size_t count);
+#ifdef __cplusplus
+}
+#endif
+#endif // AUDIO_FORMAT_CONVERT_H
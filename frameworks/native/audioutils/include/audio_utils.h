@@ -85,11 +85,21 @@ public:
     static void Count(const std::string &value, int64_t count);
     // Show if data is silent.
     static void CountVolume(const std::string &value, uint8_t data);
+    /**
+     * Detail trace and dfx on per-buffer paths, switched at runtime with HOT_PATH_TRACE_PARA. Callers on those paths
+     * keep their trace tags in file scope static strings and pass them to HotPathCount or Trace(tag, value), so that
+     * nothing is formatted or allocated per buffer unless this is enabled.
+    */
+    static bool IsHotPathEnabled();
+    // Count on per-buffer paths, only done when IsHotPathEnabled. value should be a prebuilt tag.
+    static void HotPathCount(const std::string &value, int64_t count);
     Trace(const std::string &value);
+    // Trace on per-buffer paths. tag should be prebuilt, value is appended to it only when IsHotPathEnabled, so the
+    // trace costs no heap allocation by default.
+    Trace(const std::string &tag, int64_t value);
     void End();
     ~Trace();
 private:
-    std::string value_;
     bool isFinished_;
 };
 
@@ -181,6 +191,7 @@ enum AudioDumpFileType {
 
 const std::string DUMP_SERVER_PARA = "sys.audio.dump.writeserver.enable";
 const std::string DUMP_CLIENT_PARA = "sys.audio.dump.writeclient.enable";
+const std::string HOT_PATH_TRACE_PARA = "debug.audio.hotpath.trace.enable";
 const std::string DUMP_PULSE_DIR = "/data/data/.pulse_dir/";
 const std::string DUMP_SERVICE_DIR = "/data/local/tmp/";
 const std::string DUMP_APP_DIR = "/data/storage/el2/base/cache/";
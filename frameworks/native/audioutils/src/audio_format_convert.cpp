@@ -0,0 +1,605 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioFormatConvert"
+#endif
+
+#include "audio_format_convert.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#define CONVERT_KERNEL_NEON
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#define CONVERT_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#include "audio_common_log.h"
+
+namespace {
+static constexpr float S16_SCALE = 32768.0f; // 1 << 15
+static constexpr float S24_SCALE = 8388608.0f; // 1 << 23
+static constexpr float S32_SCALE = 2147483648.0f; // 1 << 31
+static constexpr float S16_TO_F32 = 1.0f / S16_SCALE;
+static constexpr float S32_TO_F32 = 1.0f / S32_SCALE;
+static constexpr int32_t S24_MAX = 8388607; // (1 << 23) - 1
+static constexpr int32_t S24_MIN = -8388608; // -(1 << 23)
+static constexpr size_t S24_BYTES = 3;
+static constexpr uint32_t S24_SHIFT = 8; // S24 is kept in the high 24 bits of an int32_t
+static constexpr uint32_t SHIFT_EIGHT = 8;
+static constexpr uint32_t SHIFT_SIXTEEN = 16;
+static constexpr uint32_t SHIFT_TWENTY_FOUR = 24;
+static constexpr size_t BYTE_INDEX_TWO = 2;
+// numerical recipes lcg, the top 24 bits are used as a uniform noise in [0, 1)
+static constexpr uint32_t LCG_MULTIPLIER = 1664525;
+static constexpr uint32_t LCG_INCREMENT = 1013904223;
+static constexpr float NOISE_SCALE = 1.0f / 16777216.0f; // 1 << 24
+static constexpr float HALF_LSB = 0.5f;
+
+using ToF32S16Func = void (*)(const int16_t *src, float *dst, size_t count, bool accumulate);
+using ToF32S24Func = void (*)(const uint8_t *src, float *dst, size_t count, bool accumulate);
+using ToF32S32Func = void (*)(const int32_t *src, float *dst, size_t count, bool accumulate);
+using F32ToS16Func = void (*)(const float *src, int16_t *dst, size_t count);
+using F32ToS24Func = void (*)(const float *src, uint8_t *dst, size_t count);
+using F32ToS32Func = void (*)(const float *src, int32_t *dst, size_t count);
+using AccumulateF32Func = void (*)(const float *src, float *dst, size_t count);
+
+struct ConvertKernelOps {
+    AudioConvertIsa isa;
+    ToF32S16Func s16ToF32;
+    ToF32S24Func s24ToF32;
+    ToF32S32Func s32ToF32;
+    F32ToS16Func f32ToS16;
+    F32ToS24Func f32ToS24;
+    F32ToS32Func f32ToS32;
+    AccumulateF32Func accumulateF32;
+};
+}
+
+static inline void StoreF32(float *dst, float value, bool accumulate)
+{
+    if (accumulate) {
+        *dst += value;
+    } else {
+        *dst = value;
+    }
+}
+
+static inline int32_t ReadS24(const uint8_t *p)
+{
+    uint32_t value = (static_cast<uint32_t>(p[BYTE_INDEX_TWO]) << SHIFT_TWENTY_FOUR) |
+        (static_cast<uint32_t>(p[1]) << SHIFT_SIXTEEN) | (static_cast<uint32_t>(p[0]) << SHIFT_EIGHT);
+    return static_cast<int32_t>(value);
+}
+
+static inline void WriteS24(uint8_t *p, int32_t value)
+{
+    uint32_t bits = static_cast<uint32_t>(value);
+    p[0] = static_cast<uint8_t>(bits);
+    p[1] = static_cast<uint8_t>(bits >> SHIFT_EIGHT);
+    p[BYTE_INDEX_TWO] = static_cast<uint8_t>(bits >> SHIFT_SIXTEEN);
+}
+
+// NaN is taken as silence, the vector kernels mask it out before the min and max.
+static inline float ClampF32(float value)
+{
+    if (value != value) {
+        return 0.0f;
+    }
+    value = value < 1.0f ? value : 1.0f;
+    return value > -1.0f ? value : -1.0f;
+}
+
+static inline int16_t SaturateS16(int32_t value)
+{
+    return value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value);
+}
+
+// A clamped float scaled to S32 is in [-2^31, 2^31], only 2^31 itself is out of the int32_t range.
+static inline int32_t F32ToS32Sample(float value)
+{
+    float scaled = ClampF32(value) * S32_SCALE;
+    return scaled >= S32_SCALE ? INT32_MAX : static_cast<int32_t>(scaled);
+}
+
+static void S16ToF32Range(const int16_t *src, float *dst, size_t begin, size_t end, bool accumulate)
+{
+    for (size_t i = begin; i < end; i++) {
+        StoreF32(dst + i, src[i] * S16_TO_F32, accumulate);
+    }
+}
+
+static void S24ToF32Range(const uint8_t *src, float *dst, size_t begin, size_t end, bool accumulate)
+{
+    for (size_t i = begin; i < end; i++) {
+        StoreF32(dst + i, static_cast<float>(ReadS24(src + i * S24_BYTES)) * S32_TO_F32, accumulate);
+    }
+}
+
+static void S32ToF32Range(const int32_t *src, float *dst, size_t begin, size_t end, bool accumulate)
+{
+    for (size_t i = begin; i < end; i++) {
+        StoreF32(dst + i, static_cast<float>(src[i]) * S32_TO_F32, accumulate);
+    }
+}
+
+static void F32ToS16Range(const float *src, int16_t *dst, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        dst[i] = SaturateS16(static_cast<int32_t>(ClampF32(src[i]) * S16_SCALE));
+    }
+}
+
+static void F32ToS24Range(const float *src, uint8_t *dst, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        WriteS24(dst + i * S24_BYTES, F32ToS32Sample(src[i]) >> S24_SHIFT);
+    }
+}
+
+static void F32ToS32Range(const float *src, int32_t *dst, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        dst[i] = F32ToS32Sample(src[i]);
+    }
+}
+
+static void AccumulateF32Range(const float *src, float *dst, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        dst[i] += src[i];
+    }
+}
+
+static void S16ToF32Scalar(const int16_t *src, float *dst, size_t count, bool accumulate)
+{
+    S16ToF32Range(src, dst, 0, count, accumulate);
+}
+
+static void S24ToF32Scalar(const uint8_t *src, float *dst, size_t count, bool accumulate)
+{
+    S24ToF32Range(src, dst, 0, count, accumulate);
+}
+
+static void S32ToF32Scalar(const int32_t *src, float *dst, size_t count, bool accumulate)
+{
+    S32ToF32Range(src, dst, 0, count, accumulate);
+}
+
+static void F32ToS16Scalar(const float *src, int16_t *dst, size_t count)
+{
+    F32ToS16Range(src, dst, 0, count);
+}
+
+static void F32ToS24Scalar(const float *src, uint8_t *dst, size_t count)
+{
+    F32ToS24Range(src, dst, 0, count);
+}
+
+static void F32ToS32Scalar(const float *src, int32_t *dst, size_t count)
+{
+    F32ToS32Range(src, dst, 0, count);
+}
+
+static void AccumulateF32Scalar(const float *src, float *dst, size_t count)
+{
+    AccumulateF32Range(src, dst, 0, count);
+}
+
+static constexpr ConvertKernelOps SCALAR_OPS = { AUDIO_CONVERT_ISA_SCALAR, S16ToF32Scalar, S24ToF32Scalar,
+    S32ToF32Scalar, F32ToS16Scalar, F32ToS24Scalar, F32ToS32Scalar, AccumulateF32Scalar };
+
+#ifdef CONVERT_KERNEL_NEON
+static constexpr size_t NEON_STEP = 8; // two 128bit registers of float
+
+static inline void StoreF32Neon(float *dst, float32x4_t value, bool accumulate)
+{
+    vst1q_f32(dst, accumulate ? vaddq_f32(vld1q_f32(dst), value) : value);
+}
+
+// vminq_f32 and vmaxq_f32 return NaN if any input is NaN, clear the NaN lanes first to take NaN as 0.0 like ClampF32.
+static inline float32x4_t ClampF32Neon(float32x4_t value, float32x4_t one, float32x4_t minusOne)
+{
+    value = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(value), vceqq_f32(value, value)));
+    return vmaxq_f32(vminq_f32(value, one), minusOne);
+}
+
+static inline int32x4_t F32ToS32Neon(float32x4_t value, float32x4_t one, float32x4_t minusOne)
+{
+    // vcvtq_s32_f32 truncates and saturates, 2^31 gives INT32_MAX as the scalar kernel does
+    return vcvtq_s32_f32(vmulq_n_f32(ClampF32Neon(value, one, minusOne), S32_SCALE));
+}
+
+static void S16ToF32Neon(const int16_t *src, float *dst, size_t count, bool accumulate)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        int16x8_t in = vld1q_s16(src + offset);
+        StoreF32Neon(dst + offset, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(in))), S16_TO_F32), accumulate);
+        StoreF32Neon(dst + offset + NEON_STEP / 2, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(in))),
+            S16_TO_F32), accumulate); // 2 for half
+    }
+    S16ToF32Range(src, dst, offset, count, accumulate);
+}
+
+static void S24ToF32Neon(const uint8_t *src, float *dst, size_t count, bool accumulate)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        uint8x8x3_t bytes = vld3_u8(src + offset * S24_BYTES);
+        uint16x8_t low = vshll_n_u8(bytes.val[0], SHIFT_EIGHT);
+        uint16x8_t high = vorrq_u16(vshll_n_u8(bytes.val[BYTE_INDEX_TWO], SHIFT_EIGHT), vmovl_u8(bytes.val[1]));
+        uint32x4_t first = vorrq_u32(vshll_n_u16(vget_low_u16(high), SHIFT_SIXTEEN), vmovl_u16(vget_low_u16(low)));
+        uint32x4_t second = vorrq_u32(vshll_n_u16(vget_high_u16(high), SHIFT_SIXTEEN),
+            vmovl_u16(vget_high_u16(low)));
+        StoreF32Neon(dst + offset, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(first)), S32_TO_F32),
+            accumulate);
+        StoreF32Neon(dst + offset + NEON_STEP / 2, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(second)),
+            S32_TO_F32), accumulate); // 2 for half
+    }
+    S24ToF32Range(src, dst, offset, count, accumulate);
+}
+
+static void S32ToF32Neon(const int32_t *src, float *dst, size_t count, bool accumulate)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        StoreF32Neon(dst + offset, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + offset)), S32_TO_F32), accumulate);
+        StoreF32Neon(dst + offset + NEON_STEP / 2, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + offset +
+            NEON_STEP / 2)), S32_TO_F32), accumulate); // 2 for half
+    }
+    S32ToF32Range(src, dst, offset, count, accumulate);
+}
+
+static void F32ToS16Neon(const float *src, int16_t *dst, size_t count)
+{
+    size_t offset = 0;
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t minusOne = vdupq_n_f32(-1.0f);
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        float32x4_t first = ClampF32Neon(vld1q_f32(src + offset), one, minusOne);
+        float32x4_t second = ClampF32Neon(vld1q_f32(src + offset + NEON_STEP / 2), one, minusOne);
+        int16x4_t low = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(first, S16_SCALE)));
+        int16x4_t high = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(second, S16_SCALE)));
+        vst1q_s16(dst + offset, vcombine_s16(low, high));
+    }
+    F32ToS16Range(src, dst, offset, count);
+}
+
+static void F32ToS24Neon(const float *src, uint8_t *dst, size_t count)
+{
+    size_t offset = 0;
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t minusOne = vdupq_n_f32(-1.0f);
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        uint32x4_t first = vreinterpretq_u32_s32(vshrq_n_s32(F32ToS32Neon(vld1q_f32(src + offset), one, minusOne),
+            S24_SHIFT));
+        uint32x4_t second = vreinterpretq_u32_s32(vshrq_n_s32(F32ToS32Neon(vld1q_f32(src + offset + NEON_STEP / 2),
+            one, minusOne), S24_SHIFT));
+        uint16x8_t low = vcombine_u16(vmovn_u32(first), vmovn_u32(second));
+        uint16x8_t high = vcombine_u16(vshrn_n_u32(first, SHIFT_SIXTEEN), vshrn_n_u32(second, SHIFT_SIXTEEN));
+        uint8x8x3_t bytes;
+        bytes.val[0] = vmovn_u16(low);
+        bytes.val[1] = vshrn_n_u16(low, SHIFT_EIGHT);
+        bytes.val[BYTE_INDEX_TWO] = vmovn_u16(high);
+        vst3_u8(dst + offset * S24_BYTES, bytes);
+    }
+    F32ToS24Range(src, dst, offset, count);
+}
+
+static void F32ToS32Neon(const float *src, int32_t *dst, size_t count)
+{
+    size_t offset = 0;
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t minusOne = vdupq_n_f32(-1.0f);
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        vst1q_s32(dst + offset, F32ToS32Neon(vld1q_f32(src + offset), one, minusOne));
+        vst1q_s32(dst + offset + NEON_STEP / 2, F32ToS32Neon(vld1q_f32(src + offset + NEON_STEP / 2), one,
+            minusOne)); // 2 for half
+    }
+    F32ToS32Range(src, dst, offset, count);
+}
+
+static void AccumulateF32Neon(const float *src, float *dst, size_t count)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= count; offset += NEON_STEP) {
+        vst1q_f32(dst + offset, vaddq_f32(vld1q_f32(dst + offset), vld1q_f32(src + offset)));
+        vst1q_f32(dst + offset + NEON_STEP / 2, vaddq_f32(vld1q_f32(dst + offset + NEON_STEP / 2),
+            vld1q_f32(src + offset + NEON_STEP / 2))); // 2 for half
+    }
+    AccumulateF32Range(src, dst, offset, count);
+}
+
+static constexpr ConvertKernelOps NEON_OPS = { AUDIO_CONVERT_ISA_NEON, S16ToF32Neon, S24ToF32Neon, S32ToF32Neon,
+    F32ToS16Neon, F32ToS24Neon, F32ToS32Neon, AccumulateF32Neon };
+#endif
+
+#ifdef CONVERT_KERNEL_X86
+static constexpr size_t SSE_STEP = 4; // 4 * float or int32_t in one 128bit register
+// 4 samples are loaded or stored with 16 bytes, which must stay in the buffer. A store writes 4 bytes of the next
+// samples, they are written again by the next step or the scalar tail.
+static constexpr size_t SSE_S24_ACCESS_SAMPLES = 6;
+
+__attribute__((target("sse4.1")))
+static inline void StoreF32Sse(float *dst, __m128 value, bool accumulate)
+{
+    _mm_storeu_ps(dst, accumulate ? _mm_add_ps(_mm_loadu_ps(dst), value) : value);
+}
+
+// _mm_min_ps returns its second operand for NaN, clear the NaN lanes first to take NaN as 0.0 like ClampF32.
+__attribute__((target("sse4.1")))
+static inline __m128 ClampF32Sse(__m128 value, __m128 one, __m128 minusOne)
+{
+    value = _mm_and_ps(value, _mm_cmpord_ps(value, value));
+    return _mm_max_ps(_mm_min_ps(value, one), minusOne);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i F32ToS32Sse(__m128 value, __m128 one, __m128 minusOne, __m128 scale)
+{
+    __m128 scaled = _mm_mul_ps(ClampF32Sse(value, one, minusOne), scale);
+    // _mm_cvttps_epi32 gives INT32_MIN for 2^31, flip it to INT32_MAX as the scalar kernel does
+    return _mm_xor_si128(_mm_cvttps_epi32(scaled), _mm_castps_si128(_mm_cmpge_ps(scaled, scale)));
+}
+
+__attribute__((target("sse4.1")))
+static void S16ToF32Sse(const int16_t *src, float *dst, size_t count, bool accumulate)
+{
+    size_t offset = 0;
+    __m128 scale = _mm_set1_ps(S16_TO_F32);
+    for (; offset + SSE_STEP <= count; offset += SSE_STEP) {
+        __m128i in = _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + offset)));
+        StoreF32Sse(dst + offset, _mm_mul_ps(_mm_cvtepi32_ps(in), scale), accumulate);
+    }
+    S16ToF32Range(src, dst, offset, count, accumulate);
+}
+
+__attribute__((target("sse4.1")))
+static void S24ToF32Sse(const uint8_t *src, float *dst, size_t count, bool accumulate)
+{
+    size_t offset = 0;
+    __m128 scale = _mm_set1_ps(S32_TO_F32);
+    // byte i of a sample goes to byte i + 1 of an int32_t, byte 0 is cleared
+    __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    for (; offset + SSE_S24_ACCESS_SAMPLES <= count; offset += SSE_STEP) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + offset * S24_BYTES));
+        StoreF32Sse(dst + offset, _mm_mul_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(in, shuffle)), scale), accumulate);
+    }
+    S24ToF32Range(src, dst, offset, count, accumulate);
+}
+
+__attribute__((target("sse4.1")))
+static void S32ToF32Sse(const int32_t *src, float *dst, size_t count, bool accumulate)
+{
+    size_t offset = 0;
+    __m128 scale = _mm_set1_ps(S32_TO_F32);
+    for (; offset + SSE_STEP <= count; offset += SSE_STEP) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + offset));
+        StoreF32Sse(dst + offset, _mm_mul_ps(_mm_cvtepi32_ps(in), scale), accumulate);
+    }
+    S32ToF32Range(src, dst, offset, count, accumulate);
+}
+
+__attribute__((target("sse4.1")))
+static void F32ToS16Sse(const float *src, int16_t *dst, size_t count)
+{
+    size_t offset = 0;
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 minusOne = _mm_set1_ps(-1.0f);
+    __m128 scale = _mm_set1_ps(S16_SCALE);
+    for (; offset + SSE_STEP * 2 <= count; offset += SSE_STEP * 2) { // 2 registers for 8 * int16_t
+        __m128 first = ClampF32Sse(_mm_loadu_ps(src + offset), one, minusOne);
+        __m128 second = ClampF32Sse(_mm_loadu_ps(src + offset + SSE_STEP), one, minusOne);
+        __m128i low = _mm_cvttps_epi32(_mm_mul_ps(first, scale));
+        __m128i high = _mm_cvttps_epi32(_mm_mul_ps(second, scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), _mm_packs_epi32(low, high));
+    }
+    F32ToS16Range(src, dst, offset, count);
+}
+
+__attribute__((target("sse4.1")))
+static void F32ToS24Sse(const float *src, uint8_t *dst, size_t count)
+{
+    size_t offset = 0;
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 minusOne = _mm_set1_ps(-1.0f);
+    __m128 scale = _mm_set1_ps(S32_SCALE);
+    // the low 3 bytes of each int32_t, packed into the first 12 bytes
+    __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; offset + SSE_S24_ACCESS_SAMPLES <= count; offset += SSE_STEP) {
+        __m128i out = _mm_srai_epi32(F32ToS32Sse(_mm_loadu_ps(src + offset), one, minusOne, scale), S24_SHIFT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset * S24_BYTES), _mm_shuffle_epi8(out, shuffle));
+    }
+    F32ToS24Range(src, dst, offset, count);
+}
+
+__attribute__((target("sse4.1")))
+static void F32ToS32Sse(const float *src, int32_t *dst, size_t count)
+{
+    size_t offset = 0;
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 minusOne = _mm_set1_ps(-1.0f);
+    __m128 scale = _mm_set1_ps(S32_SCALE);
+    for (; offset + SSE_STEP <= count; offset += SSE_STEP) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset),
+            F32ToS32Sse(_mm_loadu_ps(src + offset), one, minusOne, scale));
+    }
+    F32ToS32Range(src, dst, offset, count);
+}
+
+__attribute__((target("sse4.1")))
+static void AccumulateF32Sse(const float *src, float *dst, size_t count)
+{
+    size_t offset = 0;
+    for (; offset + SSE_STEP <= count; offset += SSE_STEP) {
+        _mm_storeu_ps(dst + offset, _mm_add_ps(_mm_loadu_ps(dst + offset), _mm_loadu_ps(src + offset)));
+    }
+    AccumulateF32Range(src, dst, offset, count);
+}
+
+static constexpr ConvertKernelOps SSE41_OPS = { AUDIO_CONVERT_ISA_SSE41, S16ToF32Sse, S24ToF32Sse, S32ToF32Sse,
+    F32ToS16Sse, F32ToS24Sse, F32ToS32Sse, AccumulateF32Sse };
+#endif
+
+static const ConvertKernelOps *GetOpsByIsa(AudioConvertIsa isa)
+{
+    switch (isa) {
+        case AUDIO_CONVERT_ISA_SCALAR:
+            return &SCALAR_OPS;
+#ifdef CONVERT_KERNEL_NEON
+        case AUDIO_CONVERT_ISA_NEON:
+            return &NEON_OPS;
+#endif
+#ifdef CONVERT_KERNEL_X86
+        case AUDIO_CONVERT_ISA_SSE41:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.1") ? &SSE41_OPS : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+static const ConvertKernelOps *DetectOps()
+{
+    static const AudioConvertIsa preferOrder[] = { AUDIO_CONVERT_ISA_SSE41, AUDIO_CONVERT_ISA_NEON };
+    for (AudioConvertIsa isa : preferOrder) {
+        const ConvertKernelOps *ops = GetOpsByIsa(isa);
+        if (ops != nullptr) {
+            AUDIO_INFO_LOG("use isa %{public}d convert kernel", isa);
+            return ops;
+        }
+    }
+    AUDIO_INFO_LOG("use scalar convert kernel");
+    return &SCALAR_OPS;
+}
+
+static std::atomic<const ConvertKernelOps *> &GetActiveOps()
+{
+    static std::atomic<const ConvertKernelOps *> activeOps(DetectOps());
+    return activeOps;
+}
+
+static inline const ConvertKernelOps *LoadOps()
+{
+    return GetActiveOps().load(std::memory_order_relaxed);
+}
+
+// Triangular noise in (-1, 1), the difference of two uniform noises.
+static inline float TriangularNoise(uint32_t *seed)
+{
+    *seed = *seed * LCG_MULTIPLIER + LCG_INCREMENT;
+    float first = static_cast<float>(*seed >> SHIFT_EIGHT) * NOISE_SCALE;
+    *seed = *seed * LCG_MULTIPLIER + LCG_INCREMENT;
+    float second = static_cast<float>(*seed >> SHIFT_EIGHT) * NOISE_SCALE;
+    return first - second;
+}
+
+static inline int32_t DitherSample(float value, float scale, uint32_t *seed)
+{
+    return static_cast<int32_t>(std::floor(ClampF32(value) * scale + TriangularNoise(seed) + HALF_LSB));
+}
+
+extern "C" {
+AudioConvertIsa AudioConvertGetIsa(void)
+{
+    return LoadOps()->isa;
+}
+
+bool AudioConvertSetIsa(AudioConvertIsa isa)
+{
+    const ConvertKernelOps *ops = GetOpsByIsa(isa);
+    CHECK_AND_RETURN_RET_LOG(ops != nullptr, false, "isa %{public}d is not supported", isa);
+    GetActiveOps().store(ops, std::memory_order_relaxed);
+    return true;
+}
+
+void AudioConvertS16ToF32(const int16_t *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid convert param");
+    LoadOps()->s16ToF32(src, dst, count, false);
+}
+
+void AudioConvertS24ToF32(const uint8_t *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid convert param");
+    LoadOps()->s24ToF32(src, dst, count, false);
+}
+
+void AudioConvertS32ToF32(const int32_t *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid convert param");
+    LoadOps()->s32ToF32(src, dst, count, false);
+}
+
+void AudioConvertF32ToS16(const float *src, int16_t *dst, size_t count, uint32_t *ditherSeed)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid convert param");
+    if (ditherSeed == nullptr) {
+        LoadOps()->f32ToS16(src, dst, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = SaturateS16(DitherSample(src[i], S16_SCALE, ditherSeed));
+    }
+}
+
+void AudioConvertF32ToS24(const float *src, uint8_t *dst, size_t count, uint32_t *ditherSeed)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid convert param");
+    if (ditherSeed == nullptr) {
+        LoadOps()->f32ToS24(src, dst, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = DitherSample(src[i], S24_SCALE, ditherSeed);
+        WriteS24(dst + i * S24_BYTES, value > S24_MAX ? S24_MAX : (value < S24_MIN ? S24_MIN : value));
+    }
+}
+
+void AudioConvertF32ToS32(const float *src, int32_t *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid convert param");
+    LoadOps()->f32ToS32(src, dst, count);
+}
+
+void AudioAccumulateF32(const float *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid accumulate param");
+    LoadOps()->accumulateF32(src, dst, count);
+}
+
+void AudioAccumulateS16ToF32(const int16_t *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid accumulate param");
+    LoadOps()->s16ToF32(src, dst, count, true);
+}
+
+void AudioAccumulateS24ToF32(const uint8_t *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid accumulate param");
+    LoadOps()->s24ToF32(src, dst, count, true);
+}
+
+void AudioAccumulateS32ToF32(const int32_t *src, float *dst, size_t count)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid accumulate param");
+    LoadOps()->s32ToF32(src, dst, count, true);
+}
+}
@@ -25,6 +25,7 @@
 #include <string>
 #include "audio_utils_c.h"
 #include "audio_errors.h"
+#include "audio_format_convert.h"
 #include "audio_common_log.h"
 #ifdef FEATURE_HITRACE_METER
 #include "hitrace_meter.h"
@@ -54,6 +55,7 @@ constexpr int32_t UID_FOUNDATION_SA = 5523;
 constexpr int32_t UID_DISTRIBUTED_CALL_SA = 3069;
 constexpr int32_t UID_TELEPHONY_SA = 1001;
 constexpr int32_t TIME_OUT_SECONDS = 10;
+constexpr int64_t HOT_PATH_PARA_CHECK_INTERVAL = 1000000000; // 1s
 
 constexpr size_t FIRST_CHAR = 1;
 constexpr size_t MIN_LEN = 8;
@@ -146,12 +148,45 @@ void Trace::CountVolume(const std::string &value, uint8_t data)
 #endif
 }
 
+bool Trace::IsHotPathEnabled()
+{
+    static std::atomic<bool> isEnabled = false;
+    static std::atomic<int64_t> nextCheckTime = 0;
+    int64_t curTime = ClockTime::GetCurNano();
+    int64_t checkTime = nextCheckTime.load();
+    // the parameter is read at most once a second, only by the thread that moves the check time.
+    if (curTime >= checkTime && nextCheckTime.compare_exchange_strong(checkTime,
+        curTime + HOT_PATH_PARA_CHECK_INTERVAL)) {
+        int32_t flag = 0;
+        isEnabled.store(GetSysPara(HOT_PATH_TRACE_PARA.c_str(), flag) && flag == 1);
+    }
+    return isEnabled.load();
+}
+
+void Trace::HotPathCount(const std::string &value, int64_t count)
+{
+    if (IsHotPathEnabled()) {
+        Count(value, count);
+    }
+}
+
 Trace::Trace(const std::string &value)
 {
-    value_ = value;
     isFinished_ = false;
 #ifdef FEATURE_HITRACE_METER
-    StartTrace(HITRACE_TAG_ZAUDIO, value_);
+    StartTrace(HITRACE_TAG_ZAUDIO, value);
+#endif
+}
+
+Trace::Trace(const std::string &tag, int64_t value)
+{
+    isFinished_ = false;
+#ifdef FEATURE_HITRACE_METER
+    if (IsHotPathEnabled()) {
+        StartTrace(HITRACE_TAG_ZAUDIO, tag + std::to_string(value));
+    } else {
+        StartTrace(HITRACE_TAG_ZAUDIO, tag);
+    }
 #endif
 }
 
@@ -426,63 +461,24 @@ void AdjustAudioBalanceForPCM32Bit(int32_t *data, uint64_t len, float left, floa
     }
 }
 
-uint32_t Read24Bit(const uint8_t *p)
-{
-    return ((uint32_t) p[BIT_DEPTH_TWO] << BIT_16) | ((uint32_t) p[1] << BIT_8) | ((uint32_t) p[0]);
-}
-
-void Write24Bit(uint8_t *p, uint32_t u)
-{
-    p[BIT_DEPTH_TWO] = (uint8_t) (u >> BIT_16);
-    p[1] = static_cast<uint8_t>(u >> BIT_8);
-    p[0] = static_cast<uint8_t>(u);
-}
-
 void ConvertFrom24BitToFloat(unsigned n, const uint8_t *a, float *b)
 {
-    for (; n > 0; n--) {
-        int32_t s = Read24Bit(a) << BIT_8;
-        *b = s * (1.0f / (1U << (BIT_32 - 1)));
-        a += OFFSET_BIT_24;
-        b++;
-    }
+    AudioConvertS24ToF32(a, b, n);
 }
 
 void ConvertFrom32BitToFloat(unsigned n, const int32_t *a, float *b)
 {
-    for (; n > 0; n--) {
-        *(b++) = *(a++) * (1.0f / (1U << (BIT_32 - 1)));
-    }
-}
-
-float CapMax(float v)
-{
-    float value = v;
-    if (v > 1.0f) {
-        value = 1.0f - FLOAT_EPS;
-    } else if (v < -1.0f) {
-        value = -1.0f + FLOAT_EPS;
-    }
-    return value;
+    AudioConvertS32ToF32(a, b, n);
 }
 
 void ConvertFromFloatTo24Bit(unsigned n, const float *a, uint8_t *b)
 {
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1U << (BIT_32 - 1));
-        Write24Bit(b, (static_cast<int32_t>(v)) >> BIT_8);
-        b += OFFSET_BIT_24;
-    }
+    AudioConvertF32ToS24(a, b, n, nullptr);
 }
 
 void ConvertFromFloatTo32Bit(unsigned n, const float *a, int32_t *b)
 {
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1U << (BIT_32 - 1));
-        *(b++) = static_cast<int32_t>(v);
-    }
+    AudioConvertF32ToS32(a, b, n);
 }
 
 float UpdateMaxAmplitude(ConvertHdiFormat adapterFormat, char *frame, uint64_t replyBytes)
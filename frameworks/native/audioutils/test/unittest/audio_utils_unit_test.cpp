@@ -13,9 +13,12 @@
  * limitations under the License.
  */
 
+#include <limits>
 #include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include "audio_utils.h"
+#include "audio_format_convert.h"
 
 using namespace testing::ext;
 using namespace std;
@@ -565,6 +568,128 @@ HWTEST(AudioUtilsUnitTest, CalculateMaxAmplitudeForPCM32Bit_005, TestSize.Level0
     EXPECT_NEAR(result, 0.875, 0.1);
 }
 
+/**
+* @tc.name  : Test AudioConvertF32ToS16 API
+* @tc.type  : FUNC
+* @tc.number: AudioFormatConvert_001
+* @tc.desc  : Test every kernel set gives the same samples as the scalar one, in and out of range
+*/
+HWTEST(AudioUtilsUnitTest, AudioFormatConvert_001, TestSize.Level1)
+{
+    size_t count = 963; // not aligned with any vector width
+    std::vector<float> input(count);
+    for (size_t i = 0; i < count; i++) {
+        input[i] = static_cast<float>(static_cast<int32_t>(i * 7919 % 2600) - 1300) / 1000; // -1.3 to 1.3
+    }
+    input[0] = 1.0f;
+    input[1] = -1.0f;
+
+    AudioConvertIsa defaultIsa = AudioConvertGetIsa();
+    EXPECT_TRUE(AudioConvertSetIsa(AUDIO_CONVERT_ISA_SCALAR));
+    std::vector<int16_t> s16(count);
+    std::vector<uint8_t> s24(count * 3); // 3 bytes for each sample
+    std::vector<int32_t> s32(count);
+    std::vector<float> sum(input);
+    AudioConvertF32ToS16(input.data(), s16.data(), count, nullptr);
+    AudioConvertF32ToS24(input.data(), s24.data(), count, nullptr);
+    AudioConvertF32ToS32(input.data(), s32.data(), count);
+    AudioAccumulateS16ToF32(s16.data(), sum.data(), count);
+    AudioAccumulateS24ToF32(s24.data(), sum.data(), count);
+    AudioAccumulateS32ToF32(s32.data(), sum.data(), count);
+    EXPECT_EQ(s16[0], INT16_MAX);
+    EXPECT_EQ(s16[1], INT16_MIN);
+    EXPECT_EQ(s32[0], INT32_MAX);
+    EXPECT_EQ(s32[1], INT32_MIN);
+
+    AudioConvertIsa isaList[] = { AUDIO_CONVERT_ISA_NEON, AUDIO_CONVERT_ISA_SSE41 };
+    for (AudioConvertIsa isa : isaList) {
+        if (!AudioConvertSetIsa(isa)) {
+            continue;
+        }
+        std::vector<int16_t> outS16(count);
+        std::vector<uint8_t> outS24(count * 3); // 3 bytes for each sample
+        std::vector<int32_t> outS32(count);
+        std::vector<float> outSum(input);
+        AudioConvertF32ToS16(input.data(), outS16.data(), count, nullptr);
+        AudioConvertF32ToS24(input.data(), outS24.data(), count, nullptr);
+        AudioConvertF32ToS32(input.data(), outS32.data(), count);
+        AudioAccumulateS16ToF32(outS16.data(), outSum.data(), count);
+        AudioAccumulateS24ToF32(outS24.data(), outSum.data(), count);
+        AudioAccumulateS32ToF32(outS32.data(), outSum.data(), count);
+        EXPECT_EQ(s16, outS16);
+        EXPECT_EQ(s24, outS24);
+        EXPECT_EQ(s32, outS32);
+        EXPECT_EQ(sum, outSum);
+    }
+    EXPECT_TRUE(AudioConvertSetIsa(defaultIsa));
+}
+
+/**
+* @tc.name  : Test AudioConvertS24ToF32 API
+* @tc.type  : FUNC
+* @tc.number: AudioFormatConvert_002
+* @tc.desc  : Test packed 24 bit round trip and the dithered conversion
+*/
+HWTEST(AudioUtilsUnitTest, AudioFormatConvert_002, TestSize.Level1)
+{
+    const size_t count = 480;
+    std::vector<uint8_t> s24(count * 3); // 3 bytes for each sample
+    for (size_t i = 0; i < s24.size(); i++) {
+        s24[i] = static_cast<uint8_t>(i * 31);
+    }
+    std::vector<float> samples(count);
+    std::vector<uint8_t> output(count * 3); // 3 bytes for each sample
+    AudioConvertS24ToF32(s24.data(), samples.data(), count);
+    AudioConvertF32ToS24(samples.data(), output.data(), count, nullptr);
+    EXPECT_EQ(s24, output);
+
+    // a quarter lsb is lost by truncation, the dither keeps it in the mean
+    std::vector<float> quarter(count, 0.25f / 32768);
+    std::vector<int16_t> dithered(count);
+    uint32_t seed = 1;
+    AudioConvertF32ToS16(quarter.data(), dithered.data(), count, &seed);
+    float mean = 0.0f;
+    for (int16_t sample : dithered) {
+        EXPECT_TRUE(sample >= -1 && sample <= 1);
+        mean += sample;
+    }
+    EXPECT_NEAR(mean / count, 0.25f, 0.1f);
+}
+
+/**
+* @tc.name  : Test AudioConvertF32ToS16 API
+* @tc.type  : FUNC
+* @tc.number: AudioFormatConvert_003
+* @tc.desc  : Test every kernel set converts NaN as 0.0, the same as the scalar one
+*/
+HWTEST(AudioUtilsUnitTest, AudioFormatConvert_003, TestSize.Level1)
+{
+    const size_t count = 19; // covers the vector loops and the scalar tail
+    std::vector<float> input(count, std::numeric_limits<float>::quiet_NaN());
+    input[1] = -std::numeric_limits<float>::quiet_NaN();
+    AudioConvertIsa defaultIsa = AudioConvertGetIsa();
+    AudioConvertIsa isaList[] = { AUDIO_CONVERT_ISA_SCALAR, AUDIO_CONVERT_ISA_NEON, AUDIO_CONVERT_ISA_SSE41 };
+    for (AudioConvertIsa isa : isaList) {
+        if (!AudioConvertSetIsa(isa)) {
+            continue;
+        }
+        std::vector<int16_t> s16(count);
+        std::vector<uint8_t> s24(count * 3); // 3 bytes for each sample
+        std::vector<int32_t> s32(count);
+        std::vector<float> back(count);
+        AudioConvertF32ToS16(input.data(), s16.data(), count, nullptr);
+        AudioConvertF32ToS24(input.data(), s24.data(), count, nullptr);
+        AudioConvertF32ToS32(input.data(), s32.data(), count);
+        AudioConvertS24ToF32(s24.data(), back.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(0, s16[i]) << "isa " << isa << " at " << i;
+            EXPECT_EQ(0, s32[i]) << "isa " << isa << " at " << i;
+            EXPECT_EQ(0.0f, back[i]) << "isa " << isa << " at " << i;
+        }
+    }
+    AudioConvertSetIsa(defaultIsa);
+}
+
 /**
 * @tc.name  : Test GetFormatByteSize API
 * @tc.type  : FUNC
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_CAPTURE_FANOUT_RING_H
+#define AUDIO_CAPTURE_FANOUT_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace OHOS {
+namespace AudioStandard {
+/**
+ * Capture history shared by the readers of one capture. A single writer appends the captured bytes, the position of
+ * a byte is its index since the ring was created. Each reader keeps its own cursor and never blocks the writer nor
+ * the other readers: the oldest bytes are overwritten, and a reader left behind skips to the oldest bytes still in
+ * the ring and counts an overrun. The data path is lock free, like a seqlock the reader checks after using the bytes
+ * that the writer has not started to overwrite them. The mutex is only there to put the waiting readers to sleep.
+ */
+class AudioCaptureFanoutRing {
+public:
+    // The bytes [pos, pos + firstSize + secondSize) of the ring, in place.
+    struct View {
+        uint64_t pos = 0;
+        const char *first = nullptr;
+        size_t firstSize = 0;
+        const char *second = nullptr;
+        size_t secondSize = 0;
+    };
+
+    explicit AudioCaptureFanoutRing(size_t capacity)
+        : capacity_(capacity), buffer_(std::make_unique<char[]>(capacity))
+    {
+    }
+
+    size_t GetCapacity() const
+    {
+        return capacity_;
+    }
+
+    // The position of the next byte to be written.
+    uint64_t GetWritePos() const
+    {
+        return writePos_.load();
+    }
+
+    uint64_t GetOldestPos() const
+    {
+        uint64_t writeEnd = writeEnd_.load(std::memory_order_acquire);
+        return writeEnd > capacity_ ? writeEnd - capacity_ : 0;
+    }
+
+    // Only called by the writer.
+    void Write(const char *data, size_t size)
+    {
+        uint64_t end = writePos_.load(std::memory_order_relaxed) + size;
+        if (size > capacity_) {
+            data += size - capacity_;
+            size = capacity_;
+        }
+        // announce the bytes about to be overwritten before touching them
+        writeEnd_.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        size_t offset = (end - size) % capacity_;
+        size_t firstSize = std::min(size, capacity_ - offset);
+        std::copy(data, data + firstSize, buffer_.get() + offset);
+        std::copy(data + firstSize, data + size, buffer_.get());
+
+        writePos_.store(end);
+        if (waiters_.load() > 0) {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            waitCv_.notify_all();
+        }
+    }
+
+    // Wake up the waiting readers, no more bytes are coming until Open.
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        closed_ = true;
+        waitCv_.notify_all();
+    }
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        closed_ = false;
+    }
+
+    // Wait until size bytes from cursor are written, return false on timeout or if the ring is closed.
+    bool WaitFor(uint64_t cursor, size_t size, std::chrono::milliseconds timeout)
+    {
+        uint64_t target = cursor + std::min(size, capacity_);
+        if (writePos_.load() >= target) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        waiters_++;
+        bool ready = waitCv_.wait_for(lock, timeout, [this, target] {
+            return closed_ || writePos_.load() >= target;
+        });
+        waiters_--;
+        return ready && writePos_.load() >= target;
+    }
+
+    // Zero copy read of up to size bytes from cursor. Overruns counts the times the cursor was left behind. The view
+    // is only usable while IsValid returns true, the cursor is advanced by Consume.
+    View Peek(uint64_t &cursor, size_t size, uint64_t &overruns) const
+    {
+        uint64_t writePos = writePos_.load(std::memory_order_acquire);
+        uint64_t oldest = GetOldestPos();
+        if (cursor < oldest) {
+            cursor = oldest;
+            overruns++;
+        }
+        View view;
+        view.pos = cursor;
+        size_t available = writePos > cursor ? static_cast<size_t>(writePos - cursor) : 0;
+        size = std::min(size, available);
+        size_t offset = cursor % capacity_;
+        view.first = buffer_.get() + offset;
+        view.firstSize = std::min(size, capacity_ - offset);
+        view.second = buffer_.get();
+        view.secondSize = size - view.firstSize;
+        return view;
+    }
+
+    // True if the bytes of the view have not been overwritten since Peek.
+    bool IsValid(const View &view) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t writeEnd = writeEnd_.load(std::memory_order_relaxed);
+        return writeEnd <= capacity_ || view.pos >= writeEnd - capacity_;
+    }
+
+    static void Consume(uint64_t &cursor, const View &view)
+    {
+        cursor = view.pos + view.firstSize + view.secondSize;
+    }
+
+    // Copy up to size bytes from cursor and advance it, return the number of bytes copied.
+    size_t Read(uint64_t &cursor, char *dst, size_t size, uint64_t &overruns) const
+    {
+        while (true) {
+            View view = Peek(cursor, size, overruns);
+            std::copy(view.first, view.first + view.firstSize, dst);
+            std::copy(view.second, view.second + view.secondSize, dst + view.firstSize);
+            if (IsValid(view)) {
+                Consume(cursor, view);
+                return view.firstSize + view.secondSize;
+            }
+            // overwritten while copying, retry from the oldest bytes
+        }
+    }
+
+private:
+    const size_t capacity_;
+    std::unique_ptr<char[]> buffer_;
+    std::atomic<uint64_t> writePos_ = 0; // all the bytes before are written
+    std::atomic<uint64_t> writeEnd_ = 0; // the bytes before may be being written
+
+    std::mutex waitMutex_;
+    std::condition_variable waitCv_;
+    std::atomic<uint32_t> waiters_ = 0;
+    bool closed_ = false;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_CAPTURE_FANOUT_RING_H
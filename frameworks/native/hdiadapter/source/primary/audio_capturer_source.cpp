@@ -20,6 +20,7 @@
 
 #include <cstring>
 #include <dlfcn.h>
+#include <unistd.h>
 #include <string>
 #include <cinttypes>
 #include <thread>
@@ -33,8 +34,10 @@
 #endif
 #include "v4_0/iaudio_manager.h"
 
+#include "audio_capture_fanout_ring.h"
 #include "audio_hdi_log.h"
 #include "audio_errors.h"
+#include "audio_schedule.h"
 #include "audio_utils.h"
 #include "parameters.h"
 #include "media_monitor_manager.h"
@@ -199,124 +202,29 @@ public:
     ~AudioCapturerSourceWakeup() = default;
 
 private:
-    static inline void MemcpysAndCheck(void *dest, size_t destMax, const void *src, size_t count)
-    {
-        if (memcpy_s(dest, destMax, src, count)) {
-            AUDIO_ERR_LOG("memcpy_s error");
-        }
-    }
-    class WakeupBuffer {
-    public:
-        explicit WakeupBuffer(size_t sizeMax = BUFFER_SIZE_MAX)
-            : sizeMax_(sizeMax),
-              buffer_(std::make_unique<char[]>(sizeMax))
-        {
-        }
-
-        ~WakeupBuffer() = default;
-
-        int32_t Poll(char *frame, uint64_t requestBytes, uint64_t &replyBytes, uint64_t &noStart)
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-
-            if (noStart < headNum_) {
-                noStart = headNum_;
-            }
-
-            if (noStart >= (headNum_ + size_)) {
-                if (requestBytes > sizeMax_) {
-                    requestBytes = sizeMax_;
-                }
-
-                int32_t res = audioCapturerSource_.CaptureFrame(frame, requestBytes, replyBytes);
-                Offer(frame, replyBytes);
-
-                return res;
-            }
-
-            if (requestBytes > size_) { // size_!=0
-                replyBytes = size_;
-            } else {
-                replyBytes = requestBytes;
-            }
-
-            uint64_t tail = (head_ + size_) % sizeMax_;
-
-            if (tail > head_) {
-                MemcpysAndCheck(frame, replyBytes, buffer_.get() + head_, replyBytes);
-                headNum_ += replyBytes;
-                size_ -= replyBytes;
-                head_ = (head_ + replyBytes) % sizeMax_;
-            } else {
-                uint64_t copySize = min((sizeMax_ - head_), replyBytes);
-                if (copySize != 0) {
-                    MemcpysAndCheck(frame, replyBytes, buffer_.get() + head_, copySize);
-                    headNum_ += copySize;
-                    size_ -= copySize;
-                    head_ = (head_ + copySize) % sizeMax_;
-                }
-
-                uint64_t remainCopySize = replyBytes - copySize;
-                if (remainCopySize != 0) {
-                    MemcpysAndCheck(frame + copySize, remainCopySize, buffer_.get(), remainCopySize);
-                    headNum_ += remainCopySize;
-                    size_ -= remainCopySize;
-                    head_ = (head_ + remainCopySize) % sizeMax_;
-                }
-            }
-
-            return SUCCESS;
-        }
-    private:
-        static constexpr size_t BUFFER_SIZE_MAX = 32000; // 2 seconds
-
-        const size_t sizeMax_;
-        size_t size_ = 0;
-
-        std::unique_ptr<char[]> buffer_;
-        std::mutex mutex_;
-
-        uint64_t head_ = 0;
-
-        uint64_t headNum_ = 0;
-
-        void Offer(const char *frame, const uint64_t bufferBytes)
-        {
-            if ((size_ + bufferBytes) > sizeMax_) { // head_ need shift
-                u_int64_t shift = (size_ + bufferBytes) - sizeMax_; // 1 to sizeMax_
-                headNum_ += shift;
-                if (size_ > shift) {
-                    size_ -= shift;
-                    head_ = ((head_ + shift) % sizeMax_);
-                } else {
-                    size_ = 0;
-                    head_ = 0;
-                }
-            }
-
-            uint64_t tail = (head_ + size_) % sizeMax_;
-            if (tail < head_) {
-                MemcpysAndCheck((buffer_.get() + tail), bufferBytes, frame, bufferBytes);
-            } else {
-                uint64_t copySize = min(sizeMax_ - tail, bufferBytes);
-                MemcpysAndCheck((buffer_.get() + tail), sizeMax_ - tail, frame, copySize);
-
-                if (copySize < bufferBytes) {
-                    MemcpysAndCheck((buffer_.get()), bufferBytes - copySize, frame + copySize, bufferBytes - copySize);
-                }
-            }
-            size_ += bufferBytes;
-        }
-    };
-
-    uint64_t noStart_ = 0;
+    static void CaptureLoop(std::shared_ptr<AudioCaptureFanoutRing> ring, size_t chunkSize);
+    static std::shared_ptr<AudioCaptureFanoutRing> GetCaptureRing();
+    static int32_t StartCaptureThread();
+    static void StopCaptureThread();
+
+    static constexpr size_t CAPTURE_RING_SIZE = 32000; // 2 seconds
+    static constexpr size_t CAPTURE_CHUNK_SIZE_DEFAULT = 640; // 20ms
+    static constexpr int32_t CAPTURE_WAIT_TIMEOUT_MS = 1000;
+    static constexpr int32_t CAPTURE_RETRY_SLEEP_MS = 10;
+
+    uint64_t noStart_ = 0; // the cursor of this reader in the capture ring
+    uint64_t overruns_ = 0;
     std::atomic<bool> isInited = false;
     static inline int initCount = 0;
 
     std::atomic<bool> isStarted = false;
     static inline int startCount = 0;
 
-    static inline std::unique_ptr<WakeupBuffer> wakeupBuffer_;
+    // The capture is read by one thread into the ring, each wakeup source reads the ring at its own cursor.
+    static inline std::shared_ptr<AudioCaptureFanoutRing> captureRing_;
+    static inline size_t captureChunkSize_ = CAPTURE_CHUNK_SIZE_DEFAULT;
+    static inline std::thread captureThread_;
+    static inline std::atomic<bool> captureRunning_ = false;
     static inline std::mutex wakeupMutex_;
 
     static inline AudioCapturerSourceInner audioCapturerSource_;
@@ -1281,13 +1189,17 @@ int32_t AudioCapturerSourceWakeup::Init(const IAudioSourceAttr &attr)
     if (isInited) {
         return res;
     }
-    noStart_ = 0;
     if (initCount == 0) {
-        if (wakeupBuffer_ == nullptr) {
-            wakeupBuffer_ = std::make_unique<WakeupBuffer>();
+        if (captureRing_ == nullptr) {
+            captureRing_ = std::make_shared<AudioCaptureFanoutRing>(CAPTURE_RING_SIZE);
         }
+        captureChunkSize_ = attr.bufferSize > 0 ? std::min<size_t>(attr.bufferSize, CAPTURE_RING_SIZE / 2) :
+            CAPTURE_CHUNK_SIZE_DEFAULT;
         res = audioCapturerSource_.Init(attr);
     }
+    // a new reader starts with the history kept in the ring
+    noStart_ = captureRing_->GetOldestPos();
+    overruns_ = 0;
     if (res == SUCCESS) {
         isInited = true;
         initCount++;
@@ -1311,9 +1223,13 @@ void AudioCapturerSourceWakeup::DeInit(void)
     isInited = false;
     initCount--;
     if (initCount == 0) {
-        wakeupBuffer_.reset();
+        StopCaptureThread();
+        captureRing_.reset();
         audioCapturerSource_.DeInit();
     }
+    if (overruns_ > 0) {
+        AUDIO_WARNING_LOG("reader left behind %{public}" PRIu64 " times", overruns_);
+    }
 }
 
 int32_t AudioCapturerSourceWakeup::Start(void)
@@ -1325,6 +1241,13 @@ int32_t AudioCapturerSourceWakeup::Start(void)
     }
     if (startCount == 0) {
         res = audioCapturerSource_.Start();
+        if (res == SUCCESS) {
+            res = StartCaptureThread();
+            if (res != SUCCESS) {
+                AUDIO_ERR_LOG("start capture thread failed, stop the source");
+                audioCapturerSource_.Stop();
+            }
+        }
     }
     if (res == SUCCESS) {
         isStarted = true;
@@ -1341,7 +1264,12 @@ int32_t AudioCapturerSourceWakeup::Stop(void)
         return res;
     }
     if (startCount == 1) {
+        StopCaptureThread();
         res = audioCapturerSource_.Stop();
+        if (res != SUCCESS && StartCaptureThread() != SUCCESS) {
+            AUDIO_ERR_LOG("restart capture thread failed, stop the source");
+            audioCapturerSource_.Stop();
+        }
     }
     if (res == SUCCESS) {
         isStarted = false;
@@ -1370,11 +1298,68 @@ int32_t AudioCapturerSourceWakeup::Resume(void)
     return audioCapturerSource_.Resume();
 }
 
+std::shared_ptr<AudioCaptureFanoutRing> AudioCapturerSourceWakeup::GetCaptureRing()
+{
+    std::lock_guard<std::mutex> lock(wakeupMutex_);
+    return captureRing_;
+}
+
+int32_t AudioCapturerSourceWakeup::StartCaptureThread()
+{
+    CHECK_AND_RETURN_RET_LOG(captureRing_ != nullptr, ERR_ILLEGAL_STATE, "capture ring is not inited");
+    captureRing_->Open();
+    captureRunning_ = true;
+    captureThread_ = std::thread(&AudioCapturerSourceWakeup::CaptureLoop, captureRing_, captureChunkSize_);
+    pthread_setname_np(captureThread_.native_handle(), "OS_WakeupCapture");
+    return SUCCESS;
+}
+
+void AudioCapturerSourceWakeup::StopCaptureThread()
+{
+    captureRunning_ = false;
+    if (captureThread_.joinable()) {
+        captureThread_.join();
+    }
+    if (captureRing_ != nullptr) {
+        captureRing_->Close();
+    }
+}
+
+void AudioCapturerSourceWakeup::CaptureLoop(std::shared_ptr<AudioCaptureFanoutRing> ring, size_t chunkSize)
+{
+    AUDIO_INFO_LOG("capture %{public}zu bytes per read", chunkSize);
+    // scheduled as the render threads are, every wakeup reader waits on it
+    ScheduleThreadInServer(getpid(), gettid());
+    std::unique_ptr<char[]> chunk = std::make_unique<char[]>(chunkSize);
+    while (captureRunning_) {
+        uint64_t replyBytes = 0;
+        int32_t ret = audioCapturerSource_.CaptureFrame(chunk.get(), chunkSize, replyBytes);
+        if (ret != SUCCESS) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(CAPTURE_RETRY_SLEEP_MS));
+            continue;
+        }
+        ring->Write(chunk.get(), std::min<uint64_t>(replyBytes, chunkSize));
+    }
+    UnscheduleThreadInServer(getpid(), gettid());
+}
+
 int32_t AudioCapturerSourceWakeup::CaptureFrame(char *frame, uint64_t requestBytes, uint64_t &replyBytes)
 {
-    int32_t res = wakeupBuffer_->Poll(frame, requestBytes, replyBytes, noStart_);
-    noStart_ += replyBytes;
-    return res;
+    replyBytes = 0;
+    std::shared_ptr<AudioCaptureFanoutRing> ring = GetCaptureRing();
+    CHECK_AND_RETURN_RET_LOG(ring != nullptr, ERR_ILLEGAL_STATE, "capture ring is not inited");
+
+    size_t size = std::min<uint64_t>(requestBytes, ring->GetCapacity());
+    CHECK_AND_RETURN_RET_LOG(ring->WaitFor(noStart_, size, std::chrono::milliseconds(CAPTURE_WAIT_TIMEOUT_MS)),
+        ERR_READ_FAILED, "no capture data");
+
+    uint64_t overruns = overruns_;
+    replyBytes = ring->Read(noStart_, frame, size, overruns);
+    if (overruns != overruns_) {
+        AUDIO_WARNING_LOG("reader left behind, skip to the oldest data");
+        overruns_ = overruns;
+    }
+    return SUCCESS;
 }
 
 int32_t AudioCapturerSourceWakeup::SetVolume(float left, float right)
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_capture_fanout_ring_unit_test.h"
+
+#include <thread>
+#include <vector>
+
+#include "audio_capture_fanout_ring.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr size_t RING_SIZE = 64;
+constexpr size_t CHUNK_SIZE = 16;
+constexpr int32_t WAIT_TIMEOUT_MS = 1000;
+
+// byte i of the capture is i % 251, so that a reader can check where its bytes come from
+void FillChunk(vector<char> &chunk, uint64_t pos)
+{
+    for (size_t i = 0; i < chunk.size(); i++) {
+        chunk[i] = static_cast<char>((pos + i) % 251);
+    }
+}
+
+bool CheckBytes(const char *data, size_t size, uint64_t pos)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != static_cast<char>((pos + i) % 251)) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+void AudioCaptureFanoutRingUnitTest::SetUpTestCase(void) {}
+void AudioCaptureFanoutRingUnitTest::TearDownTestCase(void) {}
+void AudioCaptureFanoutRingUnitTest::SetUp(void) {}
+void AudioCaptureFanoutRingUnitTest::TearDown(void) {}
+
+/**
+ * @tc.name  : Test AudioCaptureFanoutRing
+ * @tc.number: Audio_Capture_Fanout_Ring_001
+ * @tc.desc  : Test two readers reading the same bytes at their own cursors
+ */
+HWTEST(AudioCaptureFanoutRingUnitTest, AudioCaptureFanoutRingUnitTest_001, TestSize.Level1)
+{
+    AudioCaptureFanoutRing ring(RING_SIZE);
+    vector<char> chunk(CHUNK_SIZE);
+    FillChunk(chunk, 0);
+    ring.Write(chunk.data(), chunk.size());
+    EXPECT_EQ(CHUNK_SIZE, ring.GetWritePos());
+
+    uint64_t cursorA = 0;
+    uint64_t cursorB = 0;
+    uint64_t overruns = 0;
+    char out[CHUNK_SIZE] = {};
+    EXPECT_EQ(CHUNK_SIZE / 2, ring.Read(cursorA, out, CHUNK_SIZE / 2, overruns));
+    EXPECT_TRUE(CheckBytes(out, CHUNK_SIZE / 2, 0));
+    EXPECT_EQ(CHUNK_SIZE, ring.Read(cursorB, out, CHUNK_SIZE, overruns));
+    EXPECT_TRUE(CheckBytes(out, CHUNK_SIZE, 0));
+    EXPECT_EQ(CHUNK_SIZE / 2, ring.Read(cursorA, out, CHUNK_SIZE, overruns));
+    EXPECT_TRUE(CheckBytes(out, CHUNK_SIZE / 2, CHUNK_SIZE / 2));
+    EXPECT_EQ(0, ring.Read(cursorA, out, CHUNK_SIZE, overruns));
+    EXPECT_EQ(0, overruns);
+}
+
+/**
+ * @tc.name  : Test AudioCaptureFanoutRing
+ * @tc.number: Audio_Capture_Fanout_Ring_002
+ * @tc.desc  : Test a reader left behind skips to the oldest bytes and counts an overrun
+ */
+HWTEST(AudioCaptureFanoutRingUnitTest, AudioCaptureFanoutRingUnitTest_002, TestSize.Level1)
+{
+    AudioCaptureFanoutRing ring(RING_SIZE);
+    vector<char> chunk(CHUNK_SIZE);
+    uint64_t pos = 0;
+    for (size_t i = 0; i < RING_SIZE / CHUNK_SIZE + 2; i++) {
+        FillChunk(chunk, pos);
+        ring.Write(chunk.data(), chunk.size());
+        pos += CHUNK_SIZE;
+    }
+    EXPECT_EQ(pos - RING_SIZE, ring.GetOldestPos());
+
+    uint64_t cursor = 0;
+    uint64_t overruns = 0;
+    char out[RING_SIZE] = {};
+    EXPECT_EQ(RING_SIZE, ring.Read(cursor, out, RING_SIZE, overruns));
+    EXPECT_EQ(1, overruns);
+    EXPECT_TRUE(CheckBytes(out, RING_SIZE, pos - RING_SIZE));
+    EXPECT_EQ(pos, cursor);
+
+    // a write larger than the ring keeps its last bytes
+    vector<char> large(RING_SIZE + CHUNK_SIZE);
+    FillChunk(large, pos);
+    ring.Write(large.data(), large.size());
+    pos += large.size();
+    EXPECT_EQ(RING_SIZE, ring.Read(cursor, out, RING_SIZE, overruns));
+    EXPECT_EQ(2, overruns);
+    EXPECT_TRUE(CheckBytes(out, RING_SIZE, pos - RING_SIZE));
+}
+
+/**
+ * @tc.name  : Test AudioCaptureFanoutRing
+ * @tc.number: Audio_Capture_Fanout_Ring_003
+ * @tc.desc  : Test the zero copy view wrapping around the end of the ring
+ */
+HWTEST(AudioCaptureFanoutRingUnitTest, AudioCaptureFanoutRingUnitTest_003, TestSize.Level1)
+{
+    AudioCaptureFanoutRing ring(RING_SIZE);
+    vector<char> chunk(RING_SIZE - CHUNK_SIZE);
+    FillChunk(chunk, 0);
+    ring.Write(chunk.data(), chunk.size());
+    uint64_t cursor = chunk.size() - CHUNK_SIZE;
+    FillChunk(chunk, chunk.size());
+    ring.Write(chunk.data(), CHUNK_SIZE * 2);
+
+    uint64_t overruns = 0;
+    AudioCaptureFanoutRing::View view = ring.Peek(cursor, CHUNK_SIZE * 3, overruns);
+    EXPECT_EQ(CHUNK_SIZE * 2, view.firstSize);
+    EXPECT_EQ(CHUNK_SIZE, view.secondSize);
+    EXPECT_TRUE(CheckBytes(view.first, view.firstSize, cursor));
+    EXPECT_TRUE(CheckBytes(view.second, view.secondSize, cursor + view.firstSize));
+    EXPECT_TRUE(ring.IsValid(view));
+
+    // the ring is full, the next byte written overwrites the first byte of the view
+    ring.Write(chunk.data(), CHUNK_SIZE);
+    EXPECT_TRUE(ring.IsValid(view));
+    ring.Write(chunk.data(), 1);
+    EXPECT_FALSE(ring.IsValid(view));
+}
+
+/**
+ * @tc.name  : Test AudioCaptureFanoutRing
+ * @tc.number: Audio_Capture_Fanout_Ring_004
+ * @tc.desc  : Test readers waiting for the writer thread, and woken up by Close
+ */
+HWTEST(AudioCaptureFanoutRingUnitTest, AudioCaptureFanoutRingUnitTest_004, TestSize.Level1)
+{
+    constexpr size_t totalSize = RING_SIZE * 8;
+    AudioCaptureFanoutRing ring(RING_SIZE);
+    std::thread writer([&ring] {
+        vector<char> chunk(CHUNK_SIZE);
+        for (uint64_t pos = 0; pos < totalSize; pos += CHUNK_SIZE) {
+            FillChunk(chunk, pos);
+            ring.Write(chunk.data(), chunk.size());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    uint64_t cursor = 0;
+    uint64_t overruns = 0;
+    char out[CHUNK_SIZE] = {};
+    bool bytesOk = true;
+    while (cursor < totalSize) {
+        ASSERT_TRUE(ring.WaitFor(cursor, CHUNK_SIZE, std::chrono::milliseconds(WAIT_TIMEOUT_MS)));
+        uint64_t pos = cursor;
+        size_t size = ring.Read(cursor, out, CHUNK_SIZE, overruns);
+        bytesOk = bytesOk && CheckBytes(out, size, cursor - size);
+        EXPECT_GE(cursor, pos + size);
+    }
+    writer.join();
+    EXPECT_TRUE(bytesOk);
+
+    ring.Close();
+    EXPECT_FALSE(ring.WaitFor(cursor, CHUNK_SIZE, std::chrono::milliseconds(WAIT_TIMEOUT_MS)));
+}
+} // namespace AudioStandard
+} // namespace OHOS
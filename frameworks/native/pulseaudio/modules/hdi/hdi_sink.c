@@ -47,6 +47,7 @@
 #include "audio_hdi_log.h"
 #include "audio_schedule.h"
 #include "audio_utils_c.h"
+#include "audio_format_convert.h"
 #include "audio_hdiadapter_info.h"
 #include "volume_tools_c.h"
 #include "renderer_sink_adapter.h"
@@ -67,9 +68,13 @@
 #define DEFAULT_IN_CHANNEL_NUM 2
 #define PRIMARY_CHANNEL_NUM 2
 #define IN_CHANNEL_NUM_MAX 16
-#define OUT_CHANNEL_NUM_MAX 2
 #define DEFAULT_FRAMELEN 2048
+#define RENDER_BLOCK_NUM 3 // one being rendered, one queued to the hdi write thread and one being written
 #define SCENE_TYPE_NUM 7
+#define SCENE_MODE_NUM 3
+#define SCENE_ROUTE_NUM (SCENE_TYPE_NUM + 1) // the last route is for inputs with an unknown scene type
+#define SPATIALIZATION_STATE_NUM 2
+#define INPUT_ROUTE_CACHE_SIZE 64
 #define HDI_MIN_MS_MAINTAIN 30
 #define OFFLOAD_HDI_CACHE1 200 // ms, should equal with val in client
 #define OFFLOAD_HDI_CACHE2 7000 // ms, should equal with val in client
@@ -119,6 +124,8 @@ bool g_effectHaveDisabledMap[SCENE_TYPE_NUM] = {false, false, false, false, fals
 time_t g_effectStartVolZeroTimeMap[SCENE_TYPE_NUM] = {0, 0, 0, 0, 0, 0, 0};
 char *const SCENE_TYPE_SET[SCENE_TYPE_NUM] = {"SCENE_MUSIC", "SCENE_GAME", "SCENE_MOVIE", "SCENE_SPEECH", "SCENE_RING",
     "SCENE_OTHERS", "EFFECT_NONE"};
+// the last one stands for any other mode, no effect chain key is built with it
+char *const SCENE_MODE_SET[SCENE_MODE_NUM] = {"EFFECT_NONE", "EFFECT_DEFAULT", ""};
 const int32_t COMMON_SCENE_TYPE_INDEX = 0;
 
 enum HdiInputType { HDI_INPUT_TYPE_PRIMARY, HDI_INPUT_TYPE_OFFLOAD, HDI_INPUT_TYPE_MULTICHANNEL };
@@ -151,6 +158,28 @@ enum AudioOffloadType {
     OFFLOAD_INACTIVE_BACKGROUND = 3,
 };
 
+// Scene properties of a sink input as route table indexes, refreshed when the route generation changes.
+struct InputRoute {
+    bool valid;
+    uint32_t index; // sink input index
+    uint32_t generation;
+    int32_t sceneId; // index in SCENE_TYPE_SET, SCENE_TYPE_NUM for an unknown scene type
+    int32_t modeId; // index in SCENE_MODE_SET
+    int32_t spatializationId; // 0 if spatialization.enabled is "0", else 1
+    bool clientVolumeIsZero;
+};
+
+// EffectChainManagerExist and EffectChainManagerSceneCheck of all scenes, built once per route generation so that
+// the primary render loop looks them up by index instead of querying the effect chain manager for each input.
+struct EffectRoute {
+    bool built;
+    uint32_t generation;
+    bool effectOffload;
+    bool exist[SCENE_ROUTE_NUM][SCENE_MODE_NUM][SPATIALIZATION_STATE_NUM];
+    bool sceneMatch[SCENE_ROUTE_NUM][SCENE_TYPE_NUM]; // [scene of the input][scene being rendered]
+    struct InputRoute inputs[INPUT_ROUTE_CACHE_SIZE]; // direct mapped by sink input index
+};
+
 struct Userdata {
     const char *adapterName;
     uint32_t buffer_size;
@@ -160,6 +189,7 @@ struct Userdata {
     uint32_t open_mic_speaker;
     bool offload_enable;
     bool multichannel_enable;
+    bool effectParallel; // run the effect chains of the scenes in parallel
     const char *deviceNetworkId;
     int32_t deviceType;
     size_t bytes_dropped;
@@ -191,6 +221,12 @@ struct Userdata {
     int8_t spatializationFadingState; // for indicating the fading state, =0:no fading, >0:fading in, <0:fading out
     int8_t spatializationFadingCount; // for indicating the fading rate
     bool actualSpatializationEnabled; // the spatialization state that actually applies effect
+    struct EffectRoute effectRoute; // only used by the primary render thread
+    struct {
+        pa_sink_input *inputs[SCENE_TYPE_NUM][MAX_MIX_CHANNELS];
+        uint32_t inputNum[SCENE_TYPE_NUM];
+        BufferAttr bufferAttrs[SCENE_TYPE_NUM]; // bufIn and bufOut of each scene, allocated if effectParallel
+    } effectGroup;
     bool isFirstStarted;
     struct {
         int32_t sessionID;
@@ -227,6 +263,7 @@ struct Userdata {
         pa_atomic_t fadingFlagForPrimary; // 1：do fade in, 0: no need
         int32_t primaryFadingInDone;
         int32_t primarySinkInIndex;
+        pa_memblock *renderBlocks[RENDER_BLOCK_NUM]; // only used by the render thread
     } primary;
     struct {
         bool used;
@@ -248,6 +285,7 @@ struct Userdata {
         int32_t multiChannelFadingInDone;
         int32_t multiChannelSinkInIndex;
         int32_t multiChannelTmpSinkInIndex;
+        pa_memblock *renderBlocks[RENDER_BLOCK_NUM]; // only used by the render thread
     } multiChannel;
 };
 
@@ -271,92 +309,10 @@ static void StopPrimaryHdiIfNoRunning(struct Userdata *u);
 static void StartPrimaryHdiIfRunning(struct Userdata *u);
 static void StartMultiChannelHdiIfRunning(struct Userdata *u);
 static void CheckInputChangeToOffload(struct Userdata *u, pa_sink_input *i);
-static void CheckIfCommonSceneTypeZeroVolume();
+static void CheckIfCommonSceneTypeZeroVolume(struct Userdata *u);
 
 // BEGIN Utility functions
-#define FLOAT_EPS 1e-9f
 #define MEMBLOCKQ_MAXLENGTH (16*1024*16)
-#define OFFSET_BIT_24 3
-#define BIT_DEPTH_TWO 2
-#define BIT_8 8
-#define BIT_16 16
-#define BIT_24 24
-#define BIT_32 32
-static uint32_t Read24Bit(const uint8_t *p)
-{
-    return ((uint32_t) p[BIT_DEPTH_TWO] << BIT_16) | ((uint32_t) p[1] << BIT_8) | ((uint32_t) p[0]);
-}
-
-static void Write24Bit(uint8_t *p, uint32_t u)
-{
-    p[BIT_DEPTH_TWO] = (uint8_t) (u >> BIT_16);
-    p[1] = (uint8_t) (u >> BIT_8);
-    p[0] = (uint8_t) u;
-}
-
-static void ConvertFrom16BitToFloat(unsigned n, const int16_t *a, float *b)
-{
-    for (; n > 0; n--) {
-        *(b++) = *(a++) * (1.0f / (1 << (BIT_16 - 1)));
-    }
-}
-
-static void ConvertFrom24BitToFloat(unsigned n, const uint8_t *a, float *b)
-{
-    for (; n > 0; n--) {
-        int32_t s = Read24Bit(a) << BIT_8;
-        *b = s * (1.0f / (1U << (BIT_32 - 1)));
-        a += OFFSET_BIT_24;
-        b++;
-    }
-}
-
-static void ConvertFrom32BitToFloat(unsigned n, const int32_t *a, float *b)
-{
-    for (; n > 0; n--) {
-        *(b++) = *(a++) * (1.0f / (1U << (BIT_32 - 1)));
-    }
-}
-
-static float CapMax(float v)
-{
-    float value = v;
-    if (v > 1.0f) {
-        value = 1.0f - FLOAT_EPS;
-    } else if (v < -1.0f) {
-        value = -1.0f + FLOAT_EPS;
-    }
-    return value;
-}
-
-static void ConvertFromFloatTo16Bit(unsigned n, const float *a, int16_t *b)
-{
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1 << (BIT_16 - 1));
-        *(b++) = (int16_t) v;
-    }
-}
-
-static void ConvertFromFloatTo24Bit(unsigned n, const float *a, uint8_t *b)
-{
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1U << (BIT_32 - 1));
-        Write24Bit(b, ((int32_t) v) >> BIT_8);
-        b += OFFSET_BIT_24;
-    }
-}
-
-static void ConvertFromFloatTo32Bit(unsigned n, const float *a, int32_t *b)
-{
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1U << (BIT_32 - 1));
-        *(b++) = (int32_t) v;
-    }
-}
-
 static void ConvertToFloat(pa_sample_format_t format, unsigned n, void *src, float *dst)
 {
     pa_assert(src);
@@ -364,13 +320,13 @@ static void ConvertToFloat(pa_sample_format_t format, unsigned n, void *src, flo
     int32_t ret;
     switch (format) {
         case PA_SAMPLE_S16LE:
-            ConvertFrom16BitToFloat(n, src, dst);
+            AudioConvertS16ToF32(src, dst, n);
             break;
         case PA_SAMPLE_S24LE:
-            ConvertFrom24BitToFloat(n, src, dst);
+            AudioConvertS24ToF32(src, dst, n);
             break;
         case PA_SAMPLE_S32LE:
-            ConvertFrom32BitToFloat(n, src, dst);
+            AudioConvertS32ToF32(src, dst, n);
             break;
         default:
             ret = memcpy_s(dst, n, src, n);
@@ -391,13 +347,13 @@ static void ConvertFromFloat(pa_sample_format_t format, unsigned n, float *src,
     int32_t ret;
     switch (format) {
         case PA_SAMPLE_S16LE:
-            ConvertFromFloatTo16Bit(n, src, dst);
+            AudioConvertF32ToS16(src, dst, n, NULL);
             break;
         case PA_SAMPLE_S24LE:
-            ConvertFromFloatTo24Bit(n, src, dst);
+            AudioConvertF32ToS24(src, dst, n, NULL);
             break;
         case PA_SAMPLE_S32LE:
-            ConvertFromFloatTo32Bit(n, src, dst);
+            AudioConvertF32ToS32(src, dst, n);
             break;
         default:
             ret = memcpy_s(dst, n, src, n);
@@ -1227,6 +1183,162 @@ static void RecordEffectChainStatus(bool existFlag, const char *sinkSceneType, c
     }
 }
 
+static int32_t GetSetIndex(char *const *set, int32_t num, const char *value, int32_t notFound)
+{
+    for (int32_t i = 0; i < num; i++) {
+        if (pa_safe_streq(value, set[i])) {
+            return i;
+        }
+    }
+    return notFound;
+}
+
+static void UpdateEffectRoute(struct Userdata *u)
+{
+    struct EffectRoute *route = &u->effectRoute;
+    uint32_t generation = EffectChainManagerGetRouteGeneration();
+    if (route->built && route->generation == generation) {
+        return;
+    }
+    AUTO_CTRACE("hdi_sink::UpdateEffectRoute:%u", generation);
+    for (int32_t scene = 0; scene < SCENE_TYPE_NUM; scene++) {
+        for (int32_t mode = 0; mode < SCENE_MODE_NUM; mode++) {
+            route->exist[scene][mode][0] = EffectChainManagerExist(SCENE_TYPE_SET[scene], SCENE_MODE_SET[mode], "0");
+            route->exist[scene][mode][1] = EffectChainManagerExist(SCENE_TYPE_SET[scene], SCENE_MODE_SET[mode], "1");
+        }
+        for (int32_t sinkScene = 0; sinkScene < SCENE_TYPE_NUM; sinkScene++) {
+            route->sceneMatch[scene][sinkScene] =
+                EffectChainManagerSceneCheck(SCENE_TYPE_SET[scene], SCENE_TYPE_SET[sinkScene]);
+        }
+    }
+    // no effect chain is configured for an unknown scene type
+    memset_s(route->exist[SCENE_TYPE_NUM], sizeof(route->exist[SCENE_TYPE_NUM]), 0,
+        sizeof(route->exist[SCENE_TYPE_NUM]));
+    memset_s(route->sceneMatch[SCENE_TYPE_NUM], sizeof(route->sceneMatch[SCENE_TYPE_NUM]), 0,
+        sizeof(route->sceneMatch[SCENE_TYPE_NUM]));
+    route->effectOffload = EffectChainManagerCheckEffectOffload();
+    route->generation = generation;
+    route->built = true;
+}
+
+static const struct InputRoute *GetInputRoute(struct Userdata *u, pa_sink_input *sinkIn)
+{
+    struct InputRoute *input = &u->effectRoute.inputs[sinkIn->index % INPUT_ROUTE_CACHE_SIZE];
+    if (input->valid && input->index == sinkIn->index && input->generation == u->effectRoute.generation) {
+        return input;
+    }
+    input->sceneId = GetSetIndex(SCENE_TYPE_SET, SCENE_TYPE_NUM, pa_proplist_gets(sinkIn->proplist, "scene.type"),
+        SCENE_TYPE_NUM);
+    input->modeId = GetSetIndex(SCENE_MODE_SET, SCENE_MODE_NUM - 1, pa_proplist_gets(sinkIn->proplist, "scene.mode"),
+        SCENE_MODE_NUM - 1);
+    input->spatializationId = pa_safe_streq(pa_proplist_gets(sinkIn->proplist, "spatialization.enabled"), "0") ? 0 : 1;
+    input->clientVolumeIsZero = pa_safe_streq(pa_proplist_gets(sinkIn->proplist, "clientVolumeIsZero"), "true");
+    input->index = sinkIn->index;
+    input->generation = u->effectRoute.generation;
+    input->valid = true;
+    return input;
+}
+
+// Same as InputIsPrimary, with the effect chain looked up in the route table.
+static bool InputRouteIsPrimary(struct Userdata *u, pa_sink_input *sinkIn, const struct InputRoute *input)
+{
+    const bool isMultiChannel = u->effectRoute.effectOffload && sinkIn->sample_spec.channels > PRIMARY_CHANNEL_NUM &&
+        !u->effectRoute.exist[input->sceneId][input->modeId][input->spatializationId];
+    return !InputIsOffload(sinkIn) && !isMultiChannel && sinkIn->thread_info.state == PA_SINK_INPUT_RUNNING;
+}
+
+// Peeks a sink input selected for a scene into infoIn.
+static void SinkRenderPrimaryClusterInput(pa_sink *si, pa_sink_input *sinkIn, pa_mix_info *infoIn, size_t length,
+    size_t *mixlength, bool existFlag)
+{
+    struct Userdata *u;
+    pa_assert_se(u = si->userdata);
+
+    const char *sinkSceneType = pa_proplist_gets(sinkIn->proplist, "scene.type");
+    RecordEffectChainStatus(existFlag, sinkSceneType, pa_proplist_gets(sinkIn->proplist, "scene.mode"),
+        u->actualSpatializationEnabled);
+    pa_sink_input_assert_ref(sinkIn);
+    updateResampler(sinkIn, sinkSceneType, false);
+
+    AUTO_CTRACE("hdi_sink::PrimaryCluster:%u len:%zu", sinkIn->index, length);
+    pa_sink_input_peek(sinkIn, length, &infoIn->chunk, &infoIn->volume);
+
+    if (*mixlength == 0 || infoIn->chunk.length < *mixlength) {*mixlength = infoIn->chunk.length;}
+
+    if (pa_memblock_is_silence(infoIn->chunk.memblock) && sinkIn->thread_info.state == PA_SINK_INPUT_RUNNING) {
+        AUTO_CTRACE("hdi_sink::PrimaryCluster::is_silence");
+        pa_sink_input_handle_ohos_underrun(sinkIn);
+    } else {
+        AUTO_CTRACE("hdi_sink::PrimaryCluster::is_not_silence");
+    }
+
+    infoIn->userdata = pa_sink_input_ref(sinkIn);
+    pa_assert(infoIn->chunk.memblock);
+    pa_assert(infoIn->chunk.length > 0);
+    PreparePrimaryFading(sinkIn, infoIn, si);
+    CheckPrimaryFadeinIsDone(si, sinkIn);
+}
+
+// Sorts the primary inputs into the scene groups in one pass, an input goes to every scene that
+// SinkRenderPrimaryCluster would pick it for.
+static void SinkRenderPrimaryGroupInputs(pa_sink *si, struct Userdata *u)
+{
+    AUTO_CTRACE("hdi_sink::SinkRenderPrimaryGroupInputs");
+    pa_sink_input *sinkIn;
+    void *state = NULL;
+    int32_t appsUid[MAX_MIX_CHANNELS];
+    size_t count = 0;
+    const struct EffectRoute *route = &u->effectRoute;
+    const int32_t spatializationId = u->actualSpatializationEnabled ? 1 : 0;
+    memset_s(u->effectGroup.inputNum, sizeof(u->effectGroup.inputNum), 0, sizeof(u->effectGroup.inputNum));
+    while ((sinkIn = pa_hashmap_iterate(si->thread_info.inputs, &state, NULL))) {
+        if (count < MAX_MIX_CHANNELS) {
+            CheckAndPushUidToArr(sinkIn, appsUid, &count);
+        }
+        const struct InputRoute *input = GetInputRoute(u, sinkIn);
+        if ((IsInnerCapturer(sinkIn) && IsCaptureSilently()) || !InputRouteIsPrimary(u, sinkIn, input)) {
+            continue;
+        }
+        const bool existFlag = route->exist[input->sceneId][input->modeId][spatializationId];
+        for (int32_t group = 0; group < SCENE_TYPE_NUM; group++) {
+            // EFFECT_NONE, the last scene, takes the inputs without effect chain
+            bool picked = existFlag ? route->sceneMatch[input->sceneId][group] : group == SCENE_TYPE_NUM - 1;
+            if (picked && u->effectGroup.inputNum[group] < MAX_MIX_CHANNELS) {
+                u->effectGroup.inputs[group][u->effectGroup.inputNum[group]++] = sinkIn;
+            }
+        }
+    }
+    SafeRendererSinkUpdateAppsUid(u->primary.sinkAdapter, appsUid, count);
+}
+
+static unsigned SinkRenderPrimaryGroupCluster(pa_sink *si, size_t *length, pa_mix_info *infoIn,
+    unsigned maxInfo, char *sceneType)
+{
+    AUTO_CTRACE("hdi_sink::SinkRenderPrimaryGroupCluster:%s len:%zu", sceneType, *length);
+
+    struct Userdata *u;
+    pa_assert_se(u = si->userdata);
+    pa_assert(infoIn);
+
+    unsigned n = 0;
+    size_t mixlength = *length;
+    const int32_t group = GetSetIndex(SCENE_TYPE_SET, SCENE_TYPE_NUM, sceneType, SCENE_TYPE_NUM);
+    const int32_t spatializationId = u->actualSpatializationEnabled ? 1 : 0;
+    for (uint32_t i = 0; group < SCENE_TYPE_NUM && i < u->effectGroup.inputNum[group] && maxInfo > 0; i++) {
+        pa_sink_input *sinkIn = u->effectGroup.inputs[group][i];
+        const struct InputRoute *input = GetInputRoute(u, sinkIn);
+        SinkRenderPrimaryClusterInput(si, sinkIn, infoIn, *length, &mixlength,
+            u->effectRoute.exist[input->sceneId][input->modeId][spatializationId]);
+        infoIn++;
+        n++;
+        maxInfo--;
+    }
+
+    if (mixlength > 0) { *length = mixlength;}
+
+    return n;
+}
+
 static unsigned SinkRenderPrimaryCluster(pa_sink *si, size_t *length, pa_mix_info *infoIn,
     unsigned maxInfo, char *sceneType)
 {
@@ -1234,6 +1346,9 @@ static unsigned SinkRenderPrimaryCluster(pa_sink *si, size_t *length, pa_mix_inf
 
     struct Userdata *u;
     pa_assert_se(u = si->userdata);
+    if (u->effectParallel) {
+        return SinkRenderPrimaryGroupCluster(si, length, infoIn, maxInfo, sceneType);
+    }
 
     pa_sink_input *sinkIn;
     unsigned n = 0;
@@ -1246,38 +1361,19 @@ static unsigned SinkRenderPrimaryCluster(pa_sink *si, size_t *length, pa_mix_inf
 
     int32_t appsUid[MAX_MIX_CHANNELS];
     size_t count = 0;
+    const struct EffectRoute *route = &u->effectRoute;
+    const int32_t sceneId = GetSetIndex(SCENE_TYPE_SET, SCENE_TYPE_NUM, sceneType, SCENE_TYPE_NUM);
+    const bool isEffectNone = pa_safe_streq(sceneType, "EFFECT_NONE");
+    const int32_t spatializationId = u->actualSpatializationEnabled ? 1 : 0;
     while ((sinkIn = pa_hashmap_iterate(si->thread_info.inputs, &state, NULL)) && maxInfo > 0) {
         CheckAndPushUidToArr(sinkIn, appsUid, &count);
-        const char *sinkSceneType = pa_proplist_gets(sinkIn->proplist, "scene.type");
-        const char *sinkSceneMode = pa_proplist_gets(sinkIn->proplist, "scene.mode");
-        bool existFlag =
-            EffectChainManagerExist(sinkSceneType, sinkSceneMode, u->actualSpatializationEnabled ? "1" : "0");
-        bool sceneTypeFlag = EffectChainManagerSceneCheck(sinkSceneType, sceneType);
-        if ((IsInnerCapturer(sinkIn) && IsCaptureSilently()) || !InputIsPrimary(sinkIn)) {
+        const struct InputRoute *input = GetInputRoute(u, sinkIn);
+        bool existFlag = route->exist[input->sceneId][input->modeId][spatializationId];
+        bool sceneTypeFlag = sceneId < SCENE_TYPE_NUM && route->sceneMatch[input->sceneId][sceneId];
+        if ((IsInnerCapturer(sinkIn) && IsCaptureSilently()) || !InputRouteIsPrimary(u, sinkIn, input)) {
             continue;
-        } else if ((sceneTypeFlag && existFlag) || (pa_safe_streq(sceneType, "EFFECT_NONE") && (!existFlag))) {
-            RecordEffectChainStatus(existFlag, sinkSceneType, sinkSceneMode, u->actualSpatializationEnabled);
-            pa_sink_input_assert_ref(sinkIn);
-            updateResampler(sinkIn, sinkSceneType, false);
-
-            AUTO_CTRACE("hdi_sink::PrimaryCluster:%u len:%zu", sinkIn->index, *length);
-            pa_sink_input_peek(sinkIn, *length, &infoIn->chunk, &infoIn->volume);
-
-            if (mixlength == 0 || infoIn->chunk.length < mixlength) {mixlength = infoIn->chunk.length;}
-
-            if (pa_memblock_is_silence(infoIn->chunk.memblock) && sinkIn->thread_info.state == PA_SINK_INPUT_RUNNING) {
-                AUTO_CTRACE("hdi_sink::PrimaryCluster::is_silence");
-                pa_sink_input_handle_ohos_underrun(sinkIn);
-            } else {
-                AUTO_CTRACE("hdi_sink::PrimaryCluster::is_not_silence");
-            }
-
-            infoIn->userdata = pa_sink_input_ref(sinkIn);
-            pa_assert(infoIn->chunk.memblock);
-            pa_assert(infoIn->chunk.length > 0);
-            PreparePrimaryFading(sinkIn, infoIn, si);
-            CheckPrimaryFadeinIsDone(si, sinkIn);
-
+        } else if ((sceneTypeFlag && existFlag) || (isEffectNone && (!existFlag))) {
+            SinkRenderPrimaryClusterInput(si, sinkIn, infoIn, *length, &mixlength, existFlag);
             infoIn++;
             n++;
             maxInfo--;
@@ -1657,24 +1753,25 @@ static char *CheckAndDealEffectZeroVolume(struct Userdata *u, time_t currentTime
     g_effectAllStreamVolumeZeroMap[i] = true;
     while ((input = pa_hashmap_iterate(u->sink->thread_info.inputs, &state, NULL))) {
         pa_sink_input_assert_ref(input);
-        const char *sinkSceneTypeTmp = pa_proplist_gets(input->proplist, "scene.type");
-        const char *streamType = safeProplistGets(input->proplist, "stream.type", "NULL");
-        const char *clientVolumeIsZero = safeProplistGets(input->proplist, "clientVolumeIsZero", "false");
+        const struct InputRoute *route = GetInputRoute(u, input);
+        if (route->sceneId != i) {
+            continue;
+        }
         pa_cvolume vol;
         pa_sink_input_get_volume(input, &vol, true);
         pa_sw_cvolume_multiply(&vol, &input->sink->thread_info.soft_volume, &input->volume);
         bool isZeroVolume = input->sink->thread_info.soft_muted || pa_cvolume_is_muted(&vol) ||
-            pa_safe_streq(clientVolumeIsZero, "true");
-        if (pa_safe_streq(sinkSceneTypeTmp, SCENE_TYPE_SET[i]) && !isZeroVolume) {
+            route->clientVolumeIsZero;
+        if (!isZeroVolume) {
             g_effectAllStreamVolumeZeroMap[i] = false;
             g_effectStartVolZeroTimeMap[i] = 0;
             AUDIO_DEBUG_LOG("SCENE_TYPE_SET[%{public}d]:%{public}s for streamtype:[%{public}s]'s"
                 " volume is non zero, this effect all streamtype is non zero volume.", i,
-                SCENE_TYPE_SET[i], streamType);
+                SCENE_TYPE_SET[i], safeProplistGets(input->proplist, "stream.type", "NULL"));
             break;
         }
     }
-    CheckIfCommonSceneTypeZeroVolume();
+    CheckIfCommonSceneTypeZeroVolume(u);
     if (g_effectAllStreamVolumeZeroMap[i] && !g_effectHaveDisabledMap[i] && (g_effectStartVolZeroTimeMap[i] == 0) &&
         PA_SINK_IS_RUNNING(u->sink->thread_info.state)) {
         AUDIO_INFO_LOG("Timing begins, will close [%{public}s] effect after [%{public}d]s", SCENE_TYPE_SET[i],
@@ -1686,11 +1783,10 @@ static char *CheckAndDealEffectZeroVolume(struct Userdata *u, time_t currentTime
     return handledSceneType;
 }
 
-static void CheckIfCommonSceneTypeZeroVolume()
+static void CheckIfCommonSceneTypeZeroVolume(struct Userdata *u)
 {
     for (int32_t i = 0; i < SCENE_TYPE_NUM; i++) {
-        if (!g_effectAllStreamVolumeZeroMap[i] &&
-            EffectChainManagerSceneCheck(SCENE_TYPE_SET[i], SCENE_TYPE_SET[COMMON_SCENE_TYPE_INDEX])) {
+        if (!g_effectAllStreamVolumeZeroMap[i] && u->effectRoute.sceneMatch[i][COMMON_SCENE_TYPE_INDEX]) {
             g_effectAllStreamVolumeZeroMap[COMMON_SCENE_TYPE_INDEX] = false;
             break;
         }
@@ -1795,17 +1891,97 @@ static void CheckAndDealSpeakerPaZeroVolume(struct Userdata *u, time_t currentTi
     }
 }
 
+// The block of a period goes to the hdi write thread, which drops its reference once written. A block of the arena is
+// reused as soon as only the arena holds it, a new one is allocated only if the arena is all in flight or too small.
+static pa_memblock *AcquireRenderBlock(pa_memblock **blocks, pa_mempool *pool, size_t size)
+{
+    int32_t freeIndex = -1;
+    for (int32_t i = 0; i < RENDER_BLOCK_NUM; i++) {
+        if (blocks[i] == NULL || pa_memblock_ref_is_one(blocks[i])) {
+            if (blocks[i] != NULL && pa_memblock_get_length(blocks[i]) >= size) {
+                return pa_memblock_ref(blocks[i]);
+            }
+            freeIndex = freeIndex < 0 ? i : freeIndex;
+        }
+    }
+    if (freeIndex < 0) {
+        AUDIO_WARNING_LOG("all render blocks in flight");
+        return pa_memblock_new(pool, size);
+    }
+    if (blocks[freeIndex] != NULL) {
+        pa_memblock_unref(blocks[freeIndex]);
+    }
+    blocks[freeIndex] = pa_memblock_new(pool, size);
+    return pa_memblock_ref(blocks[freeIndex]);
+}
+
+static void FreeRenderBlocks(pa_memblock **blocks)
+{
+    for (int32_t i = 0; i < RENDER_BLOCK_NUM; i++) {
+        if (blocks[i] != NULL) {
+            pa_memblock_unref(blocks[i]);
+            blocks[i] = NULL;
+        }
+    }
+}
+
 static void PrimaryEffectProcess(struct Userdata *u, pa_memchunk *chunkIn, char *sinkSceneType)
 {
     AUTO_CTRACE("hdi_sink::EffectChainManagerProcess:%s", sinkSceneType);
     EffectChainManagerProcess(sinkSceneType, u->bufferAttr);
-    for (int32_t k = 0; k < u->bufferAttr->frameLen * u->bufferAttr->numChanOut; k++) {
-        u->bufferAttr->tempBufOut[k] += u->bufferAttr->bufOut[k];
-    }
+    AudioAccumulateF32(u->bufferAttr->bufOut, u->bufferAttr->tempBufOut,
+        (size_t)(u->bufferAttr->frameLen * u->bufferAttr->numChanOut));
     pa_memblock_release(chunkIn->memblock);
     u->bufferAttr->numChanIn = DEFAULT_IN_CHANNEL_NUM;
 }
 
+// Renders every scene into its own buffers first, then runs all the effect chains at once on the effect workers.
+static void SinkRenderPrimaryGroupProcess(pa_sink *si, size_t length, pa_memchunk *chunkIn, time_t currentTime)
+{
+    struct Userdata *u;
+    pa_assert_se(u = si->userdata);
+
+    char *sceneTypes[SCENE_TYPE_NUM];
+    BufferAttr *bufferAttrs[SCENE_TYPE_NUM];
+    uint32_t sceneNum = 0;
+    int32_t bitSize = (int32_t)pa_sample_size_of_format(u->format);
+    SinkRenderPrimaryGroupInputs(si, u);
+    for (int32_t i = 0; i < SCENE_TYPE_NUM; i++) {
+        uint32_t processChannels = DEFAULT_NUM_CHANNEL;
+        uint64_t processChannelLayout = DEFAULT_CHANNELLAYOUT;
+        EffectChainManagerReturnEffectChannelInfo(SCENE_TYPE_SET[i], &processChannels, &processChannelLayout);
+        char *sinkSceneType = CheckAndDealEffectZeroVolume(u, currentTime, i);
+        if (u->effectGroup.inputNum[i] == 0) { continue; }
+        size_t tmpLength = length * processChannels / DEFAULT_IN_CHANNEL_NUM;
+        chunkIn->index = 0;
+        chunkIn->length = tmpLength;
+        int32_t nSinkInput = SinkRenderPrimaryGetData(si, chunkIn, SCENE_TYPE_SET[i]);
+        if (nSinkInput == 0) { continue; }
+        chunkIn->index = 0;
+        chunkIn->length = tmpLength;
+        void *src = pa_memblock_acquire_chunk(chunkIn);
+        int32_t frameLen = bitSize > 0 ? ((int32_t)tmpLength / bitSize) : 0;
+
+        BufferAttr *bufferAttr = &u->effectGroup.bufferAttrs[i];
+        ConvertToFloat(u->format, frameLen, src, bufferAttr->bufIn);
+        pa_memblock_release(chunkIn->memblock);
+        bufferAttr->numChanIn = (int32_t)processChannels;
+        bufferAttr->numChanOut = u->bufferAttr->numChanOut;
+        bufferAttr->frameLen = frameLen / bufferAttr->numChanIn;
+        sceneTypes[sceneNum] = sinkSceneType;
+        bufferAttrs[sceneNum] = bufferAttr;
+        sceneNum++;
+    }
+    if (sceneNum == 0) { return; }
+
+    AUTO_CTRACE("hdi_sink::EffectChainManagerProcessScenes:%u", sceneNum);
+    EffectChainManagerProcessScenes(sceneTypes, bufferAttrs, sceneNum);
+    for (uint32_t i = 0; i < sceneNum; i++) {
+        AudioAccumulateF32(bufferAttrs[i]->bufOut, u->bufferAttr->tempBufOut,
+            (size_t)(bufferAttrs[i]->frameLen * bufferAttrs[i]->numChanOut));
+    }
+}
+
 static void SinkRenderPrimaryProcess(pa_sink *si, size_t length, pa_memchunk *chunkIn)
 {
     if (GetInnerCapturerState()) {
@@ -1817,21 +1993,23 @@ static void SinkRenderPrimaryProcess(pa_sink *si, size_t length, pa_memchunk *ch
     struct Userdata *u;
     pa_assert_se(u = si->userdata);
 
-    size_t memsetInLen = sizeof(float) * DEFAULT_FRAMELEN * IN_CHANNEL_NUM_MAX;
-    size_t memsetOutLen = sizeof(float) * DEFAULT_FRAMELEN * OUT_CHANNEL_NUM_MAX;
-    if (memset_s(u->bufferAttr->tempBufIn, u->processSize, 0, memsetInLen) != EOK) {
-        AUDIO_WARNING_LOG("SinkRenderBufIn memset_s failed");
-    }
+    int32_t bitSize = (int32_t)pa_sample_size_of_format(u->format);
+    // the scenes are accumulated into the output samples of the period, nothing else of it is read
+    size_t memsetOutLen = bitSize > 0 ? sizeof(float) * (length / (size_t)bitSize) : 0;
     if (memset_s(u->bufferAttr->tempBufOut, u->processSize, 0, memsetOutLen) != EOK) {
         AUDIO_WARNING_LOG("SinkRenderBufOut memset_s failed");
     }
-    int32_t bitSize = (int32_t)pa_sample_size_of_format(u->format);
-    chunkIn->memblock = pa_memblock_new(si->core->mempool, length * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
+    chunkIn->memblock = AcquireRenderBlock(u->primary.renderBlocks, si->core->mempool,
+        length * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
     time_t currentTime = time(NULL);
     PrepareSpatializationFading(&u->spatializationFadingState, &u->spatializationFadingCount,
         &u->actualSpatializationEnabled);
+    UpdateEffectRoute(u);
     g_effectProcessFrameCount++;
-    for (int32_t i = 0; i < SCENE_TYPE_NUM; i++) {
+    if (u->effectParallel) {
+        SinkRenderPrimaryGroupProcess(si, length, chunkIn, currentTime);
+    }
+    for (int32_t i = 0; i < SCENE_TYPE_NUM && !u->effectParallel; i++) {
         uint32_t processChannels = DEFAULT_NUM_CHANNEL;
         uint64_t processChannelLayout = DEFAULT_CHANNELLAYOUT;
         EffectChainManagerReturnEffectChannelInfo(SCENE_TYPE_SET[i], &processChannels, &processChannelLayout);
@@ -1846,8 +2024,7 @@ static void SinkRenderPrimaryProcess(pa_sink *si, size_t length, pa_memchunk *ch
         void *src = pa_memblock_acquire_chunk(chunkIn);
         int32_t frameLen = bitSize > 0 ? ((int32_t)tmpLength / bitSize) : 0;
 
-        ConvertToFloat(u->format, frameLen, src, u->bufferAttr->tempBufIn);
-        memcpy_s(u->bufferAttr->bufIn, frameLen * sizeof(float), u->bufferAttr->tempBufIn, frameLen * sizeof(float));
+        ConvertToFloat(u->format, frameLen, src, u->bufferAttr->bufIn);
         u->bufferAttr->numChanIn = (int32_t)processChannels;
         u->bufferAttr->frameLen = frameLen / u->bufferAttr->numChanIn;
         PrimaryEffectProcess(u, chunkIn, sinkSceneType);
@@ -2860,7 +3037,8 @@ static void SinkRenderMultiChannelProcess(pa_sink *si, size_t length, pa_memchun
     uint64_t sinkChannelLayout = DEFAULT_MULTICHANNEL_CHANNELLAYOUT;
     EffectChainManagerReturnMultiChannelInfo(&sinkChannel, &sinkChannelLayout);
 
-    chunkIn->memblock = pa_memblock_new(si->core->mempool, length * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
+    chunkIn->memblock = AcquireRenderBlock(u->multiChannel.renderBlocks, si->core->mempool,
+        length * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
     size_t tmpLength = length * sinkChannel / DEFAULT_IN_CHANNEL_NUM;
     chunkIn->index = 0;
     chunkIn->length = tmpLength;
@@ -3767,7 +3945,6 @@ static void PaHdiSinkUserdataInit(struct Userdata *u)
     u->bufferAttr = pa_xnew0(BufferAttr, 1);
     pa_assert_se(u->bufferAttr->bufIn = (float *)malloc(u->processSize));
     pa_assert_se(u->bufferAttr->bufOut = (float *)malloc(u->processSize));
-    pa_assert_se(u->bufferAttr->tempBufIn = (float *)malloc(u->processSize));
     pa_assert_se(u->bufferAttr->tempBufOut = (float *)malloc(u->processSize));
     u->bufferAttr->samplingRate = (int32_t)u->ss.rate;
     u->bufferAttr->frameLen = DEFAULT_FRAMELEN;
@@ -3777,6 +3954,13 @@ static void PaHdiSinkUserdataInit(struct Userdata *u)
     u->sinkSceneMode = -1;
     u->sinkSceneType = -1;
     u->hdiEffectEnabled = false;
+    for (int32_t i = 0; i < SCENE_TYPE_NUM && u->effectParallel; i++) {
+        BufferAttr *bufferAttr = &u->effectGroup.bufferAttrs[i];
+        pa_assert_se(bufferAttr->bufIn = (float *)malloc(u->processSize));
+        pa_assert_se(bufferAttr->bufOut = (float *)malloc(u->processSize));
+        bufferAttr->samplingRate = (int32_t)u->ss.rate;
+        bufferAttr->bufOutUsed = true;
+    }
 }
 
 static pa_sink *PaHdiSinkInit(struct Userdata *u, pa_modargs *ma, const char *driver)
@@ -3854,6 +4038,11 @@ static int32_t PaHdiSinkNewInitThreadMultiChannel(pa_module *m, pa_modargs *ma,
     }
 
     u->multiChannel.used = true;
+    // sized like the primary render blocks, so that the multichannel render thread does not allocate either
+    for (int32_t i = 0; i < RENDER_BLOCK_NUM; i++) {
+        u->multiChannel.renderBlocks[i] = pa_memblock_new(u->sink->core->mempool,
+            u->buffer_size * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
+    }
 
     u->multiChannel.chunk.memblock = pa_memblock_new(u->sink->core->mempool, -1); // -1 == pa_mempool_block_size_max
 
@@ -3971,6 +4160,10 @@ static int32_t PaHdiSinkNewInitUserDataAndSink(pa_module *m, pa_modargs *ma, con
         AUDIO_ERR_LOG("Failed to parse offload_enable argument.");
         return -1;
     }
+    if (pa_modargs_get_value_boolean(ma, "effect_parallel", &u->effectParallel) < 0) {
+        AUDIO_ERR_LOG("Failed to parse effect_parallel argument.");
+        return -1;
+    }
 
     pa_atomic_store(&u->primary.dflag, 0);
     u->primary.dq = pa_asyncmsgq_new(0);
@@ -4008,6 +4201,11 @@ static int32_t PaHdiSinkNewInitUserDataAndSink(pa_module *m, pa_modargs *ma, con
     }
 
     pa_sink_set_max_request(u->sink, u->buffer_size);
+    // sized for the max channels of the effect chains, so that the primary render thread does not allocate
+    for (int32_t i = 0; i < RENDER_BLOCK_NUM; i++) {
+        u->primary.renderBlocks[i] = pa_memblock_new(u->sink->core->mempool,
+            u->buffer_size * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
+    }
 
     return 0;
 }
@@ -4111,6 +4309,7 @@ static void UserdataFreeMultiChannel(struct Userdata *u)
     if (u->multiChannel.chunk.memblock) {
         pa_memblock_unref(u->multiChannel.chunk.memblock);
     }
+    FreeRenderBlocks(u->multiChannel.renderBlocks);
 }
 
 static void UserdataFreeThread(struct Userdata *u)
@@ -4177,6 +4376,7 @@ static void UserdataFree(struct Userdata *u)
     if (u->primary.dq) {
         pa_asyncmsgq_unref(u->primary.dq);
     }
+    FreeRenderBlocks(u->primary.renderBlocks);
 
     if (u->primary.sinkAdapter) {
         u->primary.sinkAdapter->RendererSinkStop(u->primary.sinkAdapter);
@@ -4195,12 +4395,16 @@ static void UserdataFree(struct Userdata *u)
     }
     free(u->bufferAttr->bufIn);
     free(u->bufferAttr->bufOut);
-    free(u->bufferAttr->tempBufIn);
     free(u->bufferAttr->tempBufOut);
     u->bufferAttr->bufIn = NULL;
     u->bufferAttr->bufOut = NULL;
-    u->bufferAttr->tempBufIn = NULL;
     u->bufferAttr->tempBufOut = NULL;
+    for (int32_t i = 0; i < SCENE_TYPE_NUM; i++) {
+        free(u->effectGroup.bufferAttrs[i].bufIn);
+        free(u->effectGroup.bufferAttrs[i].bufOut);
+        u->effectGroup.bufferAttrs[i].bufIn = NULL;
+        u->effectGroup.bufferAttrs[i].bufOut = NULL;
+    }
 
     pa_xfree(u->bufferAttr);
     u->bufferAttr = NULL;
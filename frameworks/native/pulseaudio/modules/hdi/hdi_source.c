@@ -23,6 +23,7 @@
 #include <pulse/util.h>
 #include <pulse/xmalloc.h>
 #include <pulsecore/core.h>
+#include <pulsecore/core-util.h>
 #include <pulsecore/log.h>
 #include <pulsecore/memchunk.h>
 #include <pulsecore/modargs.h>
@@ -56,9 +57,30 @@
 #define AUDIO_POINT_NUM  1024
 #define AUDIO_FRAME_NUM_IN_BUF 30
 #define HDI_WAKEUP_BUFFER_TIME (PA_USEC_PER_SEC * 2)
+#define DEFAULT_PIPELINE_BLOCK_NUM 4
+#define PIPELINE_STATS_INTERVAL_USEC (PA_USEC_PER_SEC * 10)
 
 const char *DEVICE_CLASS_REMOTE = "remote";
 
+enum {
+    SOURCE_MESSAGE_CAPTURED_CHUNK = PA_SOURCE_MESSAGE_MAX,
+};
+
+enum {
+    PIPELINE_START,
+    PIPELINE_STOP,
+    PIPELINE_QUIT,
+};
+
+struct CaptureStageStats {
+    const char *name;
+    uint64_t count;
+    pa_usec_t total;
+    pa_usec_t max;
+    uint64_t droppedBytes;
+    pa_usec_t lastReport;
+};
+
 struct Userdata {
     pa_core *core;
     pa_module *module;
@@ -74,10 +96,24 @@ struct Userdata {
     bool IsCapturerStarted;
     struct CapturerSourceAdapter *sourceAdapter;
     pa_usec_t delayTime;
+    // In pipelined mode the hdi is read by its own thread, the IO thread only delivers what was read to the
+    // source outputs, so that a slow delivery does not hold up the capture.
+    struct {
+        bool enable;
+        bool active; // the last command sent to the read thread, only used by the IO thread
+        uint32_t maxBlocks; // chunks read but not delivered yet, bounds the latency added by the pipeline
+        pa_thread *thread;
+        pa_asyncmsgq *cq; // commands to the read thread
+        pa_atomic_t queuedBlocks;
+        struct CaptureStageStats readStats; // only used by the read thread
+        struct CaptureStageStats queueStats; // only used by the IO thread
+        struct CaptureStageStats deliverStats; // only used by the IO thread
+    } pipeline;
 };
 
 static int PaHdiCapturerInit(struct Userdata *u);
 static void PaHdiCapturerExit(struct Userdata *u);
+static void DeliverCapturedChunk(struct Userdata *u, pa_memchunk *chunk, pa_usec_t capturedTime);
 
 static char *GetStateInfo(pa_source_state_t state)
 {
@@ -102,6 +138,16 @@ static char *GetStateInfo(pa_source_state_t state)
 static void UserdataFree(struct Userdata *u)
 {
     pa_assert(u);
+    // the read thread posts to the IO thread, it stops first, the state changes of the unlink no longer command it
+    if (u->pipeline.thread) {
+        pa_asyncmsgq_send(u->pipeline.cq, NULL, PIPELINE_QUIT, NULL, 0, NULL);
+        pa_thread_free(u->pipeline.thread);
+    }
+    u->pipeline.enable = false;
+    if (u->pipeline.cq) {
+        pa_asyncmsgq_unref(u->pipeline.cq);
+    }
+
     if (u->source) {
         pa_source_unlink(u->source);
     }
@@ -143,6 +189,10 @@ static int SourceProcessMsg(pa_msgobject *o, int code, void *data, int64_t offse
             *((int64_t*)data) = (int64_t)now - (int64_t)u->timestamp;
             return 0;
         }
+        case SOURCE_MESSAGE_CAPTURED_CHUNK: {
+            DeliverCapturedChunk(u, chunk, (pa_usec_t)offset);
+            return 0;
+        }
         default: {
             pa_log("SourceProcessMsg default case");
             return pa_source_process_msg(o, code, data, offset, chunk);
@@ -150,6 +200,16 @@ static int SourceProcessMsg(pa_msgobject *o, int code, void *data, int64_t offse
     }
 }
 
+// Waits for the read thread to take the command, after a stop it no longer calls the hdi.
+static void PipelineSetActive(struct Userdata *u, bool active)
+{
+    if (!u->pipeline.enable || u->pipeline.active == active) {
+        return;
+    }
+    u->pipeline.active = active;
+    pa_asyncmsgq_send(u->pipeline.cq, NULL, active ? PIPELINE_START : PIPELINE_STOP, NULL, 0, NULL);
+}
+
 /* Called from the IO thread. */
 static int SourceSetStateInIoThreadCb(pa_source *s, pa_source_state_t newState,
     pa_suspend_cause_t newSuspendCause)
@@ -160,6 +220,10 @@ static int SourceSetStateInIoThreadCb(pa_source *s, pa_source_state_t newState,
     AUDIO_INFO_LOG("Source[%{public}s] state change:[%{public}s]-->[%{public}s]",
         GetDeviceClass(u->sourceAdapter->deviceClass), GetStateInfo(s->thread_info.state), GetStateInfo(newState));
 
+    // from any state, so that the read thread no longer calls the hdi once the capturer may be stopped
+    if (newState == PA_SOURCE_SUSPENDED) {
+        PipelineSetActive(u, false);
+    }
     if ((s->thread_info.state == PA_SOURCE_SUSPENDED || s->thread_info.state == PA_SOURCE_INIT) &&
         PA_SOURCE_IS_OPENED(newState)) {
         u->delayTime = 0;
@@ -193,6 +257,9 @@ static int SourceSetStateInIoThreadCb(pa_source *s, pa_source_state_t newState,
         }
     }
 
+    if (PA_SOURCE_IS_OPENED(newState) && u->IsCapturerStarted) {
+        PipelineSetActive(u, true);
+    }
     return 0;
 }
 
@@ -237,12 +304,130 @@ static int GetCapturerFrameFromHdi(pa_memchunk *chunk, const struct Userdata *u)
     return 0;
 }
 
+static void UpdateAppsUid(struct Userdata *u)
+{
+    int32_t appsUid[PA_MAX_OUTPUTS_PER_SOURCE];
+    size_t count = 0;
+    void *state = NULL;
+    pa_source_output *sourceOutput;
+    while ((sourceOutput = pa_hashmap_iterate(u->source->thread_info.outputs, &state, NULL))) {
+        const char *cstringClientUid = pa_proplist_gets(sourceOutput->proplist, "stream.client.uid");
+        if (cstringClientUid && (sourceOutput->state == PA_SOURCE_OUTPUT_RUNNING)) {
+            appsUid[count++] = atoi(cstringClientUid);
+        }
+    }
+
+    if (u->sourceAdapter) {
+        u->sourceAdapter->CapturerSourceAppsUid(u->sourceAdapter->wapper, appsUid, count);
+    }
+}
+
+// Logs the average and max latency of a stage of the capture pipeline once per interval.
+static void RecordCaptureStage(struct CaptureStageStats *stats, pa_usec_t cost, pa_usec_t now)
+{
+    stats->count++;
+    stats->total += cost;
+    stats->max = PA_MAX(stats->max, cost);
+    if (now - stats->lastReport < PIPELINE_STATS_INTERVAL_USEC) {
+        return;
+    }
+    AUDIO_INFO_LOG("capture stage [%{public}s] count: %{public}" PRIu64 " avg: %{public}" PRIu64 "us max: "
+        "%{public}" PRIu64 "us dropped: %{public}" PRIu64 " bytes", stats->name, stats->count,
+        stats->total / stats->count, stats->max, stats->droppedBytes);
+    stats->count = 0;
+    stats->total = 0;
+    stats->max = 0;
+    stats->droppedBytes = 0;
+    stats->lastReport = now;
+}
+
+/* Called from the read thread. */
+static void PipelineReadChunk(struct Userdata *u)
+{
+    pa_memchunk chunk;
+    uint64_t replyBytes = 0;
+    pa_usec_t start = pa_rtclock_now();
+
+    chunk.memblock = pa_memblock_new(u->core->mempool, u->buffer_size);
+    uint64_t requestBytes = pa_memblock_get_length(chunk.memblock);
+    void *p = pa_memblock_acquire(chunk.memblock);
+    u->sourceAdapter->CapturerSourceFrame(u->sourceAdapter->wapper, (char *)p, requestBytes, &replyBytes);
+    pa_memblock_release(chunk.memblock);
+    pa_usec_t end = pa_rtclock_now();
+    if (replyBytes == 0 || replyBytes > requestBytes) {
+        AUDIO_ERR_LOG("HDI Source: Failed to read, Requested data Length: %{public}" PRIu64 " bytes,"
+            " Read: %{public}" PRIu64 " bytes", requestBytes, replyBytes);
+        pa_memblock_unref(chunk.memblock);
+        pa_msleep(u->block_usec / PA_USEC_PER_MSEC); // do not spin on a failing hdi
+        return;
+    }
+
+    // the delivery is behind, drop what was just read rather than hold up the next read
+    if ((uint32_t)pa_atomic_load(&u->pipeline.queuedBlocks) >= u->pipeline.maxBlocks) {
+        u->pipeline.readStats.droppedBytes += replyBytes;
+        pa_memblock_unref(chunk.memblock);
+        RecordCaptureStage(&u->pipeline.readStats, end - start, end);
+        return;
+    }
+    chunk.index = 0;
+    chunk.length = replyBytes;
+    pa_atomic_inc(&u->pipeline.queuedBlocks);
+    pa_asyncmsgq_post(u->thread_mq.inq, PA_MSGOBJECT(u->source), SOURCE_MESSAGE_CAPTURED_CHUNK, NULL, (int64_t)end,
+        &chunk, NULL);
+    pa_memblock_unref(chunk.memblock);
+    RecordCaptureStage(&u->pipeline.readStats, end - start, end);
+}
+
+static void ThreadFuncCapturerPipelineRead(void *userdata)
+{
+    struct Userdata *u = userdata;
+    pa_assert(u);
+
+    if (u->core->realtime_scheduling) {
+        pa_thread_make_realtime(u->core->realtime_priority);
+    }
+
+    bool active = false;
+    bool quit = false;
+    while (!quit) {
+        int32_t code = 0;
+        // block for a command while stopped, only look for one between two reads while capturing
+        if (pa_asyncmsgq_get(u->pipeline.cq, NULL, &code, NULL, NULL, NULL, !active) == 0) {
+            active = (code == PIPELINE_START) || (active && code != PIPELINE_STOP);
+            quit = (code == PIPELINE_QUIT);
+            pa_asyncmsgq_done(u->pipeline.cq, 0);
+            continue;
+        }
+        AUTO_CTRACE("hdi_source::PipelineReadChunk");
+        PipelineReadChunk(u);
+    }
+}
+
+/* Called from the IO thread. */
+static void DeliverCapturedChunk(struct Userdata *u, pa_memchunk *chunk, pa_usec_t capturedTime)
+{
+    pa_atomic_dec(&u->pipeline.queuedBlocks);
+    if (!PA_SOURCE_IS_OPENED(u->source->thread_info.state)) {
+        return;
+    }
+    pa_usec_t now = pa_rtclock_now();
+    RecordCaptureStage(&u->pipeline.queueStats, now - capturedTime, now);
+
+    pa_source_post(u->source, chunk);
+    u->timestamp = capturedTime;
+    UpdateAppsUid(u);
+
+    pa_usec_t end = pa_rtclock_now();
+    RecordCaptureStage(&u->pipeline.deliverStats, end - now, end);
+}
+
 static bool PaRtpollSetTimerFunc(struct Userdata *u, bool timerElapsed)
 {
     bool flag = (u->attrs.sourceType == SOURCE_TYPE_WAKEUP) ?
         (u->source->thread_info.state == PA_SOURCE_RUNNING && u->IsCapturerStarted) :
         (PA_SOURCE_IS_OPENED(u->source->thread_info.state) && u->IsCapturerStarted);
-    if (!flag) {
+    // in pipelined mode the chunks come from the read thread, nothing to do on timer
+    if (!flag || u->pipeline.enable) {
         pa_rtpoll_set_timer_disabled(u->rtpoll);
         AUDIO_DEBUG_LOG("HDI Source: pa_rtpoll_set_timer_disabled done ");
         return true;
@@ -266,20 +451,7 @@ static bool PaRtpollSetTimerFunc(struct Userdata *u, bool timerElapsed)
         }
     }
 
-    int32_t appsUid[PA_MAX_OUTPUTS_PER_SOURCE];
-    size_t count = 0;
-    void *state = NULL;
-    pa_source_output *sourceOutput;
-    while ((sourceOutput = pa_hashmap_iterate(u->source->thread_info.outputs, &state, NULL))) {
-        const char *cstringClientUid = pa_proplist_gets(sourceOutput->proplist, "stream.client.uid");
-        if (cstringClientUid && (sourceOutput->state == PA_SOURCE_OUTPUT_RUNNING)) {
-            appsUid[count++] = atoi(cstringClientUid);
-        }
-    }
-
-    if (u->sourceAdapter) {
-        u->sourceAdapter->CapturerSourceAppsUid(u->sourceAdapter->wapper, appsUid, count);
-    }
+    UpdateAppsUid(u);
 
     pa_usec_t costTime = pa_rtclock_now() - now;
     if (costTime > u->block_usec) {
@@ -498,6 +670,20 @@ static void InitUserdataAttrs(pa_modargs *ma, struct Userdata *u, const pa_sampl
         "sampleRate: %{public}d", u->attrs.format, u->attrs.isBigEndian, u->attrs.channel, u->attrs.sampleRate);
 
     u->attrs.openMicSpeaker = u->open_mic_speaker;
+
+    if (pa_modargs_get_value_boolean(ma, "capture_pipeline", &u->pipeline.enable) < 0) {
+        AUDIO_ERR_LOG("Failed to parse capture_pipeline argument");
+    }
+    // the wakeup source reads back what the hdi buffered before it was opened, it keeps the timer
+    u->pipeline.enable = u->pipeline.enable && u->attrs.sourceType != SOURCE_TYPE_WAKEUP;
+    u->pipeline.maxBlocks = DEFAULT_PIPELINE_BLOCK_NUM;
+    if (pa_modargs_get_value_u32(ma, "pipeline_blocks", &u->pipeline.maxBlocks) < 0 || u->pipeline.maxBlocks == 0) {
+        AUDIO_ERR_LOG("Failed to parse pipeline_blocks argument");
+        u->pipeline.maxBlocks = DEFAULT_PIPELINE_BLOCK_NUM;
+    }
+    u->pipeline.readStats.name = "read";
+    u->pipeline.queueStats.name = "queue";
+    u->pipeline.deliverStats.name = "deliver";
 }
 
 pa_source *PaHdiSourceNew(pa_module *m, pa_modargs *ma, const char *driver)
@@ -552,6 +738,16 @@ pa_source *PaHdiSourceNew(pa_module *m, pa_modargs *ma, const char *driver)
         goto fail;
     }
 
+    if (u->pipeline.enable) {
+        pa_atomic_store(&u->pipeline.queuedBlocks, 0);
+        u->pipeline.cq = pa_asyncmsgq_new(0);
+        if (!u->pipeline.cq || !(u->pipeline.thread = pa_thread_new("OS_ReadHdiPipe", ThreadFuncCapturerPipelineRead,
+            u))) {
+            AUDIO_ERR_LOG("Failed to create hdi-source-pipeline thread!");
+            goto fail;
+        }
+    }
+
     pa_source_put(u->source);
     return u->source;
 
@@ -55,6 +55,7 @@ PA_MODULE_USAGE(
         "network_id<device network id>"
         "device_type<device type or port>"
         "offload_enable<if device support offload>"
+        "effect_parallel<run the effect chains of the scenes in parallel>"
         );
 
 static const char * const VALID_MODARGS[] = {
@@ -76,12 +77,15 @@ static const char * const VALID_MODARGS[] = {
     "network_id",
     "device_type",
     "offload_enable",
+    "effect_parallel",
     NULL
 };
 
 static pa_hook_result_t SinkInputNewCb(pa_core *c, pa_sink_input *si)
 {
     pa_assert(c);
+    // the render loop caches the scene properties of sink inputs until the route generation changes
+    EffectChainManagerInvalidateRoute();
 
     const char *flush = pa_proplist_gets(si->proplist, "stream.flush");
     const char *sceneMode = pa_proplist_gets(si->proplist, "scene.mode");
@@ -53,6 +53,8 @@ PA_MODULE_USAGE(
         "network_id<device network id>"
         "device_type<device type or port>"
         "source_type<source type or port>"
+        "capture_pipeline<read the hdi on its own thread>"
+        "pipeline_blocks<max blocks read but not delivered yet>"
     );
 
 static const char * const VALID_MODARGS[] = {
@@ -70,6 +72,8 @@ static const char * const VALID_MODARGS[] = {
     "network_id",
     "device_type",
     "source_type",
+    "capture_pipeline",
+    "pipeline_blocks",
     NULL
 };
 
@@ -705,6 +705,28 @@ public:
      */
     virtual int32_t GetBufQueueState(BufferQueueState &bufState) const = 0;
 
+    /**
+     * @brief Gets the span in the shared buffer to write pcm in place, this saves the copies done by Write.
+     * This API should only be used if RENDER_MODE_NORMAL is used, and speed or channel blend is not set.
+     *
+     * @param bufDesc Indicates the buffer descriptor of the span, bufLength is the size of the span.
+     * @return Returns {@link SUCCESS} if the span is successfully obtained; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     * @since 12
+     */
+    virtual int32_t AcquireWriteSpan(BufferDesc &bufDesc) = 0;
+
+    /**
+     * @brief Commits the span obtained by AcquireWriteSpan.
+     *
+     * @param bufDesc Indicates the buffer descriptor of the span, dataLength is the size written. The rest of the
+     * span is filled with silence, dataLength 0 gives up the span.
+     * @return Returns {@link SUCCESS} if the span is successfully committed; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     * @since 12
+     */
+    virtual int32_t CommitWriteSpan(const BufferDesc &bufDesc) = 0;
+
     /**
      * @brief Set the application cache path to access the application resources
      *
@@ -113,6 +113,9 @@ enum class GlobalConfigType {
 enum class PAConfigType {
     AUDIO_LATENCY,
     SINK_LATENCY,
+    EFFECT_PARALLEL,
+    CAPTURE_PIPELINE,
+    PIPELINE_BLOCKS,
     UNKNOWN
 };
 
@@ -248,6 +251,9 @@ public:
 
     std::string audioLatency_ = STR_INIT;
     std::string sinkLatency_ = STR_INIT;
+    std::string effectParallel_ = STR_INIT;
+    std::string capturePipeline_ = STR_INIT;
+    std::string pipelineBlocks_ = STR_INIT;
 };
 
 class GlobalConfigs {
@@ -105,6 +105,9 @@ public:
     std::string sceneName;
     std::string sourceType;
     std::string offloadEnable;
+    std::string effectParallel;
+    std::string capturePipeline;
+    std::string pipelineBlocks;
     std::list<AudioModuleInfo> ports;
 };
 
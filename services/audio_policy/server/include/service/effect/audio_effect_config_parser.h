@@ -32,6 +32,8 @@ public:
     explicit AudioEffectConfigParser();
     ~AudioEffectConfigParser();
     int32_t LoadEffectConfig(OriginalEffectConfig &result);
+    // Loads the given file instead of the audio_effect_config.xml of the system.
+    int32_t LoadEffectConfig(OriginalEffectConfig &result, const std::string &configPath);
 };
 } // namespace AudioStandard
 } // namespace OHOS
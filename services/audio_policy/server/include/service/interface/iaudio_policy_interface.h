@@ -75,6 +75,9 @@ public:
 
     virtual int32_t MoveSinkInputByIndexOrName(uint32_t sinkInputId, uint32_t sinkIndex, std::string sinkName) = 0;
 
+    virtual int32_t MoveSinkInputsByIndexOrName(const std::vector<uint32_t> &sinkInputIds, uint32_t sinkIndex,
+        const std::vector<std::string> &sinkNames) = 0;
+
     virtual int32_t MoveSourceOutputByIndexOrName(uint32_t sourceOutputId,
         uint32_t sourceIndex, std::string sourceName) = 0;
 
@@ -99,6 +99,9 @@ public:
 
     int32_t MoveSinkInputByIndexOrName(uint32_t sinkInputId, uint32_t sinkIndex, std::string sinkName);
 
+    int32_t MoveSinkInputsByIndexOrName(const std::vector<uint32_t> &sinkInputIds, uint32_t sinkIndex,
+        const std::vector<std::string> &sinkNames);
+
     int32_t MoveSourceOutputByIndexOrName(uint32_t sourceOutputId, uint32_t sourceIndex, std::string sourceName);
 
     int32_t SetRingerMode(AudioRingerMode ringerMode);
@@ -1287,8 +1287,10 @@ int32_t AudioPolicyService::MoveToLocalOutputDevice(std::vector<SinkInput> sinkI
     CHECK_AND_RETURN_RET_LOG(LOCAL_NETWORK_ID == localDeviceDescriptor->networkId_,
         ERR_INVALID_OPERATION, "failed: not a local device.");
 
-    // start move.
+    // start move, all the sink inputs at once.
     uint32_t sinkId = -1; // invalid sink id, use sink name instead.
+    std::vector<uint32_t> paStreamIds;
+    std::vector<std::string> sinkNames;
     for (size_t i = 0; i < sinkInputIds.size(); i++) {
         AudioPipeType pipeType = PIPE_TYPE_UNKNOWN;
         streamCollector_.GetPipeType(sinkInputIds[i].streamId, pipeType);
@@ -1298,10 +1300,13 @@ int32_t AudioPolicyService::MoveToLocalOutputDevice(std::vector<SinkInput> sinkI
         }
         AUDIO_INFO_LOG("move for session [%{public}d], portName %{public}s pipeType %{public}d",
             sinkInputIds[i].streamId, sinkName.c_str(), pipeType);
-        int32_t ret = audioPolicyManager_.MoveSinkInputByIndexOrName(sinkInputIds[i].paStreamId, sinkId, sinkName);
-        CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR,
-            "move [%{public}d] to local failed", sinkInputIds[i].streamId);
-        std::lock_guard<std::mutex> lock(routerMapMutex_);
+        paStreamIds.push_back(sinkInputIds[i].paStreamId);
+        sinkNames.push_back(sinkName);
+    }
+    int32_t ret = audioPolicyManager_.MoveSinkInputsByIndexOrName(paStreamIds, sinkId, sinkNames);
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "move [%{public}zu] to local failed", sinkInputIds.size());
+    std::lock_guard<std::mutex> lock(routerMapMutex_);
+    for (size_t i = 0; i < sinkInputIds.size(); i++) {
         routerMap_[sinkInputIds[i].uid] = std::pair(LOCAL_NETWORK_ID, sinkInputIds[i].pid);
     }
 
@@ -1365,11 +1370,16 @@ int32_t AudioPolicyService::MoveToRemoteOutputDevice(std::vector<SinkInput> sink
 
     CHECK_AND_RETURN_RET_LOG(res == SUCCESS, ERR_OPERATION_FAILED, "remote device state is invalid!");
 
-    // start move.
+    // start move, all the sink inputs at once.
+    std::vector<uint32_t> paStreamIds;
+    for (size_t i = 0; i < sinkInputIds.size(); i++) {
+        paStreamIds.push_back(sinkInputIds[i].paStreamId);
+    }
+    int32_t ret = audioPolicyManager_.MoveSinkInputsByIndexOrName(paStreamIds, sinkId,
+        std::vector<std::string>(paStreamIds.size(), moduleName));
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "move [%{public}zu] failed", sinkInputIds.size());
+    std::lock_guard<std::mutex> lock(routerMapMutex_);
     for (size_t i = 0; i < sinkInputIds.size(); i++) {
-        int32_t ret = audioPolicyManager_.MoveSinkInputByIndexOrName(sinkInputIds[i].paStreamId, sinkId, moduleName);
-        CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "move [%{public}d] failed", sinkInputIds[i].streamId);
-        std::lock_guard<std::mutex> lock(routerMapMutex_);
         routerMap_[sinkInputIds[i].uid] = std::pair(moduleName, sinkInputIds[i].pid);
     }
 
@@ -1680,13 +1690,17 @@ int32_t AudioPolicyService::MoveToOutputDevice(uint32_t sessionId, std::string p
 {
     AUDIO_INFO_LOG("move for session [%{public}d], portName %{public}s", sessionId, portName.c_str());
     std::vector<SinkInput> sinkInputIds = FilterSinkInputs(sessionId);
-    // start move.
+    // start move, all the sink inputs at once.
     uint32_t sinkId = -1; // invalid sink id, use sink name instead.
+    std::vector<uint32_t> paStreamIds;
+    for (size_t i = 0; i < sinkInputIds.size(); i++) {
+        paStreamIds.push_back(sinkInputIds[i].paStreamId);
+    }
+    int32_t ret = audioPolicyManager_.MoveSinkInputsByIndexOrName(paStreamIds, sinkId,
+        std::vector<std::string>(paStreamIds.size(), portName));
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "move [%{public}zu] to local failed", sinkInputIds.size());
+    std::lock_guard<std::mutex> lock(routerMapMutex_);
     for (size_t i = 0; i < sinkInputIds.size(); i++) {
-        int32_t ret = audioPolicyManager_.MoveSinkInputByIndexOrName(sinkInputIds[i].paStreamId, sinkId, portName);
-        CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR,
-            "move [%{public}d] to local failed", sinkInputIds[i].streamId);
-        std::lock_guard<std::mutex> lock(routerMapMutex_);
         routerMap_[sinkInputIds[i].uid] = std::pair(LOCAL_NETWORK_ID, sinkInputIds[i].pid);
     }
     return SUCCESS;
@@ -7832,11 +7846,14 @@ void AudioPolicyService::AudioPolicyParserDump(std::string &dumpString)
             interrupt.second.c_str());
     }
     AppendFormat(dumpString, " - globalConfig  adapter:%s, pipe:%s, device:%s, updateRouteSupport:%d, "
-        "audioLatency:%s, sinkLatency:%s\n", globalConfigs_.adapter_.c_str(),
-        globalConfigs_.pipe_.c_str(), globalConfigs_.device_.c_str(),
+        "audioLatency:%s, sinkLatency:%s, effectParallel:%s, capturePipeline:%s, pipelineBlocks:%s\n",
+        globalConfigs_.adapter_.c_str(), globalConfigs_.pipe_.c_str(), globalConfigs_.device_.c_str(),
         globalConfigs_.updateRouteSupport_,
         globalConfigs_.globalPaConfigs_.audioLatency_.c_str(),
-        globalConfigs_.globalPaConfigs_.sinkLatency_.c_str());
+        globalConfigs_.globalPaConfigs_.sinkLatency_.c_str(),
+        globalConfigs_.globalPaConfigs_.effectParallel_.c_str(),
+        globalConfigs_.globalPaConfigs_.capturePipeline_.c_str(),
+        globalConfigs_.globalPaConfigs_.pipelineBlocks_.c_str());
     for (auto &outputConfig : globalConfigs_.outputConfigInfos_) {
         AppendFormat(dumpString, " - output config name:%s, type:%s, value:%s\n", outputConfig.name_.c_str(),
             outputConfig.type_.c_str(), outputConfig.value_.c_str());
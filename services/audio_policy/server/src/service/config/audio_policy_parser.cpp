@@ -278,6 +278,13 @@ void AudioPolicyParser::ConvertAdapterInfoToAudioModuleInfo()
                 shouldEnableOffload && pipeInfo.paPropRole_ == MODULE_TYPE_SINK) {
                 audioModuleInfo.offloadEnable = "1";
             }
+            if (adapterType == AdaptersType::TYPE_PRIMARY && pipeInfo.paPropRole_ == MODULE_TYPE_SINK) {
+                audioModuleInfo.effectParallel = globalConfigs_.globalPaConfigs_.effectParallel_;
+            }
+            if (adapterType == AdaptersType::TYPE_PRIMARY && pipeInfo.paPropRole_ == MODULE_TYPE_SOURCE) {
+                audioModuleInfo.capturePipeline = globalConfigs_.globalPaConfigs_.capturePipeline_;
+                audioModuleInfo.pipelineBlocks = globalConfigs_.globalPaConfigs_.pipelineBlocks_;
+            }
             audioModuleList.push_back(audioModuleInfo);
         }
         std::list<AudioModuleInfo> audioModuleListTmp = audioModuleList;
@@ -624,6 +631,15 @@ void AudioPolicyParser::ParsePAConfigs(xmlNode &node)
                     portObserver_.OnSinkLatencyParsed((uint64_t)std::stoi(value));
                     globalConfigs_.globalPaConfigs_.sinkLatency_ = value;
                     break;
+                case PAConfigType::EFFECT_PARALLEL:
+                    globalConfigs_.globalPaConfigs_.effectParallel_ = value;
+                    break;
+                case PAConfigType::CAPTURE_PIPELINE:
+                    globalConfigs_.globalPaConfigs_.capturePipeline_ = value;
+                    break;
+                case PAConfigType::PIPELINE_BLOCKS:
+                    globalConfigs_.globalPaConfigs_.pipelineBlocks_ = value;
+                    break;
                 default:
                     ParsePAConfigs(*(currNode->children));
                     break;
@@ -783,6 +799,12 @@ PAConfigType AudioPolicyParser::GetPaConfigType(std::string &name)
         return PAConfigType::AUDIO_LATENCY;
     } else if (name =="sinkLatency") {
         return PAConfigType::SINK_LATENCY;
+    } else if (name =="effectParallel") {
+        return PAConfigType::EFFECT_PARALLEL;
+    } else if (name =="capturePipeline") {
+        return PAConfigType::CAPTURE_PIPELINE;
+    } else if (name =="pipelineBlocks") {
+        return PAConfigType::PIPELINE_BLOCKS;
     } else {
         return PAConfigType::UNKNOWN;
     }
@@ -695,15 +695,12 @@ static void LoadEffectConfigException(OriginalEffectConfig &result, const xmlNod
     }
 }
 
-int32_t AudioEffectConfigParser::LoadEffectConfig(OriginalEffectConfig &result)
+// Frees the doc when done.
+static int32_t LoadEffectConfigDoc(OriginalEffectConfig &result, xmlDoc *doc)
 {
     int32_t countFirstNode[NODE_SIZE] = {0};
-    xmlDoc *doc = nullptr;
     xmlNode *rootElement = nullptr;
 
-    int32_t ret = ParseEffectConfigFile(doc);
-    CHECK_AND_RETURN_RET_LOG(ret == 0, ret, "error: could not parse audio effect config file");
-
     rootElement = xmlDocGetRootElement(doc);
     xmlNode *currNode = rootElement;
 
@@ -749,5 +746,21 @@ int32_t AudioEffectConfigParser::LoadEffectConfig(OriginalEffectConfig &result)
     }
     return 0;
 }
+
+int32_t AudioEffectConfigParser::LoadEffectConfig(OriginalEffectConfig &result)
+{
+    xmlDoc *doc = nullptr;
+    int32_t ret = ParseEffectConfigFile(doc);
+    CHECK_AND_RETURN_RET_LOG(ret == 0, ret, "error: could not parse audio effect config file");
+    return LoadEffectConfigDoc(result, doc);
+}
+
+int32_t AudioEffectConfigParser::LoadEffectConfig(OriginalEffectConfig &result, const std::string &configPath)
+{
+    xmlDoc *doc = xmlReadFile(configPath.c_str(), nullptr, XML_PARSE_NOERROR | XML_PARSE_NOWARNING);
+    CHECK_AND_RETURN_RET_LOG(doc != nullptr, FILE_PARSE_ERROR, "load audio effect config %{public}s fail",
+        configPath.c_str());
+    return LoadEffectConfigDoc(result, doc);
+}
 } // namespace AudioStandard
 } // namespace OHOS
\ No newline at end of file
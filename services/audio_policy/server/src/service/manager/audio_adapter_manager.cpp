@@ -384,15 +384,9 @@ int32_t AudioAdapterManager::SetVolumeDb(AudioStreamType streamType)
 int32_t AudioAdapterManager::SetVolumeDbForVolumeTypeGroup(const std::vector<AudioStreamType> &volumeTypeGroup,
     float volumeDb)
 {
-    int32_t result = SUCCESS;
-    for (auto &streamType: volumeTypeGroup) {
-        result = audioServiceAdapter_->SetVolumeDb(streamType, volumeDb);
-        if (result != SUCCESS) {
-            // The operation of setting volume has failed, return error directly.
-            return result;
-        }
-    }
-    return result;
+    // The whole group is set in one pass over the sink inputs.
+    std::set<AudioStreamType> streamTypes(volumeTypeGroup.begin(), volumeTypeGroup.end());
+    return audioServiceAdapter_->SetVolumeDbBatch(streamTypes);
 }
 
 int32_t AudioAdapterManager::GetSystemVolumeLevel(AudioStreamType streamType)
@@ -640,6 +634,12 @@ int32_t AudioAdapterManager::MoveSinkInputByIndexOrName(uint32_t sinkInputId, ui
     return audioServiceAdapter_->MoveSinkInputByIndexOrName(sinkInputId, sinkIndex, sinkName);
 }
 
+int32_t AudioAdapterManager::MoveSinkInputsByIndexOrName(const std::vector<uint32_t> &sinkInputIds,
+    uint32_t sinkIndex, const std::vector<std::string> &sinkNames)
+{
+    return audioServiceAdapter_->MoveSinkInputsByIndexOrName(sinkInputIds, sinkIndex, sinkNames);
+}
+
 int32_t AudioAdapterManager::MoveSourceOutputByIndexOrName(uint32_t sourceOutputId, uint32_t sourceIndex,
     std::string sourceName)
 {
@@ -731,6 +731,11 @@ void UpdateSinkArgs(const AudioModuleInfo &audioModuleInfo, std::string &args)
         args.append(" device_type=");
         args.append(audioModuleInfo.deviceType);
     }
+
+    if (!audioModuleInfo.effectParallel.empty()) {
+        args.append(" effect_parallel=");
+        args.append(audioModuleInfo.effectParallel);
+    }
 }
 
 void UpdateSourceArgs(const AudioModuleInfo &audioModuleInfo, std::string &args)
@@ -771,6 +776,16 @@ void UpdateSourceArgs(const AudioModuleInfo &audioModuleInfo, std::string &args)
         args.append(" source_type=");
         args.append(audioModuleInfo.sourceType);
     }
+
+    if (!audioModuleInfo.capturePipeline.empty()) {
+        args.append(" capture_pipeline=");
+        args.append(audioModuleInfo.capturePipeline);
+    }
+
+    if (!audioModuleInfo.pipelineBlocks.empty()) {
+        args.append(" pipeline_blocks=");
+        args.append(audioModuleInfo.pipelineBlocks);
+    }
 }
 
 void UpdateCommonArgs(const AudioModuleInfo &audioModuleInfo, std::string &args)
@@ -60,7 +60,7 @@ public:
 
     virtual int32_t GetBufferDesc(BufferDesc &bufDesc) const = 0;
 
-    virtual int32_t Enqueue(const BufferDesc &bufDesc) const = 0;
+    virtual int32_t Enqueue(const BufferDesc &bufDesc) = 0;
 
     virtual int32_t SetVolume(int32_t vol) = 0;
 
@@ -98,6 +98,8 @@ public:
     int32_t GetBufQueueState(BufferQueueState &bufState) override;
     int32_t Enqueue(const BufferDesc &bufDesc) override;
     int32_t Clear() override;
+    int32_t AcquireWriteSpan(BufferDesc &bufDesc) override;
+    int32_t CommitWriteSpan(const BufferDesc &bufDesc) override;
 
     int32_t SetLowPowerVolume(float volume) override;
     float GetLowPowerVolume() override;
@@ -212,6 +214,9 @@ private:
     int32_t DrainRingCache();
 
     int32_t WriteCacheData(bool isDrain = false);
+    int32_t WaitForWriteSpan(uint64_t &curWriteIndex, BufferDesc &desc);
+    int32_t CommitWriteSpanInner(uint64_t curWriteIndex, BufferDesc &desc);
+    int32_t WriteDirectData(const uint8_t *buffer);
 
     void InitCallbackBuffer(uint64_t bufferDurationInUs);
     void WriteCallbackFunc();
@@ -286,6 +291,7 @@ private:
     std::string dumpOutFile_ = "";
     FILE *dumpOutFd_ = nullptr;
     mutable int64_t volumeDataCount_ = 0;
+    mutable uint32_t volumeSampleIndex_ = 0;
     std::string logUtilsTag_ = "";
 
     std::shared_ptr<AudioRendererFirstFrameWritingCallback> firstFrameWritingCb_ = nullptr;
@@ -330,8 +336,10 @@ private:
     std::shared_ptr<OHAudioBuffer> clientBuffer_ = nullptr;
 
     // buffer handle
-    std::unique_ptr<AudioRingCache> ringCache_ = nullptr;
+    std::unique_ptr<AudioSpscRingCache> ringCache_ = nullptr;
     std::mutex writeMutex_; // used for prevent multi thread call write
+    bool writeSpanAcquired_ = false; // span at acquiredWriteFrame_ is handed to app by AcquireWriteSpan
+    uint64_t acquiredWriteFrame_ = 0;
 
     // Mark reach and period reach callback
     int64_t totalBytesWritten_ = 0;
@@ -369,6 +377,7 @@ private:
     uint64_t lastFrameTimestamp_ = 0;
 
     std::string traceTag_;
+    std::string writeTraceTag_; // traceTag_ + " WriteSize:", prebuilt for WriteInner
     std::string spatializationEnabled_ = "Invalid";
     std::string headTrackingEnabled_ = "Invalid";
     uint32_t spatializationRegisteredSessionID_ = 0;
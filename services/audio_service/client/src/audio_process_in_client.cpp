@@ -18,6 +18,7 @@
 
 #include "audio_process_in_client.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cinttypes>
 #include <condition_variable>
@@ -30,6 +31,7 @@
 #include "system_ability_definition.h"
 
 #include "audio_errors.h"
+#include "audio_mix_kernel.h"
 #include "audio_service_log.h"
 #include "audio_system_manager.h"
 #include "audio_utils.h"
@@ -41,6 +43,9 @@
 #include "i_audio_process.h"
 #include "linear_pos_time_model.h"
 #include "audio_log_utils.h"
+#include "audio_wakeup_scheduler.h"
+#include "futex_tool.h"
+#include "volume_tools.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -49,6 +54,14 @@ namespace {
 static constexpr int32_t VOLUME_SHIFT_NUMBER = 16; // 1 >> 16 = 65536, max volume
 static const int64_t DELAY_RESYNC_TIME = 10000000000; // 10s
 static const int32_t HALF_FACTOR = 2;
+static const int64_t AUDIO_NS_PER_US = 1000;
+static const float MISS_RATE_TRACE_SCALE = 10000.0f; // the miss rate is traced in 0.01% steps
+static const std::string READ_PROCESS_DATA_TRACE_TAG = "AudioProcessInClient::ReadProcessData-<";
+static const std::string WRITE_PROCESS_DATA_TRACE_TAG = "AudioProcessInClient::WriteProcessData->";
+static const std::string PREPARE_NEXT_TRACE_TAG = "AudioProcessInClient::PrepareNext ";
+static const std::string PREPARE_CURRENT_TRACE_TAG = "AudioProcessInClient::PrepareCurrent ";
+static const std::string FINISH_HANDLE_CURRENT_TRACE_TAG = "AudioProcessInClient::FinishHandleCurrent ";
+static const std::string PREPARE_NEXT_LOOP_TRACE_TAG = "AudioEndpoint::PrepareNextLoop ";
 }
 
 class ProcessCbImpl;
@@ -64,7 +77,7 @@ public:
 
     int32_t GetBufferDesc(BufferDesc &bufDesc) const override;
 
-    int32_t Enqueue(const BufferDesc &bufDesc) const override;
+    int32_t Enqueue(const BufferDesc &bufDesc) override;
 
     int32_t SetVolume(int32_t vol) override;
 
@@ -118,6 +131,8 @@ public:
     static const sptr<IStandardAudioService> GetAudioServerProxy();
     static void AudioServerDied(pid_t pid);
     static constexpr AudioStreamInfo g_targetStreamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, STEREO};
+    // Formats the fast endpoint mixes by itself, they are written to the server without conversion.
+    static bool NeedServerMix(const AudioStreamInfo &streamInfo);
 
 private:
     // move it to a common folder
@@ -151,24 +166,28 @@ private:
     void ProcessCallbackFuc();
     void ProcessCallbackFucIndependent();
     void RecordProcessCallbackFuc();
-    void CopyWithVolume(const BufferDesc &srcDesc, const BufferDesc &dstDesc) const;
-    void ProcessVolume(const AudioStreamData &targetData) const;
-    int32_t ProcessData(const BufferDesc &srcDesc, const BufferDesc &dstDesc) const;
+    void CopyWithVolume(const BufferDesc &srcDesc, const BufferDesc &dstDesc);
+    void ProcessVolume(const AudioStreamData &targetData);
+    void ApplyVolume(const BufferDesc &buffer, const AudioStreamInfo &streamInfo, int32_t targetVolume);
+    int32_t GetTargetVolume() const;
+    int32_t ProcessData(const BufferDesc &srcDesc, const BufferDesc &dstDesc);
     void CheckIfWakeUpTooLate(int64_t &curTime, int64_t &wakeUpTime);
     void CheckIfWakeUpTooLate(int64_t &curTime, int64_t &wakeUpTime, int64_t clientWriteCost);
+    void UpdateWakeUpMargin(int64_t demand, bool missed);
+    void LogWakeUpStats();
     void DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const;
 
     void DoFadeInOut(uint64_t &curWritePos);
 
 private:
-    static constexpr int64_t MILLISECOND_PER_SECOND = 1000; // 1000ms
     static constexpr int64_t ONE_MILLISECOND_DURATION = 1000000; // 1ms
     static constexpr int64_t THREE_MILLISECOND_DURATION = 3000000; // 3ms
     static constexpr int64_t MAX_WRITE_COST_DURATION_NANO = 5000000; // 5ms
     static constexpr int64_t MAX_READ_COST_DURATION_NANO = 5000000; // 5ms
-    static constexpr int64_t WRITE_BEFORE_DURATION_NANO = 2000000; // 2ms
+    static constexpr int64_t WRITE_BEFORE_DURATION_NANO = 2000000; // 2ms, initial wake up margin of playback
     static constexpr int64_t RECORD_RESYNC_SLEEP_NANO = 2000000; // 2ms
-    static constexpr int64_t RECORD_HANDLE_DELAY_NANO = 3000000; // 3ms
+    static constexpr int64_t RECORD_HANDLE_DELAY_NANO = 3000000; // 3ms, initial wake up margin of record
+    static constexpr int64_t MIN_WAKE_UP_MARGIN_NANO = 500000; // 0.5ms
     static constexpr size_t MAX_TIMES = 4; // 4 times spanSizeInFrame_
     static constexpr size_t DIV = 2; // halt of span
     static constexpr int64_t MAX_STOP_FADING_DURATION_NANO = 10000000; // 10ms
@@ -192,7 +211,7 @@ private:
     uint32_t totalSizeInFrame_ = 0;
     uint32_t spanSizeInFrame_ = 0;
     uint32_t byteSizePerFrame_ = 0;
-    uint32_t spanSizeInMs_ = 0;
+    int64_t spanDuration_ = 0; // nano second, spans may last a fraction of millisecond
     size_t spanSizeInByte_ = 0;
     std::weak_ptr<AudioDataCallback> audioDataCallback_;
     std::weak_ptr<ClientUnderrunCallBack> underrunCallback_;
@@ -208,7 +227,14 @@ private:
     float volumeInFloat_ = 1.0f;
     float duckVolumeInFloat_ = 1.0f;
     int32_t processVolume_ = PROCESS_VOLUME_MAX; // 0 ~ 65536
+    // Volume at the end of the last span written, the next span ramps from it. Only used by the writing thread.
+    int32_t appliedVolume_ = PROCESS_VOLUME_MAX;
     LinearPosTimeModel handleTimeModel_;
+    // Margin between the wake up and the predicted server handle time, learned from the cycles of the callback loop.
+    AudioWakeupScheduler wakeUpScheduler_;
+    int64_t nextHandleTime_ = 0; // predicted server handle time of the span handled at the next wake up
+    std::string wakeUpMarginTag_ = "";
+    std::string wakeUpMissRateTag_ = "";
 
     std::thread callbackLoop_; // thread for callback to client and write.
     bool isCallbackLoopEnd_ = false;
@@ -222,6 +248,7 @@ private:
     std::string cachePath_;
     FILE *dumpFile_ = nullptr;
     mutable int64_t volumeDataCount_ = 0;
+    mutable uint32_t volumeSampleIndex_ = 0;
     std::string logUtilsTag_ = "";
 
     std::atomic<bool> startFadein_ = false; // true-fade  in  when start or resume stream
@@ -316,6 +343,10 @@ std::shared_ptr<AudioProcessInClient> AudioProcessInClient::Create(const AudioPr
     if (config.rendererInfo.streamUsage != STREAM_USAGE_VOICE_COMMUNICATION &&
         config.capturerInfo.sourceType != SOURCE_TYPE_VOICE_COMMUNICATION) {
         resetConfig.streamInfo = AudioProcessInClientInner::g_targetStreamInfo;
+        if (config.audioMode == AUDIO_MODE_PLAYBACK && AudioProcessInClientInner::NeedServerMix(config.streamInfo)) {
+            resetConfig.streamInfo.format = config.streamInfo.format;
+            resetConfig.streamInfo.channels = config.streamInfo.channels;
+        }
     } else {
         isVoipMmap = true;
     }
@@ -520,7 +551,8 @@ bool AudioProcessInClientInner::InitAudioBuffer()
 
     audioBuffer_->GetSizeParameter(totalSizeInFrame_, spanSizeInFrame_, byteSizePerFrame_);
     spanSizeInByte_ = spanSizeInFrame_ * byteSizePerFrame_;
-    spanSizeInMs_ = spanSizeInFrame_ * MILLISECOND_PER_SECOND / processConfig_.streamInfo.samplingRate;
+    spanDuration_ = static_cast<int64_t>(spanSizeInFrame_) * AUDIO_NS_PER_SECOND /
+        static_cast<int64_t>(processConfig_.streamInfo.samplingRate);
 
     clientSpanSizeInByte_ = spanSizeInFrame_ * clientByteSizePerFrame_;
     if (processConfig_.audioMode == AUDIO_MODE_PLAYBACK) {
@@ -532,8 +564,8 @@ bool AudioProcessInClientInner::InitAudioBuffer()
     }
 
     AUDIO_INFO_LOG("Using totalSizeInFrame_ %{public}d spanSizeInFrame_ %{public}d byteSizePerFrame_ %{public}d "
-        "spanSizeInByte_ %{public}zu, spanSizeInMs_ %{public}u", totalSizeInFrame_, spanSizeInFrame_,
-        byteSizePerFrame_, spanSizeInByte_, spanSizeInMs_);
+        "spanSizeInByte_ %{public}zu, spanDuration_ %{public}" PRId64 "ns", totalSizeInFrame_, spanSizeInFrame_,
+        byteSizePerFrame_, spanSizeInByte_, spanDuration_);
 
     callbackBuffer_ = std::make_unique<uint8_t[]>(clientSpanSizeInByte_);
     CHECK_AND_RETURN_RET_LOG(callbackBuffer_ != nullptr, false, "Init callbackBuffer_ failed.");
@@ -558,6 +590,7 @@ static size_t GetFormatSize(const AudioStreamInfo &info)
             bitWidthSize = 3; // size is 3
             break;
         case SAMPLE_S32LE:
+        case SAMPLE_F32LE:
             bitWidthSize = 4; // size is 4
             break;
         default:
@@ -574,7 +607,7 @@ static size_t GetFormatSize(const AudioStreamInfo &info)
             channelSize = 2; // size is 2
             break;
         default:
-            channelSize = 2; // size is 2
+            channelSize = info.channels <= MIX_CHANNEL_MAX ? info.channels : 2; // default size is 2
             break;
     }
     result = bitWidthSize * channelSize;
@@ -586,7 +619,8 @@ bool AudioProcessInClientInner::Init(const AudioProcessConfig &config)
     AUDIO_INFO_LOG("Call Init.");
     processConfig_ = config;
     if (!isVoipMmap_ && (config.streamInfo.format != g_targetStreamInfo.format ||
-        config.streamInfo.channels != g_targetStreamInfo.channels)) {
+        config.streamInfo.channels != g_targetStreamInfo.channels) &&
+        (config.audioMode != AUDIO_MODE_PLAYBACK || !NeedServerMix(config.streamInfo))) {
         needConvert_ = true;
     }
     clientByteSizePerFrame_ = GetFormatSize(config.streamInfo);
@@ -604,6 +638,14 @@ bool AudioProcessInClientInner::Init(const AudioProcessConfig &config)
 
     streamStatus_->store(StreamStatus::STREAM_IDEL);
 
+    if (config.audioMode == AUDIO_MODE_RECORD) {
+        wakeUpScheduler_.Config(RECORD_HANDLE_DELAY_NANO, MIN_WAKE_UP_MARGIN_NANO, MAX_READ_COST_DURATION_NANO);
+    } else {
+        wakeUpScheduler_.Config(WRITE_BEFORE_DURATION_NANO, MIN_WAKE_UP_MARGIN_NANO, MAX_WRITE_COST_DURATION_NANO);
+    }
+    wakeUpMarginTag_ = "WakeUpMargin::" + std::to_string(sessionId_);
+    wakeUpMissRateTag_ = "WakeUpMissRate::" + std::to_string(sessionId_);
+
     AudioBufferHolder bufferHolder = audioBuffer_->GetBufferHolder();
     bool isIndependent = bufferHolder == AudioBufferHolder::AUDIO_SERVER_INDEPENDENT;
     if (config.audioMode == AUDIO_MODE_RECORD) {
@@ -658,7 +700,7 @@ int32_t AudioProcessInClientInner::ReadFromProcessClient() const
     CHECK_AND_RETURN_RET_LOG(audioBuffer_ != nullptr, ERR_INVALID_HANDLE,
         "%{public}s audio buffer is null.", __func__);
     uint64_t curReadPos = audioBuffer_->GetCurReadFrame();
-    Trace trace("AudioProcessInClient::ReadProcessData-<" + std::to_string(curReadPos));
+    Trace trace(READ_PROCESS_DATA_TRACE_TAG, curReadPos);
     BufferDesc readbufDesc = {nullptr, 0, 0};
     int32_t ret = audioBuffer_->GetReadbuffer(curReadPos, readbufDesc);
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS && readbufDesc.buffer != nullptr &&
@@ -709,6 +751,10 @@ bool AudioProcessInClient::CheckIfSupport(const AudioProcessConfig &config)
         return false;
     }
 
+    if (config.audioMode == AUDIO_MODE_PLAYBACK && AudioProcessInClientInner::NeedServerMix(config.streamInfo)) {
+        return true;
+    }
+
     if (config.streamInfo.format != SAMPLE_S16LE && config.streamInfo.format != SAMPLE_S32LE) {
         return false;
     }
@@ -719,6 +765,13 @@ bool AudioProcessInClient::CheckIfSupport(const AudioProcessConfig &config)
     return true;
 }
 
+bool AudioProcessInClientInner::NeedServerMix(const AudioStreamInfo &streamInfo)
+{
+    bool canConvert = (streamInfo.format == SAMPLE_S16LE || streamInfo.format == SAMPLE_S32LE) &&
+        (streamInfo.channels == MONO || streamInfo.channels == STEREO);
+    return !canConvert && AudioMixKernel::IsFormatSupported(streamInfo.format, streamInfo.channels);
+}
+
 inline bool S16MonoToS16Stereo(const BufferDesc &srcDesc, const BufferDesc &dstDesc)
 {
     size_t half = 2;
@@ -800,34 +853,50 @@ bool AudioProcessInClientInner::ChannelFormatConvert(const AudioStreamData &srcD
     return false;
 }
 
-void AudioProcessInClientInner::CopyWithVolume(const BufferDesc &srcDesc, const BufferDesc &dstDesc) const
+int32_t AudioProcessInClientInner::GetTargetVolume() const
 {
-    size_t len = dstDesc.dataLength;
-    len /= 2; // SAMPLE_S16LE--> 2 byte
-    int16_t *dstPtr = reinterpret_cast<int16_t *>(dstDesc.buffer);
-    for (size_t pos = 0; len > 0; len--) {
-        int32_t sum = 0;
-        int16_t *srcPtr = reinterpret_cast<int16_t *>(srcDesc.buffer) + pos;
-        sum += (*srcPtr * static_cast<int64_t>(processVolume_ * duckVolumeInFloat_)) >> VOLUME_SHIFT_NUMBER; // 1/65536
-        pos++;
-        *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+    return static_cast<int32_t>(processVolume_ * duckVolumeInFloat_);
+}
+
+// A volume change ramps over one span with the same kernels as DoFadeInOut, so it does not click.
+void AudioProcessInClientInner::ApplyVolume(const BufferDesc &buffer, const AudioStreamInfo &streamInfo,
+    int32_t targetVolume)
+{
+    int32_t startVolume = appliedVolume_;
+    appliedVolume_ = targetVolume;
+    ChannelVolumes vols = VolumeTools::GetChannelVolumes(static_cast<AudioChannel>(streamInfo.channels),
+        startVolume, targetVolume);
+    BufferDesc volumeDesc = {buffer.buffer, buffer.dataLength, buffer.dataLength};
+    int32_t ret = VolumeTools::Process(volumeDesc, streamInfo.format, vols);
+    if (ret != SUCCESS) {
+        AUDIO_WARNING_LOG("apply volume %{public}d to %{public}d failed:%{public}d", startVolume, targetVolume, ret);
     }
 }
 
-void AudioProcessInClientInner::ProcessVolume(const AudioStreamData &targetData) const
+void AudioProcessInClientInner::CopyWithVolume(const BufferDesc &srcDesc, const BufferDesc &dstDesc)
 {
-    size_t half = 2;
-    size_t len = targetData.bufferDesc.dataLength;
-    len /= half;
-    int16_t *dstPtr = reinterpret_cast<int16_t *>(targetData.bufferDesc.buffer);
-    for (; len > 0; len--) {
-        int32_t sum = 0;
-        sum += (*dstPtr * static_cast<int64_t>(processVolume_ * duckVolumeInFloat_)) >> VOLUME_SHIFT_NUMBER;
-        *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+    int32_t targetVolume = GetTargetVolume();
+    size_t len = std::min(srcDesc.dataLength, dstDesc.dataLength);
+    const AudioStreamInfo &streamInfo = processConfig_.streamInfo;
+    if (targetVolume == appliedVolume_ && streamInfo.format == SAMPLE_S16LE) {
+        // steady volume, the copy and the volume are done in one pass
+        AudioMixKernel::ApplyVolumeS16(reinterpret_cast<const int16_t *>(srcDesc.buffer), targetVolume,
+            reinterpret_cast<int16_t *>(dstDesc.buffer), len / sizeof(int16_t));
+        return;
+    }
+    if (memcpy_s(dstDesc.buffer, dstDesc.bufLength, srcDesc.buffer, len) != EOK) {
+        AUDIO_ERR_LOG("copy span failed");
+        return;
     }
+    ApplyVolume({dstDesc.buffer, len, len}, streamInfo, targetVolume);
 }
 
-int32_t AudioProcessInClientInner::ProcessData(const BufferDesc &srcDesc, const BufferDesc &dstDesc) const
+void AudioProcessInClientInner::ProcessVolume(const AudioStreamData &targetData)
+{
+    ApplyVolume(targetData.bufferDesc, targetData.streamInfo, GetTargetVolume());
+}
+
+int32_t AudioProcessInClientInner::ProcessData(const BufferDesc &srcDesc, const BufferDesc &dstDesc)
 {
     int32_t ret = 0;
     size_t round = (spanSizeInFrame_ == 0 ? 1 : clientSpanSizeInFrame_ / spanSizeInFrame_);
@@ -855,7 +924,7 @@ int32_t AudioProcessInClientInner::ProcessData(const BufferDesc &srcDesc, const
     return SUCCESS;
 }
 
-int32_t AudioProcessInClientInner::Enqueue(const BufferDesc &bufDesc) const
+int32_t AudioProcessInClientInner::Enqueue(const BufferDesc &bufDesc)
 {
     Trace trace("AudioProcessInClient::Enqueue");
     CHECK_AND_RETURN_RET_LOG(isInited_, ERR_ILLEGAL_STATE, "not inited!");
@@ -880,7 +949,7 @@ int32_t AudioProcessInClientInner::Enqueue(const BufferDesc &bufDesc) const
         uint64_t curPos = curWritePos + count * spanSizeInFrame_;
         if (processConfig_.audioMode == AUDIO_MODE_PLAYBACK) {
             BufferDesc curWriteBuffer = {nullptr, 0, 0};
-            Trace writeProcessDataTrace("AudioProcessInClient::WriteProcessData->" + std::to_string(curPos));
+            Trace writeProcessDataTrace(WRITE_PROCESS_DATA_TRACE_TAG, curPos);
             int32_t ret = audioBuffer_->GetWriteBuffer(curPos, curWriteBuffer);
             CHECK_AND_RETURN_RET_LOG(ret == SUCCESS && curWriteBuffer.buffer != nullptr &&
                 curWriteBuffer.bufLength == spanSizeInByte_ && curWriteBuffer.dataLength == spanSizeInByte_,
@@ -905,13 +974,17 @@ int32_t AudioProcessInClientInner::Enqueue(const BufferDesc &bufDesc) const
 
 void AudioProcessInClientInner::DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const
 {
+    int64_t step = AudioLogUtils::GetVolumeSampleStep(volumeSampleIndex_);
+    if (step == 0) {
+        return;
+    }
     ChannelVolumes vols = VolumeTools::CountVolumeLevel(buffer, format, channel);
     if (channel == MONO) {
-        Trace::Count(logUtilsTag_, vols.volStart[0]);
+        Trace::HotPathCount(logUtilsTag_, vols.volStart[0]);
     } else {
-        Trace::Count(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
+        Trace::HotPathCount(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
     }
-    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_);
+    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_, step);
 }
 
 int32_t AudioProcessInClientInner::SetVolume(int32_t vol)
@@ -1203,15 +1276,16 @@ int64_t AudioProcessInClientInner::GetPredictNextHandleTime(uint64_t posInFrame,
 
 bool AudioProcessInClientInner::PrepareNext(uint64_t curHandPos, int64_t &wakeUpTime)
 {
-    Trace trace("AudioProcessInClient::PrepareNext " + std::to_string(curHandPos));
+    Trace trace(PREPARE_NEXT_TRACE_TAG, curHandPos);
     int64_t handleModifyTime = 0;
     if (processConfig_.audioMode == AUDIO_MODE_RECORD) {
-        handleModifyTime = RECORD_HANDLE_DELAY_NANO;
+        handleModifyTime = wakeUpScheduler_.GetMargin();
     } else {
-        handleModifyTime = -WRITE_BEFORE_DURATION_NANO;
+        handleModifyTime = -wakeUpScheduler_.GetMargin();
     }
 
-    int64_t nextServerHandleTime = GetPredictNextHandleTime(curHandPos) + handleModifyTime;
+    nextHandleTime_ = GetPredictNextHandleTime(curHandPos);
+    int64_t nextServerHandleTime = nextHandleTime_ + handleModifyTime;
     if (nextServerHandleTime < ClockTime::GetCurNano()) {
         wakeUpTime = ClockTime::GetCurNano() + ONE_MILLISECOND_DURATION; // make sure less than duration
     } else {
@@ -1329,13 +1403,17 @@ void AudioProcessInClientInner::RecordProcessCallbackFuc()
     uint64_t curReadPos = 0;
     int64_t wakeUpTime = ClockTime::GetCurNano();
     int64_t clientReadCost = 0;
+    bool isWakeUpPlanned = false; // woke up at the time planned by PrepareNext, without wait nor retry in between
 
     while (!isCallbackLoopEnd_ && audioBuffer_ != nullptr) {
         if (!KeepLoopRunning()) {
+            isWakeUpPlanned = false;
             continue;
         }
         threadStatus_ = INRUNNING;
         Trace traceLoop("AudioProcessInClient Record InRunning");
+        bool hasDeadline = isWakeUpPlanned;
+        isWakeUpPlanned = false;
         if (needReSyncPosition_ && RecordReSyncServicePos() == SUCCESS) {
             wakeUpTime = ClockTime::GetCurNano();
             needReSyncPosition_ = false;
@@ -1349,8 +1427,14 @@ void AudioProcessInClientInner::RecordProcessCallbackFuc()
         }
 
         curReadPos = audioBuffer_->GetCurReadFrame();
+        SpanInfo *curReadSpan = audioBuffer_->GetSpanInfo(curReadPos);
+        bool isSpanReady = curReadSpan != nullptr && curReadSpan->spanStatus.load() == SpanStatus::SPAN_WRITE_DONE;
         int32_t recordPrepare = RecordPrepareCurrent(curReadPos);
         CHECK_AND_CONTINUE_LOG(recordPrepare == SUCCESS, "prepare current fail.");
+        if (hasDeadline) {
+            // the server wrote the span that long after its predicted handle time
+            UpdateWakeUpMargin(curReadSpan->writeDoneTime - nextHandleTime_, !isSpanReady);
+        }
         CallClientHandleCurrent();
         int32_t recordFinish = RecordFinishHandleCurrent(curReadPos, clientReadCost);
         CHECK_AND_CONTINUE_LOG(recordFinish == SUCCESS, "finish handle current fail.");
@@ -1360,15 +1444,16 @@ void AudioProcessInClientInner::RecordProcessCallbackFuc()
 
         threadStatus_ = SLEEPING;
         curTime = ClockTime::GetCurNano();
-        if (wakeUpTime > curTime && wakeUpTime - curTime < static_cast<int64_t>(spanSizeInMs_) *
-            ONE_MILLISECOND_DURATION + clientReadCost) {
+        if (wakeUpTime > curTime && wakeUpTime - curTime < spanDuration_ + clientReadCost) {
+            isWakeUpPlanned = true;
             ClockTime::AbsoluteSleep(wakeUpTime);
         } else {
             Trace trace("RecordBigWakeUpTime");
             AUDIO_WARNING_LOG("%{public}s wakeUpTime is too late...", __func__);
-            ClockTime::RelativeSleep(spanSizeInMs_ * ONE_MILLISECOND_DURATION);
+            ClockTime::RelativeSleep(spanDuration_);
         }
     }
+    LogWakeUpStats();
 }
 
 int32_t AudioProcessInClientInner::RecordReSyncServicePos()
@@ -1394,7 +1479,7 @@ int32_t AudioProcessInClientInner::RecordReSyncServicePos()
     }
     AUDIO_INFO_LOG("%{public}s get handle info OK, tryTimes %{public}d, serverHandlePos %{public}" PRIu64", "
         "serverHandleTime %{public}" PRId64".", __func__, tryTimes, serverHandlePos, serverHandleTime);
-    ClockTime::AbsoluteSleep(serverHandleTime + RECORD_HANDLE_DELAY_NANO);
+    ClockTime::AbsoluteSleep(serverHandleTime + wakeUpScheduler_.GetMargin());
 
     ret = audioBuffer_->SetCurReadFrame(serverHandlePos);
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "%{public}s set curReadPos fail, ret %{public}d.", __func__, ret);
@@ -1462,7 +1547,7 @@ int32_t AudioProcessInClientInner::RecordFinishHandleCurrent(uint64_t &curReadPo
 
 bool AudioProcessInClientInner::PrepareCurrent(uint64_t curWritePos)
 {
-    Trace trace("AudioProcessInClient::PrepareCurrent " + std::to_string(curWritePos));
+    Trace trace(PREPARE_CURRENT_TRACE_TAG, curWritePos);
     SpanInfo *tempSpan = audioBuffer_->GetSpanInfo(curWritePos);
     if (tempSpan == nullptr) {
         AUDIO_ERR_LOG("GetSpanInfo failed!");
@@ -1498,7 +1583,7 @@ bool AudioProcessInClientInner::PrepareCurrentLoop(uint64_t curWritePos)
 
 bool AudioProcessInClientInner::FinishHandleCurrent(uint64_t &curWritePos, int64_t &clientWriteCost)
 {
-    Trace trace("AudioProcessInClient::FinishHandleCurrent " + std::to_string(curWritePos));
+    Trace trace(FINISH_HANDLE_CURRENT_TRACE_TAG, curWritePos);
     SpanInfo *tempSpan = audioBuffer_->GetSpanInfo(curWritePos);
     CHECK_AND_RETURN_RET_LOG(tempSpan != nullptr, false, "GetSpanInfo failed!");
 
@@ -1510,6 +1595,11 @@ bool AudioProcessInClientInner::FinishHandleCurrent(uint64_t &curWritePos, int64
         ret = audioBuffer_->SetCurWriteFrame(nextWritePos); // move ahead before writedone
         curWritePos = nextWritePos;
         tempSpan->spanStatus.store(SpanStatus::SPAN_WRITE_DONE);
+        // the endpoint may wait on the futex for the span to be written
+        std::atomic<uint32_t> *futex = audioBuffer_->GetFutex();
+        if (futex->load() == IS_NOT_READY) {
+            FutexTool::FutexWake(futex);
+        }
     }
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, false,
         "SetCurWriteFrame %{public}" PRIu64" failed, ret:%{public}d", curWritePos, ret);
@@ -1539,22 +1629,15 @@ void AudioProcessInClientInner::DoFadeInOut(uint64_t &curWritePos)
         CHECK_AND_RETURN_LOG(audioBuffer_ != nullptr, "audioBuffer_ is null.");
         audioBuffer_->GetWriteBuffer(curWritePos, buffDesc);
         CHECK_AND_RETURN_LOG(buffDesc.buffer != nullptr, "audioBuffer_ is null.");
-        int16_t *dstPtr = reinterpret_cast<int16_t *>(buffDesc.buffer);
-        uint8_t channels = processConfig_.streamInfo.channels;
-        size_t dataLength = buffDesc.dataLength / (2 * channels); //  SAMPLE_S16LE，2 bytes per frame
+        // the span holds data in the server format, which is the target format if the client converts.
+        const AudioStreamInfo &spanInfo = needConvert_ ? g_targetStreamInfo : processConfig_.streamInfo;
 
         bool isFadeOut = startFadeout_.load();
-        float fadeStep = 1.0f / dataLength;
-        for (size_t i = 0; i < dataLength; i++) {
-            float fadeFactor;
-            if (!isFadeOut) {
-                fadeFactor = (i + 1) * fadeStep;
-            } else {
-                fadeFactor = 1.0f - ((i + 1) * fadeStep);
-            }
-            for (uint8_t j = 0; j < channels; j++) {
-                dstPtr[i * channels + j] *= fadeFactor;
-            }
+        ChannelVolumes vols = VolumeTools::GetChannelVolumes(static_cast<AudioChannel>(spanInfo.channels),
+            isFadeOut ? INT32_VOLUME_MAX : INT32_VOLUME_MIN, isFadeOut ? INT32_VOLUME_MIN : INT32_VOLUME_MAX);
+        int32_t ret = VolumeTools::Process(buffDesc, spanInfo.format, vols);
+        if (ret != SUCCESS) {
+            AUDIO_WARNING_LOG("fade %{public}s failed:%{public}d", isFadeOut ? "out" : "in", ret);
         }
 
         if (isFadeOut) {
@@ -1575,13 +1658,18 @@ void AudioProcessInClientInner::ProcessCallbackFuc()
     int64_t curTime = 0;
     int64_t wakeUpTime = ClockTime::GetCurNano();
     int64_t clientWriteCost = 0;
+    bool isWakeUpPlanned = false; // woke up at the time planned by PrepareNext, without wait nor retry in between
 
     while (!isCallbackLoopEnd_ || startFadeout_.load()) {
         if (!KeepLoopRunning()) {
+            isWakeUpPlanned = false;
             continue;
         }
         threadStatus_ = INRUNNING;
         Trace traceLoop("AudioProcessInClient::InRunning");
+        bool hasDeadline = isWakeUpPlanned;
+        isWakeUpPlanned = false;
+        int64_t plannedWakeUpTime = wakeUpTime;
         CheckIfWakeUpTooLate(curTime, wakeUpTime);
         curWritePos = audioBuffer_->GetCurWriteFrame();
         if (!PrepareCurrentLoop(curWritePos)) {
@@ -1596,6 +1684,11 @@ void AudioProcessInClientInner::ProcessCallbackFuc()
         if (!FinishHandleCurrentLoop(curWritePos, clientWriteCost)) {
             continue;
         }
+        if (hasDeadline) {
+            // wake up lateness and write cost, the span should be written before the predicted server handle time
+            int64_t finishTime = ClockTime::GetCurNano();
+            UpdateWakeUpMargin(finishTime - plannedWakeUpTime, finishTime > nextHandleTime_);
+        }
         if (!ClientPrepareNextLoop(curWritePos, wakeUpTime)) {
             break;
         }
@@ -1603,8 +1696,10 @@ void AudioProcessInClientInner::ProcessCallbackFuc()
         // start safe sleep
         threadStatus_ = SLEEPING;
         CheckIfWakeUpTooLate(curTime, wakeUpTime, clientWriteCost);
+        isWakeUpPlanned = true;
         ClockTime::AbsoluteSleep(wakeUpTime);
     }
+    LogWakeUpStats();
 }
 
 void AudioProcessInClientInner::ProcessCallbackFucIndependent()
@@ -1679,7 +1774,7 @@ bool AudioProcessInClientInner::KeepLoopRunningIndependent()
 bool AudioProcessInClientInner::PrepareNextIndependent(uint64_t curWritePos, int64_t &wakeUpTime)
 {
     uint64_t nextHandlePos = curWritePos + spanSizeInFrame_;
-    Trace prepareTrace("AudioEndpoint::PrepareNextLoop " + std::to_string(nextHandlePos));
+    Trace prepareTrace(PREPARE_NEXT_LOOP_TRACE_TAG, nextHandlePos);
     int64_t nextHdiReadTime = GetPredictNextHandleTime(nextHandlePos, true);
     uint64_t aheadTime = spanSizeInFrame_ * AUDIO_NS_PER_SECOND / processConfig_.streamInfo.samplingRate;
     int64_t nextServerHandleTime = nextHdiReadTime - static_cast<int64_t>(aheadTime);
@@ -1718,12 +1813,30 @@ void AudioProcessInClientInner::CheckIfWakeUpTooLate(int64_t &curTime, int64_t &
 {
     curTime = ClockTime::GetCurNano();
     int64_t round = static_cast<int64_t>(spanSizeInFrame_ == 0 ? 1 : clientSpanSizeInFrame_ / spanSizeInFrame_);
-    int64_t clientBufferDurationInMs = static_cast<int64_t>(spanSizeInMs_) * ONE_MILLISECOND_DURATION * round;
-    if (wakeUpTime - curTime > clientBufferDurationInMs + clientWriteCost) {
+    int64_t clientBufferDuration = spanDuration_ * round;
+    if (wakeUpTime - curTime > clientBufferDuration + clientWriteCost) {
         Trace trace("BigWakeUpTime curTime[" + std::to_string(curTime) + "] target[" + std::to_string(wakeUpTime) +
             "] delay " + std::to_string(wakeUpTime - curTime) + "ns");
         AUDIO_PRERELEASE_LOGW("wakeUpTime is too late...");
     }
 }
+
+void AudioProcessInClientInner::UpdateWakeUpMargin(int64_t demand, bool missed)
+{
+    if (missed) {
+        Trace trace("AudioProcessInClient::WakeUpMiss");
+    }
+    if (wakeUpScheduler_.Record(demand, missed)) {
+        Trace::Count(wakeUpMarginTag_, wakeUpScheduler_.GetMargin());
+        Trace::Count(wakeUpMissRateTag_, static_cast<int64_t>(wakeUpScheduler_.GetMissRate() * MISS_RATE_TRACE_SCALE));
+    }
+}
+
+void AudioProcessInClientInner::LogWakeUpStats()
+{
+    AUDIO_INFO_LOG("wake up margin %{public}" PRId64 "us, missed %{public}" PRIu64 " of %{public}" PRIu64 " cycles"
+        " (%{public}f%%)", wakeUpScheduler_.GetMargin() / AUDIO_NS_PER_US, wakeUpScheduler_.GetMissCount(),
+        wakeUpScheduler_.GetCycleCount(), wakeUpScheduler_.GetMissRate() * 100); // 100 for percent
+}
 } // namespace AudioStandard
 } // namespace OHOS
@@ -63,6 +63,8 @@ const uint64_t MAX_BUF_DURATION_IN_USEC = 2000000; // 2S
 const int64_t INVALID_FRAME_SIZE = -1;
 static const int32_t SHORT_TIMEOUT_IN_MS = 20; // ms
 static constexpr int CB_QUEUE_CAPACITY = 3;
+static const std::string HANDLE_CAPTURER_READ_TRACE_TAG = "CapturerInClientInner::HandleCapturerRead ";
+static const std::string READ_TRACE_TAG = "CapturerInClientInner::Read ";
 }
 
 class CapturerInClientPolicyServiceDiedCallbackImpl : public AudioStreamPolicyServiceDiedCallback {
@@ -1581,7 +1583,7 @@ int32_t CapturerInClientInner::Write(uint8_t *buffer, size_t bufferSize)
 int32_t CapturerInClientInner::HandleCapturerRead(size_t &readSize, size_t &userSize, uint8_t &buffer,
     bool isBlockingRead)
 {
-    Trace trace("CapturerInClientInner::HandleCapturerRead " + std::to_string(userSize));
+    Trace trace(HANDLE_CAPTURER_READ_TRACE_TAG, userSize);
     while (readSize < userSize) {
         AUDIO_DEBUG_LOG("readSize %{public}zu < userSize %{public}zu", readSize, userSize);
         OptResult result = ringCache_->GetReadableSize();
@@ -1625,7 +1627,7 @@ int32_t CapturerInClientInner::HandleCapturerRead(size_t &readSize, size_t &user
 
 int32_t CapturerInClientInner::Read(uint8_t &buffer, size_t userSize, bool isBlockingRead)
 {
-    Trace trace("CapturerInClientInner::Read " + std::to_string(userSize));
+    Trace trace(READ_TRACE_TAG, userSize);
 
     CHECK_AND_RETURN_RET_LOG(userSize < MAX_CLIENT_READ_SIZE && userSize > 0,
         ERR_INVALID_PARAM, "invalid size %{public}zu", userSize);
@@ -94,6 +94,13 @@ static constexpr int32_t ONE_MINUTE = 60;
 static const int32_t MEDIA_SERVICE_UID = 1013;
 const int32_t CONTINUE_DOWN_BARRIER = 5;
 const float DOWN_BARRIER_VOLUME = 0.31f;
+static const std::string WRITABLE_SIZE_TRACE_TAG = "RendererInClient::CacheBuffer->writableSize";
+static const std::string READABLE_SIZE_TRACE_TAG = "RendererInClient::CacheBuffer->readableSize";
+static const std::string WRITE_CACHE_TRACE_TAG = "RendererInClientInner::WriteCacheData";
+static const std::string DRAIN_CACHE_TRACE_TAG = "RendererInClientInner::DrainCacheData";
+static const std::string WRITE_DIRECT_TRACE_TAG = "RendererInClientInner::WriteDirectData";
+static const std::string ENQUEUE_TRACE_TAG = "RendererInClientInner::Enqueue ";
+static const std::string COMMIT_WRITE_SPAN_TRACE_TAG = "RendererInClientInner::CommitWriteSpan ";
 } // namespace
 
 static AppExecFwk::BundleInfo gBundleInfo_;
@@ -505,7 +512,7 @@ int32_t RendererInClientInner::InitCacheBuffer(size_t targetSize)
     cacheSizeInByte_ = targetSize;
 
     if (ringCache_ == nullptr) {
-        ringCache_ = AudioRingCache::Create(cacheSizeInByte_);
+        ringCache_ = AudioSpscRingCache::Create(cacheSizeInByte_);
     } else {
         OptResult result = ringCache_->ReConfig(cacheSizeInByte_, false); // false --> clear buffer
         if (result.ret != OPERATION_SUCCESS) {
@@ -546,6 +553,7 @@ int32_t RendererInClientInner::InitIpcStream()
     ret = ipcStream_->GetAudioSessionID(sessionId_);
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "GetAudioSessionID failed:%{public}d", ret);
     traceTag_ = "[" + std::to_string(sessionId_) + "]RendererInClient"; // [100001]RendererInClient
+    writeTraceTag_ = traceTag_ + " WriteSize:";
     InitCallbackHandler();
     return SUCCESS;
 }
@@ -1071,7 +1079,7 @@ int32_t RendererInClientInner::GetBufQueueState(BufferQueueState &bufState)
 
 int32_t RendererInClientInner::Enqueue(const BufferDesc &bufDesc)
 {
-    Trace trace("RendererInClientInner::Enqueue " + std::to_string(bufDesc.bufLength));
+    Trace trace(ENQUEUE_TRACE_TAG, bufDesc.bufLength);
     if (renderMode_ != RENDER_MODE_CALLBACK) {
         AUDIO_ERR_LOG("Enqueue is not supported. Render mode is not callback.");
         return ERR_INCORRECT_MODE;
@@ -1111,6 +1119,65 @@ int32_t RendererInClientInner::Clear()
     return SUCCESS;
 }
 
+int32_t RendererInClientInner::AcquireWriteSpan(BufferDesc &bufDesc)
+{
+    Trace trace("RendererInClientInner::AcquireWriteSpan");
+    CHECK_AND_RETURN_RET_LOG(renderMode_ == RENDER_MODE_NORMAL && curStreamParams_.encoding == ENCODING_PCM,
+        ERR_INCORRECT_MODE, "AcquireWriteSpan only support pcm in normal render mode");
+    CHECK_AND_RETURN_RET_LOG(isEqual(speed_, 1.0f) && !isBlendSet_, ERR_INVALID_OPERATION,
+        "AcquireWriteSpan not support speed or channel blend");
+    CHECK_AND_RETURN_RET_LOG(gServerProxy_ != nullptr, ERROR, "server is died");
+    if (clientBuffer_->GetStreamStatus()->load() == STREAM_STAND_BY) {
+        CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERROR, "ipcStream is not inited!");
+        int32_t ret = ipcStream_->Start();
+        AUDIO_INFO_LOG("%{public}u call start to exit stand-by ret %{public}u", sessionId_, ret);
+    }
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_LOG(!writeSpanAcquired_, ERR_ILLEGAL_STATE, "last span is not committed");
+    CHECK_AND_RETURN_RET_PRELOG(state_ == RUNNING, ERR_ILLEGAL_STATE,
+        "AcquireWriteSpan: Illegal state:%{public}u sessionid: %{public}u", state_.load(), sessionId_);
+    // data left by Write must reach server before the span, as it is less than a span it can not be mixed here.
+    OptResult result = ringCache_->GetReadableSize();
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS && result.size == 0, ERR_ILLEGAL_STATE,
+        "%{public}zu bytes left in cache by Write", result.size);
+
+    FirstFrameProcess();
+    BufferDesc desc = {};
+    int32_t ret = WaitForWriteSpan(acquiredWriteFrame_, desc);
+    CHECK_AND_RETURN_RET(ret == SUCCESS, ret);
+    bufDesc.buffer = desc.buffer;
+    bufDesc.bufLength = clientSpanSizeInByte_;
+    bufDesc.dataLength = 0;
+    writeSpanAcquired_ = true;
+    return SUCCESS;
+}
+
+int32_t RendererInClientInner::CommitWriteSpan(const BufferDesc &bufDesc)
+{
+    Trace trace(COMMIT_WRITE_SPAN_TRACE_TAG, bufDesc.dataLength);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_LOG(writeSpanAcquired_, ERR_ILLEGAL_STATE, "no span acquired");
+    BufferDesc desc = {};
+    int32_t ret = clientBuffer_->GetWriteBuffer(acquiredWriteFrame_, desc);
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS && desc.buffer == bufDesc.buffer, ERR_INVALID_PARAM,
+        "span changed, ret %{public}d", ret);
+    CHECK_AND_RETURN_RET_LOG(bufDesc.dataLength <= clientSpanSizeInByte_, ERR_INVALID_PARAM,
+        "invalid dataLength %{public}zu", bufDesc.dataLength);
+    writeSpanAcquired_ = false;
+    if (bufDesc.dataLength == 0) {
+        return SUCCESS; // nothing written, give up the span.
+    }
+    CHECK_AND_RETURN_RET_PRELOG(state_ == RUNNING, ERR_ILLEGAL_STATE,
+        "CommitWriteSpan: Illegal state:%{public}u sessionid: %{public}u", state_.load(), sessionId_);
+    if (bufDesc.dataLength < clientSpanSizeInByte_) {
+        size_t padSize = clientSpanSizeInByte_ - bufDesc.dataLength;
+        CHECK_AND_RETURN_RET_LOG(memset_s(desc.buffer + bufDesc.dataLength, padSize, 0, padSize) == EOK,
+            ERR_OPERATION_FAILED, "pad span failed");
+    }
+    clientWrittenBytes_ += bufDesc.dataLength;
+    return CommitWriteSpanInner(acquiredWriteFrame_, desc);
+}
+
 int32_t RendererInClientInner::SetLowPowerVolume(float volume)
 {
     AUDIO_INFO_LOG("Volume number: %{public}f", volume);
@@ -1462,6 +1529,7 @@ bool RendererInClientInner::FlushAudioStream()
 int32_t RendererInClientInner::FlushRingCache()
 {
     ringCache_->ResetBuffer();
+    writeSpanAcquired_ = false;
     return SUCCESS;
 }
 
@@ -1469,6 +1537,7 @@ int32_t RendererInClientInner::DrainRingCache()
 {
     // send all data in ringCache_ to server even if GetReadableSize() < clientSpanSizeInByte_.
     Trace trace("RendererInClientInner::DrainRingCache " + std::to_string(sessionId_));
+    CHECK_AND_RETURN_RET_LOG(!writeSpanAcquired_, ERR_ILLEGAL_STATE, "span acquired by app is not committed");
 
     OptResult result = ringCache_->GetReadableSize();
     CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, ERR_OPERATION_FAILED, "ring cache unreadable");
@@ -1627,16 +1696,30 @@ void RendererInClientInner::FirstFrameProcess()
 int32_t RendererInClientInner::WriteRingCache(uint8_t *buffer, size_t bufferSize, bool speedCached,
     size_t oriBufferSize)
 {
+    CHECK_AND_RETURN_RET_LOG(!writeSpanAcquired_, ERR_ILLEGAL_STATE, "span acquired by app is not committed");
     size_t targetSize = bufferSize;
     size_t offset = 0;
     while (targetSize >= sizePerFrameInByte_) {
+        // 0. nothing is cached and a whole span is left, write it to OHAudioBuffer directly.
+        OptResult result = ringCache_->GetReadableSize();
+        if (result.ret == OPERATION_SUCCESS && result.size == 0 && targetSize >= clientSpanSizeInByte_) {
+            int32_t ret = WriteDirectData(buffer + offset);
+            CHECK_AND_RETURN_RET_LOG(ret != ERR_ILLEGAL_STATE, speedCached ? oriBufferSize : bufferSize - targetSize,
+                "Status changed while write");
+            CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "WriteDirectData failed %{public}d", ret);
+            offset += clientSpanSizeInByte_;
+            targetSize -= clientSpanSizeInByte_;
+            clientWrittenBytes_ += clientSpanSizeInByte_;
+            continue;
+        }
+
         // 1. write data into ring cache
-        OptResult result = ringCache_->GetWritableSize();
+        result = ringCache_->GetWritableSize();
         CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, speedCached ? oriBufferSize : bufferSize - targetSize,
             "RingCache write status invalid size is:%{public}zu", result.size);
 
         size_t writableSize = result.size;
-        Trace::Count("RendererInClient::CacheBuffer->writableSize", writableSize);
+        Trace::HotPathCount(WRITABLE_SIZE_TRACE_TAG, writableSize);
 
         size_t writeSize = std::min(writableSize, targetSize);
         BufferWrap bufferWrap = {buffer + offset, writeSize};
@@ -1658,7 +1741,7 @@ int32_t RendererInClientInner::WriteRingCache(uint8_t *buffer, size_t bufferSize
         CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, speedCached ? oriBufferSize : bufferSize - targetSize,
             "RingCache read status invalid size is:%{public}zu", result.size);
         size_t readableSize = result.size;
-        Trace::Count("RendererInClient::CacheBuffer->readableSize", readableSize);
+        Trace::HotPathCount(READABLE_SIZE_TRACE_TAG, readableSize);
 
         if (readableSize < clientSpanSizeInByte_) { continue; }
         // if readable size is enough, we will call write data to server
@@ -1673,7 +1756,7 @@ int32_t RendererInClientInner::WriteRingCache(uint8_t *buffer, size_t bufferSize
 int32_t RendererInClientInner::WriteInner(uint8_t *buffer, size_t bufferSize)
 {
     // eg: RendererInClient::sessionId:100001 WriteSize:3840
-    Trace trace(traceTag_+ " WriteSize:" + std::to_string(bufferSize));
+    Trace trace(writeTraceTag_, bufferSize);
     CHECK_AND_RETURN_RET_LOG(buffer != nullptr && bufferSize < MAX_WRITE_SIZE && bufferSize > 0, ERR_INVALID_PARAM,
         "invalid size is %{public}zu", bufferSize);
     Trace::CountVolume(traceTag_, *buffer);
@@ -1685,6 +1768,7 @@ int32_t RendererInClientInner::WriteInner(uint8_t *buffer, size_t bufferSize)
         AUDIO_INFO_LOG("%{public}u call start to exit stand-by ret %{public}u", sessionId_, ret);
     }
     std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_LOG(!writeSpanAcquired_, ERR_ILLEGAL_STATE, "span acquired by app is not committed");
 
     size_t oriBufferSize = bufferSize;
     bool speedCached = false;
@@ -1763,7 +1847,7 @@ void RendererInClientInner::ReportDataToResSched()
 
 int32_t RendererInClientInner::WriteCacheData(bool isDrain)
 {
-    Trace traceCache(isDrain ? "RendererInClientInner::DrainCacheData" : "RendererInClientInner::WriteCacheData");
+    Trace traceCache(isDrain ? DRAIN_CACHE_TRACE_TAG : WRITE_CACHE_TRACE_TAG);
 
     OptResult result = ringCache_->GetReadableSize();
     CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, ERR_OPERATION_FAILED, "ring cache unreadable");
@@ -1773,6 +1857,18 @@ int32_t RendererInClientInner::WriteCacheData(bool isDrain)
     }
     size_t targetSize = isDrain ? std::min(result.size, clientSpanSizeInByte_) : clientSpanSizeInByte_;
 
+    BufferDesc desc = {};
+    uint64_t curWriteIndex = 0;
+    int32_t ret = WaitForWriteSpan(curWriteIndex, desc);
+    CHECK_AND_RETURN_RET(ret == SUCCESS, ret);
+    result = ringCache_->Dequeue({desc.buffer, targetSize});
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, ERROR, "ringCache Dequeue failed %{public}d", result.ret);
+    return CommitWriteSpanInner(curWriteIndex, desc);
+}
+
+// Wait until the shared buffer has room for one span and get the span to write.
+int32_t RendererInClientInner::WaitForWriteSpan(uint64_t &curWriteIndex, BufferDesc &desc)
+{
     int32_t sizeInFrame = clientBuffer_->GetAvailableDataFrames();
     CHECK_AND_RETURN_RET_LOG(sizeInFrame >= 0, ERROR, "GetAvailableDataFrames invalid, %{public}d", sizeInFrame);
 
@@ -1793,13 +1889,18 @@ int32_t RendererInClientInner::WriteCacheData(bool isDrain)
         AUDIO_ERR_LOG("failed: sizeInFrame is:%{public}d, futexRes:%{public}d", sizeInFrame, futexRes);
         return ERROR;
     }
-    BufferDesc desc = {};
-    uint64_t curWriteIndex = clientBuffer_->GetCurWriteFrame();
+    curWriteIndex = clientBuffer_->GetCurWriteFrame();
     int32_t ret = clientBuffer_->GetWriteBuffer(curWriteIndex, desc);
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "GetWriteBuffer failed %{public}d", ret);
-    result = ringCache_->Dequeue({desc.buffer, targetSize});
-    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, ERROR, "ringCache Dequeue failed %{public}d", result.ret);
+    return SUCCESS;
+}
 
+// Publish the span at curWriteIndex to server, data in desc must be a whole span.
+int32_t RendererInClientInner::CommitWriteSpanInner(uint64_t curWriteIndex, BufferDesc &desc)
+{
+    CHECK_AND_RETURN_RET_LOG(curWriteIndex == clientBuffer_->GetCurWriteFrame(), ERR_ILLEGAL_STATE,
+        "write position moved to %{public}" PRIu64 " from %{public}" PRIu64, clientBuffer_->GetCurWriteFrame(),
+        curWriteIndex);
     // volume process in client
     if (volumeRamp_.IsActive()) {
         // do not call SetVolume here.
@@ -1815,20 +1916,42 @@ int32_t RendererInClientInner::WriteCacheData(bool isDrain)
     clientBuffer_->SetCurWriteFrame(curWriteIndex + spanSizeInFrame_);
 
     CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERR_OPERATION_FAILED, "WriteCacheData failed, null ipcStream_.");
-    ipcStream_->UpdatePosition(); // notiify server update position
+    // server reads curWriteFrame from the shared buffer, ipc is only needed when server asked for it.
+    if (clientBuffer_->TakePositionUpdateRequest()) {
+        ipcStream_->UpdatePosition(); // notiify server update position
+    }
     HandleRendererPositionChanges(desc.bufLength);
     return SUCCESS;
 }
 
+// Copy one whole span from app buffer into the shared buffer, skip the ring cache.
+int32_t RendererInClientInner::WriteDirectData(const uint8_t *buffer)
+{
+    Trace trace(WRITE_DIRECT_TRACE_TAG);
+    BufferDesc desc = {};
+    uint64_t curWriteIndex = 0;
+    int32_t ret = WaitForWriteSpan(curWriteIndex, desc);
+    CHECK_AND_RETURN_RET(ret == SUCCESS, ret);
+    CHECK_AND_RETURN_RET_LOG(desc.bufLength >= clientSpanSizeInByte_, ERROR, "span %{public}zu too small",
+        desc.bufLength);
+    ret = memcpy_s(desc.buffer, desc.bufLength, buffer, clientSpanSizeInByte_);
+    CHECK_AND_RETURN_RET_LOG(ret == EOK, ERROR, "copy to span failed %{public}d", ret);
+    return CommitWriteSpanInner(curWriteIndex, desc);
+}
+
 void RendererInClientInner::DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const
 {
+    int64_t step = AudioLogUtils::GetVolumeSampleStep(volumeSampleIndex_);
+    if (step == 0) {
+        return;
+    }
     ChannelVolumes vols = VolumeTools::CountVolumeLevel(buffer, format, channel);
     if (channel == MONO) {
-        Trace::Count(logUtilsTag_, vols.volStart[0]);
+        Trace::HotPathCount(logUtilsTag_, vols.volStart[0]);
     } else {
-        Trace::Count(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
+        Trace::HotPathCount(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
     }
-    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_);
+    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_, step);
 }
 
 void RendererInClientInner::HandleRendererPositionChanges(size_t bytesWritten)
@@ -21,7 +21,13 @@ namespace OHOS {
 namespace AudioStandard {
 class AudioLogUtils {
 public:
-    static void ProcessVolumeData(const std::string &logTag, const ChannelVolumes &vols, int64_t &count);
+    // step is the number of spans vols stands for, see GetVolumeSampleStep.
+    static void ProcessVolumeData(const std::string &logTag, const ChannelVolumes &vols, int64_t &count,
+        int64_t step = 1);
+
+    // Volume level is counted for one span in VOLUME_SAMPLE_INTERVAL, or every span if hot path trace is on.
+    // sampleIndex is kept by caller for each stream. Return the step for ProcessVolumeData, 0 if this span is skipped.
+    static int64_t GetVolumeSampleStep(uint32_t &sampleIndex);
 
 private:
     static void IncSilentData(const std::string &logTag, const ChannelVolumes &vols, int64_t count);
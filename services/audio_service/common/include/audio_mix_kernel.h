@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_MIX_KERNEL_H
+#define AUDIO_MIX_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_info.h"
+
+namespace OHOS {
+namespace AudioStandard {
+enum MixKernelIsa : uint32_t {
+    MIX_ISA_SCALAR = 0,
+    MIX_ISA_NEON,
+    MIX_ISA_SSE41,
+    MIX_ISA_AVX2,
+};
+
+static constexpr uint32_t MIX_CHANNEL_MAX = 8; // mono through 7.1
+
+// One source of a mix. volume is in Q16, 65536(1 << 16) means unity gain.
+struct MixSourceS16 {
+    const int16_t *data = nullptr;
+    int32_t volume = 0;
+};
+
+// One source of a format-generic mix, data holds interleaved frames in the given format and channel count.
+// CH_LAYOUT_UNKNOWN or a layout that does not match the channel count means the default layout of the count.
+struct MixSourceDesc {
+    const uint8_t *data = nullptr;
+    AudioSampleFormat format = SAMPLE_S16LE;
+    uint32_t channels = 0;
+    int32_t volume = 0;
+    uint64_t channelLayout = CH_LAYOUT_UNKNOWN;
+};
+
+/**
+ * Mix/volume/saturate kernels used by the fast endpoint. The best kernel set is chosen on first use according to
+ * the cpu features, all kernel sets produce bit-exact results with the scalar one.
+*/
+class AudioMixKernel {
+public:
+    static MixKernelIsa GetIsa();
+    static bool IsIsaSupported(MixKernelIsa isa);
+    // Force a kernel set, used by test and benchmark. Return false if the isa is not supported on this cpu.
+    static bool SetIsa(MixKernelIsa isa);
+    static const char *GetIsaName(MixKernelIsa isa);
+
+    // dst[i] = saturate16(sum((srcs[j].data[i] * srcs[j].volume) >> 16)), dst will be zero if srcCount is 0.
+    static void MixS16(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount);
+
+    // dst[i] = saturate16((src[i] * volume) >> 16), src and dst can be the same buffer.
+    static void ApplyVolumeS16(const int16_t *src, int32_t volume, int16_t *dst, size_t sampleCount);
+
+    // dst[i] = saturate16(dst[i] + src[i])
+    static void AccumulateS16(const int16_t *src, int16_t *dst, size_t sampleCount);
+
+    // data[i] = saturate16((data[i] * vols[i]) >> 16), one volume for each sample, vols must be in [0, 65536].
+    static void ApplyVolumesS16(int16_t *data, const int32_t *vols, size_t sampleCount);
+
+    // data[i] = data[i] * vols[i] / 65536, one volume for each sample.
+    static void ApplyVolumesF32(float *data, const int32_t *vols, size_t sampleCount);
+
+    // sum(a[i] * b[i]), accumulated in 8 lanes with the same order in every kernel set, used by the resampler.
+    static float DotProductF32(const float *a, const float *b, size_t count);
+
+    // S16LE, S24LE, S32LE and F32LE with 1 to MIX_CHANNEL_MAX channels can be mixed.
+    static bool IsFormatSupported(AudioSampleFormat format, uint32_t channels);
+
+    /**
+     * Convert src to float, map its channels to dstChannels in dstLayout and add it with volume to acc, which holds
+     * frameCount * dstChannels samples. Channels are mapped by speaker: mono goes to the front pair, a speaker the
+     * destination lacks goes to the nearest one of its side (FC to both front channels at -3dB), LFE is dropped.
+     * ERR_NOT_SUPPORTED for layouts with speakers out of 7.1, FLC, FRC and BC.
+    */
+    static int32_t AccumulateToFloat(const MixSourceDesc &src, uint32_t dstChannels, uint64_t dstLayout, float *acc,
+        size_t frameCount);
+
+    // dst[i] = float(src[i]) * volume, channel agnostic. U8, S16LE, S24LE, S32LE and F32LE are supported.
+    static int32_t ConvertToFloat(const uint8_t *src, AudioSampleFormat format, float volume, float *dst,
+        size_t sampleCount);
+
+    // Write the float accumulator in format with clamp to [-1.0, 1.0].
+    static int32_t FloatToFormat(const float *acc, AudioSampleFormat format, uint8_t *dst, size_t sampleCount);
+
+    static size_t GetFormatByteSize(AudioSampleFormat format);
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_MIX_KERNEL_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AUDIO_POLYPHASE_RESAMPLER_H
+#define AUDIO_POLYPHASE_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace OHOS {
+namespace AudioStandard {
+// Taps of one phase at 1:1 ratio, a down sampler widens its filter by the ratio. Latency is half of the taps.
+enum AudioResampleQuality : uint32_t {
+    RESAMPLE_QUALITY_LOW = 0, // 16 taps
+    RESAMPLE_QUALITY_MEDIUM, // 32 taps
+    RESAMPLE_QUALITY_HIGH, // 64 taps
+};
+
+/**
+ * Kaiser windowed sinc resampler for rational ratios. The filter bank of a ratio and quality is built once and
+ * shared by all the resamplers using it, Process does not allocate and runs its dot products with AudioMixKernel.
+ * Output starts aligned with the first input frame, as speex does after speex_resampler_skip_zeros.
+*/
+class AudioPolyphaseResampler {
+public:
+    AudioPolyphaseResampler(uint32_t channels, uint32_t inRate, uint32_t outRate, AudioResampleQuality quality);
+    ~AudioPolyphaseResampler() = default;
+
+    // The reduced ratio of the rates must have no more than MAX_PHASE_COUNT phases, which all standard rates meet.
+    static bool IsRateSupported(uint32_t inRate, uint32_t outRate);
+
+    bool IsInit() const noexcept;
+
+    // inFrames and outFrames hold the capacity of the interleaved buffers on entry, and the frames consumed and
+    // produced on return. Input that does not fit in the output is left unconsumed.
+    int32_t Process(const float *input, uint32_t &inFrames, float *output, uint32_t &outFrames);
+
+    // Clear the history, the next output is aligned with the next input frame again.
+    void Reset();
+
+    // Input frames held back before the first output.
+    uint32_t GetLatencyFrames() const noexcept;
+
+    uint32_t GetTaps() const noexcept;
+
+    static constexpr uint32_t MAX_PHASE_COUNT = 1024;
+
+private:
+    struct FilterBank;
+    static std::shared_ptr<const FilterBank> GetFilterBank(uint32_t phaseCount, uint32_t step,
+        AudioResampleQuality quality);
+    void ProduceFrame(float *output);
+    void AdvanceFrame();
+    void CompactHistory();
+    uint32_t AppendInput(const float *input, uint32_t frames);
+
+    std::shared_ptr<const FilterBank> bank_ = nullptr;
+    uint32_t channels_ = 0;
+    uint32_t taps_ = 0;
+    uint32_t phaseCount_ = 1; // reduced output rate
+    uint32_t intStep_ = 0; // reduced input rate / reduced output rate
+    uint32_t fracStep_ = 0; // reduced input rate % reduced output rate
+    size_t historyFrames_ = 0; // capacity of each channel in history_
+    std::vector<float> history_; // planar, one row of historyFrames_ for each channel
+
+    size_t filled_ = 0; // frames in each row
+    size_t center_ = 0; // input frame the next output is taken at, plus phase_ / phaseCount_
+    uint32_t phase_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_POLYPHASE_RESAMPLER_H
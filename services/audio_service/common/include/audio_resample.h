@@ -16,19 +16,28 @@
 #define AUDIO_RESAMPLE_H
 
 #include <vector>
+#include "audio_polyphase_resampler.h"
 
 namespace OHOS {
 namespace AudioStandard {
+// Resample with AudioPolyphaseResampler when the rates are supported, or with speex otherwise.
 class AudioResample {
 public:
     AudioResample(uint32_t channels, uint32_t inRate, uint32_t outRate, int32_t quantity);
     ~AudioResample();
     bool IsResampleInit() const noexcept;
     int32_t ProcessFloatResample(const std::vector<float> &input, std::vector<float> &output);
+    // inFrames and outFrames hold the capacity of the interleaved buffers on entry, and the frames consumed and
+    // produced on return.
+    int32_t ProcessFloatResample(const float *input, uint32_t &inFrames, float *output, uint32_t &outFrames);
+
+    static AudioResampleQuality GetQuality(int32_t quantity);
 
 private:
     struct SpeexResample;
     std::unique_ptr<SpeexResample> speex_;
+    std::unique_ptr<AudioPolyphaseResampler> polyphase_;
+    uint32_t channels_;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -90,6 +90,74 @@ private:
     size_t writeIndex_ = 0;
     size_t readIndex_ = 0;
 };
+
+// A reserved region of the cache, second is used only when the region wraps around the end of the cache.
+struct RingSpan {
+    BufferWrap first;
+    BufferWrap second;
+};
+
+/**
+ * Lock free AudioSpscRingCache for exactly one producer thread and one consumer thread. The producer may only call
+ * GetWritableSize, Enqueue, ReserveWrite and CommitWrite, the consumer may only call GetReadableSize, Dequeue,
+ * ReserveRead and CommitRead. ReConfig and ResetBuffer are not lock free, they must be called when neither side is
+ * working, as the callers do under their own write/read mutex.
+ * The Reserve/Commit pairs give direct access to the cache memory, so data can be produced into or consumed from it
+ * without an extra copy. Data in a reserved span is valid until the matched Commit is called.
+*/
+class AudioSpscRingCache {
+public:
+    static std::unique_ptr<AudioSpscRingCache> Create(size_t cacheSize);
+    AudioSpscRingCache(size_t cacheSize);
+    ~AudioSpscRingCache();
+
+    OptResult ReConfig(size_t cacheSize, bool copyRemained = true);
+
+    // This operation will reset inner read/write index.
+    void ResetBuffer();
+
+    size_t GetCahceSize();
+
+    // Producer side. 0 <= WritableSize <= cacheTotalSize_
+    OptResult GetWritableSize();
+
+    // Producer side. Copy the whole buffer into cache, fail with INDEX_OUT_OF_RANGE if writable size is not enough.
+    OptResult Enqueue(const BufferWrap &buffer);
+
+    // Producer side. Reserve at most size bytes to write, the size reserved is returned in result.
+    OptResult ReserveWrite(size_t size, RingSpan &span);
+
+    // Producer side. Publish size bytes written to the reserved span.
+    OptResult CommitWrite(size_t size);
+
+    // Consumer side. 0 <= ReadableSize <= cacheTotalSize_
+    OptResult GetReadableSize();
+
+    // Consumer side. Fill the whole buffer from cache, fail with INVALID_OPERATION if readable size is not enough.
+    OptResult Dequeue(const BufferWrap &buffer);
+
+    // Consumer side. Reserve at most size bytes to read, the size reserved is returned in result.
+    OptResult ReserveRead(size_t size, RingSpan &span);
+
+    // Consumer side. Release size bytes read from the reserved span.
+    OptResult CommitRead(size_t size);
+
+private:
+    bool Init();
+    size_t GetUsedSize(size_t writeIndex, size_t readIndex) const;
+    size_t AdvanceIndex(size_t index, size_t size) const;
+    void GetSpan(size_t index, size_t size, RingSpan &span) const;
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<uint8_t[]> basePtr_;
+    size_t cacheTotalSize_ = 0;
+
+    // Index runs in [0, 2 * cacheTotalSize_), so that full and empty can be told apart without a lock.
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> writeIndex_ = 0; // written by producer only
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> readIndex_ = 0; // written by consumer only
+};
 } // namespace AudioStandard
 } // namespace OHOS
 #endif // AUDIO_RING_CACHE_H
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_WAKEUP_SCHEDULER_H
+#define AUDIO_WAKEUP_SCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace AudioStandard {
+/**
+ * Safety margin of a loop waking up around the handle time the server is predicted to reach, the prediction being
+ * done by LinearPosTimeModel. Each cycle reports its demand, the time it needed on its side of the predicted time:
+ * wake-up lateness plus handle cost for a writer waking before the server, server lateness for a reader waking after
+ * it. The margin follows a high quantile of the demand of the last window with some headroom: it is widened at once
+ * when a window or a missed deadline asks for more, and shrunk a bit after each window without miss.
+*/
+class AudioWakeupScheduler {
+public:
+    AudioWakeupScheduler() = default;
+
+    bool Config(int64_t initMargin, int64_t minMargin, int64_t maxMargin);
+
+    // Return true if the margin was adapted at the end of a window.
+    bool Record(int64_t demand, bool missed);
+
+    int64_t GetMargin() const;
+    uint64_t GetCycleCount() const;
+    uint64_t GetMissCount() const;
+    // Missed deadlines per cycle since the last reset.
+    float GetMissRate() const;
+
+    // Keep the margin, forget the samples and the counts.
+    void Reset();
+
+    static constexpr size_t WINDOW_SIZE = 128;
+
+private:
+    void Adapt();
+    int64_t Clamp(int64_t margin) const;
+
+    int64_t minMargin_ = 0;
+    int64_t maxMargin_ = 0;
+    std::atomic<int64_t> margin_ = 0;
+
+    std::array<int64_t, WINDOW_SIZE> window_ = {};
+    size_t windowCount_ = 0;
+    uint32_t windowMissCount_ = 0;
+
+    std::atomic<uint64_t> cycleCount_ = 0;
+    std::atomic<uint64_t> missCount_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_WAKEUP_SCHEDULER_H
@@ -39,6 +39,12 @@ public:
      * After Waked up, will check futexPtr == IS_NOT_READY
      */
     static FutexCode FutexWait(std::atomic<uint32_t> *futexPtr, int64_t timeout);
+    /**
+     * Wait while futexPtr is IS_NOT_READY, until the CLOCK_MONOTONIC time deadline in nanosecond. Unlike FutexWait
+     * it does not arm the futex: the caller stores IS_NOT_READY, checks its condition again, then waits. A timeout is
+     * an expected result and is not logged.
+     */
+    static FutexCode FutexWaitUntil(std::atomic<uint32_t> *futexPtr, int64_t deadline);
     static FutexCode FutexWake(std::atomic<uint32_t> *futexPtr, uint32_t wakeVal = IS_READY);
 };
 } // namespace AudioStandard
@@ -80,6 +80,9 @@ struct BasicBufferInfo {
 
     std::atomic<float> streamVolume;
     std::atomic<float> duckFactor;
+
+    // Set by server when it needs to be told of the next write position through ipc, taken by client.
+    std::atomic<uint32_t> positionUpdateRequest;
 };
 
 enum SpanStatus : uint32_t {
@@ -170,6 +173,12 @@ public:
     void SetLastWrittenTime(int64_t time);
 
     std::atomic<uint32_t> *GetFutex();
+
+    // Server side, ask client to call UpdatePosition after its next write.
+    void RequestPositionUpdate();
+    // Client side, return true if server asked for UpdatePosition, the request is cleared.
+    bool TakePositionUpdateRequest();
+
     uint8_t *GetDataBase();
     size_t GetDataSize();
 private:
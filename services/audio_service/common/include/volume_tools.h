@@ -30,6 +30,12 @@ struct ChannelVolumes {
     int32_t volEnd[CHANNEL_MAX];
 };
 
+// Shape of the ramp from volStart to volEnd in VolumeTools::Process.
+enum VolumeRampCurve : uint32_t {
+    VOLUME_RAMP_LINEAR = 0,
+    VOLUME_RAMP_SMOOTH, // smoothstep, 3t^2 - 2t^3, the gain changes slowly at both ends of the ramp
+};
+
 static inline bool IsVolumeSame(const float& x, const float& y, const float& epsilon)
 {
     return (std::abs((x) - (y)) <= std::abs(epsilon));
@@ -48,6 +54,8 @@ public:
     // Data size should be rounded to each sample size
     // There will be significant sound quality loss when process uint8_t samples.
     static int32_t Process(const BufferDesc &buffer, AudioSampleFormat format, ChannelVolumes vols);
+    static int32_t Process(const BufferDesc &buffer, AudioSampleFormat format, ChannelVolumes vols,
+        VolumeRampCurve curve);
 
     // will count volume for each channel, vol sum will be kept in volStart
     static ChannelVolumes CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel);
@@ -14,6 +14,7 @@
  */
 #include "audio_common_converter.h"
 #include <cmath>
+#include "audio_format_convert.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -70,6 +71,10 @@ void AudioCommonConverter::ConvertBufferTo32Bit(const uint8_t *buffer, int32_t f
         }
         case AUDIO_SAMPLE_FORMAT_32F_BIT: {
             const float *src = reinterpret_cast<const float *>(buffer);
+            if (volume == 1.0f) {
+                AudioConvertF32ToS32(src, dst, count);
+                break;
+            }
             for (; count > 0; --count) {
                 *dst++ = *src++ * volume * AUDIO_SAMPLE_32BIT_VALUE;
             }
@@ -119,6 +124,10 @@ void AudioCommonConverter::ConvertBufferTo16Bit(const uint8_t *buffer, int32_t f
         }
         case AUDIO_SAMPLE_FORMAT_32F_BIT: {
             const float *src = reinterpret_cast<const float *>(buffer);
+            if (volume == 1.0f) {
+                AudioConvertF32ToS16(src, dst, count, nullptr);
+                break;
+            }
             static const float scale = 1 << (AUDIO_SAMPLE_16BIT_LENGTH - 1);
             for (; count > 0; --count) {
                 *dst++ = *src++ * scale * volume;
@@ -20,14 +20,29 @@
 
 #include <cinttypes>
 #include "audio_service_log.h"
+#include "audio_utils.h"
 
 namespace OHOS {
 namespace AudioStandard {
 namespace {
 static const uint32_t MEDIUM_FREQ_PRINT_LOG = 100;
 static const uint32_t LOW_FREQ_PRINT_LOG = 1000;
+static const uint32_t VOLUME_SAMPLE_INTERVAL = 10; // keep MEDIUM_FREQ_PRINT_LOG a multiple of it
 }
-void AudioLogUtils::ProcessVolumeData(const std::string &logTag, const ChannelVolumes &vols, int64_t &count)
+int64_t AudioLogUtils::GetVolumeSampleStep(uint32_t &sampleIndex)
+{
+    if (Trace::IsHotPathEnabled()) {
+        sampleIndex = 0;
+        return 1;
+    }
+    if (sampleIndex++ % VOLUME_SAMPLE_INTERVAL != 0) {
+        return 0;
+    }
+    return VOLUME_SAMPLE_INTERVAL;
+}
+
+void AudioLogUtils::ProcessVolumeData(const std::string &logTag, const ChannelVolumes &vols, int64_t &count,
+    int64_t step)
 {
     bool isDataSilent = true;
     for (int32_t i = 0; i < vols.channel; i++) {
@@ -41,14 +56,14 @@ void AudioLogUtils::ProcessVolumeData(const std::string &logTag, const ChannelVo
             AUDIO_INFO_LOG("[%{public}s] 1->0, silent frames %{public}" PRId64 "", logTag.c_str(), count);
             count = 0;
         }
-        count--;
+        count -= step;
         IncSilentData(logTag, vols, -count);
     } else {
         if (count < 0) {
             AUDIO_INFO_LOG("[%{public}s] 0->1, silent frames %{public}" PRId64 "", logTag.c_str(), -count);
             count = 0;
         }
-        count++;
+        count += step;
         IncSoundData(logTag, vols, count);
     }
 }
@@ -0,0 +1,889 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioMixKernel"
+#endif
+
+#include "audio_mix_kernel.h"
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#define MIX_KERNEL_NEON
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#define MIX_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#include "audio_errors.h"
+#include "audio_format_convert.h"
+#include "audio_service_log.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+static constexpr int32_t VOLUME_SHIFT_NUMBER = 16; // 1 << 16 = 65536, max volume
+static constexpr int32_t VOLUME_UNITY = 1 << VOLUME_SHIFT_NUMBER;
+static constexpr float FLOAT_VOLUME_UNITY = 1.0f / VOLUME_UNITY;
+static constexpr float FOLD_DOWN_GAIN = 0.70710678f; // -3dB, 1 / sqrt(2)
+static constexpr float U8_SCALE = 128.0f; // 1 << 7
+static constexpr int32_t U8_ZERO = 0x80;
+static constexpr float S16_SCALE = 32768.0f; // 1 << 15
+static constexpr float S32_SCALE = 2147483648.0f; // 1 << 31
+static constexpr uint32_t S24_SHIFT = 8;
+static constexpr uint32_t SHIFT_EIGHT = 8;
+static constexpr uint32_t SHIFT_SIXTEEN = 16;
+static constexpr uint32_t BYTE_INDEX_TWO = 2;
+static constexpr uint64_t MIXABLE_SPEAKERS = CH_LAYOUT_7POINT1 | FRONT_LEFT_OF_CENTER | FRONT_RIGHT_OF_CENTER |
+    BACK_CENTER;
+// default layout of each channel count, index is the channel count
+static constexpr std::array<uint64_t, MIX_CHANNEL_MAX + 1> DEFAULT_MIX_LAYOUTS = { CH_LAYOUT_UNKNOWN,
+    CH_LAYOUT_MONO, CH_LAYOUT_STEREO, CH_LAYOUT_SURROUND, CH_LAYOUT_QUAD, CH_LAYOUT_5POINT0, CH_LAYOUT_5POINT1,
+    CH_LAYOUT_7POINT0, CH_LAYOUT_7POINT1 };
+static constexpr size_t DOT_LANES = 8;
+
+using MixS16Func = void (*)(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount);
+using AccumulateS16Func = void (*)(const int16_t *src, int16_t *dst, size_t sampleCount);
+using ApplyVolumesS16Func = void (*)(int16_t *data, const int32_t *vols, size_t sampleCount);
+using ApplyVolumesF32Func = void (*)(float *data, const int32_t *vols, size_t sampleCount);
+using DotProductF32Func = float (*)(const float *a, const float *b, size_t count);
+
+struct MixKernelOps {
+    MixKernelIsa isa;
+    MixS16Func mixS16;
+    AccumulateS16Func accumulateS16;
+    ApplyVolumesS16Func applyVolumesS16;
+    ApplyVolumesF32Func applyVolumesF32;
+    DotProductF32Func dotProductF32;
+};
+
+// gain[dst][src] used to map the channels of one frame.
+struct ChannelMixMatrix {
+    bool isIdentity = false;
+    float gain[MIX_CHANNEL_MAX][MIX_CHANNEL_MAX] = {};
+};
+}
+
+static inline int16_t SaturateS16(int32_t sum)
+{
+    return sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+}
+
+static void MixS16Range(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t begin, size_t end)
+{
+    for (size_t offset = begin; offset < end; offset++) {
+        int32_t sum = 0;
+        for (size_t i = 0; i < srcCount; i++) {
+            sum += (srcs[i].data[offset] * static_cast<int64_t>(srcs[i].volume)) >> VOLUME_SHIFT_NUMBER; // 1/65536
+        }
+        dst[offset] = SaturateS16(sum);
+    }
+}
+
+static void AccumulateS16Range(const int16_t *src, int16_t *dst, size_t begin, size_t end)
+{
+    for (size_t offset = begin; offset < end; offset++) {
+        dst[offset] = SaturateS16(static_cast<int32_t>(dst[offset]) + src[offset]);
+    }
+}
+
+static void ApplyVolumesS16Range(int16_t *data, const int32_t *vols, size_t begin, size_t end)
+{
+    for (size_t offset = begin; offset < end; offset++) {
+        data[offset] = SaturateS16((data[offset] * static_cast<int64_t>(vols[offset])) >> VOLUME_SHIFT_NUMBER);
+    }
+}
+
+// float(vol) / 65536 is exact, so multiply by FLOAT_VOLUME_UNITY in the vector kernels gives the same result.
+static void ApplyVolumesF32Range(float *data, const int32_t *vols, size_t begin, size_t end)
+{
+    for (size_t offset = begin; offset < end; offset++) {
+        data[offset] = data[offset] * (static_cast<float>(vols[offset]) / VOLUME_UNITY);
+    }
+}
+
+// Lanes are reduced as (l0 + l4, l1 + l5, l2 + l6, l3 + l7), then (s0 + s2) + (s1 + s3), the same as the vector
+// kernels. Product and sum are kept in separate statements so that they are not contracted into one fma.
+static float ReduceDotLanes(const float *lanes)
+{
+    float sum[DOT_LANES / 2];
+    for (size_t i = 0; i < DOT_LANES / 2; i++) {
+        sum[i] = lanes[i] + lanes[i + DOT_LANES / 2];
+    }
+    return (sum[0] + sum[2]) + (sum[1] + sum[3]); // 2, 3 for the last pair of the half
+}
+
+static float DotProductTail(const float *a, const float *b, size_t begin, size_t end, float sum)
+{
+    for (size_t i = begin; i < end; i++) {
+        float product = a[i] * b[i];
+        sum += product;
+    }
+    return sum;
+}
+
+static void MixS16Scalar(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount)
+{
+    MixS16Range(srcs, srcCount, dst, 0, sampleCount);
+}
+
+static void AccumulateS16Scalar(const int16_t *src, int16_t *dst, size_t sampleCount)
+{
+    AccumulateS16Range(src, dst, 0, sampleCount);
+}
+
+static void ApplyVolumesS16Scalar(int16_t *data, const int32_t *vols, size_t sampleCount)
+{
+    ApplyVolumesS16Range(data, vols, 0, sampleCount);
+}
+
+static void ApplyVolumesF32Scalar(float *data, const int32_t *vols, size_t sampleCount)
+{
+    ApplyVolumesF32Range(data, vols, 0, sampleCount);
+}
+
+static float DotProductF32Scalar(const float *a, const float *b, size_t count)
+{
+    float lanes[DOT_LANES] = {};
+    size_t offset = 0;
+    for (; offset + DOT_LANES <= count; offset += DOT_LANES) {
+        for (size_t i = 0; i < DOT_LANES; i++) {
+            float product = a[offset + i] * b[offset + i];
+            lanes[i] += product;
+        }
+    }
+    return DotProductTail(a, b, offset, count, ReduceDotLanes(lanes));
+}
+
+static constexpr MixKernelOps SCALAR_OPS = { MIX_ISA_SCALAR, MixS16Scalar, AccumulateS16Scalar, ApplyVolumesS16Scalar,
+    ApplyVolumesF32Scalar, DotProductF32Scalar };
+
+#ifdef MIX_KERNEL_NEON
+static constexpr size_t NEON_STEP = 8; // 8 * int16_t in one 128bit register
+static constexpr size_t NEON_FLOAT_STEP = 4; // 4 * float or int32_t in one 128bit register
+
+// Product of int16_t and a volume in (-65536, 65536] fits in int32_t, so the 32bit multiply is exact. -32768 * -65536
+// is 2^31 and does not, MixS16 leaves -65536 to the scalar kernel.
+static inline int32x4_t MulVolumeNeon(int16x4_t in, int32x4_t vol)
+{
+    return vshrq_n_s32(vmulq_s32(vmovl_s16(in), vol), VOLUME_SHIFT_NUMBER);
+}
+
+static void MixS16Neon(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= sampleCount; offset += NEON_STEP) {
+        int32x4_t sumLow = vdupq_n_s32(0);
+        int32x4_t sumHigh = vdupq_n_s32(0);
+        for (size_t i = 0; i < srcCount; i++) {
+            int16x8_t in = vld1q_s16(srcs[i].data + offset);
+            int32x4_t vol = vdupq_n_s32(srcs[i].volume);
+            sumLow = vaddq_s32(sumLow, MulVolumeNeon(vget_low_s16(in), vol));
+            sumHigh = vaddq_s32(sumHigh, MulVolumeNeon(vget_high_s16(in), vol));
+        }
+        vst1q_s16(dst + offset, vcombine_s16(vqmovn_s32(sumLow), vqmovn_s32(sumHigh)));
+    }
+    MixS16Range(srcs, srcCount, dst, offset, sampleCount);
+}
+
+static void AccumulateS16Neon(const int16_t *src, int16_t *dst, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= sampleCount; offset += NEON_STEP) {
+        vst1q_s16(dst + offset, vqaddq_s16(vld1q_s16(dst + offset), vld1q_s16(src + offset)));
+    }
+    AccumulateS16Range(src, dst, offset, sampleCount);
+}
+
+static void ApplyVolumesS16Neon(int16_t *data, const int32_t *vols, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + NEON_STEP <= sampleCount; offset += NEON_STEP) {
+        int16x8_t in = vld1q_s16(data + offset);
+        int32x4_t outLow = MulVolumeNeon(vget_low_s16(in), vld1q_s32(vols + offset));
+        int32x4_t outHigh = MulVolumeNeon(vget_high_s16(in), vld1q_s32(vols + offset + NEON_FLOAT_STEP));
+        vst1q_s16(data + offset, vcombine_s16(vqmovn_s32(outLow), vqmovn_s32(outHigh)));
+    }
+    ApplyVolumesS16Range(data, vols, offset, sampleCount);
+}
+
+static void ApplyVolumesF32Neon(float *data, const int32_t *vols, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + NEON_FLOAT_STEP <= sampleCount; offset += NEON_FLOAT_STEP) {
+        float32x4_t vol = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(vols + offset)), FLOAT_VOLUME_UNITY);
+        vst1q_f32(data + offset, vmulq_f32(vld1q_f32(data + offset), vol));
+    }
+    ApplyVolumesF32Range(data, vols, offset, sampleCount);
+}
+
+static float DotProductF32Neon(const float *a, const float *b, size_t count)
+{
+    float32x4_t low = vdupq_n_f32(0.0f);
+    float32x4_t high = vdupq_n_f32(0.0f);
+    size_t offset = 0;
+    for (; offset + DOT_LANES <= count; offset += DOT_LANES) {
+        low = vaddq_f32(low, vmulq_f32(vld1q_f32(a + offset), vld1q_f32(b + offset)));
+        high = vaddq_f32(high, vmulq_f32(vld1q_f32(a + offset + NEON_FLOAT_STEP),
+            vld1q_f32(b + offset + NEON_FLOAT_STEP)));
+    }
+    float32x4_t half = vaddq_f32(low, high);
+    float32x2_t pair = vadd_f32(vget_low_f32(half), vget_high_f32(half));
+    float sum = vget_lane_f32(pair, 0) + vget_lane_f32(pair, 1);
+    return DotProductTail(a, b, offset, count, sum);
+}
+
+static constexpr MixKernelOps NEON_OPS = { MIX_ISA_NEON, MixS16Neon, AccumulateS16Neon, ApplyVolumesS16Neon,
+    ApplyVolumesF32Neon, DotProductF32Neon };
+#endif
+
+#ifdef MIX_KERNEL_X86
+static constexpr size_t SSE_STEP = 8; // 8 * int16_t in one 128bit register
+static constexpr size_t AVX_STEP = 16; // 16 * int16_t in one 256bit register
+static constexpr size_t SSE_FLOAT_STEP = 4; // 4 * float or int32_t in one 128bit register
+static constexpr size_t AVX_FLOAT_STEP = 8; // 8 * float or int32_t in one 256bit register
+static constexpr int32_t SSE_HIGH_HALF_BYTES = 8;
+static constexpr int32_t AVX_PACK_ORDER = 0xD8; // 0b11011000, reorder lanes after _mm256_packs_epi32
+
+__attribute__((target("sse4.1")))
+static inline __m128i MulVolumeSse(__m128i in, __m128i vol)
+{
+    return _mm_srai_epi32(_mm_mullo_epi32(_mm_cvtepi16_epi32(in), vol), VOLUME_SHIFT_NUMBER);
+}
+
+__attribute__((target("sse4.1")))
+static void MixS16Sse(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + SSE_STEP <= sampleCount; offset += SSE_STEP) {
+        __m128i sumLow = _mm_setzero_si128();
+        __m128i sumHigh = _mm_setzero_si128();
+        for (size_t i = 0; i < srcCount; i++) {
+            __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(srcs[i].data + offset));
+            __m128i vol = _mm_set1_epi32(srcs[i].volume);
+            sumLow = _mm_add_epi32(sumLow, MulVolumeSse(in, vol));
+            sumHigh = _mm_add_epi32(sumHigh, MulVolumeSse(_mm_srli_si128(in, SSE_HIGH_HALF_BYTES), vol));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), _mm_packs_epi32(sumLow, sumHigh));
+    }
+    MixS16Range(srcs, srcCount, dst, offset, sampleCount);
+}
+
+__attribute__((target("sse4.1")))
+static void AccumulateS16Sse(const int16_t *src, int16_t *dst, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + SSE_STEP <= sampleCount; offset += SSE_STEP) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + offset));
+        __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + offset));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), _mm_adds_epi16(out, in));
+    }
+    AccumulateS16Range(src, dst, offset, sampleCount);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i MulVolumeAvx(__m128i in, __m256i vol)
+{
+    return _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_cvtepi16_epi32(in), vol), VOLUME_SHIFT_NUMBER);
+}
+
+__attribute__((target("avx2")))
+static void MixS16Avx(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + AVX_STEP <= sampleCount; offset += AVX_STEP) {
+        __m256i sumLow = _mm256_setzero_si256();
+        __m256i sumHigh = _mm256_setzero_si256();
+        for (size_t i = 0; i < srcCount; i++) {
+            __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(srcs[i].data + offset));
+            __m256i vol = _mm256_set1_epi32(srcs[i].volume);
+            sumLow = _mm256_add_epi32(sumLow, MulVolumeAvx(_mm256_castsi256_si128(in), vol));
+            sumHigh = _mm256_add_epi32(sumHigh, MulVolumeAvx(_mm256_extracti128_si256(in, 1), vol));
+        }
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(sumLow, sumHigh), AVX_PACK_ORDER);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + offset), packed);
+    }
+    MixS16Range(srcs, srcCount, dst, offset, sampleCount);
+}
+
+__attribute__((target("avx2")))
+static void AccumulateS16Avx(const int16_t *src, int16_t *dst, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + AVX_STEP <= sampleCount; offset += AVX_STEP) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + offset));
+        __m256i out = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + offset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + offset), _mm256_adds_epi16(out, in));
+    }
+    AccumulateS16Range(src, dst, offset, sampleCount);
+}
+
+__attribute__((target("sse4.1")))
+static void ApplyVolumesS16Sse(int16_t *data, const int32_t *vols, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + SSE_STEP <= sampleCount; offset += SSE_STEP) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset));
+        __m128i volLow = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vols + offset));
+        __m128i volHigh = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vols + offset + SSE_FLOAT_STEP));
+        __m128i outLow = MulVolumeSse(in, volLow);
+        __m128i outHigh = MulVolumeSse(_mm_srli_si128(in, SSE_HIGH_HALF_BYTES), volHigh);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + offset), _mm_packs_epi32(outLow, outHigh));
+    }
+    ApplyVolumesS16Range(data, vols, offset, sampleCount);
+}
+
+__attribute__((target("sse4.1")))
+static void ApplyVolumesF32Sse(float *data, const int32_t *vols, size_t sampleCount)
+{
+    size_t offset = 0;
+    __m128 unity = _mm_set1_ps(FLOAT_VOLUME_UNITY);
+    for (; offset + SSE_FLOAT_STEP <= sampleCount; offset += SSE_FLOAT_STEP) {
+        __m128i volInt = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vols + offset));
+        __m128 vol = _mm_mul_ps(_mm_cvtepi32_ps(volInt), unity);
+        _mm_storeu_ps(data + offset, _mm_mul_ps(_mm_loadu_ps(data + offset), vol));
+    }
+    ApplyVolumesF32Range(data, vols, offset, sampleCount);
+}
+
+__attribute__((target("avx2")))
+static void ApplyVolumesS16Avx(int16_t *data, const int32_t *vols, size_t sampleCount)
+{
+    size_t offset = 0;
+    for (; offset + AVX_STEP <= sampleCount; offset += AVX_STEP) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + offset));
+        __m256i volLow = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vols + offset));
+        __m256i volHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vols + offset + AVX_FLOAT_STEP));
+        __m256i outLow = MulVolumeAvx(_mm256_castsi256_si128(in), volLow);
+        __m256i outHigh = MulVolumeAvx(_mm256_extracti128_si256(in, 1), volHigh);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(outLow, outHigh), AVX_PACK_ORDER);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + offset), packed);
+    }
+    ApplyVolumesS16Range(data, vols, offset, sampleCount);
+}
+
+__attribute__((target("avx2")))
+static void ApplyVolumesF32Avx(float *data, const int32_t *vols, size_t sampleCount)
+{
+    size_t offset = 0;
+    __m256 unity = _mm256_set1_ps(FLOAT_VOLUME_UNITY);
+    for (; offset + AVX_FLOAT_STEP <= sampleCount; offset += AVX_FLOAT_STEP) {
+        __m256i volInt = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vols + offset));
+        __m256 vol = _mm256_mul_ps(_mm256_cvtepi32_ps(volInt), unity);
+        _mm256_storeu_ps(data + offset, _mm256_mul_ps(_mm256_loadu_ps(data + offset), vol));
+    }
+    ApplyVolumesF32Range(data, vols, offset, sampleCount);
+}
+
+__attribute__((target("sse4.1")))
+static inline float ReduceDotSse(__m128 half)
+{
+    __m128 pair = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1))); // lane 1 to lane 0
+}
+
+__attribute__((target("sse4.1")))
+static float DotProductF32Sse(const float *a, const float *b, size_t count)
+{
+    __m128 low = _mm_setzero_ps();
+    __m128 high = _mm_setzero_ps();
+    size_t offset = 0;
+    for (; offset + DOT_LANES <= count; offset += DOT_LANES) {
+        low = _mm_add_ps(low, _mm_mul_ps(_mm_loadu_ps(a + offset), _mm_loadu_ps(b + offset)));
+        high = _mm_add_ps(high, _mm_mul_ps(_mm_loadu_ps(a + offset + SSE_FLOAT_STEP),
+            _mm_loadu_ps(b + offset + SSE_FLOAT_STEP)));
+    }
+    return DotProductTail(a, b, offset, count, ReduceDotSse(_mm_add_ps(low, high)));
+}
+
+__attribute__((target("avx2")))
+static float DotProductF32Avx(const float *a, const float *b, size_t count)
+{
+    __m256 lanes = _mm256_setzero_ps();
+    size_t offset = 0;
+    for (; offset + DOT_LANES <= count; offset += DOT_LANES) {
+        lanes = _mm256_add_ps(lanes, _mm256_mul_ps(_mm256_loadu_ps(a + offset), _mm256_loadu_ps(b + offset)));
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(lanes), _mm256_extractf128_ps(lanes, 1));
+    return DotProductTail(a, b, offset, count, ReduceDotSse(half));
+}
+
+static constexpr MixKernelOps SSE41_OPS = { MIX_ISA_SSE41, MixS16Sse, AccumulateS16Sse, ApplyVolumesS16Sse,
+    ApplyVolumesF32Sse, DotProductF32Sse };
+static constexpr MixKernelOps AVX2_OPS = { MIX_ISA_AVX2, MixS16Avx, AccumulateS16Avx, ApplyVolumesS16Avx,
+    ApplyVolumesF32Avx, DotProductF32Avx };
+#endif
+
+static const MixKernelOps *GetOpsByIsa(MixKernelIsa isa)
+{
+    switch (isa) {
+        case MIX_ISA_SCALAR:
+            return &SCALAR_OPS;
+#ifdef MIX_KERNEL_NEON
+        case MIX_ISA_NEON:
+            return &NEON_OPS;
+#endif
+#ifdef MIX_KERNEL_X86
+        case MIX_ISA_SSE41:
+            return __builtin_cpu_supports("sse4.1") ? &SSE41_OPS : nullptr;
+        case MIX_ISA_AVX2:
+            return __builtin_cpu_supports("avx2") ? &AVX2_OPS : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+static const MixKernelOps *DetectOps()
+{
+#ifdef MIX_KERNEL_X86
+    __builtin_cpu_init();
+#endif
+    static const MixKernelIsa preferOrder[] = { MIX_ISA_AVX2, MIX_ISA_SSE41, MIX_ISA_NEON };
+    for (MixKernelIsa isa : preferOrder) {
+        const MixKernelOps *ops = GetOpsByIsa(isa);
+        if (ops != nullptr) {
+            AUDIO_INFO_LOG("use %{public}s mix kernel", AudioMixKernel::GetIsaName(isa));
+            return ops;
+        }
+    }
+    AUDIO_INFO_LOG("use scalar mix kernel");
+    return &SCALAR_OPS;
+}
+
+static std::atomic<const MixKernelOps *> &GetActiveOps()
+{
+    static std::atomic<const MixKernelOps *> activeOps(DetectOps());
+    return activeOps;
+}
+
+MixKernelIsa AudioMixKernel::GetIsa()
+{
+    return GetActiveOps().load(std::memory_order_relaxed)->isa;
+}
+
+bool AudioMixKernel::IsIsaSupported(MixKernelIsa isa)
+{
+#ifdef MIX_KERNEL_X86
+    __builtin_cpu_init();
+#endif
+    return GetOpsByIsa(isa) != nullptr;
+}
+
+bool AudioMixKernel::SetIsa(MixKernelIsa isa)
+{
+    const MixKernelOps *ops = IsIsaSupported(isa) ? GetOpsByIsa(isa) : nullptr;
+    CHECK_AND_RETURN_RET_LOG(ops != nullptr, false, "isa %{public}u is not supported", isa);
+    GetActiveOps().store(ops, std::memory_order_relaxed);
+    return true;
+}
+
+const char *AudioMixKernel::GetIsaName(MixKernelIsa isa)
+{
+    switch (isa) {
+        case MIX_ISA_SCALAR:
+            return "scalar";
+        case MIX_ISA_NEON:
+            return "neon";
+        case MIX_ISA_SSE41:
+            return "sse4.1";
+        case MIX_ISA_AVX2:
+            return "avx2";
+        default:
+            return "unknown";
+    }
+}
+
+void AudioMixKernel::MixS16(const MixSourceS16 *srcs, size_t srcCount, int16_t *dst, size_t sampleCount)
+{
+    CHECK_AND_RETURN_LOG(dst != nullptr && (srcs != nullptr || srcCount == 0), "invalid mix param");
+    const MixKernelOps *ops = GetActiveOps().load(std::memory_order_relaxed);
+    for (size_t i = 0; i < srcCount; i++) {
+        // Vector kernels multiply in 32bit, which is only exact when volume is in (-65536, 65536].
+        if (srcs[i].volume > VOLUME_UNITY || srcs[i].volume <= -VOLUME_UNITY) {
+            ops = &SCALAR_OPS;
+            break;
+        }
+    }
+    ops->mixS16(srcs, srcCount, dst, sampleCount);
+}
+
+void AudioMixKernel::ApplyVolumeS16(const int16_t *src, int32_t volume, int16_t *dst, size_t sampleCount)
+{
+    MixSourceS16 source = { src, volume };
+    MixS16(&source, 1, dst, sampleCount);
+}
+
+void AudioMixKernel::AccumulateS16(const int16_t *src, int16_t *dst, size_t sampleCount)
+{
+    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "invalid accumulate param");
+    GetActiveOps().load(std::memory_order_relaxed)->accumulateS16(src, dst, sampleCount);
+}
+
+void AudioMixKernel::ApplyVolumesS16(int16_t *data, const int32_t *vols, size_t sampleCount)
+{
+    CHECK_AND_RETURN_LOG(data != nullptr && vols != nullptr, "invalid volume param");
+    GetActiveOps().load(std::memory_order_relaxed)->applyVolumesS16(data, vols, sampleCount);
+}
+
+void AudioMixKernel::ApplyVolumesF32(float *data, const int32_t *vols, size_t sampleCount)
+{
+    CHECK_AND_RETURN_LOG(data != nullptr && vols != nullptr, "invalid volume param");
+    GetActiveOps().load(std::memory_order_relaxed)->applyVolumesF32(data, vols, sampleCount);
+}
+
+float AudioMixKernel::DotProductF32(const float *a, const float *b, size_t count)
+{
+    CHECK_AND_RETURN_RET_LOG(a != nullptr && b != nullptr, 0.0f, "invalid dot product param");
+    return GetActiveOps().load(std::memory_order_relaxed)->dotProductF32(a, b, count);
+}
+
+bool AudioMixKernel::IsFormatSupported(AudioSampleFormat format, uint32_t channels)
+{
+    if (channels < MONO || channels > MIX_CHANNEL_MAX) {
+        return false;
+    }
+    return format == SAMPLE_S16LE || format == SAMPLE_S24LE || format == SAMPLE_S32LE || format == SAMPLE_F32LE;
+}
+
+size_t AudioMixKernel::GetFormatByteSize(AudioSampleFormat format)
+{
+    switch (format) {
+        case SAMPLE_U8:
+            return 1; // size is 1
+        case SAMPLE_S16LE:
+            return 2; // size is 2
+        case SAMPLE_S24LE:
+            return 3; // size is 3
+        case SAMPLE_S32LE:
+        case SAMPLE_F32LE:
+            return 4; // size is 4
+        default:
+            return 2; // default size is 2
+    }
+}
+
+template <AudioSampleFormat format>
+static inline float ReadSample(const uint8_t *ptr);
+
+template <>
+inline float ReadSample<SAMPLE_U8>(const uint8_t *ptr)
+{
+    return (static_cast<int32_t>(*ptr) - U8_ZERO) / U8_SCALE;
+}
+
+template <>
+inline float ReadSample<SAMPLE_S16LE>(const uint8_t *ptr)
+{
+    return *reinterpret_cast<const int16_t *>(ptr) / S16_SCALE;
+}
+
+template <>
+inline float ReadSample<SAMPLE_S24LE>(const uint8_t *ptr)
+{
+    uint32_t raw = (static_cast<uint32_t>(ptr[BYTE_INDEX_TWO]) << SHIFT_SIXTEEN) |
+        (static_cast<uint32_t>(ptr[1]) << SHIFT_EIGHT) | static_cast<uint32_t>(ptr[0]);
+    return static_cast<int32_t>(raw << S24_SHIFT) / S32_SCALE;
+}
+
+template <>
+inline float ReadSample<SAMPLE_S32LE>(const uint8_t *ptr)
+{
+    return *reinterpret_cast<const int32_t *>(ptr) / S32_SCALE;
+}
+
+template <>
+inline float ReadSample<SAMPLE_F32LE>(const uint8_t *ptr)
+{
+    return *reinterpret_cast<const float *>(ptr);
+}
+
+// The layout of the interleaved channels, in the ascending bit order of AudioChannelSet. The declared layout is
+// used when it matches the channel count, else the default layout of the count. CH_LAYOUT_UNKNOWN if it holds
+// speakers the matrix can not map.
+static uint64_t GetMixLayout(uint64_t layout, uint32_t channels)
+{
+    if ((layout & CH_MODE_MASK) != 0) {
+        return CH_LAYOUT_UNKNOWN;
+    }
+    if (layout == CH_LAYOUT_UNKNOWN || static_cast<uint32_t>(__builtin_popcountll(layout)) != channels) {
+        return channels < DEFAULT_MIX_LAYOUTS.size() ? DEFAULT_MIX_LAYOUTS[channels] : CH_LAYOUT_UNKNOWN;
+    }
+    return (layout & ~MIXABLE_SPEAKERS) == 0 ? layout : CH_LAYOUT_UNKNOWN;
+}
+
+static uint32_t GetChannelIndex(uint64_t layout, uint64_t speaker)
+{
+    return static_cast<uint32_t>(__builtin_popcountll(layout & (speaker - 1)));
+}
+
+// Add a source speaker to a destination speaker, -3dB if the destination carries its own source channel too.
+static bool FoldSpeaker(uint64_t srcLayout, uint64_t dstLayout, uint64_t speaker, uint64_t target,
+    ChannelMixMatrix &matrix)
+{
+    if ((dstLayout & target) == 0) {
+        return false;
+    }
+    float gain = (srcLayout & target) != 0 ? FOLD_DOWN_GAIN : 1.0f;
+    matrix.gain[GetChannelIndex(dstLayout, target)][GetChannelIndex(srcLayout, speaker)] = gain;
+    return true;
+}
+
+// A speaker the destination lacks goes to the nearest one of its side, a center one to both sides at -3dB and
+// LFE is dropped.
+static bool MapSpeaker(uint64_t srcLayout, uint64_t dstLayout, uint64_t speaker, ChannelMixMatrix &matrix)
+{
+    if ((dstLayout & speaker) != 0) {
+        matrix.gain[GetChannelIndex(dstLayout, speaker)][GetChannelIndex(srcLayout, speaker)] = 1.0f;
+        return true;
+    }
+    switch (speaker) {
+        case LOW_FREQUENCY:
+            return true;
+        case FRONT_CENTER:
+            matrix.gain[GetChannelIndex(dstLayout, FRONT_LEFT)][GetChannelIndex(srcLayout, speaker)] = FOLD_DOWN_GAIN;
+            matrix.gain[GetChannelIndex(dstLayout, FRONT_RIGHT)][GetChannelIndex(srcLayout, speaker)] = FOLD_DOWN_GAIN;
+            return true;
+        case BACK_CENTER: {
+            uint64_t pair = (dstLayout & BACK_LEFT) != 0 && (dstLayout & BACK_RIGHT) != 0 ? BACK_LEFT | BACK_RIGHT :
+                ((dstLayout & SIDE_LEFT) != 0 && (dstLayout & SIDE_RIGHT) != 0 ? SIDE_LEFT | SIDE_RIGHT :
+                FRONT_LEFT | FRONT_RIGHT);
+            uint32_t srcIndex = GetChannelIndex(srcLayout, speaker);
+            matrix.gain[GetChannelIndex(dstLayout, pair & (~pair + 1))][srcIndex] = FOLD_DOWN_GAIN; // lowest bit
+            matrix.gain[GetChannelIndex(dstLayout, pair & (pair - 1))][srcIndex] = FOLD_DOWN_GAIN; // highest bit
+            return true;
+        }
+        case FRONT_LEFT_OF_CENTER:
+            return FoldSpeaker(srcLayout, dstLayout, speaker, FRONT_LEFT, matrix);
+        case FRONT_RIGHT_OF_CENTER:
+            return FoldSpeaker(srcLayout, dstLayout, speaker, FRONT_RIGHT, matrix);
+        case BACK_LEFT:
+            return FoldSpeaker(srcLayout, dstLayout, speaker, SIDE_LEFT, matrix) ||
+                FoldSpeaker(srcLayout, dstLayout, speaker, FRONT_LEFT, matrix);
+        case BACK_RIGHT:
+            return FoldSpeaker(srcLayout, dstLayout, speaker, SIDE_RIGHT, matrix) ||
+                FoldSpeaker(srcLayout, dstLayout, speaker, FRONT_RIGHT, matrix);
+        case SIDE_LEFT:
+            return FoldSpeaker(srcLayout, dstLayout, speaker, BACK_LEFT, matrix) ||
+                FoldSpeaker(srcLayout, dstLayout, speaker, FRONT_LEFT, matrix);
+        case SIDE_RIGHT:
+            return FoldSpeaker(srcLayout, dstLayout, speaker, BACK_RIGHT, matrix) ||
+                FoldSpeaker(srcLayout, dstLayout, speaker, FRONT_RIGHT, matrix);
+        default:
+            return false;
+    }
+}
+
+static bool BuildChannelMixMatrix(const MixSourceDesc &src, uint32_t dstChannels, uint64_t dstLayout,
+    ChannelMixMatrix &matrix)
+{
+    uint64_t srcMixLayout = GetMixLayout(src.channelLayout, src.channels);
+    uint64_t dstMixLayout = GetMixLayout(dstLayout, dstChannels);
+    CHECK_AND_RETURN_RET_LOG(srcMixLayout != CH_LAYOUT_UNKNOWN && dstMixLayout != CH_LAYOUT_UNKNOWN, false,
+        "can not map layout %{public}" PRIu64 " to %{public}" PRIu64, src.channelLayout, dstLayout);
+    matrix.isIdentity = srcMixLayout == dstMixLayout;
+    if (matrix.isIdentity) {
+        return true;
+    }
+    if (src.channels == MONO) {
+        matrix.gain[GetChannelIndex(dstMixLayout, FRONT_LEFT)][0] = 1.0f;
+        matrix.gain[GetChannelIndex(dstMixLayout, FRONT_RIGHT)][0] = 1.0f;
+        return true;
+    }
+    if (dstChannels == MONO) {
+        bool hasLfe = (srcMixLayout & LOW_FREQUENCY) != 0;
+        float gain = 1.0f / (hasLfe ? src.channels - 1 : src.channels);
+        for (uint32_t i = 0; i < src.channels; i++) {
+            matrix.gain[0][i] = gain;
+        }
+        if (hasLfe) {
+            matrix.gain[0][GetChannelIndex(srcMixLayout, LOW_FREQUENCY)] = 0.0f;
+        }
+        return true;
+    }
+    // every destination layout but mono has the front pair to fold into
+    CHECK_AND_RETURN_RET_LOG((dstMixLayout & CH_LAYOUT_STEREO) == CH_LAYOUT_STEREO, false,
+        "no front pair in layout %{public}" PRIu64, dstMixLayout);
+    for (uint64_t speakers = srcMixLayout; speakers != 0; speakers &= speakers - 1) {
+        uint64_t speaker = speakers & (~speakers + 1); // lowest bit
+        CHECK_AND_RETURN_RET_LOG(MapSpeaker(srcMixLayout, dstMixLayout, speaker, matrix), false,
+            "can not map speaker %{public}" PRIu64 " to layout %{public}" PRIu64, speaker, dstMixLayout);
+    }
+    return true;
+}
+
+template <AudioSampleFormat format>
+static void AccumulateFrames(const MixSourceDesc &src, const ChannelMixMatrix &matrix, uint32_t dstChannels,
+    float *acc, size_t frameCount)
+{
+    const size_t sampleSize = AudioMixKernel::GetFormatByteSize(format);
+    const float volume = src.volume * FLOAT_VOLUME_UNITY;
+    const uint8_t *in = src.data;
+    if (matrix.isIdentity) {
+        size_t sampleCount = frameCount * dstChannels;
+        for (size_t i = 0; i < sampleCount; i++) {
+            acc[i] += ReadSample<format>(in + i * sampleSize) * volume;
+        }
+        return;
+    }
+    float frame[MIX_CHANNEL_MAX] = {};
+    for (size_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+        for (uint32_t srcIdx = 0; srcIdx < src.channels; srcIdx++) {
+            frame[srcIdx] = ReadSample<format>(in) * volume;
+            in += sampleSize;
+        }
+        for (uint32_t dstIdx = 0; dstIdx < dstChannels; dstIdx++) {
+            float sum = 0.0f;
+            for (uint32_t srcIdx = 0; srcIdx < src.channels; srcIdx++) {
+                sum += matrix.gain[dstIdx][srcIdx] * frame[srcIdx];
+            }
+            *acc++ += sum;
+        }
+    }
+}
+
+// A unity gain source in the layout of the accumulator goes to the fused kernels of audio_format_convert.
+static bool AccumulateUnity(const MixSourceDesc &src, float *acc, size_t sampleCount)
+{
+    switch (src.format) {
+        case SAMPLE_S16LE:
+            AudioAccumulateS16ToF32(reinterpret_cast<const int16_t *>(src.data), acc, sampleCount);
+            return true;
+        case SAMPLE_S24LE:
+            AudioAccumulateS24ToF32(src.data, acc, sampleCount);
+            return true;
+        case SAMPLE_S32LE:
+            AudioAccumulateS32ToF32(reinterpret_cast<const int32_t *>(src.data), acc, sampleCount);
+            return true;
+        case SAMPLE_F32LE:
+            AudioAccumulateF32(reinterpret_cast<const float *>(src.data), acc, sampleCount);
+            return true;
+        default:
+            return false;
+    }
+}
+
+int32_t AudioMixKernel::AccumulateToFloat(const MixSourceDesc &src, uint32_t dstChannels, uint64_t dstLayout,
+    float *acc, size_t frameCount)
+{
+    CHECK_AND_RETURN_RET_LOG(src.data != nullptr && acc != nullptr && IsFormatSupported(src.format, src.channels) &&
+        dstChannels >= MONO && dstChannels <= MIX_CHANNEL_MAX, ERR_INVALID_PARAM,
+        "invalid param, format:%{public}d channels:%{public}u->%{public}u", src.format, src.channels, dstChannels);
+    ChannelMixMatrix matrix;
+    CHECK_AND_RETURN_RET(BuildChannelMixMatrix(src, dstChannels, dstLayout, matrix), ERR_NOT_SUPPORTED);
+    if (matrix.isIdentity && src.volume == VOLUME_UNITY && AccumulateUnity(src, acc, frameCount * dstChannels)) {
+        return SUCCESS;
+    }
+    switch (src.format) {
+        case SAMPLE_S16LE:
+            AccumulateFrames<SAMPLE_S16LE>(src, matrix, dstChannels, acc, frameCount);
+            break;
+        case SAMPLE_S24LE:
+            AccumulateFrames<SAMPLE_S24LE>(src, matrix, dstChannels, acc, frameCount);
+            break;
+        case SAMPLE_S32LE:
+            AccumulateFrames<SAMPLE_S32LE>(src, matrix, dstChannels, acc, frameCount);
+            break;
+        case SAMPLE_F32LE:
+            AccumulateFrames<SAMPLE_F32LE>(src, matrix, dstChannels, acc, frameCount);
+            break;
+        default:
+            return ERR_NOT_SUPPORTED;
+    }
+    return SUCCESS;
+}
+
+template <AudioSampleFormat format>
+static void ConvertSamples(const uint8_t *src, float volume, float *dst, size_t sampleCount)
+{
+    const size_t sampleSize = AudioMixKernel::GetFormatByteSize(format);
+    for (size_t i = 0; i < sampleCount; i++) {
+        dst[i] = ReadSample<format>(src + i * sampleSize) * volume;
+    }
+}
+
+int32_t AudioMixKernel::ConvertToFloat(const uint8_t *src, AudioSampleFormat format, float volume, float *dst,
+    size_t sampleCount)
+{
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ERR_INVALID_PARAM, "invalid param");
+    if (volume == 1.0f && format == SAMPLE_S16LE) {
+        AudioConvertS16ToF32(reinterpret_cast<const int16_t *>(src), dst, sampleCount);
+        return SUCCESS;
+    } else if (volume == 1.0f && format == SAMPLE_S24LE) {
+        AudioConvertS24ToF32(src, dst, sampleCount);
+        return SUCCESS;
+    } else if (volume == 1.0f && format == SAMPLE_S32LE) {
+        AudioConvertS32ToF32(reinterpret_cast<const int32_t *>(src), dst, sampleCount);
+        return SUCCESS;
+    }
+    switch (format) {
+        case SAMPLE_U8:
+            ConvertSamples<SAMPLE_U8>(src, volume, dst, sampleCount);
+            break;
+        case SAMPLE_S16LE:
+            ConvertSamples<SAMPLE_S16LE>(src, volume, dst, sampleCount);
+            break;
+        case SAMPLE_S24LE:
+            ConvertSamples<SAMPLE_S24LE>(src, volume, dst, sampleCount);
+            break;
+        case SAMPLE_S32LE:
+            ConvertSamples<SAMPLE_S32LE>(src, volume, dst, sampleCount);
+            break;
+        case SAMPLE_F32LE:
+            ConvertSamples<SAMPLE_F32LE>(src, volume, dst, sampleCount);
+            break;
+        default:
+            AUDIO_ERR_LOG("not supported format:%{public}d", format);
+            return ERR_NOT_SUPPORTED;
+    }
+    return SUCCESS;
+}
+
+static inline float ClampFloat(float value)
+{
+    return value > 1.0f ? 1.0f : (value < -1.0f ? -1.0f : value);
+}
+
+int32_t AudioMixKernel::FloatToFormat(const float *acc, AudioSampleFormat format, uint8_t *dst, size_t sampleCount)
+{
+    CHECK_AND_RETURN_RET_LOG(acc != nullptr && dst != nullptr, ERR_INVALID_PARAM, "invalid param");
+    switch (format) {
+        case SAMPLE_S16LE:
+            AudioConvertF32ToS16(acc, reinterpret_cast<int16_t *>(dst), sampleCount, nullptr);
+            break;
+        case SAMPLE_S24LE:
+            AudioConvertF32ToS24(acc, dst, sampleCount, nullptr);
+            break;
+        case SAMPLE_S32LE:
+            AudioConvertF32ToS32(acc, reinterpret_cast<int32_t *>(dst), sampleCount);
+            break;
+        case SAMPLE_F32LE: {
+            float *out = reinterpret_cast<float *>(dst);
+            for (size_t i = 0; i < sampleCount; i++) {
+                out[i] = ClampFloat(acc[i]);
+            }
+            break;
+        }
+        default:
+            AUDIO_ERR_LOG("not supported format:%{public}d", format);
+            return ERR_NOT_SUPPORTED;
+    }
+    return SUCCESS;
+}
+} // namespace AudioStandard
+} // namespace OHOS
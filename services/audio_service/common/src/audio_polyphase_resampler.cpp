@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioPolyphaseResampler"
+#endif
+
+#include "audio_polyphase_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+
+#include "audio_errors.h"
+#include "audio_mix_kernel.h"
+#include "audio_service_log.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+static constexpr uint32_t TAPS_ALIGNMENT = 8; // lanes of AudioMixKernel::DotProductF32
+static constexpr uint32_t MAX_TAPS = 256;
+static constexpr size_t INPUT_BLOCK_FRAMES = 256; // input frames appended to the history at a time
+static constexpr double BESSEL_EPSILON = 1e-12;
+static constexpr uint32_t KEY_PHASE_SHIFT = 32;
+static constexpr uint32_t KEY_QUALITY_SHIFT = 16;
+
+struct QualityParam {
+    uint32_t taps;
+    double kaiserBeta;
+    double rolloff; // pass band edge relative to the lower nyquist
+};
+
+static constexpr QualityParam QUALITY_PARAMS[] = {
+    { 16, 6.0, 0.86 }, // RESAMPLE_QUALITY_LOW
+    { 32, 8.0, 0.92 }, // RESAMPLE_QUALITY_MEDIUM
+    { 64, 10.0, 0.95 }, // RESAMPLE_QUALITY_HIGH
+};
+}
+
+struct AudioPolyphaseResampler::FilterBank {
+    uint32_t taps = 0;
+    std::vector<float> coeffs; // taps coefficients for each phase
+};
+
+// Zeroth order modified bessel function of the first kind, for the kaiser window.
+static double BesselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    double halfX = x / 2; // 2 for the series of (x / 2)^2k / (k!)^2
+    for (uint32_t k = 1; term > sum * BESSEL_EPSILON; k++) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+    }
+    return sum;
+}
+
+static double WindowedSinc(double distance, double cutoff, double halfWidth, double beta)
+{
+    double ratio = distance / halfWidth;
+    if (ratio <= -1.0 || ratio >= 1.0) {
+        return 0.0;
+    }
+    double window = BesselI0(beta * std::sqrt(1.0 - ratio * ratio)) / BesselI0(beta);
+    double x = M_PI * cutoff * distance;
+    double sinc = std::fabs(x) < BESSEL_EPSILON ? 1.0 : std::sin(x) / x;
+    return cutoff * sinc * window;
+}
+
+static const QualityParam &GetQualityParam(AudioResampleQuality quality)
+{
+    size_t index = std::min<size_t>(quality, sizeof(QUALITY_PARAMS) / sizeof(QUALITY_PARAMS[0]) - 1);
+    return QUALITY_PARAMS[index];
+}
+
+std::shared_ptr<const AudioPolyphaseResampler::FilterBank> AudioPolyphaseResampler::GetFilterBank(
+    uint32_t phaseCount, uint32_t step, AudioResampleQuality quality)
+{
+    static std::mutex bankMutex;
+    static std::map<uint64_t, std::weak_ptr<const FilterBank>> bankCache;
+    uint64_t key = (static_cast<uint64_t>(phaseCount) << KEY_PHASE_SHIFT) |
+        (static_cast<uint64_t>(quality) << KEY_QUALITY_SHIFT) | step;
+    std::lock_guard<std::mutex> lock(bankMutex);
+    std::shared_ptr<const FilterBank> cached = bankCache[key].lock();
+    if (cached != nullptr) {
+        return cached;
+    }
+
+    const QualityParam &param = GetQualityParam(quality);
+    // A down sampler cuts at the output nyquist, the filter is widened by the ratio to keep the transition band.
+    double ratio = static_cast<double>(step) / phaseCount;
+    double cutoff = param.rolloff * std::min(1.0, 1.0 / ratio);
+    uint32_t taps = static_cast<uint32_t>(std::ceil(param.taps * std::max(1.0, ratio)));
+    taps = std::min(MAX_TAPS, (taps + TAPS_ALIGNMENT - 1) / TAPS_ALIGNMENT * TAPS_ALIGNMENT);
+    double halfWidth = taps / 2; // 2 for half
+
+    auto bank = std::make_shared<FilterBank>();
+    bank->taps = taps;
+    bank->coeffs.resize(static_cast<size_t>(phaseCount) * taps);
+    for (uint32_t phase = 0; phase < phaseCount; phase++) {
+        float *coeffs = bank->coeffs.data() + static_cast<size_t>(phase) * taps;
+        // coeffs[k] weights input frame center - taps / 2 + 1 + k for an output at center + phase / phaseCount
+        double offset = static_cast<double>(phase) / phaseCount + halfWidth - 1;
+        double sum = 0.0;
+        for (uint32_t k = 0; k < taps; k++) {
+            coeffs[k] = static_cast<float>(WindowedSinc(offset - k, cutoff, halfWidth, param.kaiserBeta));
+            sum += coeffs[k];
+        }
+        // unity gain at dc for every phase
+        for (uint32_t k = 0; k < taps; k++) {
+            coeffs[k] = static_cast<float>(coeffs[k] / sum);
+        }
+    }
+    AUDIO_INFO_LOG("filter bank %{public}u/%{public}u quality %{public}u taps %{public}u", phaseCount, step, quality,
+        taps);
+    bankCache[key] = bank;
+    return bank;
+}
+
+bool AudioPolyphaseResampler::IsRateSupported(uint32_t inRate, uint32_t outRate)
+{
+    if (inRate == 0 || outRate == 0) {
+        return false;
+    }
+    return outRate / std::gcd(inRate, outRate) <= MAX_PHASE_COUNT;
+}
+
+AudioPolyphaseResampler::AudioPolyphaseResampler(uint32_t channels, uint32_t inRate, uint32_t outRate,
+    AudioResampleQuality quality)
+{
+    CHECK_AND_RETURN_LOG(channels > 0 && IsRateSupported(inRate, outRate),
+        "not supported, channels:%{public}u rate:%{public}u->%{public}u", channels, inRate, outRate);
+    uint32_t divisor = std::gcd(inRate, outRate);
+    uint32_t step = inRate / divisor;
+    phaseCount_ = outRate / divisor;
+    intStep_ = step / phaseCount_;
+    fracStep_ = step % phaseCount_;
+    bank_ = GetFilterBank(phaseCount_, step, quality);
+    taps_ = bank_->taps;
+    channels_ = channels;
+    historyFrames_ = taps_ + INPUT_BLOCK_FRAMES;
+    history_.resize(historyFrames_ * channels_);
+    Reset();
+}
+
+bool AudioPolyphaseResampler::IsInit() const noexcept
+{
+    return bank_ != nullptr;
+}
+
+void AudioPolyphaseResampler::Reset()
+{
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    // taps / 2 - 1 frames of silence before the first input, so that the first output is taken at it.
+    filled_ = taps_ / 2 - 1; // 2 for half
+    center_ = filled_;
+    phase_ = 0;
+}
+
+uint32_t AudioPolyphaseResampler::GetLatencyFrames() const noexcept
+{
+    return taps_ / 2; // 2 for half
+}
+
+uint32_t AudioPolyphaseResampler::GetTaps() const noexcept
+{
+    return taps_;
+}
+
+void AudioPolyphaseResampler::ProduceFrame(float *output)
+{
+    const float *coeffs = bank_->coeffs.data() + static_cast<size_t>(phase_) * taps_;
+    size_t start = center_ + 1 - taps_ / 2; // 2 for half
+    for (uint32_t ch = 0; ch < channels_; ch++) {
+        output[ch] = AudioMixKernel::DotProductF32(coeffs, history_.data() + ch * historyFrames_ + start, taps_);
+    }
+}
+
+void AudioPolyphaseResampler::AdvanceFrame()
+{
+    center_ += intStep_;
+    phase_ += fracStep_;
+    if (phase_ >= phaseCount_) {
+        phase_ -= phaseCount_;
+        center_++;
+    }
+}
+
+// Drop the frames no output needs any more, a down sampler may have stepped past all of them.
+void AudioPolyphaseResampler::CompactHistory()
+{
+    size_t start = std::min(center_ + 1 - taps_ / 2, filled_); // 2 for half
+    if (start == 0) {
+        return;
+    }
+    size_t remain = filled_ - start;
+    for (uint32_t ch = 0; ch < channels_; ch++) {
+        float *row = history_.data() + ch * historyFrames_;
+        std::copy(row + start, row + filled_, row);
+    }
+    filled_ = remain;
+    center_ -= start;
+}
+
+uint32_t AudioPolyphaseResampler::AppendInput(const float *input, uint32_t frames)
+{
+    uint32_t count = static_cast<uint32_t>(std::min<size_t>(frames, historyFrames_ - filled_));
+    for (uint32_t ch = 0; ch < channels_; ch++) {
+        float *row = history_.data() + ch * historyFrames_ + filled_;
+        const float *in = input + ch;
+        for (uint32_t i = 0; i < count; i++) {
+            row[i] = in[static_cast<size_t>(i) * channels_];
+        }
+    }
+    filled_ += count;
+    return count;
+}
+
+int32_t AudioPolyphaseResampler::Process(const float *input, uint32_t &inFrames, float *output, uint32_t &outFrames)
+{
+    CHECK_AND_RETURN_RET_LOG(IsInit() && (input != nullptr || inFrames == 0) && (output != nullptr || outFrames == 0),
+        ERR_INVALID_PARAM, "invalid resample param");
+    uint32_t consumed = 0;
+    uint32_t produced = 0;
+    size_t halfTaps = taps_ / 2; // 2 for half
+    while (true) {
+        while (produced < outFrames && center_ + halfTaps < filled_) {
+            ProduceFrame(output + static_cast<size_t>(produced) * channels_);
+            AdvanceFrame();
+            produced++;
+        }
+        if (produced == outFrames || consumed == inFrames) {
+            break;
+        }
+        CompactHistory();
+        consumed += AppendInput(input + static_cast<size_t>(consumed) * channels_, inFrames - consumed);
+    }
+    inFrames = consumed;
+    outFrames = produced;
+    return SUCCESS;
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -23,14 +23,27 @@
 
 namespace OHOS {
 namespace AudioStandard {
+// speex quality 0-1, 2-4 and 5-10 use at least 16, 32 and 64 taps, the same as the polyphase tiers.
+static constexpr int32_t SPEEX_QUALITY_MEDIUM = 2;
+static constexpr int32_t SPEEX_QUALITY_HIGH = 5;
+static const std::string PROCESS_FLOAT_RESAMPLE_TRACE_TAG = "AudioResample::ProcessFloatResample ";
+
 struct AudioResample::SpeexResample {
 #ifdef SPEEX_ENABLE
     SpeexResamplerState *resampler;
     uint32_t channelCount_;
 #endif
 };
-AudioResample::AudioResample(uint32_t channels, uint32_t inRate, uint32_t outRate, int32_t quantity) : speex_(nullptr)
+AudioResample::AudioResample(uint32_t channels, uint32_t inRate, uint32_t outRate, int32_t quantity)
+    : speex_(nullptr), polyphase_(nullptr), channels_(channels)
 {
+    if (AudioPolyphaseResampler::IsRateSupported(inRate, outRate)) {
+        polyphase_ = std::make_unique<AudioPolyphaseResampler>(channels, inRate, outRate, GetQuality(quantity));
+        if (polyphase_->IsInit()) {
+            return;
+        }
+        polyphase_ = nullptr;
+    }
 #ifdef SPEEX_ENABLE
     int32_t error;
     speex_ = std::make_unique<SpeexResample>();
@@ -45,9 +58,17 @@ AudioResample::AudioResample(uint32_t channels, uint32_t inRate, uint32_t outRat
 #endif
 }
 
+AudioResampleQuality AudioResample::GetQuality(int32_t quantity)
+{
+    if (quantity >= SPEEX_QUALITY_HIGH) {
+        return RESAMPLE_QUALITY_HIGH;
+    }
+    return quantity >= SPEEX_QUALITY_MEDIUM ? RESAMPLE_QUALITY_MEDIUM : RESAMPLE_QUALITY_LOW;
+}
+
 bool AudioResample::IsResampleInit() const noexcept
 {
-    if (speex_) {
+    if (polyphase_ || speex_) {
         return true;
     }
     return false;
@@ -66,20 +87,35 @@ AudioResample::~AudioResample()
 }
 
 int32_t AudioResample::ProcessFloatResample(const std::vector<float> &input, std::vector<float> &output)
+{
+    if (channels_ == 0) {
+        return ERR_INVALID_PARAM;
+    }
+    uint32_t inSize = input.size() / channels_;
+    uint32_t outSize = output.size() / channels_;
+    return ProcessFloatResample(input.data(), inSize, output.data(), outSize);
+}
+
+int32_t AudioResample::ProcessFloatResample(const float *input, uint32_t &inFrames, float *output, uint32_t &outFrames)
 {
     int32_t ret = 0;
+    if (input == nullptr || output == nullptr) {
+        return ERR_INVALID_PARAM;
+    }
+    if (polyphase_) {
+        Trace trace(PROCESS_FLOAT_RESAMPLE_TRACE_TAG, inFrames);
+        return polyphase_->Process(input, inFrames, output, outFrames);
+    }
     if (!speex_) {
         return ERR_INVALID_PARAM;
     }
 #ifdef SPEEX_ENABLE
-    Trace trace("AudioResample::ProcessFloatResample");
+    Trace trace(PROCESS_FLOAT_RESAMPLE_TRACE_TAG, inFrames);
     if (speex_->channelCount_ <= 0) {
         return ERR_INVALID_PARAM;
     }
-    uint32_t inSize = input.size() / speex_->channelCount_;
-    uint32_t outSize = output.size() / speex_->channelCount_;
-    ret = speex_resampler_process_interleaved_float(speex_->resampler, input.data(), &inSize, output.data(), &outSize);
-    AUDIO_DEBUG_LOG("after in size:%{public}d,out size:%{public}d,result:%{public}d", inSize, outSize, ret);
+    ret = speex_resampler_process_interleaved_float(speex_->resampler, input, &inFrames, output, &outFrames);
+    AUDIO_DEBUG_LOG("after in size:%{public}d,out size:%{public}d,result:%{public}d", inFrames, outFrames, ret);
 #endif
     return ret;
 }
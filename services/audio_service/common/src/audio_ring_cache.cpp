@@ -19,6 +19,8 @@
 #include "audio_ring_cache.h"
 #include "audio_service_log.h"
 
+#include <algorithm>
+
 #include "securec.h"
 
 namespace OHOS {
@@ -322,5 +324,229 @@ OptResult AudioRingCache::Dequeue(const BufferWrap &buffer)
     result = {OPERATION_SUCCESS, buffer.dataSize};
     return result;
 }
+
+AudioSpscRingCache::AudioSpscRingCache(size_t cacheSize) : cacheTotalSize_(cacheSize)
+{
+    AUDIO_INFO_LOG("AudioSpscRingCache() with cacheSize:%{public}zu", cacheSize);
+}
+
+AudioSpscRingCache::~AudioSpscRingCache()
+{
+    AUDIO_DEBUG_LOG("~AudioSpscRingCache()");
+}
+
+bool AudioSpscRingCache::Init()
+{
+    if (cacheTotalSize_ > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("Init failed: size too large:%{public}zu", cacheTotalSize_);
+        return false;
+    }
+    writeIndex_.store(0);
+    readIndex_.store(0);
+    basePtr_ = std::make_unique<uint8_t[]>(cacheTotalSize_);
+    if (basePtr_ == nullptr) {
+        AUDIO_ERR_LOG("Init failed, get memory failed size is:%{public}zu", cacheTotalSize_);
+        return false;
+    }
+    if (memset_s(basePtr_.get(), cacheTotalSize_, 0, cacheTotalSize_) != EOK) {
+        AUDIO_ERR_LOG("Init call memeset_s failed.");
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<AudioSpscRingCache> AudioSpscRingCache::Create(size_t cacheSize)
+{
+    if (cacheSize > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("Create failed: size too large:%{public}zu", cacheSize);
+        return nullptr;
+    }
+    std::unique_ptr<AudioSpscRingCache> ringCache = std::make_unique<AudioSpscRingCache>(cacheSize);
+
+    if (ringCache->Init() != true) {
+        AUDIO_ERR_LOG("Create failed: Init failed");
+        return nullptr;
+    }
+    return ringCache;
+}
+
+OptResult AudioSpscRingCache::ReConfig(size_t cacheSize, bool copyRemained)
+{
+    AUDIO_INFO_LOG("ReConfig with cacheSize:%{public}zu", cacheSize);
+    OptResult result = {OPERATION_SUCCESS, cacheSize};
+    if (cacheSize > MAX_CACHE_SIZE) {
+        result.ret = INDEX_OUT_OF_RANGE;
+        AUDIO_ERR_LOG("ReConfig failed: size too large:%{public}zu", cacheSize);
+        return result;
+    }
+    if (!copyRemained) {
+        cacheTotalSize_ = cacheSize;
+        if (Init() != true) {
+            result.ret = OPERATION_FAILED;
+        }
+        return result;
+    }
+    // if need copyRemained, we should check the cacheSize >= remained size.
+    result = GetReadableSize();
+    if (result.ret != OPERATION_SUCCESS || result.size > cacheSize) {
+        AUDIO_ERR_LOG("ReConfig in copyRemained failed ret:%{public}d size :%{public}zu", result.ret, cacheSize);
+        return result;
+    }
+    size_t remainedSize = result.size;
+    std::unique_ptr<uint8_t[]> temp = std::make_unique<uint8_t[]>(cacheSize);
+    if (remainedSize > 0) {
+        result = Dequeue({temp.get(), remainedSize});
+        CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result,
+            "ReConfig dequeue failed ret:%{public}d", result.ret);
+    }
+    // keep the remained data at the start of the new buffer and publish it with the write index.
+    basePtr_ = std::move(temp);
+    cacheTotalSize_ = cacheSize;
+    readIndex_.store(0);
+    writeIndex_.store(remainedSize);
+    return {OPERATION_SUCCESS, remainedSize};
+}
+
+void AudioSpscRingCache::ResetBuffer()
+{
+    writeIndex_.store(0);
+    readIndex_.store(0);
+}
+
+size_t AudioSpscRingCache::GetCahceSize()
+{
+    return cacheTotalSize_;
+}
+
+size_t AudioSpscRingCache::GetUsedSize(size_t writeIndex, size_t readIndex) const
+{
+    return writeIndex >= readIndex ? writeIndex - readIndex : writeIndex + 2 * cacheTotalSize_ - readIndex;
+}
+
+size_t AudioSpscRingCache::AdvanceIndex(size_t index, size_t size) const
+{
+    index += size;
+    return index >= 2 * cacheTotalSize_ ? index - 2 * cacheTotalSize_ : index;
+}
+
+void AudioSpscRingCache::GetSpan(size_t index, size_t size, RingSpan &span) const
+{
+    size_t offset = index >= cacheTotalSize_ ? index - cacheTotalSize_ : index;
+    size_t headSize = std::min(size, cacheTotalSize_ - offset);
+    span.first = {basePtr_.get() + offset, headSize};
+    span.second = {headSize < size ? basePtr_.get() : nullptr, size - headSize};
+}
+
+OptResult AudioSpscRingCache::GetWritableSize()
+{
+    size_t writeIndex = writeIndex_.load(std::memory_order_relaxed);
+    size_t readIndex = readIndex_.load(std::memory_order_acquire);
+    size_t usedSize = GetUsedSize(writeIndex, readIndex);
+    if (usedSize > cacheTotalSize_) {
+        AUDIO_ERR_LOG("GetWritableSize failed: writeIndex[%{public}zu] readIndex[%{public}zu]", writeIndex, readIndex);
+        return {INVALID_STATUS, 0};
+    }
+    return {OPERATION_SUCCESS, cacheTotalSize_ - usedSize};
+}
+
+OptResult AudioSpscRingCache::GetReadableSize()
+{
+    size_t writeIndex = writeIndex_.load(std::memory_order_acquire);
+    size_t readIndex = readIndex_.load(std::memory_order_relaxed);
+    size_t usedSize = GetUsedSize(writeIndex, readIndex);
+    if (usedSize > cacheTotalSize_) {
+        AUDIO_ERR_LOG("GetReadableSize failed: writeIndex[%{public}zu] readIndex[%{public}zu]", writeIndex, readIndex);
+        return {INVALID_STATUS, 0};
+    }
+    return {OPERATION_SUCCESS, usedSize};
+}
+
+OptResult AudioSpscRingCache::ReserveWrite(size_t size, RingSpan &span)
+{
+    OptResult result = GetWritableSize();
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "ReserveWrite failed to get writable size.");
+    result.size = std::min(size, result.size);
+    GetSpan(writeIndex_.load(std::memory_order_relaxed), result.size, span);
+    return result;
+}
+
+OptResult AudioSpscRingCache::CommitWrite(size_t size)
+{
+    OptResult result = GetWritableSize();
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "CommitWrite failed to get writable size.");
+    if (size > result.size) {
+        AUDIO_ERR_LOG("CommitWrite size %{public}zu over writable size %{public}zu", size, result.size);
+        return {INDEX_OUT_OF_RANGE, result.size};
+    }
+    writeIndex_.store(AdvanceIndex(writeIndex_.load(std::memory_order_relaxed), size), std::memory_order_release);
+    return {OPERATION_SUCCESS, size};
+}
+
+OptResult AudioSpscRingCache::ReserveRead(size_t size, RingSpan &span)
+{
+    OptResult result = GetReadableSize();
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "ReserveRead failed to get readable size.");
+    result.size = std::min(size, result.size);
+    GetSpan(readIndex_.load(std::memory_order_relaxed), result.size, span);
+    return result;
+}
+
+OptResult AudioSpscRingCache::CommitRead(size_t size)
+{
+    OptResult result = GetReadableSize();
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "CommitRead failed to get readable size.");
+    if (size > result.size) {
+        AUDIO_ERR_LOG("CommitRead size %{public}zu over readable size %{public}zu", size, result.size);
+        return {INVALID_OPERATION, result.size};
+    }
+    readIndex_.store(AdvanceIndex(readIndex_.load(std::memory_order_relaxed), size), std::memory_order_release);
+    return {OPERATION_SUCCESS, size};
+}
+
+OptResult AudioSpscRingCache::Enqueue(const BufferWrap &buffer)
+{
+    if (buffer.dataPtr == nullptr || buffer.dataSize > MAX_CACHE_SIZE || buffer.dataSize == 0) {
+        AUDIO_ERR_LOG("Enqueue failed: BufferWrap is null or size %{public}zu is too large", buffer.dataSize);
+        return {INVALID_PARAMS, 0};
+    }
+    RingSpan span;
+    OptResult result = ReserveWrite(buffer.dataSize, span);
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "Enqueue failed to get writeable size.");
+    if (result.size < buffer.dataSize) {
+        AUDIO_WARNING_LOG("Enqueue find buffer not enough, writableSize:%{public}zu , enqueue size:%{public}zu",
+            result.size, buffer.dataSize);
+        return {INDEX_OUT_OF_RANGE, result.size};
+    }
+    if (memcpy_s(span.first.dataPtr, span.first.dataSize, buffer.dataPtr, span.first.dataSize) != EOK ||
+        (span.second.dataSize > 0 && memcpy_s(span.second.dataPtr, span.second.dataSize,
+        buffer.dataPtr + span.first.dataSize, span.second.dataSize) != EOK)) {
+        AUDIO_ERR_LOG("Enqueue memcpy_s failed, buffer.dataSize[%{public}zu]", buffer.dataSize);
+        return {OPERATION_FAILED, result.size};
+    }
+    return CommitWrite(buffer.dataSize);
+}
+
+OptResult AudioSpscRingCache::Dequeue(const BufferWrap &buffer)
+{
+    if (buffer.dataPtr == nullptr || buffer.dataSize > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("Dequeue failed: BufferWrap is null or size %{public}zu is too large", buffer.dataSize);
+        return {INVALID_PARAMS, 0};
+    }
+    RingSpan span;
+    OptResult result = ReserveRead(buffer.dataSize, span);
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "Dequeue failed to get readable size.");
+    if (result.size < buffer.dataSize) {
+        AUDIO_WARNING_LOG("Dequeue find buffer not enough, readableSize:%{public}zu , Dequeue size:%{public}zu",
+            result.size, buffer.dataSize);
+        return {INVALID_OPERATION, result.size};
+    }
+    if ((span.first.dataSize > 0 && memcpy_s(buffer.dataPtr, span.first.dataSize, span.first.dataPtr,
+        span.first.dataSize) != EOK) || (span.second.dataSize > 0 && memcpy_s(buffer.dataPtr + span.first.dataSize,
+        span.second.dataSize, span.second.dataPtr, span.second.dataSize) != EOK)) {
+        AUDIO_ERR_LOG("Dequeue memcpy_s failed, buffer.dataSize[%{public}zu]", buffer.dataSize);
+        return {OPERATION_FAILED, result.size};
+    }
+    return CommitRead(buffer.dataSize);
+}
 } // namespace AudioStandard
 } // namespace OHOS
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioWakeupScheduler"
+#endif
+
+#include "audio_wakeup_scheduler.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "audio_service_log.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+static constexpr size_t QUANTILE_INDEX = AudioWakeupScheduler::WINDOW_SIZE * 99 / 100; // p99 of the window
+static constexpr int64_t HEADROOM_DIV = 4; // 25% above the quantile
+static constexpr int64_t SHRINK_DIV = 4; // close a quarter of the gap to the target after a quiet window
+static constexpr int64_t MISS_WIDEN_DIV = 2; // 50% wider on a missed deadline
+}
+
+bool AudioWakeupScheduler::Config(int64_t initMargin, int64_t minMargin, int64_t maxMargin)
+{
+    CHECK_AND_RETURN_RET_LOG(minMargin >= 0 && minMargin <= maxMargin, false,
+        "invalid margin range [%{public}" PRId64 ", %{public}" PRId64 "]", minMargin, maxMargin);
+    minMargin_ = minMargin;
+    maxMargin_ = maxMargin;
+    margin_ = Clamp(initMargin);
+    Reset();
+    return true;
+}
+
+bool AudioWakeupScheduler::Record(int64_t demand, bool missed)
+{
+    demand = std::max<int64_t>(demand, 0);
+    cycleCount_++;
+    if (missed) {
+        missCount_++;
+        windowMissCount_++;
+        int64_t margin = margin_.load();
+        margin_ = Clamp(std::max(margin + margin / MISS_WIDEN_DIV, demand + demand / HEADROOM_DIV));
+    }
+    window_[windowCount_++] = demand;
+    if (windowCount_ < WINDOW_SIZE) {
+        return false;
+    }
+    Adapt();
+    return true;
+}
+
+void AudioWakeupScheduler::Adapt()
+{
+    std::nth_element(window_.begin(), window_.begin() + QUANTILE_INDEX, window_.end());
+    int64_t quantile = window_[QUANTILE_INDEX];
+    int64_t target = Clamp(quantile + quantile / HEADROOM_DIV);
+    int64_t margin = margin_.load();
+    if (target > margin) {
+        margin = target;
+    } else if (windowMissCount_ == 0) {
+        margin -= (margin - target) / SHRINK_DIV;
+    }
+    AUDIO_DEBUG_LOG("p99 demand %{public}" PRId64 "ns, margin %{public}" PRId64 "ns, %{public}u missed",
+        quantile, margin, windowMissCount_);
+    margin_ = margin;
+    windowCount_ = 0;
+    windowMissCount_ = 0;
+}
+
+int64_t AudioWakeupScheduler::Clamp(int64_t margin) const
+{
+    return std::clamp(margin, minMargin_, maxMargin_);
+}
+
+int64_t AudioWakeupScheduler::GetMargin() const
+{
+    return margin_.load();
+}
+
+uint64_t AudioWakeupScheduler::GetCycleCount() const
+{
+    return cycleCount_.load();
+}
+
+uint64_t AudioWakeupScheduler::GetMissCount() const
+{
+    return missCount_.load();
+}
+
+float AudioWakeupScheduler::GetMissRate() const
+{
+    uint64_t cycleCount = cycleCount_.load();
+    return cycleCount == 0 ? 0.0f : static_cast<float>(missCount_.load()) / cycleCount;
+}
+
+void AudioWakeupScheduler::Reset()
+{
+    windowCount_ = 0;
+    windowMissCount_ = 0;
+    cycleCount_ = 0;
+    missCount_ = 0;
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -93,6 +93,35 @@ FutexCode FutexTool::FutexWait(std::atomic<uint32_t> *futexPtr, int64_t timeout)
     return FUTEX_OPERATION_FAILED;
 }
 
+FutexCode FutexTool::FutexWaitUntil(std::atomic<uint32_t> *futexPtr, int64_t deadline)
+{
+    CHECK_AND_RETURN_RET_LOG(futexPtr != nullptr && deadline > 0, FUTEX_INVALID_PARAMS, "invalid params");
+    struct timespec waitTime;
+    TimeoutToRelativeTime(deadline, waitTime); // FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC time
+    int32_t tryCount = 0;
+    while (tryCount < WAIT_TRY_COUNT) {
+        uint32_t current = futexPtr->load();
+        if (current == IS_READY) {
+            return FUTEX_SUCCESS;
+        }
+        if (current == IS_PRE_EXIT) {
+            return FUTEX_PRE_EXIT;
+        }
+        long res = syscall(__NR_futex, futexPtr, FUTEX_WAIT_BITSET, IS_NOT_READY, &waitTime, NULL,
+            FUTEX_BITSET_MATCH_ANY);
+        if (res != 0 && errno == ETIMEDOUT) {
+            return FUTEX_TIMEOUT;
+        }
+        if (res != 0 && errno != EAGAIN && errno != EINTR) {
+            AUDIO_WARNING_LOG("result:%{public}ld, errno[%{public}d]:%{public}s", res, errno, strerror(errno));
+            return FUTEX_OPERATION_FAILED;
+        }
+        tryCount++;
+    }
+    AUDIO_ERR_LOG("too much spurious wake-up");
+    return FUTEX_OPERATION_FAILED;
+}
+
 FutexCode FutexTool::FutexWake(std::atomic<uint32_t> *futexPtr, uint32_t wakeVal)
 {
     CHECK_AND_RETURN_RET_LOG(futexPtr != nullptr, FUTEX_INVALID_PARAMS, "futexPtr is null");
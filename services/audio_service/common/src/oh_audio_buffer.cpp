@@ -282,6 +282,7 @@ int32_t OHAudioBuffer::Init(int dataFd, int infoFd)
         basicBufferInfo_->spanSizeInFrame = spanSizeInFrame_;
         basicBufferInfo_->byteSizePerFrame = byteSizePerFrame_;
         basicBufferInfo_->streamStatus.store(STREAM_INVALID);
+        basicBufferInfo_->positionUpdateRequest.store(1); // the first write should always be notified.
 
         for (uint32_t i = 0; i < spanConut_; i++) {
             spanInfoList_[i].spanStatus.store(SPAN_INVALID);
@@ -682,6 +683,18 @@ std::atomic<uint32_t> *OHAudioBuffer::GetFutex()
     return &basicBufferInfo_->futexObj;
 }
 
+void OHAudioBuffer::RequestPositionUpdate()
+{
+    CHECK_AND_RETURN_LOG(basicBufferInfo_ != nullptr, "buffer is not inited!");
+    basicBufferInfo_->positionUpdateRequest.store(1);
+}
+
+bool OHAudioBuffer::TakePositionUpdateRequest()
+{
+    CHECK_AND_RETURN_RET_LOG(basicBufferInfo_ != nullptr, true, "buffer is not inited!");
+    return basicBufferInfo_->positionUpdateRequest.exchange(0) != 0;
+}
+
 uint8_t *OHAudioBuffer::GetDataBase()
 {
     return dataBase_;
@@ -16,11 +16,13 @@
 #define LOG_TAG "VolumeTools"
 #endif
 
+#include <algorithm>
 #include <cmath>
 
 #include "volume_tools.h"
 #include "volume_tools_c.h"
 #include "audio_errors.h"
+#include "audio_mix_kernel.h"
 #include "audio_service_log.h"
 
 namespace {
@@ -32,6 +34,12 @@ static const uint32_t SHIFT_SIXTEEN = 16;
 static const uint32_t ARRAY_INDEX_TWO = 2;
 static const size_t MIN_FRAME_SIZE = 1;
 static const size_t MAX_FRAME_SIZE = 100000; // max to about 2s for 48khz
+static const size_t SAMPLE_S24_BYTES = 3;
+static const size_t VOLUME_BLOCK_SAMPLES = 1024; // volumes are built and applied in blocks of 1024 samples
+static const size_t COUNT_LANES = 16; // multiple of 1, 2, 4, 8 and 16 channels
+static const size_t COUNT_LANES_WIDE = 48; // multiple of 3, 6, 12 and 16 channels
+static const float SMOOTH_RAMP_TWO = 2.0f;
+static const float SMOOTH_RAMP_THREE = 3.0f;
 }
 namespace OHOS {
 namespace AudioStandard {
@@ -144,47 +152,177 @@ inline int32_t VolumeFlatten(int32_t vol)
     return vol < INT32_VOLUME_MIN ? 0 : (vol > INT32_VOLUME_MAX ? INT32_VOLUME_MAX : vol);
 }
 
-void ProcessOneFrame(uint8_t *ptr, AudioSampleFormat format, int32_t vol)
+// Format kernels apply one Q16 volume per sample to a block of interleaved samples. S16 and F32 use the SIMD kernels
+// of AudioMixKernel, the loops of the others have no dependency between samples and are left to the vectorizer.
+template <AudioSampleFormat format>
+static void ApplyVolumeBlock(uint8_t *data, const int32_t *vols, size_t sampleCount);
+
+template <>
+void ApplyVolumeBlock<SAMPLE_U8>(uint8_t *data, const int32_t *vols, size_t sampleCount)
 {
-    int64_t temp = 0;
-    int16_t *raw16 = nullptr;
-    int32_t *raw32 = nullptr;
-    float *rawFloat = nullptr;
-    switch (format) {
-        case SAMPLE_U8:
-            temp = *ptr - UINT8_SHIFT;
-            temp = (temp * vol) >> VOLUME_SHIFT;
-            temp = temp < INT8_MIN ? INT8_MIN : (temp > INT8_MAX ? INT8_MAX : temp);
-            *ptr = static_cast<uint8_t>(temp + UINT8_SHIFT);
-            break;
-        case SAMPLE_S16LE:
-            raw16 = reinterpret_cast<int16_t *>(ptr);
-            temp = (*raw16 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT;
-            *raw16 = temp > INT16_MAX ? INT16_MAX : (temp < INT16_MIN ? INT16_MIN : temp);
-            break;
-        case SAMPLE_S24LE:
-            temp = static_cast<int32_t>(ReadInt24LE(ptr) << INT24_SHIFT) * static_cast<int64_t>(vol) >> VOLUME_SHIFT;
-            WriteInt24LE(ptr, (static_cast<uint32_t>(temp) >> INT24_SHIFT));
-            break;
-        case SAMPLE_S32LE:
-            raw32 = reinterpret_cast<int32_t *>(ptr);
-            // int32_t * int16_t, max result is int48_t
-            temp = (*raw32 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT;
-            *raw32 = temp > INT32_MAX ? INT32_MAX : (temp < INT32_MIN ? INT32_MIN : temp);
+    for (size_t i = 0; i < sampleCount; i++) {
+        int32_t temp = ((static_cast<int32_t>(data[i]) - UINT8_SHIFT) * vols[i]) >> VOLUME_SHIFT;
+        temp = temp < INT8_MIN ? INT8_MIN : (temp > INT8_MAX ? INT8_MAX : temp);
+        data[i] = static_cast<uint8_t>(temp + UINT8_SHIFT);
+    }
+}
+
+template <>
+void ApplyVolumeBlock<SAMPLE_S16LE>(uint8_t *data, const int32_t *vols, size_t sampleCount)
+{
+    AudioMixKernel::ApplyVolumesS16(reinterpret_cast<int16_t *>(data), vols, sampleCount);
+}
+
+template <>
+void ApplyVolumeBlock<SAMPLE_S24LE>(uint8_t *data, const int32_t *vols, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; i++) {
+        uint8_t *ptr = data + i * SAMPLE_S24_BYTES;
+        int64_t temp = static_cast<int32_t>(ReadInt24LE(ptr) << INT24_SHIFT) * static_cast<int64_t>(vols[i]) >>
+            VOLUME_SHIFT;
+        WriteInt24LE(ptr, (static_cast<uint32_t>(temp) >> INT24_SHIFT));
+    }
+}
+
+template <>
+void ApplyVolumeBlock<SAMPLE_S32LE>(uint8_t *data, const int32_t *vols, size_t sampleCount)
+{
+    int32_t *raw32 = reinterpret_cast<int32_t *>(data);
+    for (size_t i = 0; i < sampleCount; i++) {
+        // int32_t * int16_t, max result is int48_t
+        int64_t temp = (raw32[i] * static_cast<int64_t>(vols[i])) >> VOLUME_SHIFT;
+        raw32[i] = temp > INT32_MAX ? INT32_MAX : (temp < INT32_MIN ? INT32_MIN : temp);
+    }
+}
+
+template <>
+void ApplyVolumeBlock<SAMPLE_F32LE>(uint8_t *data, const int32_t *vols, size_t sampleCount)
+{
+    AudioMixKernel::ApplyVolumesF32(reinterpret_cast<float *>(data), vols, sampleCount);
+}
+
+namespace {
+struct VolumeRamp {
+    size_t channel = 0;
+    VolumeRampCurve curve = VOLUME_RAMP_LINEAR;
+    float frameScale = 0.0f; // 1 / (frameSize - 1), maps frame index to [0, 1]
+    float volStart[CHANNEL_MAX] = {};
+    float volDelta[CHANNEL_MAX] = {}; // volEnd - volStart
+    float volStep[CHANNEL_MAX] = {}; // volDelta * frameScale
+};
+}
+
+// Fill the volumes of frames [frameBegin, frameBegin + frameCount). channelCount is 0 if the channel count is only
+// known at runtime, otherwise the inner loop is unrolled for it.
+template <size_t channelCount>
+static void FillRampVolumes(const VolumeRamp &ramp, size_t frameBegin, size_t frameCount, int32_t *vols)
+{
+    size_t channel = channelCount == 0 ? ramp.channel : channelCount;
+    if (ramp.curve == VOLUME_RAMP_LINEAR) {
+        for (size_t frame = 0; frame < frameCount; frame++) {
+            float frameIndex = static_cast<float>(frameBegin + frame);
+            for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+                int32_t vol = ramp.volStep[channelIdx] * frameIndex + ramp.volStart[channelIdx];
+                vols[frame * channel + channelIdx] = VolumeFlatten(vol);
+            }
+        }
+        return;
+    }
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        float pos = static_cast<float>(frameBegin + frame) * ramp.frameScale;
+        float shape = pos * pos * (SMOOTH_RAMP_THREE - SMOOTH_RAMP_TWO * pos);
+        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+            int32_t vol = ramp.volDelta[channelIdx] * shape + ramp.volStart[channelIdx];
+            vols[frame * channel + channelIdx] = VolumeFlatten(vol);
+        }
+    }
+}
+
+static void FillRampVolumes(const VolumeRamp &ramp, size_t frameBegin, size_t frameCount, int32_t *vols)
+{
+    switch (ramp.channel) {
+        case MONO:
+            FillRampVolumes<MONO>(ramp, frameBegin, frameCount, vols);
             break;
-        case SAMPLE_F32LE:
-            rawFloat = reinterpret_cast<float *>(ptr);
-            *rawFloat = *rawFloat * (static_cast<float>(vol) / INT32_VOLUME_MAX);
+        case STEREO:
+            FillRampVolumes<STEREO>(ramp, frameBegin, frameCount, vols);
             break;
         default:
-            AUDIO_ERR_LOG("ProcessOneFrame with invalid format");
+            FillRampVolumes<0>(ramp, frameBegin, frameCount, vols);
             break;
     }
 }
 
+static bool IsConstantVolume(const ChannelVolumes &vols)
+{
+    for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
+        if (vols.volStart[channelIdx] != vols.volEnd[channelIdx]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool IsSameVolumeForAll(const ChannelVolumes &vols, int32_t vol)
+{
+    for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
+        if (vols.volStart[channelIdx] != vol || vols.volEnd[channelIdx] != vol) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Volumes are built for one block of frames and applied by the format kernel, a constant volume block is built only
+// once and used for all blocks.
+template <AudioSampleFormat format>
+static void ProcessFormat(uint8_t *data, size_t frameSize, const ChannelVolumes &vols, VolumeRampCurve curve)
+{
+    if (IsSameVolumeForAll(vols, INT32_VOLUME_MAX)) {
+        return; // unity volume keeps samples of all formats unchanged
+    }
+    size_t channel = vols.channel;
+    size_t byteSizePerFrame = GetByteSize(format) * channel;
+    if (format == SAMPLE_S16LE && IsSameVolumeForAll(vols, vols.volStart[0])) {
+        int16_t *raw16 = reinterpret_cast<int16_t *>(data);
+        AudioMixKernel::ApplyVolumeS16(raw16, vols.volStart[0], raw16, frameSize * channel);
+        return;
+    }
+
+    VolumeRamp ramp;
+    ramp.channel = channel;
+    ramp.curve = curve;
+    ramp.frameScale = 1.0f / (frameSize - MIN_FRAME_SIZE);
+    for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+        ramp.volStart[channelIdx] = vols.volStart[channelIdx];
+        ramp.volDelta[channelIdx] = static_cast<float>(vols.volEnd[channelIdx] - vols.volStart[channelIdx]);
+        ramp.volStep[channelIdx] = ramp.volDelta[channelIdx] / (frameSize - MIN_FRAME_SIZE);
+    }
+
+    int32_t blockVols[VOLUME_BLOCK_SAMPLES];
+    size_t blockFrames = VOLUME_BLOCK_SAMPLES / channel;
+    bool isConstant = IsConstantVolume(vols);
+    if (isConstant) {
+        FillRampVolumes(ramp, 0, blockFrames, blockVols);
+    }
+    for (size_t frameBegin = 0; frameBegin < frameSize; frameBegin += blockFrames) {
+        size_t frameCount = std::min(blockFrames, frameSize - frameBegin);
+        if (!isConstant) {
+            FillRampVolumes(ramp, frameBegin, frameCount, blockVols);
+        }
+        ApplyVolumeBlock<format>(data + frameBegin * byteSizePerFrame, blockVols, frameCount * channel);
+    }
+}
+
 // |---------frame1--------|---------frame2--------|---------frame3--------|
 // |ch1-ch2-ch3-ch4-ch5-ch6|ch1-ch2-ch3-ch4-ch5-ch6|ch1-ch2-ch3-ch4-ch5-ch6|
 int32_t VolumeTools::Process(const BufferDesc &buffer, AudioSampleFormat format, ChannelVolumes vols)
+{
+    return Process(buffer, format, vols, VOLUME_RAMP_LINEAR);
+}
+
+int32_t VolumeTools::Process(const BufferDesc &buffer, AudioSampleFormat format, ChannelVolumes vols,
+    VolumeRampCurve curve)
 {
     // parms check
     if (format > SAMPLE_F32LE || !IsVolumeValid(vols)) {
@@ -204,24 +342,26 @@ int32_t VolumeTools::Process(const BufferDesc &buffer, AudioSampleFormat format,
         return ERR_INVALID_PARAM;
     }
 
-    float volStep[CHANNEL_MAX] = {};
-    for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
-        if (vols.volEnd[channelIdx] == vols.volStart[channelIdx]) {
-            volStep[channelIdx] = 0.0;
-        } else {
-            volStep[channelIdx] = (static_cast<float>(vols.volEnd[channelIdx] - vols.volStart[channelIdx])) /
-                (frameSize - MIN_FRAME_SIZE);
-        }
-    }
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
-            int32_t vol = volStep[channelIdx] * frameIndex + vols.volStart[channelIdx];
-            vol = VolumeFlatten(vol);
-            uint8_t *samplePtr = buffer.buffer + frameIndex * byteSizePerFrame + channelIdx * byteSizePerData;
-            ProcessOneFrame(samplePtr, format, vol);
-        }
+    switch (format) {
+        case SAMPLE_U8:
+            ProcessFormat<SAMPLE_U8>(buffer.buffer, frameSize, vols, curve);
+            break;
+        case SAMPLE_S16LE:
+            ProcessFormat<SAMPLE_S16LE>(buffer.buffer, frameSize, vols, curve);
+            break;
+        case SAMPLE_S24LE:
+            ProcessFormat<SAMPLE_S24LE>(buffer.buffer, frameSize, vols, curve);
+            break;
+        case SAMPLE_S32LE:
+            ProcessFormat<SAMPLE_S32LE>(buffer.buffer, frameSize, vols, curve);
+            break;
+        case SAMPLE_F32LE:
+            ProcessFormat<SAMPLE_F32LE>(buffer.buffer, frameSize, vols, curve);
+            break;
+        default:
+            AUDIO_ERR_LOG("Process with invalid format");
+            return ERR_INVALID_PARAM;
     }
-
     return SUCCESS;
 }
 
@@ -250,144 +390,88 @@ double VolumeTools::GetVolDb(AudioSampleFormat format, int32_t vol)
     return std::log10(volume);
 }
 
-static void CountU8Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+// |sample| in the unit of the format, the same as the volume level counted before.
+template <AudioSampleFormat format, typename SumType>
+static inline SumType AbsSample(const uint8_t *data, size_t index);
+
+template <>
+inline int64_t AbsSample<SAMPLE_U8, int64_t>(const uint8_t *data, size_t index)
 {
-    size_t byteSizePerData = 1; // 1 for unsigned 8bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
-    }
+    int32_t sample = data[index];
+    return sample >= UINT8_SHIFT ? sample - UINT8_SHIFT : UINT8_SHIFT - sample;
+}
 
-    // reset maps
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] = 0;
-        volMaps.volEnd[index] = 0;
-    }
-    uint8_t *raw8 = buffer.buffer;
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volMaps.volStart[channelIdx] += (*raw8 >= UINT8_SHIFT ? *raw8 - UINT8_SHIFT : UINT8_SHIFT - *raw8);
-            raw8++;
-        }
-    }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] /= static_cast<int32_t>(frameSize);
-    }
-    return;
+template <>
+inline int64_t AbsSample<SAMPLE_S16LE, int64_t>(const uint8_t *data, size_t index)
+{
+    int32_t sample = reinterpret_cast<const int16_t *>(data)[index];
+    return sample >= 0 ? sample : -sample;
 }
 
-static void CountS16Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+template <>
+inline int64_t AbsSample<SAMPLE_S24LE, int64_t>(const uint8_t *data, size_t index)
 {
-    size_t byteSizePerData = 2; // 2 for signed 16bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
-    }
+    return static_cast<int32_t>(ReadInt24LE(data + index * SAMPLE_S24_BYTES));
+}
 
-    // reset maps
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] = 0;
-        volMaps.volEnd[index] = 0;
-    }
-    int16_t *raw16 = reinterpret_cast<int16_t *>(buffer.buffer);
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volMaps.volStart[channelIdx] += (*raw16 >= 0 ? *raw16: (-*raw16));
-            raw16++;
-        }
-    }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] /= static_cast<int32_t>(frameSize);
-    }
-    return;
+template <>
+inline int64_t AbsSample<SAMPLE_S32LE, int64_t>(const uint8_t *data, size_t index)
+{
+    int64_t sample = reinterpret_cast<const int32_t *>(data)[index];
+    return sample >= 0 ? sample : -sample;
 }
 
-static void CountS24Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+template <>
+inline double AbsSample<SAMPLE_F32LE, double>(const uint8_t *data, size_t index)
 {
-    size_t byteSizePerData = 3; // 3 for 24bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
-    }
+    float sample = reinterpret_cast<const float *>(data)[index];
+    return sample >= 0 ? sample : -sample;
+}
 
-    // reset maps
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] = 0;
-        volMaps.volEnd[index] = 0;
-    }
-    uint8_t *raw8 = buffer.buffer;
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            int32_t sample = static_cast<int32_t>(ReadInt24LE(raw8));
-            volMaps.volStart[channelIdx] += (sample >= 0 ? sample: (-sample));
-            raw8 += byteSizePerData;
+// Sum |sample| of the interleaved samples in lanes, lane i always holds channel (i % channel) as lanes is a multiple
+// of the channel count. The loop over a group of lanes has no dependency between samples and is vectorized.
+template <AudioSampleFormat format, typename SumType, size_t lanes>
+static void SumAbsInLanes(const uint8_t *data, size_t sampleCount, size_t channel, SumType *channelSums)
+{
+    SumType laneSums[lanes] = {};
+    size_t index = 0;
+    for (; index + lanes <= sampleCount; index += lanes) {
+        for (size_t lane = 0; lane < lanes; lane++) {
+            laneSums[lane] += AbsSample<format, SumType>(data, index + lane);
         }
     }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] /= static_cast<int32_t>(frameSize);
+    for (; index < sampleCount; index++) {
+        laneSums[index % lanes] += AbsSample<format, SumType>(data, index);
+    }
+    for (size_t lane = 0; lane < lanes; lane++) {
+        channelSums[lane % channel] += laneSums[lane];
     }
-    return;
 }
 
-static void CountS32Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+template <AudioSampleFormat format, typename SumType>
+static void SumAbs(const uint8_t *data, size_t frameSize, size_t channel, SumType *channelSums)
 {
-    size_t byteSizePerData = 4; // 4 for signed 32bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
+    size_t sampleCount = frameSize * channel;
+    if (COUNT_LANES % channel == 0) {
+        SumAbsInLanes<format, SumType, COUNT_LANES>(data, sampleCount, channel, channelSums);
         return;
     }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
+    if (COUNT_LANES_WIDE % channel == 0) {
+        SumAbsInLanes<format, SumType, COUNT_LANES_WIDE>(data, sampleCount, channel, channelSums);
         return;
     }
-
-    // reset maps
-    int64_t volSums[CHANNEL_MAX] = {0};
-    for (size_t index = 0; index < CHANNEL_MAX; index++) {
-        volSums[index] = 0;
-    }
-    int32_t *raw32 = reinterpret_cast<int32_t *>(buffer.buffer);
     for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
         for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volSums[channelIdx] += (*raw32 >= 0 ? *raw32: (-*raw32));
-            raw32++;
+            channelSums[channelIdx] += AbsSample<format, SumType>(data, frameIndex * channel + channelIdx);
         }
     }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volSums[index] /= static_cast<int32_t>(frameSize);
-        volMaps.volStart[index] = volSums[index];
-    }
-    return;
 }
 
-static void CountF32Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+// Average |sample| of each channel is kept in volStart.
+template <AudioSampleFormat format, typename SumType>
+static void CountFormatVolume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
 {
-    size_t byteSizePerData = 4; // 4 for 32bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
+    size_t byteSizePerFrame = GetByteSize(format) * channel;
     if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
         AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
         return;
@@ -398,24 +482,13 @@ static void CountF32Volume(const BufferDesc &buffer, AudioChannel channel, Chann
         return;
     }
 
-    // reset maps
-    double volSums[CHANNEL_MAX] = {0};
-    for (size_t index = 0; index < CHANNEL_MAX; index++) {
-        volSums[index] = 0.0;
-    }
-    float *raw32 = reinterpret_cast<float *>(buffer.buffer);
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volSums[channelIdx] += (*raw32 >= 0 ? *raw32: (-*raw32));
-            raw32++;
-        }
-    }
+    SumType volSums[CHANNEL_MAX] = {};
+    SumAbs<format, SumType>(buffer.buffer, frameSize, channel, volSums);
     // Calculate the average value
     for (size_t index = 0; index < channel; index++) {
-        volSums[index] /= frameSize;
-        volMaps.volStart[index] = static_cast<int32_t>(volSums[index]);
+        volMaps.volStart[index] = static_cast<int32_t>(volSums[index] / static_cast<SumType>(frameSize));
+        volMaps.volEnd[index] = 0;
     }
-    return;
 }
 
 ChannelVolumes VolumeTools::CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel)
@@ -428,19 +501,19 @@ ChannelVolumes VolumeTools::CountVolumeLevel(const BufferDesc &buffer, AudioSamp
     }
     switch (format) {
         case SAMPLE_U8:
-            CountU8Volume(buffer, channel, channelVols);
+            CountFormatVolume<SAMPLE_U8, int64_t>(buffer, channel, channelVols);
             break;
         case SAMPLE_S16LE:
-            CountS16Volume(buffer, channel, channelVols);
+            CountFormatVolume<SAMPLE_S16LE, int64_t>(buffer, channel, channelVols);
             break;
         case SAMPLE_S24LE:
-            CountS24Volume(buffer, channel, channelVols);
+            CountFormatVolume<SAMPLE_S24LE, int64_t>(buffer, channel, channelVols);
             break;
         case SAMPLE_S32LE:
-            CountS32Volume(buffer, channel, channelVols);
+            CountFormatVolume<SAMPLE_S32LE, int64_t>(buffer, channel, channelVols);
             break;
         case SAMPLE_F32LE:
-            CountF32Volume(buffer, channel, channelVols);
+            CountFormatVolume<SAMPLE_F32LE, double>(buffer, channel, channelVols);
             break;
         default:
             break;
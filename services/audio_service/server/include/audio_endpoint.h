@@ -83,6 +83,11 @@ public:
     virtual int32_t LinkProcessStream(IAudioProcessStream *processStream) = 0;
     virtual int32_t UnlinkProcessStream(IAudioProcessStream *processStream) = 0;
 
+    /**
+     * Called before GetPreferBufferInfo for a process about to be linked. The span of the endpoint may only change
+     * while no process is linked, as the spans of the process buffers are fixed when they are created.
+    */
+    virtual int32_t NegotiateSpan(const AudioProcessConfig &config) = 0;
     virtual int32_t GetPreferBufferInfo(uint32_t &totalSizeInframe, uint32_t &spanSizeInframe) = 0;
 
     virtual void Dump(std::string &dumpString) = 0;
@@ -113,6 +118,7 @@ public:
     int32_t OnUpdateHandleInfo(IAudioProcessStream *processStream) override;
     int32_t LinkProcessStream(IAudioProcessStream *processStream) override;
     int32_t UnlinkProcessStream(IAudioProcessStream *processStream) override;
+    int32_t NegotiateSpan(const AudioProcessConfig &config) override;
     int32_t GetPreferBufferInfo(uint32_t &totalSizeInframe, uint32_t &spanSizeInframe) override;
 
     void Dump(std::string &dumpString) override;
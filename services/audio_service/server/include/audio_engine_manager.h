@@ -14,27 +14,26 @@
  */
 #ifndef AUDIO_ENGINE_MANAGER_H
 #define AUDIO_ENGINE_MANAGER_H
-#include <unordered_map>
+#include <memory>
 #include "audio_playback_engine.h"
 
 namespace OHOS {
 namespace AudioStandard {
 enum class PlaybackType : int32_t {
     DIRECT,
+    DIRECT_MIX,
     VOIP
 };
 class AudioEngineManager {
 public:
-    static AudioEngineManager GetInstance();
+    static AudioEngineManager &GetInstance();
     ~AudioEngineManager() = default;
-    void AddRenderer(std::shared_ptr<IRendererStream> stream, DeviceInfo device);
-    void RemoveRenderer(std::shared_ptr<IRendererStream> stream);
+    // DIRECT_MIX for several direct streams sharing one ProMixEngine. A lone DIRECT stream and VOIP streams use
+    // NoneMixEngine, which hands the stream data to the sink bit-exact.
+    static std::unique_ptr<AudioPlaybackEngine> CreatePlaybackEngine(PlaybackType type);
 
 private:
     AudioEngineManager() = default;
-
-private:
-    std::unordered_map<PlaybackType, std::shared_ptr<AudioPlaybackEngine>> renderEngines_;
 };
 } // namespace AudioStandard
 } // namespace OHOS
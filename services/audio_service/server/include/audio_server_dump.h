@@ -87,6 +87,7 @@ private:
     void RecordSourceDump(std::string &dumpString);
     void HDFModulesDump(std::string &dumpString);
     void PolicyHandlerDump(std::string &dumpString);
+    void EffectProfileDump(std::string &dumpString);
     void ArgDataDump(std::string &dumpString, std::queue<std::u16string>& argQue);
     void ServerDataDump(std::string &dumpString);
     void InitDumpFuncMap();
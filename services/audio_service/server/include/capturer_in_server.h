@@ -50,6 +50,8 @@ public:
     int32_t UpdateReadIndex();
     BufferDesc DequeueBuffer(size_t length);
     void ReadData(size_t length);
+    void DischargeData(size_t length);
+    void WriteDumpData(uint8_t *data, size_t size);
     int32_t DrainAudioBuffer();
 
     // for inner-cap.
@@ -83,9 +85,8 @@ private:
     bool resetTime_ = false;
     uint64_t resetTimestamp_ = 0;
     uint32_t overFlowLogFlag_ = 0;
-    std::unique_ptr<AudioRingCache> ringCache_ = nullptr;
+    std::unique_ptr<AudioSpscRingCache> ringCache_ = nullptr;
     size_t cacheSizeInBytes_ = 0;
-    std::unique_ptr<uint8_t []> dischargeBuffer_ = nullptr;
     FILE *dumpS2C_ = nullptr; // server to client dump file
     std::string dumpFileName_ = "";
 };
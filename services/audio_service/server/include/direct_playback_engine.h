@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DIRECT_PLAYBACK_ENGINE_H
+#define DIRECT_PLAYBACK_ENGINE_H
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <string>
+#include "audio_playback_engine.h"
+
+namespace OHOS {
+namespace AudioStandard {
+/**
+ * Start/stop skeleton shared by the engines that write one sink from their own 20ms thread: the fade out wait on
+ * Stop/Pause, the guarded sink stop and the absolute-time pacing of the writes.
+*/
+class DirectPlaybackEngine : public AudioPlaybackEngine {
+public:
+    explicit DirectPlaybackEngine(const std::string &name);
+    ~DirectPlaybackEngine() override = default;
+
+    int32_t Stop() override;
+    int32_t Pause() override;
+    bool IsPlaybackEngineRunning() const noexcept override;
+
+protected:
+    void StandbySleep();
+    void PauseAsync();
+    int32_t SinkStopTimeOut();
+
+protected:
+    bool isVoip_;
+    bool isStart_;
+    std::atomic<uint32_t> failedCount_;
+    uint64_t writeCount_;
+    uint64_t fwkSyncTime_;
+
+    std::mutex fadingMutex_;
+    std::condition_variable cvFading_;
+    std::atomic<bool> startFadein_;
+    std::atomic<bool> startFadeout_;
+
+private:
+    void WaitFadeOut();
+
+    std::string name_;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif
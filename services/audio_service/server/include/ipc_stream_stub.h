@@ -16,6 +16,8 @@
 #ifndef IPC_STREAM_STUB_H
 #define IPC_STREAM_STUB_H
 
+#include <atomic>
+
 #include "ipc_stream.h"
 
 #include "message_parcel.h"
@@ -68,6 +70,13 @@ private:
     int32_t HandleRegisterThreadPriority(MessageParcel &data, MessageParcel &reply);
 
     int OnMiddleCodeRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option);
+
+    // Count the requests of this stream and report the rate once a second.
+    void CountRequest(uint32_t code);
+
+    std::atomic<uint32_t> requestCount_ = 0;
+    std::atomic<uint32_t> positionRequestCount_ = 0;
+    std::atomic<int64_t> countStartTime_ = 0;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -17,7 +17,9 @@
 
 #include <map>
 #include <mutex>
+#include <set>
 #include "i_stream_manager.h"
+#include "audio_engine_manager.h"
 #include "audio_playback_engine.h"
 
 namespace OHOS {
@@ -40,13 +42,17 @@ public:
 private:
     std::shared_ptr<IRendererStream> CreateRendererStream(AudioProcessConfig processConfig);
     int32_t CreatePlayBackEngine(const std::shared_ptr<IRendererStream> &stream);
+    void StopPlayBackEngineIfIdle(uint32_t streamIndex, bool isPause);
+    void SwitchPlaybackEngine(size_t streamCount);
 
 private:
     std::mutex streamMapMutex_;
     std::mutex paElementsMutex_;
     ManagerType managerType_;
+    PlaybackType playbackType_;
     std::unique_ptr<AudioPlaybackEngine> playbackEngine_;
     std::map<int32_t, std::shared_ptr<IRendererStream>> rendererStreamMap_;
+    std::set<uint32_t> runningStreams_; // the engine mixes all of them, stop it only when none is running
 };
 } // namespace AudioStandard
 } // namespace OHOS
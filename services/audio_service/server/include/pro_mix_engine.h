@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PRO_MIX_ENGINE_H
+#define PRO_MIX_ENGINE_H
+#include <mutex>
+#include "direct_playback_engine.h"
+#include "audio_resample.h"
+
+namespace OHOS {
+namespace AudioStandard {
+/**
+ * Mixes several pro renderer streams into one sink. The sink is opened with the format of the first stream, the
+ * other streams are resampled to its rate and all of them are mixed in float.
+*/
+class ProMixEngine : public DirectPlaybackEngine {
+public:
+    ProMixEngine();
+    ~ProMixEngine() override;
+
+    int32_t Init(const DeviceInfo &type, bool isVoip) override;
+    int32_t Start() override;
+    int32_t Flush() override;
+
+    int32_t AddRenderer(const std::shared_ptr<IRendererStream> &stream) override;
+    void RemoveRenderer(const std::shared_ptr<IRendererStream> &stream) override;
+
+protected:
+    void MixStreams() override;
+
+private:
+    struct MixStream {
+        std::shared_ptr<IRendererStream> stream = nullptr;
+        AudioStreamInfo streamInfo; // the format of the buffers the stream hands out
+        std::shared_ptr<AudioResample> resample = nullptr;
+        std::vector<char> peekBuffer;
+        std::vector<float> floatBuffer;
+        std::vector<float> resampleFifo; // resampled frames at the sink rate, carried over the periods
+        size_t fifoFrames = 0;
+    };
+
+    int32_t InitSink(const AudioStreamInfo &streamInfo);
+    int32_t InitMixStream(const std::shared_ptr<IRendererStream> &stream, MixStream &mixStream);
+    bool MixOneStream(MixStream &mixStream);
+    bool MixResampledStream(MixStream &mixStream);
+    bool ResampleOneSpan(MixStream &mixStream);
+    void DoFadeinOut(bool isFadeOut);
+
+    AudioStreamInfo GetOutputStreamInfo(const AudioStreamInfo &streamInfo) const noexcept;
+
+private:
+    bool isInit_;
+    DeviceInfo device_;
+    AudioStreamInfo sinkStreamInfo_;
+    size_t sinkSpanSizeInFrame_;
+    std::vector<MixStream> mixStreams_;
+    std::vector<float> mixBuffer_;
+    std::vector<char> renderBuffer_;
+    std::vector<int32_t> appsUid_;
+
+    std::mutex streamMutex_;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif
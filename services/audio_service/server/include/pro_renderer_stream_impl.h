@@ -80,8 +80,10 @@ private:
     AudioSamplingRate GetDirectSampleRate(AudioSamplingRate sampleRate) const noexcept;
     AudioSampleFormat GetDirectFormat(AudioSampleFormat format) const noexcept;
     uint32_t GetSamplePerFrame(AudioSampleFormat format) const noexcept;
-    void ConvertSrcToFloat(uint8_t *buffer, size_t bufLength, float volume);
-    void ConvertFloatToDes(int32_t writeIndex);
+    void ProcessFloatTiles(const BufferDesc &bufferDesc, float volume, int32_t writeIndex);
+    void ResampleTile(const float *tile, uint32_t tileFrames, uint8_t *slot, size_t slotSamples,
+        size_t &writtenSamples);
+    size_t WriteResampleCarry(uint8_t *slot, size_t slotSamples);
     float GetStreamVolume();
     void PopSinkBuffer(std::vector<char> *audioBuffer, int32_t &index);
     int32_t PopWriteBufferIndex();
@@ -105,12 +107,14 @@ private:
     size_t spanSizeInFrame_;
     size_t totalBytesWritten_;
     size_t minBufferSize_;
+    size_t resampleCarrySamples_;
     float powerVolumeFactor_;
     std::atomic<IStatus> status_;
     std::weak_ptr<IStatusCallback> statusCallback_;
     std::weak_ptr<IWriteCallback> writeCallback_;
-    std::vector<float> resampleSrcBuffer;
-    std::vector<float> resampleDesBuffer;
+    std::vector<float> resampleSrcBuffer; // one float tile of the stream channels
+    std::vector<float> resampleDesBuffer; // resampled output of one tile
+    std::vector<float> resampleCarryBuffer_; // resampled frames that did not fit in the last sink slot
     std::vector<std::vector<char>> sinkBuffer_;
     std::shared_ptr<AudioResample> resample_;
     std::queue<int32_t> readQueue_;
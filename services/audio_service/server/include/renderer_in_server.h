@@ -114,6 +114,8 @@ private:
     std::shared_ptr<IRendererStream> stream_ = nullptr;
     uint32_t streamIndex_ = -1;
     std::string traceTag_;
+    std::string writeDataTraceTag_; // prebuilt for WriteData, which runs for every span
+    std::string nearUnderrunTraceTag_;
     IStatus status_ = I_STATUS_IDLE;
     bool offloadEnable_ = false;
     std::atomic<bool> standByEnable_ = false;
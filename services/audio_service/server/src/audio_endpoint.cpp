@@ -18,9 +18,16 @@
 
 #include "audio_endpoint.h"
 
+#ifdef FEATURE_POWER_MANAGER
+#include "power_mgr_client.h"
+#endif
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cinttypes>
 #include <condition_variable>
+#include <sys/prctl.h>
 #include <thread>
 #include <vector>
 #include <mutex>
@@ -31,10 +38,12 @@
 #include "audio_service_log.h"
 #include "audio_schedule.h"
 #include "audio_utils.h"
+#include "audio_mix_kernel.h"
 #include "bluetooth_renderer_sink.h"
 #include "fast_audio_renderer_sink.h"
 #include "fast_audio_capturer_source.h"
 #include "format_converter.h"
+#include "futex_tool.h"
 #include "i_audio_capturer_source.h"
 #include "i_stream_manager.h"
 #include "linear_pos_time_model.h"
@@ -50,6 +59,7 @@ namespace OHOS {
 namespace AudioStandard {
 namespace {
     static constexpr int32_t VOLUME_SHIFT_NUMBER = 16; // 1 >> 16 = 65536, max volume
+    static constexpr int32_t VOLUME_UNITY = 1 << VOLUME_SHIFT_NUMBER;
     static constexpr int64_t RECORD_DELAY_TIME = 4000000; // 4ms
     static constexpr int64_t RECORD_VOIP_DELAY_TIME = 10000000; // 10ms
     static constexpr int64_t MAX_SPAN_DURATION_IN_NANO = 100000000; // 100ms
@@ -58,8 +68,21 @@ namespace {
     static constexpr int64_t DELAY_STOP_HDI_TIME_FOR_ZERO_VOLUME = 4000000000; // 4s
     static constexpr int32_t SLEEP_TIME_IN_DEFAULT = 400; // 400ms
     static constexpr int64_t DELTA_TO_REAL_READ_START_TIME = 0; // 0ms
+    static constexpr int64_t AUDIO_NS_PER_US = 1000;
     const uint16_t GET_MAX_AMPLITUDE_FRAMES_THRESHOLD = 40;
     static const int32_t HALF_FACTOR = 2;
+    static const std::string DUP_WRITE_TRACE_TAG = "DupStream::OnWriteData length ";
+    static const std::string READ_PROCESS_DATA_TRACE_TAG = "AudioEndpoint::ReadProcessData->";
+    static const std::string WRITE_DST_BUFFER_TRACE_TAG = "AudioEndpoint::WriteDstBuffer=>";
+    static const std::string PREPARE_NEXT_LOOP_TRACE_TAG = "AudioEndpoint::PrepareNextLoop ";
+    static const std::string WRITE_PROCESS_DATA_TRACE_TAG = "AudioEndpoint::WriteProcessData-<";
+    static const std::string READ_DST_BUFFER_TRACE_TAG = "AudioEndpoint::ReadDstBuffer=<";
+    static const std::string WAIT_ALL_PROCESS_READY_TRACE_TAG = "AudioEndpoint::WaitAllProcessReady ";
+    // spans an ultra low latency process may get, from the smallest
+    static constexpr std::array<int64_t, 3> SPAN_LEVEL_DURATION = {2500000, 5000000, 10000000}; // 2.5ms 5ms 10ms
+    static constexpr uint32_t MIN_SPAN_COUNT = 2;
+    static constexpr uint64_t SPAN_CHECK_MIN_CYCLE = 1000; // cycles run with a span before its misses are judged
+    static constexpr uint64_t SPAN_MISS_RATE_DIV = 100; // missing more than 1% of the deadlines leaves the span
 }
 
 static enum HdiAdapterFormat ConvertToHdiAdapterFormat(AudioSampleFormat format)
@@ -78,6 +101,9 @@ static enum HdiAdapterFormat ConvertToHdiAdapterFormat(AudioSampleFormat format)
         case AudioSampleFormat::SAMPLE_S32LE:
             adapterFormat = HdiAdapterFormat::SAMPLE_S32;
             break;
+        case AudioSampleFormat::SAMPLE_F32LE:
+            adapterFormat = HdiAdapterFormat::SAMPLE_F32;
+            break;
         default:
             adapterFormat = HdiAdapterFormat::INVALID_WIDTH;
             break;
@@ -86,6 +112,11 @@ static enum HdiAdapterFormat ConvertToHdiAdapterFormat(AudioSampleFormat format)
     return adapterFormat;
 }
 
+static inline bool IsS16Stereo(const AudioStreamInfo &streamInfo)
+{
+    return streamInfo.format == SAMPLE_S16LE && streamInfo.channels == STEREO;
+}
+
 class MockCallbacks : public IStatusCallback, public IWriteCallback {
 public:
     explicit MockCallbacks(uint32_t streamIndex);
@@ -125,6 +156,7 @@ public:
     int32_t LinkProcessStream(IAudioProcessStream *processStream) override;
     int32_t UnlinkProcessStream(IAudioProcessStream *processStream) override;
 
+    int32_t NegotiateSpan(const AudioProcessConfig &config) override;
     int32_t GetPreferBufferInfo(uint32_t &totalSizeInframe, uint32_t &spanSizeInframe) override;
 
     void Dump(std::string &dumpString) override;
@@ -173,11 +205,22 @@ private:
     bool ConfigInputPoint(const DeviceInfo &deviceInfo);
     int32_t PrepareDeviceBuffer(const DeviceInfo &deviceInfo);
     int32_t GetAdapterBufferInfo(const DeviceInfo &deviceInfo);
+    int32_t UpdateSpanDuration();
+    uint32_t GetSpanLevelSize(size_t level);
+    bool IsSpanSupported(uint32_t spanSizeInframe);
+    uint32_t SelectSpanSize(const AudioProcessConfig &config);
+    uint32_t GetProcessEndpointSpan(IAudioProcessStream *processStream);
+    void CheckSpanUnderrun();
+    int32_t TrySwitchSpan(uint32_t spanSizeInframe);
+    int32_t SwitchSpan(uint32_t spanSizeInframe);
     void ReSyncPosition();
     void RecordReSyncPosition();
     void InitAudiobuffer(bool resetReadWritePos);
     void ProcessData(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData);
     void ProcessSingleData(const AudioStreamData &srcData, const AudioStreamData &dstData);
+    void ProcessMixedFormatData(const AudioStreamData *srcData, size_t srcCount, const AudioStreamData &dstData);
+    bool AccumulateToMixBuffer(const AudioStreamData &srcData, int32_t volume);
+    void MixToDupStreamInFloat(const std::vector<AudioStreamData> &srcDataList);
     void HandleZeroVolumeCheckEvent();
     void HandleRendererDataParams(const AudioStreamData &srcData, const AudioStreamData &dstData);
     int32_t HandleCapturerDataParams(const BufferDesc &writeBuf, const BufferDesc &readBuf,
@@ -201,6 +244,11 @@ private:
     void CheckStandBy();
     bool IsAnyProcessRunning();
     bool CheckAllBufferReady(int64_t checkTime, uint64_t curWritePos);
+    std::shared_ptr<OHAudioBuffer> GetUnreadyProcessBuffer();
+    bool WaitAllProcessReady(int64_t deadline);
+    void RecordWakeUpLateness(int64_t lateness);
+    uint64_t GetWakeUpCount();
+    void DumpWakeUpStats(std::string &dumpString);
     bool ProcessToEndpointDataHandle(uint64_t curWritePos);
     void GetAllReadyProcessData(std::vector<AudioStreamData> &audioDataList);
 
@@ -237,6 +285,9 @@ private:
     static constexpr int64_t THREE_MILLISECOND_DURATION = 3000000; // 3ms
     static constexpr int64_t WRITE_TO_HDI_AHEAD_TIME = -1000000; // ahead 1ms
     static constexpr int32_t UPDATE_THREAD_TIMEOUT = 1000; // 1000ms
+    static constexpr unsigned long WORK_LOOP_TIMER_SLACK_NS = 1; // the default 50us slack delays absolute wake ups
+    // Bucket i counts the wake ups late by [2^(i-1), 2^i) us, bucket 0 the ones late by less than 1 us.
+    static constexpr size_t LATENESS_BUCKET_NUM = 16;
     enum ThreadStatus : uint32_t {
         WAITTING = 0,
         SLEEPING,
@@ -293,6 +344,14 @@ private:
     uint32_t dstSpanSizeInframe_ = 0;
     uint32_t dstByteSizePerFrame_ = 0;
     std::shared_ptr<OHAudioBuffer> dstAudioBuffer_ = nullptr;
+    std::vector<float> mixBuffer_; // one span in float, for streams not in S16LE stereo
+
+    // The span is negotiated for the first linked process, see NegotiateSpan.
+    uint32_t hdiSpanSizeInframe_ = 0;
+    int64_t minSpanDuration_ = 0; // nano second, the smallest span the hdi supports
+    size_t minSpanLevel_ = 0; // raised when a span misses too many deadlines
+    uint64_t spanCycleBase_ = 0; // wake up count when the last span was judged
+    uint64_t spanMissBase_ = 0; // deadline miss count when the last span was judged
 
     std::atomic<EndpointStatus> endpointStatus_ = INVALID;
     bool isStarted_ = false;
@@ -305,6 +364,12 @@ private:
     std::condition_variable workThreadCV_;
     int64_t lastHandleProcessTime_ = 0;
 
+    // Updated by the work loop, read by the dump.
+    std::array<std::atomic<uint64_t>, LATENESS_BUCKET_NUM> latenessBuckets_ = {};
+    std::atomic<int64_t> maxLateness_ = 0;
+    std::atomic<uint64_t> earlyWakeUpCount_ = 0; // waits ended by the last process buffer getting ready
+    std::atomic<uint64_t> deadlineMissCount_ = 0; // waits ended by the deadline with a process buffer not ready
+
     std::thread updatePosTimeThread_;
     std::mutex updateThreadLock_;
     std::condition_variable updateThreadCV_;
@@ -320,6 +385,7 @@ private:
     std::string dumpDcpName_ = "";
     std::string dumpHdiName_ = "";
     mutable int64_t volumeDataCount_ = 0;
+    mutable uint32_t volumeSampleIndex_ = 0;
     std::string logUtilsTag_ = "";
 
     bool isSupportAbsVolume_ = false;
@@ -408,7 +474,7 @@ void MockCallbacks::OnStatusUpdate(IOperation operation)
 
 int32_t MockCallbacks::OnWriteData(size_t length)
 {
-    Trace trace("DupStream::OnWriteData length " + std::to_string(length));
+    Trace trace(DUP_WRITE_TRACE_TAG, length);
     return SUCCESS;
 }
 
@@ -602,11 +668,41 @@ void AudioEndpointInner::Dump(std::string &dumpString)
 
     // dump linked process info
     std::lock_guard<std::mutex> lock(listLock_);
+    AppendFormat(dumpString, "  - span: %u frames, hdi span: %u frames, min span level: %zu\n", dstSpanSizeInframe_,
+        hdiSpanSizeInframe_, minSpanLevel_);
     AppendFormat(dumpString, "  - linked process:: %zu\n", processBufferList_.size());
     for (auto item : processBufferList_) {
         AppendFormat(dumpString, "  - process read position: %u\n", item->GetCurReadFrame());
         AppendFormat(dumpString, "  - process write position: %u\n", item->GetCurWriteFrame());
     }
+    DumpWakeUpStats(dumpString);
+    dumpString += "\n";
+}
+
+uint64_t AudioEndpointInner::GetWakeUpCount()
+{
+    uint64_t wakeUpCount = 0;
+    for (const std::atomic<uint64_t> &bucket : latenessBuckets_) {
+        wakeUpCount += bucket.load();
+    }
+    return wakeUpCount;
+}
+
+void AudioEndpointInner::DumpWakeUpStats(std::string &dumpString)
+{
+    uint64_t wakeUpCount = GetWakeUpCount();
+    AppendFormat(dumpString, "  - wake up count: %llu, max lateness: %lld us\n",
+        static_cast<unsigned long long>(wakeUpCount),
+        static_cast<long long>(maxLateness_.load() / AUDIO_NS_PER_US));
+    AppendFormat(dumpString, "  - early wake up: %llu, deadline miss: %llu\n",
+        static_cast<unsigned long long>(earlyWakeUpCount_.load()),
+        static_cast<unsigned long long>(deadlineMissCount_.load()));
+    dumpString += "  - wake up lateness histogram(us):";
+    for (size_t i = 0; i < LATENESS_BUCKET_NUM; i++) {
+        bool isLast = i == LATENESS_BUCKET_NUM - 1;
+        AppendFormat(dumpString, " %s%llu:%llu", isLast ? ">=" : "<", 1ULL << (isLast ? i - 1 : i),
+            static_cast<unsigned long long>(latenessBuckets_[i].load()));
+    }
     dumpString += "\n";
 }
 
@@ -821,16 +917,14 @@ int32_t AudioEndpointInner::PrepareDeviceBuffer(const DeviceInfo &deviceInfo)
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERR_OPERATION_FAILED,
         "get adapter buffer Info fail, ret %{public}d.", ret);
 
-    // spanDuration_ may be less than the correct time of dstSpanSizeInframe_.
-    spanDuration_ = static_cast<int64_t>(dstSpanSizeInframe_) * AUDIO_NS_PER_SECOND /
-        static_cast<int64_t>(dstStreamInfo_.samplingRate);
-    int64_t temp = spanDuration_ / 5 * 3; // 3/5 spanDuration
-    serverAheadReadTime_ = temp < ONE_MILLISECOND_DURATION ? ONE_MILLISECOND_DURATION : temp; // at least 1ms ahead.
-    AUDIO_DEBUG_LOG("panDuration %{public}" PRIu64" ns, serverAheadReadTime %{public}" PRIu64" ns.",
-        spanDuration_, serverAheadReadTime_);
+    ret = UpdateSpanDuration();
+    CHECK_AND_RETURN_RET(ret == SUCCESS, ret);
+    hdiSpanSizeInframe_ = dstSpanSizeInframe_;
+    int32_t minSpanInUs = 0;
+    GetSysPara("persist.multimedia.audioflag.fast.minspan", minSpanInUs); // smaller spans the hdi handles, in us
+    minSpanDuration_ = minSpanInUs > 0 ? std::min(static_cast<int64_t>(minSpanInUs) * AUDIO_NS_PER_US,
+        spanDuration_) : spanDuration_;
 
-    CHECK_AND_RETURN_RET_LOG(spanDuration_ > 0 && spanDuration_ < MAX_SPAN_DURATION_IN_NANO,
-        ERR_INVALID_PARAM, "mmap span info error, spanDuration %{public}" PRIu64".", spanDuration_);
     dstAudioBuffer_ = OHAudioBuffer::CreateFromRemote(dstTotalSizeInframe_, dstSpanSizeInframe_, dstByteSizePerFrame_,
         AUDIO_SERVER_ONLY, dstBufferFd_, OHAudioBuffer::INVALID_BUFFER_FD);
     CHECK_AND_RETURN_RET_LOG(dstAudioBuffer_ != nullptr && dstAudioBuffer_->GetBufferHolder() ==
@@ -848,6 +942,24 @@ int32_t AudioEndpointInner::PrepareDeviceBuffer(const DeviceInfo &deviceInfo)
     return SUCCESS;
 }
 
+int32_t AudioEndpointInner::UpdateSpanDuration()
+{
+    // spanDuration_ may be less than the correct time of dstSpanSizeInframe_.
+    spanDuration_ = static_cast<int64_t>(dstSpanSizeInframe_) * AUDIO_NS_PER_SECOND /
+        static_cast<int64_t>(dstStreamInfo_.samplingRate);
+    int64_t temp = spanDuration_ / 5 * 3; // 3/5 spanDuration
+    serverAheadReadTime_ = temp < ONE_MILLISECOND_DURATION ? ONE_MILLISECOND_DURATION : temp; // at least 1ms ahead.
+    AUDIO_DEBUG_LOG("panDuration %{public}" PRIu64" ns, serverAheadReadTime %{public}" PRIu64" ns.",
+        spanDuration_, serverAheadReadTime_);
+
+    CHECK_AND_RETURN_RET_LOG(spanDuration_ > 0 && spanDuration_ < MAX_SPAN_DURATION_IN_NANO,
+        ERR_INVALID_PARAM, "mmap span info error, spanDuration %{public}" PRIu64".", spanDuration_);
+    if (deviceInfo_.deviceRole == OUTPUT_DEVICE) {
+        mixBuffer_.assign(static_cast<size_t>(dstSpanSizeInframe_) * dstStreamInfo_.channels, 0.0f);
+    }
+    return SUCCESS;
+}
+
 void AudioEndpointInner::InitAudiobuffer(bool resetReadWritePos)
 {
     CHECK_AND_RETURN_LOG((dstAudioBuffer_ != nullptr), "dst audio buffer is null.");
@@ -886,6 +998,164 @@ int32_t AudioEndpointInner::GetPreferBufferInfo(uint32_t &totalSizeInframe, uint
     return SUCCESS;
 }
 
+// The first process linked decides the span: the smallest span level the hdi supports for an ultra low latency
+// process, the span of the hdi for the others. The processes linked later share it, as their buffers are mapped by
+// the clients with the span they were created with, the span is never switched under a linked process.
+int32_t AudioEndpointInner::NegotiateSpan(const AudioProcessConfig &config)
+{
+    {
+        std::lock_guard<std::mutex> lock(listLock_);
+        if (!processList_.empty()) {
+            return SUCCESS;
+        }
+    }
+    int32_t ret = TrySwitchSpan(SelectSpanSize(config));
+    if (ret == ERR_ILLEGAL_STATE) {
+        AUDIO_INFO_LOG("endpoint busy, keep span %{public}u", dstSpanSizeInframe_);
+        return SUCCESS;
+    }
+    return ret;
+}
+
+uint32_t AudioEndpointInner::GetSpanLevelSize(size_t level)
+{
+    return static_cast<uint32_t>(SPAN_LEVEL_DURATION[level] * dstStreamInfo_.samplingRate / AUDIO_NS_PER_SECOND);
+}
+
+bool AudioEndpointInner::IsSpanSupported(uint32_t spanSizeInframe)
+{
+    if (spanSizeInframe == hdiSpanSizeInframe_) {
+        return true;
+    }
+    int64_t duration = static_cast<int64_t>(spanSizeInframe) * AUDIO_NS_PER_SECOND / dstStreamInfo_.samplingRate;
+    return spanSizeInframe != 0 && dstTotalSizeInframe_ % spanSizeInframe == 0 &&
+        dstTotalSizeInframe_ / spanSizeInframe >= MIN_SPAN_COUNT && duration >= minSpanDuration_ &&
+        duration < MAX_SPAN_DURATION_IN_NANO;
+}
+
+uint32_t AudioEndpointInner::SelectSpanSize(const AudioProcessConfig &config)
+{
+    int32_t originalFlag = config.audioMode == AUDIO_MODE_PLAYBACK ? config.rendererInfo.originalFlag :
+        config.capturerInfo.originalFlag;
+    if (endpointType_ != TYPE_MMAP || originalFlag != AUDIO_FLAG_MMAP) {
+        return hdiSpanSizeInframe_;
+    }
+#ifdef FEATURE_POWER_MANAGER
+    // no need to pay for more wake ups with the screen off
+    if (!PowerMgr::PowerMgrClient::GetInstance().IsScreenOn()) {
+        return hdiSpanSizeInframe_;
+    }
+#endif
+    size_t minSpanLevel = 0;
+    {
+        std::lock_guard<std::mutex> lock(listLock_);
+        minSpanLevel = minSpanLevel_;
+    }
+    for (size_t level = minSpanLevel; level < SPAN_LEVEL_DURATION.size(); level++) {
+        uint32_t spanSizeInframe = GetSpanLevelSize(level);
+        if (IsSpanSupported(spanSizeInframe)) {
+            return spanSizeInframe;
+        }
+    }
+    return hdiSpanSizeInframe_;
+}
+
+// The span the span of the process buffer was derived from, see AudioProcessInServer::ConfigProcessBuffer.
+uint32_t AudioEndpointInner::GetProcessEndpointSpan(IAudioProcessStream *processStream)
+{
+    uint32_t totalSizeInframe = 0;
+    uint32_t spanSizeInframe = 0;
+    uint32_t byteSizePerFrame = 0;
+    processStream->GetStreamBuffer()->GetSizeParameter(totalSizeInframe, spanSizeInframe, byteSizePerFrame);
+    uint64_t processRate = processStream->GetStreamInfo().samplingRate;
+    auto isSource = [this, processRate, spanSizeInframe](uint32_t endpointSpan) {
+        uint64_t spanTime = static_cast<uint64_t>(endpointSpan) * AUDIO_US_PER_SECOND / dstStreamInfo_.samplingRate;
+        return spanTime * processRate / AUDIO_US_PER_SECOND == spanSizeInframe;
+    };
+    if (isSource(dstSpanSizeInframe_)) {
+        return dstSpanSizeInframe_;
+    }
+    if (isSource(hdiSpanSizeInframe_)) {
+        return hdiSpanSizeInframe_;
+    }
+    for (size_t level = 0; level < SPAN_LEVEL_DURATION.size(); level++) {
+        if (isSource(GetSpanLevelSize(level))) {
+            return GetSpanLevelSize(level);
+        }
+    }
+    return dstSpanSizeInframe_;
+}
+
+// Judge the span when the last process unlinks, once enough cycles ran with it. If it missed too many deadlines,
+// the next ultra low latency process gets a larger one, else the smallest level is tried again.
+void AudioEndpointInner::CheckSpanUnderrun()
+{
+    uint64_t cycles = GetWakeUpCount() - spanCycleBase_;
+    uint64_t misses = deadlineMissCount_.load() - spanMissBase_;
+    if (cycles < SPAN_CHECK_MIN_CYCLE) {
+        return;
+    }
+    spanCycleBase_ += cycles;
+    spanMissBase_ += misses;
+    minSpanLevel_ = 0;
+    if (misses * SPAN_MISS_RATE_DIV <= cycles) {
+        return;
+    }
+    while (minSpanLevel_ < SPAN_LEVEL_DURATION.size() && GetSpanLevelSize(minSpanLevel_) <= dstSpanSizeInframe_) {
+        minSpanLevel_++;
+    }
+    AUDIO_WARNING_LOG("%{public}" PRIu64 " deadlines missed in %{public}" PRIu64 " cycles with span %{public}u, "
+        "min span level %{public}zu", misses, cycles, dstSpanSizeInframe_, minSpanLevel_);
+}
+
+// Only switch while the device is stopped and the work loop waits for a link, nothing is using the hdi buffer then.
+// Return ERR_ILLEGAL_STATE if the endpoint is busy and keeps its span.
+int32_t AudioEndpointInner::TrySwitchSpan(uint32_t spanSizeInframe)
+{
+    std::unique_lock<std::mutex> lock(loopThreadLock_);
+    if (spanSizeInframe == dstSpanSizeInframe_) {
+        return SUCCESS;
+    }
+    CHECK_AND_RETURN_RET_LOG(IsSpanSupported(spanSizeInframe), ERR_NOT_SUPPORTED, "span %{public}u not supported",
+        spanSizeInframe);
+    {
+        std::lock_guard<std::mutex> listLock(listLock_);
+        CHECK_AND_RETURN_RET_LOG(processList_.empty(), ERR_ILLEGAL_STATE,
+            "%{public}zu process linked, keep span %{public}u", processList_.size(), dstSpanSizeInframe_);
+    }
+    CHECK_AND_RETURN_RET_LOG(endpointStatus_ == UNLINKED && threadStatus_ == WAITTING && !isInnerCapEnabled_,
+        ERR_ILLEGAL_STATE, "endpoint busy in %{public}s, keep span %{public}u", GetStatusStr(endpointStatus_).c_str(),
+        dstSpanSizeInframe_);
+    return SwitchSpan(spanSizeInframe);
+}
+
+// Map the hdi buffer again with the new span, the positions are synced again when the device starts.
+int32_t AudioEndpointInner::SwitchSpan(uint32_t spanSizeInframe)
+{
+    Trace trace("AudioEndpoint::SwitchSpan");
+    std::shared_ptr<OHAudioBuffer> buffer = OHAudioBuffer::CreateFromRemote(dstTotalSizeInframe_, spanSizeInframe,
+        dstByteSizePerFrame_, AUDIO_SERVER_ONLY, dstBufferFd_, OHAudioBuffer::INVALID_BUFFER_FD);
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, ERR_OPERATION_FAILED, "create buffer with span %{public}u fail.",
+        spanSizeInframe);
+    buffer->GetStreamStatus()->store(dstAudioBuffer_->GetStreamStatus()->load());
+
+    AUDIO_INFO_LOG("span %{public}u -> %{public}u frames, hdi span %{public}u", dstSpanSizeInframe_, spanSizeInframe,
+        hdiSpanSizeInframe_);
+    uint32_t oldSpanSizeInframe = dstSpanSizeInframe_;
+    dstSpanSizeInframe_ = spanSizeInframe;
+    int32_t ret = UpdateSpanDuration();
+    if (ret != SUCCESS) {
+        AUDIO_ERR_LOG("update span duration fail, keep span %{public}u", oldSpanSizeInframe);
+        dstSpanSizeInframe_ = oldSpanSizeInframe;
+        UpdateSpanDuration();
+        return ret;
+    }
+    dstAudioBuffer_ = buffer;
+    InitAudiobuffer(true);
+    needReSyncPosition_ = true;
+    return SUCCESS;
+}
+
 bool AudioEndpointInner::IsAnyProcessRunning()
 {
     std::lock_guard<std::mutex> lock(listLock_);
@@ -1164,6 +1434,18 @@ int32_t AudioEndpointInner::LinkProcessStream(IAudioProcessStream *processStream
 
     CHECK_AND_RETURN_RET_LOG(processList_.size() < MAX_LINKED_PROCESS, ERR_OPERATION_FAILED, "reach link limit.");
 
+    // a process relinked after a reset of the endpoint brings the span it was created with
+    uint32_t spanSizeInframe = GetProcessEndpointSpan(processStream);
+    CHECK_AND_RETURN_RET_LOG(spanSizeInframe == dstSpanSizeInframe_ || TrySwitchSpan(spanSizeInframe) == SUCCESS,
+        ERR_OPERATION_FAILED, "process span %{public}u does not match endpoint span %{public}u", spanSizeInframe,
+        dstSpanSizeInframe_);
+    // reported once here, the work loop skips the spans of such a stream without a log
+    AudioStreamInfo streamInfo = processStream->GetStreamInfo();
+    if (streamInfo.samplingRate != dstStreamInfo_.samplingRate) {
+        AUDIO_WARNING_LOG("process rate %{public}d differs from endpoint rate %{public}d, it is not mixed",
+            streamInfo.samplingRate, dstStreamInfo_.samplingRate);
+    }
+
     AUDIO_INFO_LOG("LinkProcessStream start status is:%{public}s.", GetStatusStr(endpointStatus_).c_str());
 
     bool needEndpointRunning = processBuffer->GetStreamStatus()->load() == STREAM_RUNNING;
@@ -1244,6 +1526,7 @@ int32_t AudioEndpointInner::UnlinkProcessStream(IAudioProcessStream *processStre
     if (processList_.size() == 0) {
         StopDevice();
         endpointStatus_ = UNLINKED;
+        CheckSpanUnderrun();
     }
 
     AUDIO_DEBUG_LOG("UnlinkProcessStream end, %{public}s the process.", (isFind ? "find and remove" : "not find"));
@@ -1314,37 +1597,96 @@ bool AudioEndpointInner::CheckAllBufferReady(int64_t checkTime, uint64_t curWrit
     }
 
     if (!isAllReady) {
-        Trace trace("AudioEndpoint::WaitAllProcessReady");
-        int64_t tempWakeupTime = readTimeModel_.GetTimeOfPos(curWritePos) + WRITE_TO_HDI_AHEAD_TIME;
-        if (tempWakeupTime - ClockTime::GetCurNano() < ONE_MILLISECOND_DURATION) {
-            ClockTime::RelativeSleep(ONE_MILLISECOND_DURATION);
-        } else {
-            ClockTime::AbsoluteSleep(tempWakeupTime); // sleep to hdi read time ahead 1ms.
-        }
+        // wait until the hdi read time ahead 1ms, or less if all the processes get ready before.
+        isAllReady = WaitAllProcessReady(readTimeModel_.GetTimeOfPos(curWritePos) + WRITE_TO_HDI_AHEAD_TIME);
     }
     return isAllReady;
 }
 
+std::shared_ptr<OHAudioBuffer> AudioEndpointInner::GetUnreadyProcessBuffer()
+{
+    std::lock_guard<std::mutex> lock(listLock_);
+    for (const std::shared_ptr<OHAudioBuffer> &buffer : processBufferList_) {
+        if (buffer->GetStreamStatus() == nullptr || buffer->GetStreamStatus()->load() != StreamStatus::STREAM_RUNNING) {
+            continue;
+        }
+        SpanInfo *curReadSpan = buffer->GetSpanInfo(buffer->GetCurReadFrame());
+        if (curReadSpan == nullptr || curReadSpan->spanStatus != SpanStatus::SPAN_WRITE_DONE) {
+            return buffer;
+        }
+    }
+    return nullptr;
+}
+
+// The clients wake the futex of their buffer when a span is written, the loop sleeps on the futex of one buffer not
+// ready at a time, with the deadline as absolute timeout.
+bool AudioEndpointInner::WaitAllProcessReady(int64_t deadline)
+{
+    Trace trace(WAIT_ALL_PROCESS_READY_TRACE_TAG, deadline); // the absolute deadline in ns
+    while (ClockTime::GetCurNano() < deadline) {
+        std::shared_ptr<OHAudioBuffer> buffer = GetUnreadyProcessBuffer();
+        if (buffer == nullptr) {
+            earlyWakeUpCount_++;
+            return true;
+        }
+        std::atomic<uint32_t> *futex = buffer->GetFutex();
+        uint32_t expect = IS_READY;
+        futex->compare_exchange_strong(expect, IS_NOT_READY);
+        if (GetUnreadyProcessBuffer() != buffer) {
+            continue; // written between the check and the arm
+        }
+        FutexCode ret = FutexTool::FutexWaitUntil(futex, deadline);
+        if (ret == FUTEX_TIMEOUT) {
+            break;
+        }
+        if (ret != FUTEX_SUCCESS) {
+            ClockTime::AbsoluteSleep(deadline);
+            break;
+        }
+    }
+    if (GetUnreadyProcessBuffer() == nullptr) {
+        return true;
+    }
+    deadlineMissCount_++;
+    return false;
+}
+
+void AudioEndpointInner::RecordWakeUpLateness(int64_t lateness)
+{
+    lateness = std::max<int64_t>(lateness, 0);
+    uint64_t latenessUs = static_cast<uint64_t>(lateness / AUDIO_NS_PER_US);
+    size_t bucket = 0;
+    while (latenessUs != 0 && bucket < LATENESS_BUCKET_NUM - 1) {
+        latenessUs >>= 1;
+        bucket++;
+    }
+    latenessBuckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    if (lateness > maxLateness_.load(std::memory_order_relaxed)) {
+        maxLateness_.store(lateness, std::memory_order_relaxed);
+    }
+}
+
 void AudioEndpointInner::MixToDupStream(const std::vector<AudioStreamData> &srcDataList)
 {
     Trace trace("AudioEndpointInner::MixToDupStream");
     std::lock_guard<std::mutex> lock(dupMutex_);
     CHECK_AND_RETURN_LOG(dupBuffer_ != nullptr, "Buffer is not ready");
 
-    for (size_t i = 0; i < srcDataList.size(); i++) {
-        if (!srcDataList[i].isInnerCaped) {
-            continue;
-        }
-        size_t dataLength = dupBufferSize_;
-        dataLength /= 2; // SAMPLE_S16LE--> 2 byte
-        int16_t *dstPtr = reinterpret_cast<int16_t *>(dupBuffer_.get());
-
-        for (size_t offset = 0; dataLength > 0; dataLength--) {
-            int32_t sum = *dstPtr;
-            sum += *(reinterpret_cast<int16_t *>(srcDataList[i].bufferDesc.buffer) + offset);
-            *dstPtr = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
-            dstPtr++;
-            offset++;
+    bool isAllS16Stereo = IsS16Stereo(dstStreamInfo_);
+    for (size_t i = 0; i < srcDataList.size() && isAllS16Stereo; i++) {
+        isAllS16Stereo = !srcDataList[i].isInnerCaped || IsS16Stereo(srcDataList[i].streamInfo);
+    }
+    if (!isAllS16Stereo) {
+        MixToDupStreamInFloat(srcDataList);
+    } else {
+        for (size_t i = 0; i < srcDataList.size(); i++) {
+            if (!srcDataList[i].isInnerCaped) {
+                continue;
+            }
+            size_t dataLength = dupBufferSize_;
+            dataLength /= 2; // SAMPLE_S16LE--> 2 byte
+            AudioMixKernel::AccumulateS16(reinterpret_cast<int16_t *>(srcDataList[i].bufferDesc.buffer),
+                reinterpret_cast<int16_t *>(dupBuffer_.get()), dataLength);
         }
     }
     BufferDesc temp;
@@ -1361,13 +1703,70 @@ void AudioEndpointInner::MixToDupStream(const std::vector<AudioStreamData> &srcD
     }
 }
 
+// call with dupMutex_ hold, mixBuffer_ is only used on the endpoint work thread.
+void AudioEndpointInner::MixToDupStreamInFloat(const std::vector<AudioStreamData> &srcDataList)
+{
+    size_t sampleCount = static_cast<size_t>(dstSpanSizeInframe_) * dstStreamInfo_.channels;
+    CHECK_AND_RETURN_LOG(mixBuffer_.size() >= sampleCount && dupBufferSize_ >= sampleCount *
+        AudioMixKernel::GetFormatByteSize(dstStreamInfo_.format), "mix buffer is not ready");
+    std::fill(mixBuffer_.begin(), mixBuffer_.end(), 0.0f);
+    for (size_t i = 0; i < srcDataList.size(); i++) {
+        if (srcDataList[i].isInnerCaped) {
+            AccumulateToMixBuffer(srcDataList[i], VOLUME_UNITY);
+        }
+    }
+    AudioMixKernel::FloatToFormat(mixBuffer_.data(), dstStreamInfo_.format, dupBuffer_.get(), sampleCount);
+}
+
+bool AudioEndpointInner::AccumulateToMixBuffer(const AudioStreamData &srcData, int32_t volume)
+{
+    const AudioStreamInfo &info = srcData.streamInfo;
+    size_t spanSize = static_cast<size_t>(dstSpanSizeInframe_) * info.channels *
+        AudioMixKernel::GetFormatByteSize(info.format);
+    if (info.samplingRate != dstStreamInfo_.samplingRate) {
+        return false; // logged once in LinkProcessStream
+    }
+    CHECK_AND_RETURN_RET_LOG(srcData.bufferDesc.dataLength >= spanSize, false, "skip stream, dataLength %{public}zu",
+        srcData.bufferDesc.dataLength);
+    MixSourceDesc src = { srcData.bufferDesc.buffer, info.format, info.channels, volume, info.channelLayout };
+    return AudioMixKernel::AccumulateToFloat(src, dstStreamInfo_.channels, dstStreamInfo_.channelLayout,
+        mixBuffer_.data(), dstSpanSizeInframe_) == SUCCESS;
+}
+
+// Any format and channel count AudioMixKernel supports, mixed in float and written in the endpoint format.
+void AudioEndpointInner::ProcessMixedFormatData(const AudioStreamData *srcData, size_t srcCount,
+    const AudioStreamData &dstData)
+{
+    Trace trace("AudioEndpointInner::ProcessMixedFormatData");
+    size_t sampleCount = static_cast<size_t>(dstSpanSizeInframe_) * dstData.streamInfo.channels;
+    CHECK_AND_RETURN_LOG(AudioMixKernel::IsFormatSupported(dstData.streamInfo.format, dstData.streamInfo.channels) &&
+        mixBuffer_.size() >= sampleCount, "ProcessData failed, streamInfo are not support");
+
+    std::fill(mixBuffer_.begin(), mixBuffer_.end(), 0.0f);
+    for (size_t i = 0; i < srcCount; i++) {
+        int32_t vol = srcData[i].volumeStart; // change to modify volume of each channel
+        AccumulateToMixBuffer(srcData[i], vol);
+        ZeroVolumeCheck(vol);
+    }
+    AudioMixKernel::FloatToFormat(mixBuffer_.data(), dstData.streamInfo.format, dstData.bufferDesc.buffer,
+        sampleCount);
+    HandleZeroVolumeCheckEvent();
+}
+
 void AudioEndpointInner::ProcessData(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData)
 {
     size_t srcListSize = srcDataList.size();
 
+    bool isAllS16Stereo = IsS16Stereo(dstData.streamInfo);
+    for (size_t i = 0; i < srcListSize && isAllS16Stereo; i++) {
+        isAllS16Stereo = IsS16Stereo(srcDataList[i].streamInfo);
+    }
+    if (!isAllS16Stereo) {
+        return ProcessMixedFormatData(srcDataList.data(), srcListSize, dstData);
+    }
+
     for (size_t i = 0; i < srcListSize; i++) {
-        if (srcDataList[i].streamInfo.format != SAMPLE_S16LE || srcDataList[i].streamInfo.channels != STEREO ||
-            srcDataList[i].bufferDesc.bufLength != dstData.bufferDesc.bufLength ||
+        if (srcDataList[i].bufferDesc.bufLength != dstData.bufferDesc.bufLength ||
             srcDataList[i].bufferDesc.dataLength != dstData.bufferDesc.dataLength) {
             AUDIO_ERR_LOG("ProcessData failed, streamInfo are different");
             return;
@@ -1380,18 +1779,16 @@ void AudioEndpointInner::ProcessData(const std::vector<AudioStreamData> &srcData
 
     size_t dataLength = dstData.bufferDesc.dataLength;
     dataLength /= 2; // SAMPLE_S16LE--> 2 byte
-    int16_t *dstPtr = reinterpret_cast<int16_t *>(dstData.bufferDesc.buffer);
-    for (size_t offset = 0; dataLength > 0; dataLength--) {
-        int32_t sum = 0;
-        for (size_t i = 0; i < srcListSize; i++) {
-            int32_t vol = srcDataList[i].volumeStart; // change to modify volume of each channel
-            int16_t *srcPtr = reinterpret_cast<int16_t *>(srcDataList[i].bufferDesc.buffer) + offset;
-            sum += (*srcPtr * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER; // 1/65536
-            ZeroVolumeCheck(vol);
-        }
-        offset++;
-        *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+    MixSourceS16 mixSources[MAX_LINKED_PROCESS];
+    size_t mixCount = 0;
+    for (size_t i = 0; i < srcListSize && mixCount < static_cast<size_t>(MAX_LINKED_PROCESS); i++) {
+        int32_t vol = srcDataList[i].volumeStart; // change to modify volume of each channel
+        mixSources[mixCount].data = reinterpret_cast<int16_t *>(srcDataList[i].bufferDesc.buffer);
+        mixSources[mixCount].volume = vol;
+        mixCount++;
+        ZeroVolumeCheck(vol);
     }
+    AudioMixKernel::MixS16(mixSources, mixCount, reinterpret_cast<int16_t *>(dstData.bufferDesc.buffer), dataLength);
     HandleZeroVolumeCheckEvent();
 }
 
@@ -1432,7 +1829,9 @@ void AudioEndpointInner::HandleRendererDataParams(const AudioStreamData &srcData
         ret = memset_s(static_cast<void *>(convertedBuffer.buffer), convertedBuffer.bufLength, 0,
             convertedBuffer.bufLength);
         CHECK_AND_RETURN_LOG(ret == EOK, "memset converted buffer to 0 failed");
+        return;
     }
+    ProcessMixedFormatData(&srcData, 1, dstData);
 }
 
 void AudioEndpointInner::ProcessSingleData(const AudioStreamData &srcData, const AudioStreamData &dstData)
@@ -1442,15 +1841,10 @@ void AudioEndpointInner::ProcessSingleData(const AudioStreamData &srcData, const
 
     size_t dataLength = dstData.bufferDesc.dataLength;
     dataLength /= 2; // SAMPLE_S16LE--> 2 byte
-    int16_t *dstPtr = reinterpret_cast<int16_t *>(dstData.bufferDesc.buffer);
-    for (size_t offset = 0; dataLength > 0; dataLength--) {
-        int32_t vol = srcData.volumeStart; // change to modify volume of each channel
-        int16_t *srcPtr = reinterpret_cast<int16_t *>(srcData.bufferDesc.buffer) + offset;
-        int32_t sum = (*srcPtr * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER; // 1/65536
-        ZeroVolumeCheck(vol);
-        offset++;
-        *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
-    }
+    int32_t vol = srcData.volumeStart; // change to modify volume of each channel
+    AudioMixKernel::ApplyVolumeS16(reinterpret_cast<int16_t *>(srcData.bufferDesc.buffer), vol,
+        reinterpret_cast<int16_t *>(dstData.bufferDesc.buffer), dataLength);
+    ZeroVolumeCheck(vol);
     HandleZeroVolumeCheckEvent();
 }
 
@@ -1483,7 +1877,7 @@ void AudioEndpointInner::GetAllReadyProcessData(std::vector<AudioStreamData> &au
 {
     for (size_t i = 0; i < processBufferList_.size(); i++) {
         uint64_t curRead = processBufferList_[i]->GetCurReadFrame();
-        Trace trace("AudioEndpoint::ReadProcessData->" + std::to_string(curRead));
+        Trace trace(READ_PROCESS_DATA_TRACE_TAG, curRead);
         SpanInfo *curReadSpan = processBufferList_[i]->GetSpanInfo(curRead);
         CHECK_AND_CONTINUE_LOG(curReadSpan != nullptr, "GetSpanInfo failed, can not get client curReadSpan");
         AudioStreamData streamData;
@@ -1536,7 +1930,7 @@ bool AudioEndpointInner::ProcessToEndpointDataHandle(uint64_t curWritePos)
     dstStreamData.volumeStart = curWriteSpan->volumeStart;
     dstStreamData.volumeEnd = curWriteSpan->volumeEnd;
 
-    Trace trace("AudioEndpoint::WriteDstBuffer=>" + std::to_string(curWritePos));
+    Trace trace(WRITE_DST_BUFFER_TRACE_TAG, curWritePos);
     // do write work
     if (audioDataList.size() == 0) {
         memset_s(dstStreamData.bufferDesc.buffer, dstStreamData.bufferDesc.bufLength, 0,
@@ -1570,13 +1964,17 @@ bool AudioEndpointInner::ProcessToEndpointDataHandle(uint64_t curWritePos)
 
 void AudioEndpointInner::DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const
 {
+    int64_t step = AudioLogUtils::GetVolumeSampleStep(volumeSampleIndex_);
+    if (step == 0) {
+        return;
+    }
     ChannelVolumes vols = VolumeTools::CountVolumeLevel(buffer, format, channel);
     if (channel == MONO) {
-        Trace::Count(logUtilsTag_, vols.volStart[0]);
+        Trace::HotPathCount(logUtilsTag_, vols.volStart[0]);
     } else {
-        Trace::Count(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
+        Trace::HotPathCount(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
     }
-    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_);
+    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_, step);
 }
 
 void AudioEndpointInner::CheckUpdateState(char *frame, uint64_t replyBytes)
@@ -1669,7 +2067,7 @@ bool AudioEndpointInner::RecordPrepareNextLoop(uint64_t curReadPos, int64_t &wak
 bool AudioEndpointInner::PrepareNextLoop(uint64_t curWritePos, int64_t &wakeUpTime)
 {
     uint64_t nextHandlePos = curWritePos + dstSpanSizeInframe_;
-    Trace prepareTrace("AudioEndpoint::PrepareNextLoop " + std::to_string(nextHandlePos));
+    Trace prepareTrace(PREPARE_NEXT_LOOP_TRACE_TAG, nextHandlePos);
     int64_t nextHdiReadTime = GetPredictNextReadTime(nextHandlePos);
     int64_t predictWakeupTime = nextHdiReadTime - serverAheadReadTime_;
     if (predictWakeupTime <= ClockTime::GetCurNano()) {
@@ -1839,7 +2237,7 @@ int32_t AudioEndpointInner::WriteToSpecialProcBuf(const std::shared_ptr<OHAudioB
 {
     CHECK_AND_RETURN_RET_LOG(procBuf != nullptr, ERR_INVALID_HANDLE, "process buffer is null.");
     uint64_t curWritePos = procBuf->GetCurWriteFrame();
-    Trace trace("AudioEndpoint::WriteProcessData-<" + std::to_string(curWritePos));
+    Trace trace(WRITE_PROCESS_DATA_TRACE_TAG, curWritePos);
 
     int32_t writeAbleSize = procBuf->GetAvailableDataFrames();
     if (writeAbleSize <= 0 || static_cast<uint32_t>(writeAbleSize) <= dstSpanSizeInframe_) {
@@ -1925,7 +2323,7 @@ void AudioEndpointInner::WriteToProcessBuffers(const BufferDesc &readBuf)
 
 int32_t AudioEndpointInner::ReadFromEndpoint(uint64_t curReadPos)
 {
-    Trace trace("AudioEndpoint::ReadDstBuffer=<" + std::to_string(curReadPos));
+    Trace trace(READ_DST_BUFFER_TRACE_TAG, curReadPos);
     AUDIO_DEBUG_LOG("ReadFromEndpoint enter, dstAudioBuffer curReadPos %{public}" PRIu64".", curReadPos);
     CHECK_AND_RETURN_RET_LOG(dstAudioBuffer_ != nullptr, ERR_INVALID_HANDLE,
         "dst audio buffer is null.");
@@ -1958,12 +2356,19 @@ void AudioEndpointInner::RecordEndpointWorkLoopFuc()
     int64_t curTime = 0;
     uint64_t curReadPos = 0;
     int64_t wakeUpTime = ClockTime::GetCurNano();
+    bool isWakeUpPlanned = false;
+    prctl(PR_SET_TIMERSLACK, WORK_LOOP_TIMER_SLACK_NS);
     AUDIO_INFO_LOG("Record endpoint work loop fuc start.");
     while (isInited_.load()) {
         if (!KeepWorkloopRunning()) {
+            isWakeUpPlanned = false;
             continue;
         }
         threadStatus_ = INRUNNING;
+        if (isWakeUpPlanned) {
+            RecordWakeUpLateness(ClockTime::GetCurNano() - wakeUpTime);
+            isWakeUpPlanned = false;
+        }
         if (needReSyncPosition_) {
             RecordReSyncPosition();
             wakeUpTime = ClockTime::GetCurNano();
@@ -1988,6 +2393,7 @@ void AudioEndpointInner::RecordEndpointWorkLoopFuc()
 
         loopTrace.End();
         threadStatus_ = SLEEPING;
+        isWakeUpPlanned = true;
         ClockTime::AbsoluteSleep(wakeUpTime);
     }
 }
@@ -1998,16 +2404,23 @@ void AudioEndpointInner::EndpointWorkLoopFuc()
     int64_t curTime = 0;
     uint64_t curWritePos = 0;
     int64_t wakeUpTime = ClockTime::GetCurNano();
+    bool isWakeUpPlanned = false;
+    prctl(PR_SET_TIMERSLACK, WORK_LOOP_TIMER_SLACK_NS);
     AUDIO_INFO_LOG("Endpoint work loop fuc start");
     int32_t ret = 0;
     while (isInited_.load()) {
         if (!KeepWorkloopRunning()) {
+            isWakeUpPlanned = false;
             continue;
         }
         ret = 0;
         threadStatus_ = INRUNNING;
         curTime = ClockTime::GetCurNano();
         Trace loopTrace("AudioEndpoint::loop_trace");
+        if (isWakeUpPlanned) {
+            RecordWakeUpLateness(curTime - wakeUpTime);
+            isWakeUpPlanned = false;
+        }
         if (needReSyncPosition_) {
             ReSyncPosition();
             wakeUpTime = curTime;
@@ -2044,6 +2457,7 @@ void AudioEndpointInner::EndpointWorkLoopFuc()
         loopTrace.End();
         // start sleep
         threadStatus_ = SLEEPING;
+        isWakeUpPlanned = true;
         ClockTime::AbsoluteSleep(wakeUpTime);
     }
     AUDIO_DEBUG_LOG("Endpoint work loop fuc end, ret %{public}d", ret);
@@ -42,6 +42,7 @@ namespace {
     static constexpr int32_t VOLUME_SHIFT_NUMBER = 16; // 1 >> 16 = 65536, max volume
     static constexpr int64_t MAX_SPAN_DURATION_IN_NANO = 100000000; // 100ms
     static constexpr int64_t DELTA_TO_REAL_READ_START_TIME = 0; // 0ms
+    static const std::string WRITE_PROCESS_DATA_TRACE_TAG = "AudioEndpoint::WriteProcessData-<";
 }
 
 static enum HdiAdapterFormat ConvertToHdiAdapterFormat(AudioSampleFormat format)
@@ -337,6 +338,12 @@ void AudioEndpointSeparate::InitAudiobuffer(bool resetReadWritePos)
     return;
 }
 
+int32_t AudioEndpointSeparate::NegotiateSpan(const AudioProcessConfig &config)
+{
+    (void)config; // the buffer is owned by a single process, keep the span of the hdi
+    return SUCCESS;
+}
+
 int32_t AudioEndpointSeparate::GetPreferBufferInfo(uint32_t &totalSizeInframe, uint32_t &spanSizeInframe)
 {
     totalSizeInframe = dstTotalSizeInframe_;
@@ -676,7 +683,7 @@ int32_t AudioEndpointSeparate::WriteToSpecialProcBuf(const std::shared_ptr<OHAud
 {
     CHECK_AND_RETURN_RET_LOG(procBuf != nullptr, ERR_INVALID_HANDLE, "%{public}s process buffer is null.", __func__);
     uint64_t curWritePos = procBuf->GetCurWriteFrame();
-    Trace trace("AudioEndpoint::WriteProcessData-<" + std::to_string(curWritePos));
+    Trace trace(WRITE_PROCESS_DATA_TRACE_TAG, curWritePos);
     SpanInfo *curWriteSpan = procBuf->GetSpanInfo(curWritePos);
     CHECK_AND_RETURN_RET_LOG(curWriteSpan != nullptr, ERR_INVALID_HANDLE,
         "%{public}s get write span info of procBuf fail.", __func__);
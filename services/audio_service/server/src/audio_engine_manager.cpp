@@ -14,43 +14,22 @@
  */
 #include "audio_engine_manager.h"
 #include "none_mix_engine.h"
+#include "pro_mix_engine.h"
 
 namespace OHOS {
 namespace AudioStandard {
-AudioEngineManager AudioEngineManager::GetInstance()
+AudioEngineManager &AudioEngineManager::GetInstance()
 {
     static AudioEngineManager enginManager;
     return enginManager;
 }
 
-void AudioEngineManager::AddRenderer(std::shared_ptr<IRendererStream> stream, DeviceInfo device)
+std::unique_ptr<AudioPlaybackEngine> AudioEngineManager::CreatePlaybackEngine(PlaybackType type)
 {
-    AudioProcessConfig config = stream->GetAudioProcessConfig();
-    bool isDirect = true;
-    PlaybackType playbackType_ = PlaybackType::DIRECT;
-    if (config.streamType != STREAM_MUSIC) {
-        playbackType_ = PlaybackType::VOIP;
-        isDirect = false;
-    }
-    auto iter = renderEngines_.find(playbackType_);
-    if (iter == renderEngines_.end()) {
-        std::shared_ptr<AudioPlaybackEngine> playbackEngine = std::make_shared<NoneMixEngine>();
-        playbackEngine->Init(device, !isDirect);
-        playbackEngine->AddRenderer(stream);
-        renderEngines_.emplace(playbackType_, playbackEngine);
-    }
-}
-void AudioEngineManager::RemoveRenderer(std::shared_ptr<IRendererStream> stream)
-{
-    AudioProcessConfig config = stream->GetAudioProcessConfig();
-    PlaybackType playbackType_ = PlaybackType::DIRECT;
-    if (config.streamType != STREAM_MUSIC) {
-        playbackType_ = PlaybackType::VOIP;
-    }
-    auto iter = renderEngines_.find(playbackType_);
-    if (iter != renderEngines_.end()) {
-        renderEngines_.erase(iter);
+    if (type == PlaybackType::DIRECT_MIX) {
+        return std::make_unique<ProMixEngine>();
     }
+    return std::make_unique<NoneMixEngine>();
 }
 } // namespace AudioStandard
 } // namespace OHOS
@@ -345,8 +345,10 @@ int32_t AudioProcessInServer::ConfigProcessBuffer(uint32_t &totalSizeInframe,
         ERR_INVALID_PARAM, "ConfigProcessBuffer failed: ERR_INVALID_PARAM");
     CHECK_AND_RETURN_RET_LOG(serverStreamInfo.samplingRate.size() > 0 && serverStreamInfo.channels.size() > 0,
         ERR_INVALID_PARAM, "Invalid stream info in server");
-    uint32_t spanTime = spanSizeInframe * AUDIO_MS_PER_SECOND / *serverStreamInfo.samplingRate.rbegin();
-    spanSizeInframe_ = spanTime * processConfig_.streamInfo.samplingRate / AUDIO_MS_PER_SECOND;
+    // in us, the span of the endpoint may be 2.5ms
+    uint64_t spanTime = static_cast<uint64_t>(spanSizeInframe) * AUDIO_US_PER_SECOND /
+        *serverStreamInfo.samplingRate.rbegin();
+    spanSizeInframe_ = static_cast<uint32_t>(spanTime * processConfig_.streamInfo.samplingRate / AUDIO_US_PER_SECOND);
     totalSizeInframe_ = totalSizeInframe / spanSizeInframe * spanSizeInframe_;
 
     uint32_t channel = processConfig_.streamInfo.channels;
@@ -23,6 +23,8 @@
 
 namespace OHOS {
 namespace AudioStandard {
+static const std::string HANDLE_TRACE_TAG = "AudioProcess::Handle::";
+
 ProcessCbProxy::ProcessCbProxy(const sptr<IRemoteObject> &impl) : IRemoteProxy<IProcessCb>(impl)
 {
 }
@@ -58,7 +60,7 @@ int AudioProcessStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Messag
 {
     bool ret = CheckInterfaceToken(data);
     CHECK_AND_RETURN_RET(ret, AUDIO_ERR);
-    Trace trace("AudioProcess::Handle::" + std::to_string(code));
+    Trace trace(HANDLE_TRACE_TAG, code);
     if (code >= IAudioProcessMsg::PROCESS_MAX_MSG) {
         AUDIO_WARNING_LOG("OnRemoteRequest unsupported request code:%{public}d.", code);
         return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
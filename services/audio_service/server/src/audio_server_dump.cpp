@@ -19,6 +19,7 @@
 #include "audio_server_dump.h"
 #include "audio_utils.h"
 #include "audio_service.h"
+#include "audio_effect_profiler.h"
 #include "pa_adapter_tools.h"
 
 using namespace std;
@@ -48,6 +49,7 @@ void AudioServerDump::InitDumpFuncMap()
     dumpFuncMap[u"-r"] = &AudioServerDump::RecordSourceDump;
     dumpFuncMap[u"-m"] = &AudioServerDump::HDFModulesDump;
     dumpFuncMap[u"-ep"] = &AudioServerDump::PolicyHandlerDump;
+    dumpFuncMap[u"-ef"] = &AudioServerDump::EffectProfileDump;
 }
 
 void AudioServerDump::ResetPAAudioDump()
@@ -167,6 +169,7 @@ void AudioServerDump::ServerDataDump(string &dumpString)
     RecordSourceDump(dumpString);
     HDFModulesDump(dumpString);
     PolicyHandlerDump(dumpString);
+    EffectProfileDump(dumpString);
 }
 
 void AudioServerDump::ArgDataDump(std::string &dumpString, std::queue<std::u16string>& argQue)
@@ -202,6 +205,7 @@ void AudioServerDump::HelpInfoDump(string &dumpString)
     AppendFormat(dumpString, "  -r\t\t\t|dump pa record streams\n");
     AppendFormat(dumpString, "  -m\t\t\t|dump hdf input modules\n");
     AppendFormat(dumpString, "  -ep\t\t\t|dump policyhandler info\n");
+    AppendFormat(dumpString, "  -ef\t\t\t|effect process time, see persist.multimedia.audio.effect.profileinterval\n");
 }
 
 void AudioServerDump::AudioDataDump(string &dumpString, std::queue<std::u16string>& argQue)
@@ -512,5 +516,13 @@ void AudioServerDump::PolicyHandlerDump(std::string &dumpString)
     AUDIO_INFO_LOG("PolicyHandlerDump");
     AudioService::GetInstance()->Dump(dumpString);
 }
+
+void AudioServerDump::EffectProfileDump(std::string &dumpString)
+{
+    AUDIO_INFO_LOG("EffectProfileDump");
+    // a sample interval set with param set since the last dump applies from now on
+    AudioEffectProfiler::GetInstance().LoadSampleInterval();
+    AudioEffectProfiler::GetInstance().Dump(dumpString);
+}
 } // namespace AudioStandard
 } // namespace OHOS
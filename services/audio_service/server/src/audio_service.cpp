@@ -432,6 +432,8 @@ sptr<AudioProcessInServer> AudioService::GetAudioProcess(const AudioProcessConfi
 
     uint32_t totalSizeInframe = 0;
     uint32_t spanSizeInframe = 0;
+    int32_t ret = audioEndpoint->NegotiateSpan(config);
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, nullptr, "NegotiateSpan failed");
     audioEndpoint->GetPreferBufferInfo(totalSizeInframe, spanSizeInframe);
     CHECK_AND_RETURN_RET_LOG(*deviceInfo.audioStreamInfo.samplingRate.rbegin() > 0, nullptr,
         "Sample rate in server is invalid.");
@@ -441,7 +443,7 @@ sptr<AudioProcessInServer> AudioService::GetAudioProcess(const AudioProcessConfi
 
     std::shared_ptr<OHAudioBuffer> buffer = audioEndpoint->GetEndpointType()
          == AudioEndpoint::TYPE_INDEPENDENT ? audioEndpoint->GetBuffer() : nullptr;
-    int32_t ret = process->ConfigProcessBuffer(totalSizeInframe, spanSizeInframe, deviceInfo.audioStreamInfo, buffer);
+    ret = process->ConfigProcessBuffer(totalSizeInframe, spanSizeInframe, deviceInfo.audioStreamInfo, buffer);
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, nullptr, "ConfigProcessBuffer failed");
 
     ret = LinkProcessToEndpoint(process, audioEndpoint);
@@ -34,6 +34,8 @@ namespace {
     static const size_t CAPTURER_BUFFER_DEFAULT_NUM = 4;
     static const size_t CAPTURER_BUFFER_WAKE_UP_NUM = 100;
     static const uint32_t OVERFLOW_LOG_LOOP_COUNT = 100;
+    static const std::string READ_DATA_TRACE_TAG = "CapturerInServer::ReadData:";
+    static const std::string ON_READ_DATA_TRACE_TAG = "CapturerInServer::OnReadData:";
 }
 
 CapturerInServer::CapturerInServer(AudioProcessConfig processConfig, std::weak_ptr<IStreamListener> streamListener)
@@ -213,7 +215,7 @@ void CapturerInServer::ReadData(size_t length)
         return;
     }
 
-    Trace trace("CapturerInServer::ReadData:" + std::to_string(currentWriteFrame));
+    Trace trace(READ_DATA_TRACE_TAG, currentWriteFrame);
     OptResult result = ringCache_->GetWritableSize();
     CHECK_AND_RETURN_LOG(result.ret == OPERATION_SUCCESS, "RingCache write invalid size %{public}zu", result.size);
     BufferDesc srcBuffer = stream_->DequeueBuffer(result.size);
@@ -231,13 +233,10 @@ void CapturerInServer::ReadData(size_t length)
     }
     if (processConfig_.capturerInfo.sourceType == SOURCE_TYPE_PLAYBACK_CAPTURE && processConfig_.innerCapMode ==
         LEGACY_MUTE_CAP) {
-        dstBuffer.buffer = dischargeBuffer_.get(); // discharge valid data.
-    }
-    ringCache_->Dequeue({dstBuffer.buffer, dstBuffer.bufLength});
-    DumpFileUtil::WriteDumpFile(dumpS2C_, static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength);
-    if (AudioDump::GetInstance().GetVersionType() == BETA_VERSION) {
-        Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
-            static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength);
+        DischargeData(dstBuffer.bufLength); // discharge valid data.
+    } else {
+        ringCache_->Dequeue({dstBuffer.buffer, dstBuffer.bufLength});
+        WriteDumpData(dstBuffer.buffer, dstBuffer.bufLength);
     }
 
     uint64_t nextWriteFrame = currentWriteFrame + spanSizeInFrame_;
@@ -248,9 +247,32 @@ void CapturerInServer::ReadData(size_t length)
     stateListener->OnOperationHandled(UPDATE_STREAM, currentWriteFrame);
 }
 
+// Drop the data in cache without copying it out, it is only written to dump file.
+void CapturerInServer::DischargeData(size_t length)
+{
+    RingSpan span;
+    OptResult result = ringCache_->ReserveRead(length, span);
+    CHECK_AND_RETURN_LOG(result.ret == OPERATION_SUCCESS, "Discharge failed ret:%{public}d", result.ret);
+    WriteDumpData(span.first.dataPtr, span.first.dataSize);
+    if (span.second.dataSize > 0) {
+        WriteDumpData(span.second.dataPtr, span.second.dataSize);
+    }
+    ringCache_->CommitRead(result.size);
+}
+
+// Dump the data handed to the client, or discharged in its place.
+void CapturerInServer::WriteDumpData(uint8_t *data, size_t size)
+{
+    DumpFileUtil::WriteDumpFile(dumpS2C_, static_cast<void *>(data), size);
+    if (AudioDump::GetInstance().GetVersionType() == BETA_VERSION) {
+        Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
+            static_cast<void *>(data), size);
+    }
+}
+
 int32_t CapturerInServer::OnReadData(size_t length)
 {
-    Trace trace("CapturerInServer::OnReadData:" + std::to_string(length));
+    Trace trace(ON_READ_DATA_TRACE_TAG, length);
     ReadData(length);
     return SUCCESS;
 }
@@ -500,7 +522,7 @@ int32_t CapturerInServer::InitCacheBuffer(size_t targetSize)
     cacheSizeInBytes_ = targetSize;
 
     if (ringCache_ == nullptr) {
-        ringCache_ = AudioRingCache::Create(cacheSizeInBytes_);
+        ringCache_ = AudioSpscRingCache::Create(cacheSizeInBytes_);
     } else {
         OptResult result = ringCache_->ReConfig(cacheSizeInBytes_, false); // false --> clear buffer
         if (result.ret != OPERATION_SUCCESS) {
@@ -509,11 +531,6 @@ int32_t CapturerInServer::InitCacheBuffer(size_t targetSize)
         }
     }
 
-    if (processConfig_.capturerInfo.sourceType == SOURCE_TYPE_PLAYBACK_CAPTURE && processConfig_.innerCapMode ==
-        LEGACY_MUTE_CAP) {
-        dischargeBuffer_ = std::make_unique<uint8_t []>(cacheSizeInBytes_);
-    }
-
     return SUCCESS;
 }
 } // namespace AudioStandard
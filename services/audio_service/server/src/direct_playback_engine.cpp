@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "DirectPlaybackEngine"
+#endif
+
+#include "direct_playback_engine.h"
+
+#include "audio_errors.h"
+#include "audio_service_log.h"
+#include "audio_utils.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr int32_t DELTA_TIME = 4000000; // 4ms
+constexpr int32_t PERIOD_NS = 20000000; // 20ms
+constexpr int32_t FADING_MS = 20; // 20ms
+constexpr int32_t DIRECT_STOP_TIMEOUT_IN_SEC = 8; // 8S
+}
+
+DirectPlaybackEngine::DirectPlaybackEngine(const std::string &name)
+    : isVoip_(false),
+      isStart_(false),
+      failedCount_(0),
+      writeCount_(0),
+      fwkSyncTime_(0),
+      startFadein_(false),
+      startFadeout_(false),
+      name_(name)
+{
+}
+
+void DirectPlaybackEngine::WaitFadeOut()
+{
+    startFadein_ = false;
+    startFadeout_ = true;
+    // wait until fadeout complete
+    std::unique_lock fadingLock(fadingMutex_);
+    cvFading_.wait_for(
+        fadingLock, std::chrono::milliseconds(FADING_MS), [this] { return (!(startFadein_ || startFadeout_)); });
+}
+
+int32_t DirectPlaybackEngine::Stop()
+{
+    AUDIO_INFO_LOG("%{public}s enter", name_.c_str());
+    int32_t ret = SUCCESS;
+    if (!isStart_) {
+        AUDIO_INFO_LOG("already stopped");
+        return ret;
+    }
+    writeCount_ = 0;
+    failedCount_ = 0;
+    if (playbackThread_) {
+        WaitFadeOut();
+        playbackThread_->Stop();
+        playbackThread_ = nullptr;
+    }
+    ret = SinkStopTimeOut();
+    isStart_ = false;
+    return ret;
+}
+
+int32_t DirectPlaybackEngine::Pause()
+{
+    AUDIO_INFO_LOG("%{public}s enter", name_.c_str());
+    int32_t ret = SUCCESS;
+    writeCount_ = 0;
+    failedCount_ = 0;
+    if (playbackThread_) {
+        WaitFadeOut();
+        playbackThread_->Pause();
+    }
+    ret = SinkStopTimeOut();
+    isStart_ = false;
+    return ret;
+}
+
+void DirectPlaybackEngine::PauseAsync()
+{
+    // stop thread when failed too many times, do not add logic inside.
+    if (playbackThread_ && playbackThread_->CheckThreadIsRunning()) {
+        playbackThread_->PauseAsync();
+    }
+    int32_t ret = SinkStopTimeOut();
+    if (ret != SUCCESS) {
+        AUDIO_ERR_LOG("sink stop failed.ret:%{public}d", ret);
+    }
+    isStart_ = false;
+}
+
+int32_t DirectPlaybackEngine::SinkStopTimeOut()
+{
+    int32_t ret = SUCCESS;
+    int32_t XcollieFlag = (1 | 2); // flag 1 generate log file,flag 2 die when timeout, restart server
+    AudioXCollie audioXCollie(
+        name_ + "::Stop", DIRECT_STOP_TIMEOUT_IN_SEC,
+        [this](void *) { AUDIO_ERR_LOG("%{public}d renderSink_ stop timeout, trigger signal", isVoip_); }, nullptr,
+        XcollieFlag);
+    if (renderSink_ && renderSink_->IsInited()) {
+        ret = renderSink_->Stop();
+    }
+    return ret;
+}
+
+bool DirectPlaybackEngine::IsPlaybackEngineRunning() const noexcept
+{
+    return isStart_;
+}
+
+void DirectPlaybackEngine::StandbySleep()
+{
+    int64_t writeTime = static_cast<int64_t>(fwkSyncTime_) + static_cast<int64_t>(writeCount_) * PERIOD_NS + DELTA_TIME;
+    ClockTime::AbsoluteSleep(writeTime);
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -24,6 +24,8 @@
 
 namespace OHOS {
 namespace AudioStandard {
+static const std::string HANDLE_TRACE_TAG = "IpcStream::Handle::";
+
 bool IpcStreamStub::CheckInterfaceToken(MessageParcel &data)
 {
     static auto localDescriptor = IpcStream::GetDescriptor();
@@ -35,6 +37,34 @@ bool IpcStreamStub::CheckInterfaceToken(MessageParcel &data)
     return true;
 }
 
+void IpcStreamStub::CountRequest(uint32_t code)
+{
+    requestCount_++;
+    if (code == ON_UPDATE_POSITION) {
+        positionRequestCount_++;
+    }
+    int64_t now = ClockTime::GetCurNano();
+    int64_t startTime = countStartTime_.load();
+    if (startTime == 0) {
+        countStartTime_.compare_exchange_strong(startTime, now);
+        return;
+    }
+    // only the thread that moves the start time reports, as requests may come from several binder threads.
+    int64_t duration = now - startTime;
+    if (duration < static_cast<int64_t>(AUDIO_NS_PER_SECOND) || !countStartTime_.compare_exchange_strong(startTime,
+        now)) {
+        return;
+    }
+    uint32_t requestCount = requestCount_.exchange(0);
+    uint32_t positionRequestCount = positionRequestCount_.exchange(0);
+    int64_t perSecond = static_cast<int64_t>(requestCount * AUDIO_NS_PER_SECOND / static_cast<uint64_t>(duration));
+    uint32_t sessionId = 0;
+    GetAudioSessionID(sessionId);
+    Trace::Count("IpcStream::" + std::to_string(sessionId) + "::RequestsPerSecond", perSecond);
+    AUDIO_DEBUG_LOG("session %{public}u ipc requests:%{public}u update position:%{public}u in %{public}" PRId64"ns",
+        sessionId, requestCount, positionRequestCount, duration);
+}
+
 int IpcStreamStub::OnMiddleCodeRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply,
     MessageOption &option)
 {
@@ -82,7 +112,8 @@ int IpcStreamStub::OnRemoteRequest(uint32_t code, MessageParcel &data, MessagePa
     if (!CheckInterfaceToken(data)) {
         return AUDIO_ERR;
     }
-    Trace trace("IpcStream::Handle::" + std::to_string(code));
+    Trace trace(HANDLE_TRACE_TAG, code);
+    CountRequest(code);
     if (code >= IpcStreamMsg::IPC_STREAM_MAX_MSG) {
         AUDIO_WARNING_LOG("OnRemoteRequest unsupported request code:%{public}d.", code);
         return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
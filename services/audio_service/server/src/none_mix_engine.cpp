@@ -24,29 +24,20 @@
 
 namespace OHOS {
 namespace AudioStandard {
-constexpr int32_t DELTA_TIME = 4000000; // 4ms
 constexpr int32_t PERIOD_NS = 20000000; // 20ms
-constexpr int32_t FADING_MS = 20; // 20ms
 constexpr int32_t MAX_ERROR_COUNT = 50;
 constexpr int16_t STEREO_CHANNEL_COUNT = 2;
 constexpr int16_t HDI_STEREO_CHANNEL_LAYOUT = 3;
 constexpr int16_t HDI_MONO_CHANNEL_LAYOUT = 4;
-constexpr int32_t DIRECT_STOP_TIMEOUT_IN_SEC = 8; // 8S
 const std::string THREAD_NAME = "noneMixThread";
 const std::string VOIP_SINK_NAME = "voip";
 const std::string DIRECT_SINK_NAME = "direct";
 const char *SINK_ADAPTER_NAME = "primary";
 
 NoneMixEngine::NoneMixEngine()
-    : isVoip_(false),
-      isStart_(false),
+    : DirectPlaybackEngine("NoneMixEngine"),
       isInit_(false),
-      failedCount_(0),
-      writeCount_(0),
-      fwkSyncTime_(0),
       stream_(nullptr),
-      startFadein_(false),
-      startFadeout_(false),
       uChannel_(0),
       uFormat_(sizeof(int32_t)),
       uSampleRate_(0)
@@ -116,78 +107,6 @@ int32_t NoneMixEngine::Start()
     return ret;
 }
 
-int32_t NoneMixEngine::Stop()
-{
-    AUDIO_INFO_LOG("Enter");
-    int32_t ret = SUCCESS;
-    if (!isStart_) {
-        AUDIO_INFO_LOG("already stopped");
-        return ret;
-    }
-    writeCount_ = 0;
-    failedCount_ = 0;
-    if (playbackThread_) {
-        startFadein_ = false;
-        startFadeout_ = true;
-        // wait until fadeout complete
-        std::unique_lock fadingLock(fadingMutex_);
-        cvFading_.wait_for(
-            fadingLock, std::chrono::milliseconds(FADING_MS), [this] { return (!(startFadein_ || startFadeout_)); });
-        playbackThread_->Stop();
-        playbackThread_ = nullptr;
-    }
-    ret = SinkStopTimeOut();
-    isStart_ = false;
-    return ret;
-}
-
-void NoneMixEngine::PauseAsync()
-{
-    // stop thread when failed 5 times,do not add logic inside.
-    if (playbackThread_ && playbackThread_->CheckThreadIsRunning()) {
-        playbackThread_->PauseAsync();
-    }
-    int32_t ret = SinkStopTimeOut();
-    if (ret != SUCCESS) {
-        AUDIO_ERR_LOG("sink stop failed.ret:%{public}d", ret);
-    }
-    isStart_ = false;
-}
-
-int32_t NoneMixEngine::SinkStopTimeOut()
-{
-    int32_t ret = SUCCESS;
-    int32_t XcollieFlag = (1 | 2); // flag 1 generate log file,flag 2 die when timeout, restart server
-    AudioXCollie audioXCollie(
-        "NoneMixEngine::Stop", DIRECT_STOP_TIMEOUT_IN_SEC,
-        [this](void *) { AUDIO_ERR_LOG("%{public}d renderSink_ stop timeout, trigger signal", isVoip_); }, nullptr,
-        XcollieFlag);
-    if (renderSink_ && renderSink_->IsInited()) {
-        ret = renderSink_->Stop();
-    }
-    return ret;
-}
-
-int32_t NoneMixEngine::Pause()
-{
-    AUDIO_INFO_LOG("Enter");
-    int32_t ret = SUCCESS;
-    writeCount_ = 0;
-    failedCount_ = 0;
-    if (playbackThread_) {
-        startFadein_ = false;
-        startFadeout_ = true;
-        // wait until fadeout complete
-        std::unique_lock fadingLock(fadingMutex_);
-        cvFading_.wait_for(
-            fadingLock, std::chrono::milliseconds(FADING_MS), [this] { return (!(startFadein_ || startFadeout_)); });
-        playbackThread_->Pause();
-    }
-    ret = SinkStopTimeOut();
-    isStart_ = false;
-    return ret;
-}
-
 int32_t NoneMixEngine::Flush()
 {
     AUDIO_INFO_LOG("Enter");
@@ -303,17 +222,6 @@ void NoneMixEngine::RemoveRenderer(const std::shared_ptr<IRendererStream> &strea
     }
 }
 
-bool NoneMixEngine::IsPlaybackEngineRunning() const noexcept
-{
-    return isStart_;
-}
-
-void NoneMixEngine::StandbySleep()
-{
-    int64_t writeTime = static_cast<int64_t>(fwkSyncTime_) + static_cast<int64_t>(writeCount_) * PERIOD_NS + DELTA_TIME;
-    ClockTime::AbsoluteSleep(writeTime);
-}
-
 AudioSamplingRate NoneMixEngine::GetDirectSampleRate(AudioSamplingRate sampleRate)
 {
     AudioSamplingRate result = sampleRate;
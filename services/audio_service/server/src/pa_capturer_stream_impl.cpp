@@ -26,6 +26,8 @@
 
 namespace OHOS {
 namespace AudioStandard {
+static const std::string READ_CB_TRACE_TAG = "PaCapturerStreamImpl::PAStreamReadCb:length ";
+static const std::string READABLE_SIZE_TRACE_TAG = "PaCapturerStreamImpl::PAStreamReadCb:readable";
 static SafeMap<void *, std::weak_ptr<PaCapturerStreamImpl>> paCapturerMap_;
 static int32_t CheckReturnIfStreamInvalid(pa_stream *paStream, const int32_t retVal)
 {
@@ -335,8 +337,10 @@ int32_t PaCapturerStreamImpl::DropBuffer()
 
 void PaCapturerStreamImpl::PAStreamReadCb(pa_stream *stream, size_t length, void *userdata)
 {
-    Trace trace("PaCapturerStreamImpl::PAStreamReadCb:length " + std::to_string(length) + " readable:" +
-        std::to_string(pa_stream_readable_size(stream)));
+    Trace trace(READ_CB_TRACE_TAG, length);
+    if (Trace::IsHotPathEnabled()) {
+        Trace::Count(READABLE_SIZE_TRACE_TAG, pa_stream_readable_size(stream));
+    }
 
     if (!userdata) {
         AUDIO_ERR_LOG("PAStreamReadCb: userdata is null");
@@ -50,6 +50,9 @@ const uint64_t AUDIO_NS_PER_S = 1000000000;
 const uint64_t AUDIO_CYCLE_TIME_US = 20000;
 const float MIN_VOLUME = 0.0;
 const float MAX_VOLUME = 1.0;
+static const std::string ENQUEUE_BUFFER_TRACE_TAG = "PaRendererStreamImpl::EnqueueBuffer ";
+static const std::string TOTAL_WRITTEN_TRACE_TAG = "PaRendererStreamImpl::totalBytesWritten";
+static const std::string WRITE_CB_TRACE_TAG = "PaRendererStreamImpl::PAStreamWriteCb length:";
 
 static int32_t CheckReturnIfStreamInvalid(pa_stream *paStream, const int32_t retVal)
 {
@@ -612,8 +615,8 @@ BufferDesc PaRendererStreamImpl::DequeueBuffer(size_t length)
 
 int32_t PaRendererStreamImpl::EnqueueBuffer(const BufferDesc &bufferDesc)
 {
-    Trace trace("PaRendererStreamImpl::EnqueueBuffer " + std::to_string(bufferDesc.bufLength) + " totalBytesWritten" +
-        std::to_string(totalBytesWritten_));
+    Trace trace(ENQUEUE_BUFFER_TRACE_TAG, bufferDesc.bufLength);
+    Trace::HotPathCount(TOTAL_WRITTEN_TRACE_TAG, totalBytesWritten_);
     int32_t error = 0;
     if (offloadEnable_) {
         error = OffloadUpdatePolicyInWrite();
@@ -660,8 +663,7 @@ void PaRendererStreamImpl::PAStreamWriteCb(pa_stream *stream, size_t length, voi
     auto streamImpl = paRendererStreamWeakPtr.lock();
     CHECK_AND_RETURN_LOG(streamImpl, "PAStreamWriteCb: userdata is null");
 
-    Trace trace("PaRendererStreamImpl::PAStreamWriteCb sink-input:" + std::to_string(streamImpl->sinkInputIndex_) +
-        " length:" + std::to_string(length));
+    Trace trace(WRITE_CB_TRACE_TAG, length);
     std::shared_ptr<IWriteCallback> writeCallback = streamImpl->writeCallback_.lock();
     if (writeCallback != nullptr) {
         writeCallback->OnWriteData(length);
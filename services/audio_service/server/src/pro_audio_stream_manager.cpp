@@ -24,7 +24,6 @@
 #include "policy_handler.h"
 #include "pro_renderer_stream_impl.h"
 #include "audio_engine_manager.h"
-#include "none_mix_engine.h"
 #include "audio_utils.h"
 
 namespace OHOS {
@@ -32,7 +31,9 @@ namespace AudioStandard {
 using namespace std;
 
 ProAudioStreamManager::ProAudioStreamManager(ManagerType type)
-    : managerType_(type), playbackEngine_(std::make_unique<NoneMixEngine>())
+    : managerType_(type),
+      playbackType_(type == VOIP_PLAYBACK ? PlaybackType::VOIP : PlaybackType::DIRECT),
+      playbackEngine_(AudioEngineManager::CreatePlaybackEngine(playbackType_))
 {
     AUDIO_DEBUG_LOG("ProAudioStreamManager");
 }
@@ -50,14 +51,16 @@ int32_t ProAudioStreamManager::CreateRender(AudioProcessConfig processConfig, st
     uint32_t sessionId = PolicyHandler::GetInstance().GenerateSessionId(processConfig.appInfo.appUid);
     std::shared_ptr<IRendererStream> rendererStream = CreateRendererStream(processConfig);
     CHECK_AND_RETURN_RET_LOG(rendererStream != nullptr, ERR_DEVICE_INIT, "Failed to init rendererStream");
+    std::lock_guard<std::mutex> lock(streamMapMutex_);
+    SwitchPlaybackEngine(rendererStreamMap_.size() + 1);
     int32_t ret = CreatePlayBackEngine(rendererStream);
     if (ret != SUCCESS) {
         AUDIO_ERR_LOG("Create play back engine failed. ret:%{public}d", ret);
         rendererStream = nullptr;
+        SwitchPlaybackEngine(rendererStreamMap_.size());
         return ret;
     }
     rendererStream->SetStreamIndex(sessionId);
-    std::lock_guard<std::mutex> lock(streamMapMutex_);
     rendererStreamMap_[sessionId] = rendererStream;
     stream = rendererStream;
     return SUCCESS;
@@ -77,6 +80,7 @@ int32_t ProAudioStreamManager::StartRender(uint32_t streamIndex)
     currentRender = rendererStreamMap_[streamIndex];
     int32_t result = currentRender->Start();
     CHECK_AND_RETURN_RET_LOG(result == SUCCESS, result, "Failed to start rendererStream");
+    runningStreams_.insert(streamIndex);
     if (playbackEngine_) {
         playbackEngine_->Start();
     }
@@ -94,9 +98,7 @@ int32_t ProAudioStreamManager::StopRender(uint32_t streamIndex)
         return SUCCESS;
     }
     rendererStreamMap_[streamIndex]->Stop();
-    if (playbackEngine_) {
-        playbackEngine_->Stop();
-    }
+    StopPlayBackEngineIfIdle(streamIndex, false);
     return SUCCESS;
 }
 
@@ -111,9 +113,7 @@ int32_t ProAudioStreamManager::PauseRender(uint32_t streamIndex)
         return SUCCESS;
     }
     rendererStreamMap_[streamIndex]->Pause();
-    if (playbackEngine_) {
-        playbackEngine_->Pause();
-    }
+    StopPlayBackEngineIfIdle(streamIndex, true);
     return SUCCESS;
 }
 
@@ -132,10 +132,11 @@ int32_t ProAudioStreamManager::ReleaseRender(uint32_t streamIndex)
         currentRender = rendererStreamMap_[streamIndex];
         rendererStreamMap_[streamIndex] = nullptr;
         rendererStreamMap_.erase(streamIndex);
-    }
-    if (playbackEngine_) {
-        playbackEngine_->Stop();
-        playbackEngine_->RemoveRenderer(currentRender);
+        StopPlayBackEngineIfIdle(streamIndex, false);
+        if (playbackEngine_) {
+            playbackEngine_->RemoveRenderer(currentRender);
+        }
+        SwitchPlaybackEngine(rendererStreamMap_.size());
     }
     if (currentRender->Release() < 0) {
         AUDIO_WARNING_LOG("Release stream %{public}d failed", streamIndex);
@@ -148,8 +149,53 @@ int32_t ProAudioStreamManager::ReleaseRender(uint32_t streamIndex)
     return SUCCESS;
 }
 
+// call with streamMapMutex_ hold
+void ProAudioStreamManager::StopPlayBackEngineIfIdle(uint32_t streamIndex, bool isPause)
+{
+    runningStreams_.erase(streamIndex);
+    if (playbackEngine_ == nullptr || !runningStreams_.empty()) {
+        return;
+    }
+    if (isPause) {
+        playbackEngine_->Pause();
+    } else {
+        playbackEngine_->Stop();
+    }
+}
+
+// call with streamMapMutex_ hold. A lone direct stream keeps NoneMixEngine, which hands its data to the sink
+// bit-exact. ProMixEngine takes the direct streams over when a second one joins and hands back when one is left.
+void ProAudioStreamManager::SwitchPlaybackEngine(size_t streamCount)
+{
+    if (managerType_ != DIRECT_PLAYBACK) {
+        return;
+    }
+    PlaybackType type = streamCount > 1 ? PlaybackType::DIRECT_MIX : PlaybackType::DIRECT;
+    if (type == playbackType_) {
+        return;
+    }
+    AUDIO_INFO_LOG("switch playback engine to %{public}d for %{public}zu streams", static_cast<int32_t>(type),
+        streamCount);
+    if (playbackEngine_) {
+        for (const auto &item : rendererStreamMap_) {
+            playbackEngine_->RemoveRenderer(item.second);
+        }
+    }
+    playbackEngine_ = nullptr; // the old engine releases the sink before the new one opens it
+    playbackEngine_ = AudioEngineManager::CreatePlaybackEngine(type);
+    playbackType_ = type;
+    for (const auto &item : rendererStreamMap_) {
+        int32_t ret = CreatePlayBackEngine(item.second);
+        CHECK_AND_CONTINUE_LOG(ret == SUCCESS, "attach stream %{public}d failed:%{public}d", item.first, ret);
+    }
+    if (playbackEngine_ && !runningStreams_.empty()) {
+        playbackEngine_->Start();
+    }
+}
+
 int32_t ProAudioStreamManager::TriggerStartIfNecessary()
 {
+    std::lock_guard<std::mutex> lock(streamMapMutex_);
     if (playbackEngine_ && !playbackEngine_->IsPlaybackEngineRunning()) {
         AUDIO_INFO_LOG("trigger re-start thread");
         playbackEngine_->Start();
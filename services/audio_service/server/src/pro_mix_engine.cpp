@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "ProMixEngine"
+#endif
+
+#include "pro_mix_engine.h"
+
+#include <algorithm>
+
+#include "audio_errors.h"
+#include "audio_mix_kernel.h"
+#include "audio_service_log.h"
+#include "audio_utils.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr int32_t PERIOD_NS = 20000000; // 20ms
+constexpr int32_t PERIOD_MS = 20; // 20ms, same with the span of ProRendererStreamImpl
+constexpr int32_t SECOND_TO_MILLISECOND = 1000;
+constexpr int32_t MAX_ERROR_COUNT = 50;
+constexpr size_t MAX_MIX_STREAM_COUNT = 8;
+constexpr uint32_t STEREO_CHANNEL_COUNT = 2;
+constexpr int16_t HDI_STEREO_CHANNEL_LAYOUT = 3;
+constexpr int16_t HDI_MONO_CHANNEL_LAYOUT = 4;
+constexpr int32_t DEFAULT_RESAMPLE_QUANTITY = 2;
+constexpr size_t RESAMPLE_FIFO_SPANS = 3; // less than one span carried, plus at most two resampled spans
+constexpr int32_t MAX_PEEK_PER_PERIOD = 2;
+constexpr int32_t VOLUME_UNITY = 1 << 16; // 1 << 16 = 65536, stream volume is applied by the stream itself
+const std::string THREAD_NAME = "proMixThread";
+const std::string DIRECT_SINK_NAME = "direct";
+const std::string VOIP_SINK_NAME = "voip";
+const char *SINK_ADAPTER_NAME = "primary";
+}
+
+static HdiAdapterFormat GetSinkFormat(AudioSampleFormat format)
+{
+    switch (format) {
+        case AudioSampleFormat::SAMPLE_S16LE:
+            return HdiAdapterFormat::SAMPLE_S16;
+        case AudioSampleFormat::SAMPLE_F32LE:
+            return HdiAdapterFormat::SAMPLE_F32;
+        default:
+            return HdiAdapterFormat::SAMPLE_S32;
+    }
+}
+
+static size_t GetSpanSizeInFrame(uint32_t sampleRate)
+{
+    return static_cast<size_t>(sampleRate) * PERIOD_MS / SECOND_TO_MILLISECOND;
+}
+
+ProMixEngine::ProMixEngine()
+    : DirectPlaybackEngine("ProMixEngine"),
+      isInit_(false),
+      sinkSpanSizeInFrame_(0)
+{
+    AUDIO_INFO_LOG("Constructor");
+}
+
+ProMixEngine::~ProMixEngine()
+{
+    writeCount_ = 0;
+    failedCount_ = 0;
+    fwkSyncTime_ = 0;
+    if (playbackThread_) {
+        playbackThread_->Stop();
+        playbackThread_ = nullptr;
+    }
+    if (renderSink_ && renderSink_->IsInited()) {
+        renderSink_->Stop();
+        renderSink_->DeInit();
+    }
+    isStart_ = false;
+    startFadein_ = false;
+    startFadeout_ = false;
+}
+
+int32_t ProMixEngine::Init(const DeviceInfo &type, bool isVoip)
+{
+    if (!isInit_) {
+        isVoip_ = isVoip;
+        device_ = type;
+        return SUCCESS;
+    }
+    if (type.deviceType != device_.deviceType || isVoip_ != isVoip) {
+        isVoip_ = isVoip;
+        device_ = type;
+        if (renderSink_ && renderSink_->IsInited()) {
+            renderSink_->Stop();
+            renderSink_->DeInit();
+        }
+        renderSink_ = nullptr;
+        isInit_ = false;
+    }
+    return SUCCESS;
+}
+
+int32_t ProMixEngine::Start()
+{
+    AUDIO_INFO_LOG("Enter in");
+    int32_t ret = SUCCESS;
+    CHECK_AND_RETURN_RET_LOG(renderSink_ != nullptr, ERR_INVALID_HANDLE, "null sink");
+    CHECK_AND_RETURN_RET_LOG(renderSink_->IsInited(), ERR_NOT_STARTED, "sink Not Inited! Init the sink first");
+    if (!playbackThread_) {
+        playbackThread_ = std::make_unique<AudioThreadTask>(THREAD_NAME);
+        playbackThread_->RegisterJob([this] { this->MixStreams(); });
+    }
+    if (!isStart_) {
+        {
+            std::lock_guard<std::mutex> lock(streamMutex_);
+            for (MixStream &mixStream : mixStreams_) {
+                mixStream.fifoFrames = 0; // no frames of the last run
+            }
+        }
+        fwkSyncTime_ = static_cast<uint64_t>(ClockTime::GetCurNano());
+        writeCount_ = 0;
+        failedCount_ = 0;
+        startFadeout_ = false;
+        startFadein_ = true;
+        ret = renderSink_->Start();
+        isStart_ = true;
+    }
+    if (!playbackThread_->CheckThreadIsRunning()) {
+        playbackThread_->Start();
+    }
+    return ret;
+}
+
+int32_t ProMixEngine::Flush()
+{
+    AUDIO_INFO_LOG("Enter");
+    return SUCCESS;
+}
+
+void ProMixEngine::DoFadeinOut(bool isFadeOut)
+{
+    uint32_t channels = sinkStreamInfo_.channels;
+    CHECK_AND_RETURN_LOG(channels > 0 && sinkSpanSizeInFrame_ > 0, "sink is not ready.");
+    float fadeStep = 1.0f / sinkSpanSizeInFrame_;
+    for (size_t i = 0; i < sinkSpanSizeInFrame_; i++) {
+        float fadeFactor = isFadeOut ? 1.0f - ((i + 1) * fadeStep) : (i + 1) * fadeStep;
+        for (uint32_t j = 0; j < channels; j++) {
+            mixBuffer_[i * channels + j] *= fadeFactor;
+        }
+    }
+    if (isFadeOut) {
+        startFadeout_.store(false);
+    } else {
+        startFadein_.store(false);
+    }
+}
+
+bool ProMixEngine::MixOneStream(MixStream &mixStream)
+{
+    if (mixStream.resample != nullptr) {
+        return MixResampledStream(mixStream);
+    }
+    int32_t index = -1;
+    mixStream.stream->Peek(&mixStream.peekBuffer, index);
+    if (index < 0) {
+        return false;
+    }
+    const AudioStreamInfo &info = mixStream.streamInfo;
+    size_t frameSize = AudioMixKernel::GetFormatByteSize(info.format) * info.channels;
+    bool isValid = mixStream.peekBuffer.size() >= sinkSpanSizeInFrame_ * frameSize;
+    MixSourceDesc src = { reinterpret_cast<const uint8_t *>(mixStream.peekBuffer.data()), info.format,
+        info.channels, VOLUME_UNITY, info.channelLayout };
+    isValid = isValid && AudioMixKernel::AccumulateToFloat(src, sinkStreamInfo_.channels,
+        sinkStreamInfo_.channelLayout, mixBuffer_.data(), sinkSpanSizeInFrame_) == SUCCESS;
+    mixStream.stream->ReturnIndex(index);
+    CHECK_AND_RETURN_RET_LOG(isValid, false, "mix stream failed, buffer size:%{public}zu",
+        mixStream.peekBuffer.size());
+    appsUid_.push_back(mixStream.stream->GetAudioProcessConfig().appInfo.appUid);
+    return true;
+}
+
+// Peek one span of the stream, resample it and append it to the fifo.
+bool ProMixEngine::ResampleOneSpan(MixStream &mixStream)
+{
+    int32_t index = -1;
+    mixStream.stream->Peek(&mixStream.peekBuffer, index);
+    if (index < 0) {
+        return false;
+    }
+    const AudioStreamInfo &info = mixStream.streamInfo;
+    size_t frameSize = AudioMixKernel::GetFormatByteSize(info.format) * info.channels;
+    size_t frameCount = GetSpanSizeInFrame(info.samplingRate);
+    bool isValid = mixStream.peekBuffer.size() >= frameCount * frameSize;
+    if (isValid) {
+        MixSourceDesc src = { reinterpret_cast<const uint8_t *>(mixStream.peekBuffer.data()), info.format,
+            info.channels, VOLUME_UNITY, info.channelLayout };
+        std::fill(mixStream.floatBuffer.begin(), mixStream.floatBuffer.end(), 0.0f);
+        AudioMixKernel::AccumulateToFloat(src, info.channels, info.channelLayout, mixStream.floatBuffer.data(),
+            frameCount);
+        uint32_t inFrames = static_cast<uint32_t>(frameCount);
+        size_t freeFrames = mixStream.resampleFifo.size() / info.channels - mixStream.fifoFrames;
+        uint32_t outFrames = static_cast<uint32_t>(freeFrames);
+        int32_t ret = mixStream.resample->ProcessFloatResample(mixStream.floatBuffer.data(), inFrames,
+            mixStream.resampleFifo.data() + mixStream.fifoFrames * info.channels, outFrames);
+        isValid = ret == SUCCESS && outFrames <= freeFrames;
+        mixStream.fifoFrames += isValid ? outFrames : 0;
+    }
+    mixStream.stream->ReturnIndex(index);
+    CHECK_AND_RETURN_RET_LOG(isValid, false, "resample stream failed, buffer size:%{public}zu",
+        mixStream.peekBuffer.size());
+    return true;
+}
+
+// The resampler hands out about a span per span in, minus its delay at the start. Its frames go through a fifo so
+// that every period gets a full span, the frames over it are mixed in the next period. A stream short of a span is
+// peeked once more, which happens while the resampler fills its delay line.
+bool ProMixEngine::MixResampledStream(MixStream &mixStream)
+{
+    bool isPeeked = false;
+    for (int32_t i = 0; i < MAX_PEEK_PER_PERIOD && mixStream.fifoFrames < sinkSpanSizeInFrame_; i++) {
+        if (!ResampleOneSpan(mixStream)) {
+            break;
+        }
+        isPeeked = true;
+    }
+    // a stream that underruns has its last frames mixed and then is silent
+    size_t mixFrames = std::min(mixStream.fifoFrames, sinkSpanSizeInFrame_);
+    if (mixFrames == 0) {
+        return false;
+    }
+    const AudioStreamInfo &info = mixStream.streamInfo;
+    MixSourceDesc resampled = { reinterpret_cast<const uint8_t *>(mixStream.resampleFifo.data()), SAMPLE_F32LE,
+        info.channels, VOLUME_UNITY, info.channelLayout };
+    bool isValid = AudioMixKernel::AccumulateToFloat(resampled, sinkStreamInfo_.channels,
+        sinkStreamInfo_.channelLayout, mixBuffer_.data(), mixFrames) == SUCCESS;
+    auto fifoBegin = mixStream.resampleFifo.begin();
+    std::copy(fifoBegin + mixFrames * info.channels, fifoBegin + mixStream.fifoFrames * info.channels, fifoBegin);
+    mixStream.fifoFrames -= mixFrames;
+    CHECK_AND_RETURN_RET_LOG(isValid, false, "mix resampled stream failed");
+    if (isPeeked) {
+        appsUid_.push_back(mixStream.stream->GetAudioProcessConfig().appInfo.appUid);
+    }
+    return true;
+}
+
+void ProMixEngine::MixStreams()
+{
+    if (failedCount_ >= MAX_ERROR_COUNT) {
+        AUDIO_WARNING_LOG("failed count is overflow.");
+        PauseAsync();
+        return;
+    }
+    size_t mixedCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        std::fill(mixBuffer_.begin(), mixBuffer_.end(), 0.0f);
+        appsUid_.clear();
+        for (MixStream &mixStream : mixStreams_) {
+            mixedCount += MixOneStream(mixStream) ? 1 : 0;
+        }
+    }
+    writeCount_++;
+    if (mixedCount == 0) {
+        failedCount_++;
+        if (startFadeout_) {
+            startFadeout_.store(false);
+            cvFading_.notify_all();
+            return;
+        }
+        ClockTime::RelativeSleep(PERIOD_NS);
+        return;
+    }
+    failedCount_ = 0;
+    if (startFadeout_ || startFadein_) {
+        DoFadeinOut(startFadeout_);
+        cvFading_.notify_all();
+    }
+    AudioMixKernel::FloatToFormat(mixBuffer_.data(), sinkStreamInfo_.format,
+        reinterpret_cast<uint8_t *>(renderBuffer_.data()), mixBuffer_.size());
+    uint64_t written = 0;
+    renderSink_->RenderFrame(*renderBuffer_.data(), renderBuffer_.size(), written);
+    renderSink_->UpdateAppsUid(appsUid_);
+    StandbySleep();
+}
+
+AudioStreamInfo ProMixEngine::GetOutputStreamInfo(const AudioStreamInfo &streamInfo) const noexcept
+{
+    // Same with the sink buffers of ProRendererStreamImpl.
+    AudioStreamInfo result = streamInfo;
+    result.channels = streamInfo.channels >= STEREO_CHANNEL_COUNT ? STEREO : MONO;
+    if (isVoip_) {
+        result.samplingRate = streamInfo.samplingRate <= SAMPLE_RATE_16000 ? SAMPLE_RATE_16000 : SAMPLE_RATE_48000;
+        result.format = streamInfo.format == SAMPLE_S16LE ? SAMPLE_S16LE : SAMPLE_S32LE;
+        return result;
+    }
+    switch (streamInfo.samplingRate) {
+        case SAMPLE_RATE_44100:
+            result.samplingRate = SAMPLE_RATE_48000;
+            break;
+        case SAMPLE_RATE_88200:
+            result.samplingRate = SAMPLE_RATE_96000;
+            break;
+        case SAMPLE_RATE_176400:
+            result.samplingRate = SAMPLE_RATE_192000;
+            break;
+        default:
+            break;
+    }
+    result.format = SAMPLE_S32LE;
+    return result;
+}
+
+int32_t ProMixEngine::InitMixStream(const std::shared_ptr<IRendererStream> &stream, MixStream &mixStream)
+{
+    mixStream.stream = stream;
+    mixStream.streamInfo = GetOutputStreamInfo(stream->GetAudioProcessConfig().streamInfo);
+    const AudioStreamInfo &info = mixStream.streamInfo;
+    size_t frameCount = GetSpanSizeInFrame(info.samplingRate);
+    mixStream.peekBuffer.reserve(frameCount * info.channels * AudioMixKernel::GetFormatByteSize(info.format));
+    if (info.samplingRate == sinkStreamInfo_.samplingRate) {
+        return SUCCESS;
+    }
+    AUDIO_INFO_LOG("stream resample from %{public}d to %{public}d", info.samplingRate, sinkStreamInfo_.samplingRate);
+    mixStream.resample = std::make_shared<AudioResample>(info.channels, info.samplingRate,
+        sinkStreamInfo_.samplingRate, DEFAULT_RESAMPLE_QUANTITY);
+    CHECK_AND_RETURN_RET_LOG(mixStream.resample->IsResampleInit(), ERR_NOT_SUPPORTED, "resample not supported.");
+    mixStream.floatBuffer.resize(frameCount * info.channels, 0.0f);
+    mixStream.resampleFifo.resize(RESAMPLE_FIFO_SPANS * sinkSpanSizeInFrame_ * info.channels, 0.0f);
+    mixStream.fifoFrames = 0;
+    return SUCCESS;
+}
+
+int32_t ProMixEngine::AddRenderer(const std::shared_ptr<IRendererStream> &stream)
+{
+    AUDIO_INFO_LOG("Enter add");
+    CHECK_AND_RETURN_RET_LOG(stream != nullptr, ERR_INVALID_PARAM, "stream is null");
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    auto it = std::find_if(mixStreams_.begin(), mixStreams_.end(),
+        [&stream](const MixStream &mixStream) { return mixStream.stream == stream; });
+    if (it != mixStreams_.end()) {
+        return SUCCESS;
+    }
+    if (mixStreams_.empty()) {
+        int32_t result = InitSink(GetOutputStreamInfo(stream->GetAudioProcessConfig().streamInfo));
+        CHECK_AND_RETURN_RET_LOG(result == SUCCESS, result, "init sink failed:%{public}d", result);
+        isInit_ = true;
+    }
+    CHECK_AND_RETURN_RET_LOG(mixStreams_.size() < MAX_MIX_STREAM_COUNT, ERROR_UNSUPPORTED, "too many streams");
+    MixStream mixStream;
+    int32_t result = InitMixStream(stream, mixStream);
+    CHECK_AND_RETURN_RET_LOG(result == SUCCESS, result, "init mix stream failed:%{public}d", result);
+    mixStreams_.emplace_back(std::move(mixStream));
+    appsUid_.reserve(mixStreams_.size());
+    AudioPlaybackEngine::AddRenderer(stream);
+    AUDIO_INFO_LOG("stream count:%{public}zu", mixStreams_.size());
+    return SUCCESS;
+}
+
+void ProMixEngine::RemoveRenderer(const std::shared_ptr<IRendererStream> &stream)
+{
+    AUDIO_INFO_LOG("step in remove");
+    bool isEmpty = false;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        auto it = std::find_if(mixStreams_.begin(), mixStreams_.end(),
+            [&stream](const MixStream &mixStream) { return mixStream.stream == stream; });
+        if (it == mixStreams_.end()) {
+            AUDIO_INFO_LOG("stream already removed.");
+            return;
+        }
+        mixStreams_.erase(it);
+        AudioPlaybackEngine::RemoveRenderer(stream);
+        isEmpty = mixStreams_.empty();
+    }
+    if (isEmpty) {
+        Stop();
+    }
+}
+
+int32_t ProMixEngine::InitSink(const AudioStreamInfo &streamInfo)
+{
+    if (isInit_ && renderSink_ && renderSink_->IsInited()) {
+        if (sinkStreamInfo_.samplingRate == streamInfo.samplingRate && sinkStreamInfo_.format == streamInfo.format &&
+            sinkStreamInfo_.channels == streamInfo.channels) {
+            return SUCCESS;
+        }
+        renderSink_->Stop();
+        renderSink_->DeInit();
+    }
+    renderSink_ = AudioRendererSink::GetInstance(isVoip_ ? VOIP_SINK_NAME : DIRECT_SINK_NAME);
+    CHECK_AND_RETURN_RET_LOG(renderSink_ != nullptr, ERR_INVALID_HANDLE, "get sink failed");
+    IAudioSinkAttr attr = {};
+    attr.adapterName = SINK_ADAPTER_NAME;
+    attr.sampleRate = streamInfo.samplingRate;
+    attr.channel = streamInfo.channels;
+    attr.format = GetSinkFormat(streamInfo.format);
+    attr.channelLayout = streamInfo.channels >= STEREO_CHANNEL_COUNT ? HDI_STEREO_CHANNEL_LAYOUT :
+        HDI_MONO_CHANNEL_LAYOUT;
+    attr.deviceType = device_.deviceType;
+    attr.volume = 1.0f;
+    attr.openMicSpeaker = 1;
+    AUDIO_INFO_LOG("device:%{public}d,sample rate:%{public}d,format:%{public}d,channel:%{public}d",
+        attr.deviceType, attr.sampleRate, attr.format, attr.channel);
+    int32_t ret = renderSink_->Init(attr);
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "sink init failed:%{public}d", ret);
+    float volume = 1.0f;
+    ret = renderSink_->SetVolume(volume, volume);
+
+    sinkStreamInfo_ = streamInfo;
+    sinkSpanSizeInFrame_ = GetSpanSizeInFrame(streamInfo.samplingRate);
+    mixBuffer_.assign(sinkSpanSizeInFrame_ * streamInfo.channels, 0.0f);
+    renderBuffer_.assign(mixBuffer_.size() * AudioMixKernel::GetFormatByteSize(streamInfo.format), 0);
+    return ret;
+}
+} // namespace AudioStandard
+} // namespace OHOS
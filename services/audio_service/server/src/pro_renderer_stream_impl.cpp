@@ -23,6 +23,7 @@
 #include "securec.h"
 #include "policy_handler.h"
 #include "audio_common_converter.h"
+#include "audio_mix_kernel.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -38,6 +39,10 @@ constexpr int32_t STEREO_CHANNEL_COUNT = 2;
 constexpr int32_t DEFAULT_TOTAL_SPAN_COUNT = 4;
 constexpr int32_t DRAIN_WAIT_TIMEOUT_TIME = 100;
 constexpr int32_t FIRST_FRAME_TIMEOUT_TIME = 500;
+// Frames converted, down mixed and resampled together, 256 frames of 16 float channels is 16KB.
+constexpr uint32_t FLOAT_TILE_FRAMES = 256;
+// Extra resampler output room of one tile, speex may give a few frames more than the rate ratio.
+constexpr uint32_t RESAMPLE_TILE_MARGIN_FRAMES = 16;
 const std::string DUMP_DIRECT_STREAM_FILE = "dump_direct_audio_stream.pcm";
 
 ProRendererStreamImpl::ProRendererStreamImpl(AudioProcessConfig processConfig, bool isDirect)
@@ -57,6 +62,7 @@ ProRendererStreamImpl::ProRendererStreamImpl(AudioProcessConfig processConfig, b
       spanSizeInFrame_(0),
       totalBytesWritten_(0),
       minBufferSize_(0),
+      resampleCarrySamples_(0),
       powerVolumeFactor_(1.f),
       status_(I_STATUS_INVALID),
       resample_(nullptr),
@@ -128,7 +134,7 @@ int32_t ProRendererStreamImpl::InitParams()
     AUDIO_INFO_LOG("sampleSpec: channels: %{public}u, formats: %{public}d, rate: %{public}d", streamInfo.channels,
         streamInfo.format, streamInfo.samplingRate);
     InitBasicInfo(streamInfo);
-    size_t frameSize = spanSizeInFrame_ * streamInfo.channels;
+    size_t tileSize = FLOAT_TILE_FRAMES * streamInfo.channels;
     uint32_t desChannels = streamInfo.channels >= STEREO_CHANNEL_COUNT ? STEREO_CHANNEL_COUNT : 1;
     uint32_t desSpanSize = (desSamplingRate_ * DEFAULT_BUFFER_MILLISECOND) / SECOND_TO_MILLISECOND;
     if (streamInfo.samplingRate != desSamplingRate_) {
@@ -141,16 +147,23 @@ int32_t ProRendererStreamImpl::InitParams()
             AUDIO_ERR_LOG("resample not supported.");
             return ERR_INVALID_PARAM;
         }
-        resampleSrcBuffer.resize(frameSize, 0.f);
-        resampleDesBuffer.resize(desSpanSize * desChannels, 0.f);
-        resample_->ProcessFloatResample(resampleSrcBuffer, resampleDesBuffer);
+        uint32_t desTileFrames = FLOAT_TILE_FRAMES * desSamplingRate_ / streamInfo.samplingRate +
+            RESAMPLE_TILE_MARGIN_FRAMES;
+        resampleSrcBuffer.resize(tileSize, 0.f);
+        resampleDesBuffer.resize(desTileFrames * desChannels, 0.f);
+        resampleCarryBuffer_.resize(desTileFrames * desChannels, 0.f);
+        // Feed one span of silence, as the whole span resample did before.
+        for (size_t offset = 0; offset < spanSizeInFrame_; offset += FLOAT_TILE_FRAMES) {
+            uint32_t inFrames = std::min<size_t>(FLOAT_TILE_FRAMES, spanSizeInFrame_ - offset);
+            uint32_t outFrames = desTileFrames;
+            resample_->ProcessFloatResample(resampleSrcBuffer.data(), inFrames, resampleDesBuffer.data(), outFrames);
+        }
     }
     if (streamInfo.channels > STEREO_CHANNEL_COUNT) {
         Trace::Count("ProRendererStreamImpl::InitParams", streamInfo.channels);
         isNeedMcr_ = true;
         if (!isNeedResample_) {
-            resampleSrcBuffer.resize(frameSize, 0.f);
-            resampleDesBuffer.resize(desSpanSize * desChannels, 0.f);
+            resampleSrcBuffer.resize(tileSize, 0.f);
         }
         downMixer_ = std::make_unique<AudioDownMixStereo>();
         int32_t ret = downMixer_->InitMixer(streamInfo.channelLayout, streamInfo.channels);
@@ -226,6 +239,10 @@ int32_t ProRendererStreamImpl::Flush()
     for (auto &buffer : sinkBuffer_) {
         memset_s(buffer.data(), buffer.size(), 0, buffer.size());
     }
+    {
+        std::lock_guard lock(peekMutex);
+        resampleCarrySamples_ = 0;
+    }
     std::shared_ptr<IStatusCallback> statusCallback = statusCallback_.lock();
     if (statusCallback != nullptr) {
         statusCallback->OnStatusUpdate(OPERATION_FLUSHED);
@@ -404,22 +421,9 @@ int32_t ProRendererStreamImpl::EnqueueBuffer(const BufferDesc &bufferDesc)
     }
     std::lock_guard lock(peekMutex);
     float volume = GetStreamVolume();
-    if (isNeedMcr_ && !isNeedResample_) {
-        ConvertSrcToFloat(bufferDesc.buffer, bufferDesc.bufLength, volume);
-        downMixer_->Apply(spanSizeInFrame_, resampleSrcBuffer.data(), resampleDesBuffer.data());
-        ConvertFloatToDes(writeIndex);
-    } else if (isNeedMcr_ && isNeedResample_) {
-        ConvertSrcToFloat(bufferDesc.buffer, bufferDesc.bufLength, volume);
-        downMixer_->Apply(spanSizeInFrame_, resampleSrcBuffer.data(), resampleSrcBuffer.data());
-    }
-    if (isNeedResample_) {
-        if (!isNeedMcr_) {
-            ConvertSrcToFloat(bufferDesc.buffer, bufferDesc.bufLength, volume);
-        }
-        resample_->ProcessFloatResample(resampleSrcBuffer, resampleDesBuffer);
-        DumpFileUtil::WriteDumpFile(dumpFile_, resampleDesBuffer.data(), resampleDesBuffer.size() * sizeof(float));
-        ConvertFloatToDes(writeIndex);
-    } else if (!isNeedMcr_) {
+    if (isNeedMcr_ || isNeedResample_) {
+        ProcessFloatTiles(bufferDesc, volume, writeIndex);
+    } else {
         auto streamInfo = processConfig_.streamInfo;
         uint32_t samplePerFrame = GetSamplePerFrame(streamInfo.format);
         uint32_t frameLength = bufferDesc.bufLength / samplePerFrame;
@@ -632,44 +636,82 @@ void ProRendererStreamImpl::SetOffloadDisable()
     }
 }
 
-void ProRendererStreamImpl::ConvertSrcToFloat(uint8_t *buffer, size_t bufLength, float volume)
+// Convert with volume, down mix and resample FLOAT_TILE_FRAMES frames at a time, so that the float data stays in
+// cache between the stages, and write each tile straight into the sink slot.
+void ProRendererStreamImpl::ProcessFloatTiles(const BufferDesc &bufferDesc, float volume, int32_t writeIndex)
 {
-    auto streamInfo = processConfig_.streamInfo;
-    uint32_t samplePerFrame = GetSamplePerFrame(streamInfo.format);
-    if (streamInfo.format == AudioSampleFormat::SAMPLE_F32LE) {
-        if (volume >= 1.0f) {
-            auto error =
-                memcpy_s(resampleSrcBuffer.data(), resampleSrcBuffer.size() * samplePerFrame, buffer, bufLength);
-            if (error != EOK) {
-                AUDIO_ERR_LOG("copy failed");
-            }
-        } else {
-            float *tempBuffer = reinterpret_cast<float *>(buffer);
-            for (uint32_t i = 0; i < resampleSrcBuffer.size(); i++) {
-                resampleSrcBuffer[i] = volume * tempBuffer[i];
-            }
+    const AudioStreamInfo &streamInfo = processConfig_.streamInfo;
+    uint32_t desChannels = streamInfo.channels >= STEREO_CHANNEL_COUNT ? STEREO_CHANNEL_COUNT : 1;
+    size_t srcFrames = std::min(bufferDesc.bufLength / byteSizePerFrame_, spanSizeInFrame_);
+    size_t desSampleSize = GetSamplePerFrame(desFormat_);
+    uint8_t *slot = reinterpret_cast<uint8_t *>(sinkBuffer_[writeIndex].data());
+    size_t slotSamples = sinkBuffer_[writeIndex].size() / desSampleSize;
+    size_t writtenSamples = WriteResampleCarry(slot, slotSamples);
+    for (size_t offset = 0; offset < srcFrames; offset += FLOAT_TILE_FRAMES) {
+        uint32_t tileFrames = std::min<size_t>(FLOAT_TILE_FRAMES, srcFrames - offset);
+        float *tile = resampleSrcBuffer.data();
+        AudioMixKernel::ConvertToFloat(bufferDesc.buffer + offset * byteSizePerFrame_, streamInfo.format, volume,
+            tile, tileFrames * streamInfo.channels);
+        if (isNeedMcr_) {
+            downMixer_->Apply(tileFrames, tile, tile);
+        }
+        if (isNeedResample_) {
+            ResampleTile(tile, tileFrames, slot, slotSamples, writtenSamples);
+            continue;
+        }
+        size_t outSamples = std::min<size_t>(tileFrames * desChannels, slotSamples - writtenSamples);
+        AudioMixKernel::FloatToFormat(tile, desFormat_, slot + writtenSamples * desSampleSize, outSamples);
+        writtenSamples += outSamples;
+    }
+    if (writtenSamples < slotSamples) {
+        memset_s(slot + writtenSamples * desSampleSize, (slotSamples - writtenSamples) * desSampleSize, 0,
+            (slotSamples - writtenSamples) * desSampleSize);
+    }
+}
+
+// Feed the whole tile to the resampler. Output that does not fit in the slot is carried to the next buffer, so no
+// input is dropped when the resampler gives a few frames more than the rate ratio.
+void ProRendererStreamImpl::ResampleTile(const float *tile, uint32_t tileFrames, uint8_t *slot, size_t slotSamples,
+    size_t &writtenSamples)
+{
+    uint32_t desChannels = processConfig_.streamInfo.channels >= STEREO_CHANNEL_COUNT ? STEREO_CHANNEL_COUNT : 1;
+    size_t desSampleSize = GetSamplePerFrame(desFormat_);
+    while (tileFrames > 0) {
+        uint32_t inFrames = tileFrames;
+        uint32_t outFrames = resampleDesBuffer.size() / desChannels;
+        int32_t ret = resample_->ProcessFloatResample(tile, inFrames, resampleDesBuffer.data(), outFrames);
+        CHECK_AND_RETURN_LOG(ret == SUCCESS && inFrames <= tileFrames, "resample failed:%{public}d", ret);
+        CHECK_AND_RETURN_LOG(inFrames > 0 || outFrames > 0, "resample made no progress");
+        DumpFileUtil::WriteDumpFile(dumpFile_, resampleDesBuffer.data(), outFrames * desChannels * sizeof(float));
+        size_t outSamples = outFrames * desChannels;
+        size_t slotPart = std::min(outSamples, slotSamples - writtenSamples);
+        AudioMixKernel::FloatToFormat(resampleDesBuffer.data(), desFormat_, slot + writtenSamples * desSampleSize,
+            slotPart);
+        writtenSamples += slotPart;
+        size_t carryPart = std::min(outSamples - slotPart, resampleCarryBuffer_.size() - resampleCarrySamples_);
+        if (carryPart < outSamples - slotPart) {
+            AUDIO_WARNING_LOG("carry buffer full, drop %{public}zu samples", outSamples - slotPart - carryPart);
         }
-        return;
+        std::copy(resampleDesBuffer.begin() + slotPart, resampleDesBuffer.begin() + slotPart + carryPart,
+            resampleCarryBuffer_.begin() + resampleCarrySamples_);
+        resampleCarrySamples_ += carryPart;
+        tile += static_cast<size_t>(inFrames) * desChannels;
+        tileFrames -= inFrames;
     }
-
-    AUDIO_DEBUG_LOG("ConvertSrcToFloat resample buffer,samplePerFrame:%{public}d,size:%{public}zu", samplePerFrame,
-        resampleSrcBuffer.size());
-    AudioCommonConverter::ConvertBufferToFloat(buffer, samplePerFrame, resampleSrcBuffer, volume);
 }
 
-void ProRendererStreamImpl::ConvertFloatToDes(int32_t writeIndex)
+// Write the frames carried from the last buffer to the head of the slot, return the samples written.
+size_t ProRendererStreamImpl::WriteResampleCarry(uint8_t *slot, size_t slotSamples)
 {
-    uint32_t samplePerFrame = GetSamplePerFrame(desFormat_);
-    if (desFormat_ == AudioSampleFormat::SAMPLE_F32LE) {
-        auto error = memcpy_s(sinkBuffer_[writeIndex].data(), sinkBuffer_[writeIndex].size(), resampleDesBuffer.data(),
-            resampleDesBuffer.size() * samplePerFrame);
-        if (error != EOK) {
-            AUDIO_ERR_LOG("copy failed");
-        }
-        return;
+    size_t samples = std::min(resampleCarrySamples_, slotSamples);
+    if (samples == 0) {
+        return 0;
     }
-    AudioCommonConverter::ConvertFloatToAudioBuffer(resampleDesBuffer,
-        reinterpret_cast<uint8_t *>(sinkBuffer_[writeIndex].data()), samplePerFrame);
+    AudioMixKernel::FloatToFormat(resampleCarryBuffer_.data(), desFormat_, slot, samples);
+    std::copy(resampleCarryBuffer_.begin() + samples, resampleCarryBuffer_.begin() + resampleCarrySamples_,
+        resampleCarryBuffer_.begin());
+    resampleCarrySamples_ -= samples;
+    return samples;
 }
 
 float ProRendererStreamImpl::GetStreamVolume()
@@ -47,6 +47,8 @@ namespace {
     static constexpr int32_t ONE_MINUTE = 60;
     const int32_t MEDIA_UID = 1013;
     const float AUDIO_VOLOMUE_EPSILON = 0.0001;
+    static const std::string ON_WRITE_DATA_TRACE_TAG = "RendererInServer::OnWriteData length ";
+    static const std::string DUP_WRITE_TRACE_TAG = "DupStream::OnWriteData length ";
 }
 
 RendererInServer::RendererInServer(AudioProcessConfig processConfig, std::weak_ptr<IStreamListener> streamListener)
@@ -161,6 +163,8 @@ int32_t RendererInServer::Init()
         "Construct rendererInServer failed: %{public}d", ret);
     streamIndex_ = stream_->GetStreamIndex();
     traceTag_ = "[" + std::to_string(streamIndex_) + "]RendererInServer"; // [100001]RendererInServer:
+    writeDataTraceTag_ = traceTag_ + " WriteData";
+    nearUnderrunTraceTag_ = traceTag_ + " near underrun";
     ret = ConfigServerBuffer();
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERR_OPERATION_FAILED,
         "Construct rendererInServer failed: %{public}d", ret);
@@ -235,6 +239,7 @@ void RendererInServer::OnStatusUpdate(IOperation operation)
                 stateListener->OnOperationHandled(DRAIN_STREAM, 0);
             }
             afterDrain = true;
+            audioServerBuffer_->RequestPositionUpdate();
             break;
         default:
             OnStatusUpdateSub(operation);
@@ -256,6 +261,7 @@ void RendererInServer::OnStatusUpdateSub(IOperation operation)
             if (audioServerBuffer_->GetAvailableDataFrames() == static_cast<int32_t>(4 * spanSizeInFrame_)) {
                 AUDIO_INFO_LOG("Buffer is empty");
                 needForceWrite_ = 0;
+                audioServerBuffer_->RequestPositionUpdate();
             } else {
                 AUDIO_INFO_LOG("Buffer is not empty");
                 WriteData();
@@ -436,9 +442,10 @@ int32_t RendererInServer::WriteData()
 {
     uint64_t currentReadFrame = audioServerBuffer_->GetCurReadFrame();
     uint64_t currentWriteFrame = audioServerBuffer_->GetCurWriteFrame();
-    Trace trace1(traceTag_ + " WriteData"); // RendererInServer::sessionid:100001 WriteData
+    Trace trace1(writeDataTraceTag_); // RendererInServer::sessionid:100001 WriteData
     if (currentReadFrame + spanSizeInFrame_ > currentWriteFrame) {
-        Trace trace2(traceTag_ + " near underrun"); // RendererInServer::sessionid:100001 near underrun
+        Trace trace2(nearUnderrunTraceTag_); // RendererInServer::sessionid:100001 near underrun
+        audioServerBuffer_->RequestPositionUpdate(); // get notified as soon as client writes more
         FutexTool::FutexWake(audioServerBuffer_->GetFutex());
         return ERR_OPERATION_FAILED;
     }
@@ -506,7 +513,7 @@ void RendererInServer::WriteEmptyData()
 
 int32_t RendererInServer::OnWriteData(size_t length)
 {
-    Trace trace("RendererInServer::OnWriteData length " + std::to_string(length));
+    Trace trace(ON_WRITE_DATA_TRACE_TAG, length);
     bool mayNeedForceWrite = false;
     if (writeLock_.try_lock()) {
         // length unit is bytes, using spanSizeInByte_
@@ -524,6 +531,7 @@ int32_t RendererInServer::OnWriteData(size_t length)
         AUDIO_DEBUG_LOG("Server need force write to recycle callback");
         needForceWrite_ =
             writableSize / spanSizeInByte_ > 3 ? 0 : 3 - writableSize / spanSizeInByte_; // 3 is maxlength - 1
+        audioServerBuffer_->RequestPositionUpdate();
     }
 
     uint64_t currentReadFrame = audioServerBuffer_->GetCurReadFrame();
@@ -556,6 +564,10 @@ int32_t RendererInServer::UpdateWriteIndex()
             writeLock_.unlock();
         }
     }
+    // client only calls this when requested, ask again while force write or drain is not done.
+    if (needForceWrite_ < 3 || afterDrain) { // 3 is maxlength - 1
+        audioServerBuffer_->RequestPositionUpdate();
+    }
     return SUCCESS;
 }
 
@@ -580,9 +592,11 @@ int32_t RendererInServer::Start()
     AUDIO_INFO_LOG("sessionId: %{public}u", streamIndex_);
     if (standByEnable_) {
         AUDIO_INFO_LOG("sessionId: %{public}u call to exit stand by!", streamIndex_);
+        audioServerBuffer_->RequestPositionUpdate();
         return IStreamManager::GetPlaybackManager(managerType_).StartRender(streamIndex_);
     }
     needForceWrite_ = 0;
+    audioServerBuffer_->RequestPositionUpdate();
     std::unique_lock<std::mutex> lock(statusLock_);
     if (status_ != I_STATUS_IDLE && status_ != I_STATUS_PAUSED && status_ != I_STATUS_STOPPED) {
         AUDIO_ERR_LOG("RendererInServer::Start failed, Illegal state: %{public}u", status_);
@@ -976,7 +990,7 @@ void StreamCallbacks::OnStatusUpdate(IOperation operation)
 
 int32_t StreamCallbacks::OnWriteData(size_t length)
 {
-    Trace trace("DupStream::OnWriteData length " + std::to_string(length));
+    Trace trace(DUP_WRITE_TRACE_TAG, length);
     return SUCCESS;
 }
 
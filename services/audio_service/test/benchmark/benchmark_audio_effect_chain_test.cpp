@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+#include <vector>
+#include "audio_effect.h"
+#include "audio_effect_chain_manager.h"
+#include "audio_effect_config_parser.h"
+#include "mock_effect_library.h"
+using namespace std;
+using namespace OHOS::AudioStandard;
+
+/**
+ * Streams audio through the effect chains of AudioEffectChainManager. The chains are read from an effect config
+ * file, /data/audio_effect_benchmark_config.xml or the one named by the AUDIO_EFFECT_BENCHMARK_CONFIG environment
+ * variable, parsed by the AudioEffectConfigParser of the policy and loaded the way the server loads
+ * audio_effect_config.xml at boot, with every library bound to the mock effect library so that it needs no vendor
+ * library. The manager runs a single chain instance, the one of
+ * COMMON_SCENE_TYPE on the speaker, so each chain of the config is a benchmark with that instance bound to it. The
+ * input is a sine, or the wav file named by the AUDIO_EFFECT_BENCHMARK_WAV environment variable (16 bit or float),
+ * looped.
+*/
+namespace {
+    const char *WAV_ENV = "AUDIO_EFFECT_BENCHMARK_WAV";
+    const char *CONFIG_ENV = "AUDIO_EFFECT_BENCHMARK_CONFIG";
+    const char *DEFAULT_CONFIG_PATH = "/data/audio_effect_benchmark_config.xml";
+    const string KEY_SEPARATOR = "_&_";
+    const string DEFAULT_MODE = "EFFECT_DEFAULT";
+    const string SPEAKER = "DEVICE_TYPE_SPEAKER";
+    const string SESSION_ID = "10000";
+    const uint32_t BENCHMARK_VOLUME = 50;
+    const int64_t SPAN_10MS = 10;
+    const int64_t SPAN_20MS = 20;
+    const int64_t SAMPLE_RATE_48K = 48000;
+    const int64_t SAMPLE_RATE_96K = 96000;
+    const double MS_PER_SECOND = 1000.0;
+    const double NS_PER_US = 1000.0;
+    const double TEST_FREQUENCY = 997.0;
+    const float TEST_AMPLITUDE = 0.5f;
+    const size_t MAX_LATENCY_SAMPLES = 1 << 16;
+    const double PERCENTILE_50 = 0.5;
+    const double PERCENTILE_99 = 0.99;
+    const struct {
+        uint32_t channels;
+        uint64_t channelLayout;
+    } CHANNEL_LAYOUTS[] = {
+        { STEREO, CH_LAYOUT_STEREO },
+        { CHANNEL_6, CH_LAYOUT_5POINT1 },
+        { CHANNEL_12, CH_LAYOUT_7POINT1POINT4 },
+    };
+
+    // What the server gets from the policy and from its effect libraries at boot.
+    struct BenchmarkEffectConfig {
+        vector<EffectChain> effectChains;
+        unordered_map<string, string> sceneTypeToChainName;
+        vector<shared_ptr<AudioEffectLibEntry>> libList;
+    };
+    BenchmarkEffectConfig g_config;
+
+    // Like AudioEffectServer, an effect is kept if its library says it can create it.
+    void LoadLibrariesAndEffects(const OriginalEffectConfig &originalConfig, BenchmarkEffectConfig &config)
+    {
+        for (const Library &library : originalConfig.libraries) {
+            auto libEntry = make_shared<AudioEffectLibEntry>();
+            libEntry->audioEffectLibHandle = GetMockEffectLibrary();
+            libEntry->libraryName = library.name;
+            config.libList.push_back(libEntry);
+        }
+        for (const Effect &effect : originalConfig.effects) {
+            AudioEffectDescriptor descriptor = { effect.libraryName, effect.name };
+            for (auto &libEntry : config.libList) {
+                if (libEntry->libraryName == descriptor.libraryName &&
+                    libEntry->audioEffectLibHandle->checkEffect(descriptor)) {
+                    libEntry->effectName.push_back(descriptor.effectName);
+                }
+            }
+        }
+    }
+
+    // Builds the scene_&_mode_&_device keys as AudioEffectManager does for the server.
+    void LoadSceneStreams(const PostProcessConfig &postProcess, BenchmarkEffectConfig &config)
+    {
+        for (const EffectSceneStream &stream : postProcess.effectSceneStreams) {
+            for (size_t i = 0; i < stream.mode.size() && i < stream.device.size(); i++) {
+                for (const Device &device : stream.device[i]) {
+                    string key = stream.stream + KEY_SEPARATOR + stream.mode[i] + KEY_SEPARATOR + device.type;
+                    config.sceneTypeToChainName.emplace(key, device.chain);
+                }
+            }
+        }
+    }
+
+    bool LoadBenchmarkEffectConfig(const char *path, BenchmarkEffectConfig &config)
+    {
+        OriginalEffectConfig originalConfig;
+        if (AudioEffectConfigParser().LoadEffectConfig(originalConfig, path) != 0) {
+            return false;
+        }
+        LoadLibrariesAndEffects(originalConfig, config);
+        config.effectChains = originalConfig.effectChains;
+        LoadSceneStreams(originalConfig.postProcess, config);
+        return !config.effectChains.empty();
+    }
+
+    // Reads a 16 bit pcm or 32 bit float wav as interleaved float.
+    bool ReadWav(const char *path, vector<float> &samples, uint32_t &channels)
+    {
+        const uint16_t formatPcm = 1;
+        const uint16_t formatFloat = 3;
+        const uint16_t bitsS16 = 16;
+        const uint16_t bitsF32 = 32;
+        const float s16Scale = 1.0f / 32768;
+        ifstream file(path, ios::binary);
+        char riff[12]; // 12:"RIFF" size "WAVE"
+        if (!file.read(riff, sizeof(riff)) || string(riff, 4) != "RIFF" || string(riff + 8, 4) != "WAVE") { // 8:WAVE
+            return false;
+        }
+        uint16_t format = 0;
+        uint16_t bits = 0;
+        channels = 0;
+        char id[4];
+        uint32_t size = 0;
+        while (file.read(id, sizeof(id)) && file.read(reinterpret_cast<char *>(&size), sizeof(size))) {
+            if (string(id, sizeof(id)) == "fmt ") {
+                vector<char> fmt(size);
+                file.read(fmt.data(), size);
+                format = *reinterpret_cast<uint16_t *>(fmt.data());
+                channels = *reinterpret_cast<uint16_t *>(fmt.data() + 2); // 2:channels offset
+                bits = *reinterpret_cast<uint16_t *>(fmt.data() + 14); // 14:bits per sample offset
+            } else if (string(id, sizeof(id)) == "data" && channels != 0) {
+                if (format == formatPcm && bits == bitsS16) {
+                    vector<int16_t> pcm(size / sizeof(int16_t));
+                    file.read(reinterpret_cast<char *>(pcm.data()), pcm.size() * sizeof(int16_t));
+                    for (int16_t sample : pcm) {
+                        samples.push_back(sample * s16Scale);
+                    }
+                } else if (format == formatFloat && bits == bitsF32) {
+                    samples.resize(size / sizeof(float));
+                    file.read(reinterpret_cast<char *>(samples.data()), samples.size() * sizeof(float));
+                }
+                return samples.size() >= channels;
+            } else {
+                file.seekg(size + (size & 1), ios::cur); // chunks are padded to even size
+            }
+        }
+        return false;
+    }
+
+    class EffectChainRunner {
+    public:
+        EffectChainRunner(const string &chainName, const benchmark::State &state)
+        {
+            sampleRate_ = static_cast<uint32_t>(state.range(1));
+            frameLen_ = static_cast<uint32_t>(sampleRate_ * state.range(0) / MS_PER_SECOND);
+            channels_ = CHANNEL_LAYOUTS[state.range(2)].channels; // 2:channel layout
+            LoadInput();
+            bufIn_.resize(frameLen_ * channels_);
+            bufOut_.resize(frameLen_ * channels_);
+            latencyNs_.reserve(MAX_LATENCY_SAMPLES);
+
+            // what the server does at boot and when the first stream of the scene starts
+            unordered_map<string, string> sceneTypeToChainName = g_config.sceneTypeToChainName;
+            sceneTypeToChainName[sceneType_ + KEY_SEPARATOR + DEFAULT_MODE + KEY_SEPARATOR + SPEAKER] = chainName;
+            AudioEffectChainManager *manager = AudioEffectChainManager::GetInstance();
+            manager->ResetInfo();
+            manager->InitAudioEffectChainManager(g_config.effectChains, sceneTypeToChainName, g_config.libList);
+            SessionEffectInfo info = { DEFAULT_MODE, sceneType_, channels_,
+                CHANNEL_LAYOUTS[state.range(2)].channelLayout, "0", BENCHMARK_VOLUME }; // 2:channel layout
+            manager->SessionInfoMapAdd(SESSION_ID, info);
+            manager->CreateAudioEffectChainDynamic(sceneType_);
+            manager->UpdateMultichannelConfig(sceneType_);
+            // the first block sends the queued config to the effects, keep it out of the timing
+            ApplyBlock();
+        }
+
+        ~EffectChainRunner()
+        {
+            AudioEffectChainManager *manager = AudioEffectChainManager::GetInstance();
+            manager->SessionInfoMapDelete(sceneType_, SESSION_ID);
+            manager->ReleaseAudioEffectChainDynamic(sceneType_);
+            manager->ResetInfo();
+        }
+
+        void Run(benchmark::State &state)
+        {
+            for (auto _ : state) {
+                int64_t costNs = ApplyBlock();
+                if (latencyNs_.size() < MAX_LATENCY_SAMPLES) {
+                    latencyNs_.push_back(costNs);
+                }
+                benchmark::DoNotOptimize(bufOut_.data());
+            }
+            SetCounters(state);
+        }
+
+    private:
+        void LoadInput()
+        {
+            const char *wavPath = getenv(WAV_ENV);
+            vector<float> wav;
+            uint32_t wavChannels = 0;
+            if (wavPath != nullptr && ReadWav(wavPath, wav, wavChannels)) {
+                size_t wavFrames = wav.size() / wavChannels;
+                input_.resize(wavFrames * channels_);
+                for (size_t frame = 0; frame < wavFrames; frame++) {
+                    for (uint32_t ch = 0; ch < channels_; ch++) {
+                        input_[frame * channels_ + ch] = wav[frame * wavChannels + ch % wavChannels];
+                    }
+                }
+                return;
+            }
+            input_.resize(sampleRate_ * channels_); // one second
+            for (uint32_t frame = 0; frame < sampleRate_; frame++) {
+                float value = TEST_AMPLITUDE * sin(2 * M_PI * TEST_FREQUENCY * frame / sampleRate_);
+                fill_n(input_.begin() + frame * channels_, channels_, value);
+            }
+        }
+
+        // The chain uses bufIn as scratch, so it is refilled for every block.
+        int64_t ApplyBlock()
+        {
+            size_t blockSamples = bufIn_.size();
+            for (size_t i = 0; i < blockSamples; i++) {
+                bufIn_[i] = input_[(inputPos_ + i) % input_.size()];
+            }
+            inputPos_ = (inputPos_ + blockSamples) % input_.size();
+            EffectBufferAttr bufferAttr(bufIn_.data(), bufOut_.data(), static_cast<int>(channels_),
+                static_cast<int>(frameLen_));
+            auto start = chrono::steady_clock::now();
+            AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(sceneType_, bufferAttr);
+            return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        }
+
+        double GetPercentileUs(double percentile)
+        {
+            if (latencyNs_.empty()) {
+                return 0;
+            }
+            size_t index = min(latencyNs_.size() - 1, static_cast<size_t>(latencyNs_.size() * percentile));
+            nth_element(latencyNs_.begin(), latencyNs_.begin() + index, latencyNs_.end());
+            return latencyNs_[index] / NS_PER_US;
+        }
+
+        void SetCounters(benchmark::State &state)
+        {
+            state.SetItemsProcessed(state.iterations() * frameLen_);
+            // seconds of audio processed per second
+            state.counters["realtime_x"] = benchmark::Counter(static_cast<double>(state.iterations()) * frameLen_ /
+                sampleRate_, benchmark::Counter::kIsRate);
+            state.counters["p50_us"] = GetPercentileUs(PERCENTILE_50);
+            state.counters["p99_us"] = GetPercentileUs(PERCENTILE_99);
+            state.counters["max_us"] = latencyNs_.empty() ? 0 :
+                *max_element(latencyNs_.begin(), latencyNs_.end()) / NS_PER_US;
+            struct rusage usage = {};
+            getrusage(RUSAGE_SELF, &usage);
+            state.counters["max_rss_kb"] = usage.ru_maxrss;
+        }
+
+        string sceneType_ = COMMON_SCENE_TYPE;
+        uint32_t sampleRate_ = 0;
+        uint32_t frameLen_ = 0;
+        uint32_t channels_ = 0;
+        size_t inputPos_ = 0;
+        vector<float> input_;
+        vector<float> bufIn_;
+        vector<float> bufOut_;
+        vector<int64_t> latencyNs_;
+    };
+
+    void ApplyEffectChainTestCase(benchmark::State &state, const string &chainName)
+    {
+        EffectChainRunner runner(chainName, state);
+        runner.Run(state);
+    }
+
+    // {span in ms, sample rate, channel layout index}
+    void EffectChainArgs(benchmark::internal::Benchmark *bench)
+    {
+        for (int64_t span : { SPAN_10MS, SPAN_20MS }) {
+            for (int64_t rate : { SAMPLE_RATE_48K, SAMPLE_RATE_96K }) {
+                for (size_t layout = 0; layout < sizeof(CHANNEL_LAYOUTS) / sizeof(CHANNEL_LAYOUTS[0]); layout++) {
+                    bench->Args({span, rate, static_cast<int64_t>(layout)});
+                }
+            }
+        }
+    }
+}
+
+// Registers a benchmark for each chain of the effect config, then runs them.
+int main(int argc, char **argv)
+{
+    const char *configPath = getenv(CONFIG_ENV);
+    configPath = configPath == nullptr ? DEFAULT_CONFIG_PATH : configPath;
+    if (!LoadBenchmarkEffectConfig(configPath, g_config)) {
+        cerr << "could not load the effect config " << configPath << endl;
+        return 1;
+    }
+    for (const EffectChain &chain : g_config.effectChains) {
+        benchmark::RegisterBenchmark(("ApplyEffectChainTestCase/" + chain.name).c_str(), ApplyEffectChainTestCase,
+            chain.name)->Apply(EffectChainArgs)->Unit(benchmark::kMicrosecond);
+    }
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+#include "audio_mix_kernel.h"
+using namespace std;
+using namespace OHOS::AudioStandard;
+
+namespace {
+    const int32_t VOLUME_SHIFT_NUMBER = 16;
+    const int32_t MAX_STREAM_COUNT = 6; // same with AudioEndpoint::MAX_LINKED_PROCESS
+    const size_t SPAN_FRAMES_5MS = 240; // 5ms in 48k
+    const size_t SPAN_FRAMES_20MS = 960; // 20ms in 48k
+    const size_t STEREO_CHANNELS = 2;
+    const int32_t TEST_VOLUME = 45000;
+
+    // The per-sample loop used by AudioEndpointInner::ProcessData before the mix kernels.
+    void MixS16Legacy(const vector<vector<int16_t>> &srcs, size_t srcCount, int16_t *dstPtr, size_t dataLength)
+    {
+        for (size_t offset = 0; dataLength > 0; dataLength--) {
+            int32_t sum = 0;
+            for (size_t i = 0; i < srcCount; i++) {
+                int32_t vol = TEST_VOLUME;
+                const int16_t *srcPtr = srcs[i].data() + offset;
+                sum += (*srcPtr * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER;
+            }
+            offset++;
+            *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+        }
+    }
+
+    // The per-sample loop used by AudioEndpointInner::MixToDupStream before the mix kernels.
+    void AccumulateS16Legacy(const int16_t *srcPtr, int16_t *dstPtr, size_t dataLength)
+    {
+        for (size_t offset = 0; dataLength > 0; dataLength--) {
+            int32_t sum = *dstPtr;
+            sum += *(srcPtr + offset);
+            *dstPtr = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+            dstPtr++;
+            offset++;
+        }
+    }
+
+    class BenchmarkAudioMixKernelTest : public benchmark::Fixture {
+    public:
+        void SetUp(const ::benchmark::State &state) override
+        {
+            defaultIsa_ = AudioMixKernel::GetIsa();
+            sampleCount_ = static_cast<size_t>(state.range(1)) * STEREO_CHANNELS;
+            srcBuffers_.assign(MAX_STREAM_COUNT, vector<int16_t>(sampleCount_));
+            for (auto &buffer : srcBuffers_) {
+                for (auto &sample : buffer) {
+                    sample = static_cast<int16_t>(rand() % (INT16_MAX - INT16_MIN) + INT16_MIN);
+                }
+            }
+            dstBuffer_.assign(sampleCount_, 0);
+        }
+
+        void TearDown(const ::benchmark::State &state) override
+        {
+            AudioMixKernel::SetIsa(defaultIsa_);
+        }
+
+    protected:
+        bool PrepareIsa(benchmark::State &state, MixKernelIsa isa)
+        {
+            if (!AudioMixKernel::SetIsa(isa)) {
+                state.SkipWithError("isa is not supported on this device.");
+                return false;
+            }
+            state.SetLabel(AudioMixKernel::GetIsaName(isa));
+            return true;
+        }
+
+        void RunMix(benchmark::State &state, MixKernelIsa isa)
+        {
+            if (!PrepareIsa(state, isa)) {
+                return;
+            }
+            size_t streamCount = static_cast<size_t>(state.range(0));
+            vector<MixSourceS16> sources(streamCount);
+            for (size_t i = 0; i < streamCount; i++) {
+                sources[i] = { srcBuffers_[i].data(), TEST_VOLUME };
+            }
+            for (auto _ : state) {
+                AudioMixKernel::MixS16(sources.data(), streamCount, dstBuffer_.data(), sampleCount_);
+                benchmark::DoNotOptimize(dstBuffer_.data());
+            }
+            state.SetItemsProcessed(state.iterations() * sampleCount_ * streamCount);
+        }
+
+        void RunAccumulate(benchmark::State &state, MixKernelIsa isa)
+        {
+            if (!PrepareIsa(state, isa)) {
+                return;
+            }
+            for (auto _ : state) {
+                AudioMixKernel::AccumulateS16(srcBuffers_[0].data(), dstBuffer_.data(), sampleCount_);
+                benchmark::DoNotOptimize(dstBuffer_.data());
+            }
+            state.SetItemsProcessed(state.iterations() * sampleCount_);
+        }
+
+        MixKernelIsa defaultIsa_ = MIX_ISA_SCALAR;
+        size_t sampleCount_ = 0;
+        vector<vector<int16_t>> srcBuffers_;
+        vector<int16_t> dstBuffer_;
+    };
+
+    void MixArgs(benchmark::internal::Benchmark *bench)
+    {
+        for (int64_t streams = 1; streams <= MAX_STREAM_COUNT; streams++) {
+            bench->Args({streams, SPAN_FRAMES_5MS});
+            bench->Args({streams, SPAN_FRAMES_20MS});
+        }
+    }
+
+    void AccumulateArgs(benchmark::internal::Benchmark *bench)
+    {
+        bench->Args({1, SPAN_FRAMES_5MS});
+        bench->Args({1, SPAN_FRAMES_20MS});
+    }
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, MixS16LegacyTestCase)(benchmark::State &state)
+    {
+        size_t streamCount = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            MixS16Legacy(srcBuffers_, streamCount, dstBuffer_.data(), sampleCount_);
+            benchmark::DoNotOptimize(dstBuffer_.data());
+        }
+        state.SetItemsProcessed(state.iterations() * sampleCount_ * streamCount);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, MixS16LegacyTestCase)->Apply(MixArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, MixS16ScalarTestCase)(benchmark::State &state)
+    {
+        RunMix(state, MIX_ISA_SCALAR);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, MixS16ScalarTestCase)->Apply(MixArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, MixS16NeonTestCase)(benchmark::State &state)
+    {
+        RunMix(state, MIX_ISA_NEON);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, MixS16NeonTestCase)->Apply(MixArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, MixS16Sse41TestCase)(benchmark::State &state)
+    {
+        RunMix(state, MIX_ISA_SSE41);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, MixS16Sse41TestCase)->Apply(MixArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, MixS16Avx2TestCase)(benchmark::State &state)
+    {
+        RunMix(state, MIX_ISA_AVX2);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, MixS16Avx2TestCase)->Apply(MixArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, AccumulateS16LegacyTestCase)(benchmark::State &state)
+    {
+        for (auto _ : state) {
+            AccumulateS16Legacy(srcBuffers_[0].data(), dstBuffer_.data(), sampleCount_);
+            benchmark::DoNotOptimize(dstBuffer_.data());
+        }
+        state.SetItemsProcessed(state.iterations() * sampleCount_);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, AccumulateS16LegacyTestCase)->Apply(AccumulateArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioMixKernelTest, AccumulateS16DefaultTestCase)(benchmark::State &state)
+    {
+        RunAccumulate(state, AudioMixKernel::GetIsa());
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioMixKernelTest, AccumulateS16DefaultTestCase)->Apply(AccumulateArgs);
+}
+
+// Run the benchmark
+BENCHMARK_MAIN();
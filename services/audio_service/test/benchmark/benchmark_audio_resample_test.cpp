@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "audio_polyphase_resampler.h"
+#ifdef SPEEX_ENABLE
+#include <speex/speex_resampler.h>
+#endif
+using namespace std;
+using namespace OHOS::AudioStandard;
+
+namespace {
+    const uint32_t STEREO_CHANNELS = 2;
+    const int64_t SPAN_10MS = 10;
+    const int64_t SPAN_20MS = 20;
+    const double MS_PER_SECOND = 1000.0;
+    const double TEST_FREQUENCY = 997.0;
+    const float TEST_AMPLITUDE = 0.5f;
+    const uint32_t OUTPUT_MARGIN_FRAMES = 16;
+    const uint32_t TEST_RATES[][2] = {
+        { 44100, 48000 },
+        { 48000, 44100 },
+        { 48000, 96000 },
+        { 96000, 48000 },
+        { 48000, 192000 },
+        { 192000, 48000 },
+        { 16000, 48000 },
+        { 48000, 16000 },
+    };
+#ifdef SPEEX_ENABLE
+    // speex quality with about the same taps as each polyphase tier, see AudioResample::GetQuality.
+    const int32_t SPEEX_QUALITY[] = { 1, 2, 5 };
+#endif
+
+    class BenchmarkAudioResampleTest : public benchmark::Fixture {
+    public:
+        void SetUp(const ::benchmark::State &state) override
+        {
+            inRate_ = TEST_RATES[state.range(0)][0];
+            outRate_ = TEST_RATES[state.range(0)][1];
+            quality_ = static_cast<AudioResampleQuality>(state.range(1));
+            inFrames_ = static_cast<uint32_t>(inRate_ * state.range(2) / MS_PER_SECOND);
+            outCapacity_ = static_cast<uint32_t>(outRate_ * state.range(2) / MS_PER_SECOND) + OUTPUT_MARGIN_FRAMES;
+            input_.resize(inFrames_ * STEREO_CHANNELS);
+            for (uint32_t i = 0; i < inFrames_; i++) {
+                float value = TEST_AMPLITUDE * sin(2 * M_PI * TEST_FREQUENCY * i / inRate_);
+                input_[i * STEREO_CHANNELS] = value;
+                input_[i * STEREO_CHANNELS + 1] = value;
+            }
+            output_.resize(outCapacity_ * STEREO_CHANNELS);
+        }
+
+        void TearDown(const ::benchmark::State &state) override
+        {
+            input_.clear();
+            output_.clear();
+        }
+
+    protected:
+        void SetCounters(benchmark::State &state, double latencyFrames)
+        {
+            state.SetItemsProcessed(state.iterations() * inFrames_ * STEREO_CHANNELS);
+            state.counters["latency_ms"] = latencyFrames * MS_PER_SECOND / inRate_;
+        }
+
+        uint32_t inRate_ = 0;
+        uint32_t outRate_ = 0;
+        AudioResampleQuality quality_ = RESAMPLE_QUALITY_LOW;
+        uint32_t inFrames_ = 0;
+        uint32_t outCapacity_ = 0;
+        vector<float> input_;
+        vector<float> output_;
+    };
+
+    // {rate pair index, quality tier, span in ms}
+    void ResampleArgs(benchmark::internal::Benchmark *bench)
+    {
+        for (size_t rate = 0; rate < sizeof(TEST_RATES) / sizeof(TEST_RATES[0]); rate++) {
+            for (int64_t quality : { RESAMPLE_QUALITY_LOW, RESAMPLE_QUALITY_MEDIUM, RESAMPLE_QUALITY_HIGH }) {
+                bench->Args({static_cast<int64_t>(rate), quality, SPAN_10MS});
+                bench->Args({static_cast<int64_t>(rate), quality, SPAN_20MS});
+            }
+        }
+    }
+
+    BENCHMARK_DEFINE_F(BenchmarkAudioResampleTest, PolyphaseTestCase)(benchmark::State &state)
+    {
+        AudioPolyphaseResampler resampler(STEREO_CHANNELS, inRate_, outRate_, quality_);
+        for (auto _ : state) {
+            uint32_t inFrames = inFrames_;
+            uint32_t outFrames = outCapacity_;
+            resampler.Process(input_.data(), inFrames, output_.data(), outFrames);
+            benchmark::DoNotOptimize(output_.data());
+        }
+        SetCounters(state, resampler.GetLatencyFrames());
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioResampleTest, PolyphaseTestCase)->Apply(ResampleArgs);
+
+#ifdef SPEEX_ENABLE
+    BENCHMARK_DEFINE_F(BenchmarkAudioResampleTest, SpeexTestCase)(benchmark::State &state)
+    {
+        int32_t error = 0;
+        SpeexResamplerState *resampler = speex_resampler_init(STEREO_CHANNELS, inRate_, outRate_,
+            SPEEX_QUALITY[quality_], &error);
+        if (resampler == nullptr) {
+            state.SkipWithError("create speex resampler failed.");
+            return;
+        }
+        speex_resampler_skip_zeros(resampler);
+        for (auto _ : state) {
+            uint32_t inFrames = inFrames_;
+            uint32_t outFrames = outCapacity_;
+            speex_resampler_process_interleaved_float(resampler, input_.data(), &inFrames, output_.data(),
+                &outFrames);
+            benchmark::DoNotOptimize(output_.data());
+        }
+        SetCounters(state, speex_resampler_get_input_latency(resampler));
+        speex_resampler_destroy(resampler);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkAudioResampleTest, SpeexTestCase)->Apply(ResampleArgs);
+#endif
+}
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "volume_tools.h"
+using namespace std;
+using namespace OHOS::AudioStandard;
+
+namespace {
+    const int32_t VOLUME_SHIFT_NUMBER = 16;
+    const int32_t INT24_SHIFT = 8;
+    const uint32_t SHIFT_EIGHT = 8;
+    const uint32_t SHIFT_SIXTEEN = 16;
+    const uint32_t BYTE_INDEX_TWO = 2;
+    const size_t STEREO_CHANNELS = 2;
+    const int64_t SPAN_10MS = 10;
+    const int64_t SPAN_20MS = 20;
+    const int64_t MS_PER_SECOND = 1000;
+    const int64_t RAMP_MODE = 0;
+    const int64_t CONSTANT_MODE = 1;
+    const float TEST_VOLUME_START = 1.0f;
+    const float TEST_VOLUME_END = 0.3f;
+    const AudioSampleFormat TEST_FORMATS[] = { SAMPLE_S16LE, SAMPLE_S24LE, SAMPLE_S32LE, SAMPLE_F32LE };
+    const int64_t TEST_RATES[] = { SAMPLE_RATE_48000, SAMPLE_RATE_96000 };
+
+    size_t GetSampleBytes(AudioSampleFormat format)
+    {
+        switch (format) {
+            case SAMPLE_S16LE:
+                return 2; // size is 2
+            case SAMPLE_S24LE:
+                return 3; // size is 3
+            default:
+                return 4; // size is 4
+        }
+    }
+
+    // The per-sample ProcessOneFrame used by VolumeTools::Process before the format kernels, without U8.
+    void ProcessOneSampleLegacy(uint8_t *ptr, AudioSampleFormat format, int32_t vol)
+    {
+        int64_t temp = 0;
+        switch (format) {
+            case SAMPLE_S16LE: {
+                int16_t *raw16 = reinterpret_cast<int16_t *>(ptr);
+                temp = (*raw16 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER;
+                *raw16 = temp > INT16_MAX ? INT16_MAX : (temp < INT16_MIN ? INT16_MIN : temp);
+                break;
+            }
+            case SAMPLE_S24LE: {
+                uint32_t raw = (static_cast<uint32_t>(ptr[BYTE_INDEX_TWO]) << SHIFT_SIXTEEN) |
+                    (static_cast<uint32_t>(ptr[1]) << SHIFT_EIGHT) | static_cast<uint32_t>(ptr[0]);
+                temp = static_cast<int32_t>(raw << INT24_SHIFT) * static_cast<int64_t>(vol) >> VOLUME_SHIFT_NUMBER;
+                uint32_t out = static_cast<uint32_t>(temp) >> INT24_SHIFT;
+                ptr[BYTE_INDEX_TWO] = static_cast<uint8_t>(out >> SHIFT_SIXTEEN);
+                ptr[1] = static_cast<uint8_t>(out >> SHIFT_EIGHT);
+                ptr[0] = static_cast<uint8_t>(out);
+                break;
+            }
+            case SAMPLE_S32LE: {
+                int32_t *raw32 = reinterpret_cast<int32_t *>(ptr);
+                temp = (*raw32 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER;
+                *raw32 = temp > INT32_MAX ? INT32_MAX : (temp < INT32_MIN ? INT32_MIN : temp);
+                break;
+            }
+            default: {
+                float *rawFloat = reinterpret_cast<float *>(ptr);
+                *rawFloat = *rawFloat * (static_cast<float>(vol) / INT32_VOLUME_MAX);
+                break;
+            }
+        }
+    }
+
+    void ProcessLegacy(const BufferDesc &buffer, AudioSampleFormat format, const ChannelVolumes &vols)
+    {
+        size_t byteSizePerData = GetSampleBytes(format);
+        size_t byteSizePerFrame = byteSizePerData * vols.channel;
+        size_t frameSize = buffer.bufLength / byteSizePerFrame;
+        float volStep[CHANNEL_MAX] = {};
+        for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
+            volStep[channelIdx] = static_cast<float>(vols.volEnd[channelIdx] - vols.volStart[channelIdx]) /
+                (frameSize - 1);
+        }
+        for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
+            for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
+                int32_t vol = volStep[channelIdx] * frameIndex + vols.volStart[channelIdx];
+                vol = vol < 0 ? 0 : (vol > INT32_VOLUME_MAX ? INT32_VOLUME_MAX : vol);
+                uint8_t *samplePtr = buffer.buffer + frameIndex * byteSizePerFrame + channelIdx * byteSizePerData;
+                ProcessOneSampleLegacy(samplePtr, format, vol);
+            }
+        }
+    }
+
+    class BenchmarkVolumeToolsTest : public benchmark::Fixture {
+    public:
+        void SetUp(const ::benchmark::State &state) override
+        {
+            format_ = TEST_FORMATS[state.range(0)];
+            frameCount_ = static_cast<size_t>(state.range(1) * state.range(2) / MS_PER_SECOND);
+            buffer_.resize(frameCount_ * STEREO_CHANNELS * GetSampleBytes(format_));
+            for (auto &data : buffer_) {
+                data = static_cast<uint8_t>(rand());
+            }
+            if (format_ == SAMPLE_F32LE) {
+                float *samples = reinterpret_cast<float *>(buffer_.data());
+                for (size_t i = 0; i < frameCount_ * STEREO_CHANNELS; i++) {
+                    samples[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f; // 0.5f for [-0.5, 0.5]
+                }
+            }
+            source_ = buffer_;
+            desc_ = { buffer_.data(), buffer_.size(), buffer_.size() };
+            float volStart = state.range(3) == CONSTANT_MODE ? TEST_VOLUME_END : TEST_VOLUME_START;
+            vols_ = VolumeTools::GetChannelVolumes(STEREO, volStart, TEST_VOLUME_END);
+        }
+
+        void TearDown(const ::benchmark::State &state) override
+        {
+            buffer_.clear();
+            source_.clear();
+        }
+
+    protected:
+        // Volume is applied in place, the span is copied in before each run so that the samples do not decay to
+        // denormals. The copy is the same for all process cases.
+        void ResetSpan()
+        {
+            memcpy(buffer_.data(), source_.data(), buffer_.size());
+        }
+
+        AudioSampleFormat format_ = SAMPLE_S16LE;
+        size_t frameCount_ = 0;
+        vector<uint8_t> buffer_;
+        vector<uint8_t> source_;
+        BufferDesc desc_ = { nullptr, 0, 0 };
+        ChannelVolumes vols_ = {};
+    };
+
+    // {format index, sample rate, span in ms, ramp or constant volume}
+    void ProcessArgs(benchmark::internal::Benchmark *bench)
+    {
+        for (size_t format = 0; format < sizeof(TEST_FORMATS) / sizeof(TEST_FORMATS[0]); format++) {
+            for (int64_t rate : TEST_RATES) {
+                for (int64_t mode : { RAMP_MODE, CONSTANT_MODE }) {
+                    bench->Args({static_cast<int64_t>(format), rate, SPAN_10MS, mode});
+                    bench->Args({static_cast<int64_t>(format), rate, SPAN_20MS, mode});
+                }
+            }
+        }
+    }
+
+    void CountArgs(benchmark::internal::Benchmark *bench)
+    {
+        for (size_t format = 0; format < sizeof(TEST_FORMATS) / sizeof(TEST_FORMATS[0]); format++) {
+            for (int64_t rate : TEST_RATES) {
+                bench->Args({static_cast<int64_t>(format), rate, SPAN_10MS, CONSTANT_MODE});
+                bench->Args({static_cast<int64_t>(format), rate, SPAN_20MS, CONSTANT_MODE});
+            }
+        }
+    }
+
+    BENCHMARK_DEFINE_F(BenchmarkVolumeToolsTest, ProcessLegacyTestCase)(benchmark::State &state)
+    {
+        for (auto _ : state) {
+            ResetSpan();
+            ProcessLegacy(desc_, format_, vols_);
+            benchmark::DoNotOptimize(buffer_.data());
+        }
+        state.SetItemsProcessed(state.iterations() * frameCount_ * STEREO_CHANNELS);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkVolumeToolsTest, ProcessLegacyTestCase)->Apply(ProcessArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkVolumeToolsTest, ProcessTestCase)(benchmark::State &state)
+    {
+        for (auto _ : state) {
+            ResetSpan();
+            VolumeTools::Process(desc_, format_, vols_);
+            benchmark::DoNotOptimize(buffer_.data());
+        }
+        state.SetItemsProcessed(state.iterations() * frameCount_ * STEREO_CHANNELS);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkVolumeToolsTest, ProcessTestCase)->Apply(ProcessArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkVolumeToolsTest, ProcessSmoothTestCase)(benchmark::State &state)
+    {
+        for (auto _ : state) {
+            ResetSpan();
+            VolumeTools::Process(desc_, format_, vols_, VOLUME_RAMP_SMOOTH);
+            benchmark::DoNotOptimize(buffer_.data());
+        }
+        state.SetItemsProcessed(state.iterations() * frameCount_ * STEREO_CHANNELS);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkVolumeToolsTest, ProcessSmoothTestCase)->Apply(ProcessArgs);
+
+    BENCHMARK_DEFINE_F(BenchmarkVolumeToolsTest, CountVolumeLevelTestCase)(benchmark::State &state)
+    {
+        for (auto _ : state) {
+            ChannelVolumes vols = VolumeTools::CountVolumeLevel(desc_, format_, STEREO);
+            benchmark::DoNotOptimize(vols);
+        }
+        state.SetItemsProcessed(state.iterations() * frameCount_ * STEREO_CHANNELS);
+    }
+    BENCHMARK_REGISTER_F(BenchmarkVolumeToolsTest, CountVolumeLevelTestCase)->Apply(CountArgs);
+}
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_MOCK_MEDIA_MONITOR_MANAGER_H
+#define BENCHMARK_MOCK_MEDIA_MONITOR_MANAGER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+enum ModuleId {
+    AUDIO,
+};
+
+enum EventId {
+    LOAD_CONFIG_ERROR,
+};
+
+enum EventType {
+    FAULT_EVENT,
+};
+
+enum ConfigCategory {
+    AUDIO_EFFECT_CONFIG,
+};
+
+class EventBean {
+public:
+    EventBean(ModuleId moduleId, EventId eventId, EventType eventType) {}
+
+    void Add(const std::string &key, int32_t value) {}
+};
+
+class MediaMonitorManager {
+public:
+    static MediaMonitorManager &GetInstance()
+    {
+        static MediaMonitorManager instance;
+        return instance;
+    }
+
+    void WriteAudioBuffer(const std::string &fileName, void *ptr, size_t size) {}
+    void WriteLogMsg(std::shared_ptr<EventBean> &bean) {}
+};
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
+#endif // BENCHMARK_MOCK_MEDIA_MONITOR_MANAGER_H
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_effect.h"
+#include "audio_effect_hdi_param.h"
+#include "audio_errors.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// There is no effect HDI on the host, so the chain manager keeps every chain on the arm side as with a device
+// without dsp effects.
+AudioEffectHdiParam::AudioEffectHdiParam() : replyLen_(0), hdiModel_(nullptr)
+{
+}
+
+AudioEffectHdiParam::~AudioEffectHdiParam()
+{
+}
+
+void AudioEffectHdiParam::InitHdi()
+{
+}
+
+int32_t AudioEffectHdiParam::UpdateHdiState(int8_t *effectHdiInput)
+{
+    return ERROR;
+}
+
+int32_t AudioEffectHdiParam::UpdateHdiState(int8_t *effectHdiInput, DeviceType deviceType)
+{
+    return ERROR;
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_utils.h"
+
+#include <chrono>
+
+namespace OHOS {
+namespace AudioStandard {
+// The part of audio_utils used by the effect chains, without the system parameters and dump files of the device.
+int64_t ClockTime::GetCurNano()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+bool GetSysPara(const char *key, T &value)
+{
+    return false;
+}
+template bool GetSysPara(const char *key, int32_t &value);
+template bool GetSysPara(const char *key, std::string &value);
+
+void DumpFileUtil::WriteDumpFile(FILE *dumpFile, void *buffer, size_t bufferSize)
+{
+}
+
+void DumpFileUtil::CloseDumpFile(FILE **dumpFile)
+{
+}
+
+void DumpFileUtil::OpenDumpFile(std::string para, std::string fileName, FILE **file)
+{
+    if (file != nullptr) {
+        *file = nullptr;
+    }
+}
+
+AudioDump &AudioDump::GetInstance()
+{
+    static AudioDump instance;
+    return instance;
+}
+
+std::string AudioDump::GetVersionType()
+{
+    return "";
+}
+} // namespace AudioStandard
+} // namespace OHOS
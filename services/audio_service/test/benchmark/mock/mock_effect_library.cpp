@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_effect_library.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const uint32_t MOCK_MAX_CHANNELS = 16;
+const uint32_t MOCK_DELAY_FRAMES = 1021;
+const float MOCK_GAIN = 0.9f;
+const float MOCK_FEEDBACK = 0.5f;
+// a low shelf biquad, b0 b1 b2 a1 a2
+const float MOCK_EQ_COEF[] = { 1.0207f, -1.9382f, 0.9211f, -1.9393f, 0.9407f };
+enum MockEffectKind {
+    MOCK_GAIN_EFFECT = 0,
+    MOCK_EQ_EFFECT,
+    MOCK_REVERB_EFFECT,
+    MOCK_EFFECT_KIND_NUM,
+};
+const char *MOCK_EFFECT_NAMES[MOCK_EFFECT_KIND_NUM] = { "mock_gain", "mock_eq", "mock_reverb" };
+
+struct MockEffect {
+    AudioEffectInterface *itf; // first, an AudioEffectHandle points to it
+    MockEffectKind kind;
+    AudioEffectConfig config;
+    float eqState[MOCK_MAX_CHANNELS][2];
+    std::vector<float> delay;
+    uint32_t delayPos;
+};
+
+bool GetMockEffectKind(const std::string &name, MockEffectKind &kind)
+{
+    for (uint32_t i = 0; i < MOCK_EFFECT_KIND_NUM; i++) {
+        if (name == MOCK_EFFECT_NAMES[i]) {
+            kind = static_cast<MockEffectKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+float MockProcessSample(MockEffect *effect, float sample, uint32_t channel)
+{
+    if (effect->kind == MOCK_GAIN_EFFECT) {
+        return sample * MOCK_GAIN;
+    }
+    if (effect->kind == MOCK_EQ_EFFECT) {
+        float *state = effect->eqState[channel];
+        float out = MOCK_EQ_COEF[0] * sample + state[0];
+        state[0] = MOCK_EQ_COEF[1] * sample - MOCK_EQ_COEF[3] * out + state[1];
+        state[1] = MOCK_EQ_COEF[2] * sample - MOCK_EQ_COEF[4] * out; // 2:b2 4:a2
+        return out;
+    }
+    float &delayed = effect->delay[effect->delayPos * MOCK_MAX_CHANNELS + channel];
+    float out = sample + delayed * MOCK_FEEDBACK;
+    delayed = out;
+    return out;
+}
+
+// Folds the input channels into the output ones, then runs the effect on each output channel.
+int32_t MockProcess(AudioEffectHandle self, AudioBuffer *inBuffer, AudioBuffer *outBuffer)
+{
+    MockEffect *effect = reinterpret_cast<MockEffect *>(self);
+    uint32_t inChannels = std::min(effect->config.inputCfg.channels, MOCK_MAX_CHANNELS);
+    uint32_t outChannels = std::min(effect->config.outputCfg.channels, MOCK_MAX_CHANNELS);
+    if (inChannels == 0 || outChannels == 0) {
+        return -1;
+    }
+    for (size_t frame = 0; frame < inBuffer->frameLength; frame++) {
+        const float *in = inBuffer->f32 + frame * inChannels;
+        float *out = outBuffer->f32 + frame * outChannels;
+        for (uint32_t oc = 0; oc < outChannels; oc++) {
+            float sum = 0.0f;
+            uint32_t folded = 0;
+            for (uint32_t ic = oc; ic < inChannels; ic += outChannels) {
+                sum += in[ic];
+                folded++;
+            }
+            float sample = folded == 0 ? in[oc % inChannels] : sum / folded;
+            out[oc] = MockProcessSample(effect, sample, oc);
+        }
+        effect->delayPos = (effect->delayPos + 1) % MOCK_DELAY_FRAMES;
+    }
+    return 0;
+}
+
+int32_t MockCommand(AudioEffectHandle self, uint32_t cmdCode, AudioEffectTransInfo *cmdInfo,
+    AudioEffectTransInfo *replyInfo)
+{
+    MockEffect *effect = reinterpret_cast<MockEffect *>(self);
+    if (cmdCode == EFFECT_CMD_SET_CONFIG) {
+        if (cmdInfo == nullptr || cmdInfo->data == nullptr || cmdInfo->size < sizeof(AudioEffectConfig)) {
+            return -1;
+        }
+        effect->config = *static_cast<AudioEffectConfig *>(cmdInfo->data);
+        if (effect->config.outputCfg.channels == 0) { // left to the effect, keep the channels
+            effect->config.outputCfg.channels = effect->config.inputCfg.channels;
+            effect->config.outputCfg.channelLayout = effect->config.inputCfg.channelLayout;
+        }
+        return 0;
+    }
+    if (cmdCode == EFFECT_CMD_GET_CONFIG) {
+        if (replyInfo == nullptr || replyInfo->data == nullptr || replyInfo->size < sizeof(AudioEffectConfig)) {
+            return -1;
+        }
+        *static_cast<AudioEffectConfig *>(replyInfo->data) = effect->config;
+        return 0;
+    }
+    if (replyInfo != nullptr && replyInfo->data != nullptr && replyInfo->size >= sizeof(int32_t)) {
+        *static_cast<int32_t *>(replyInfo->data) = 0; // no latency
+    }
+    return 0;
+}
+
+AudioEffectInterface g_mockInterface = { MockProcess, MockCommand };
+
+bool MockCheckEffect(const AudioEffectDescriptor descriptor)
+{
+    MockEffectKind kind = MOCK_GAIN_EFFECT;
+    return GetMockEffectKind(descriptor.effectName, kind);
+}
+
+int32_t MockCreateEffect(const AudioEffectDescriptor descriptor, AudioEffectHandle *handle)
+{
+    MockEffectKind kind = MOCK_GAIN_EFFECT;
+    if (handle == nullptr || !GetMockEffectKind(descriptor.effectName, kind)) {
+        return -1;
+    }
+    MockEffect *effect = new MockEffect();
+    effect->itf = &g_mockInterface;
+    effect->kind = kind;
+    effect->delay.resize(MOCK_DELAY_FRAMES * MOCK_MAX_CHANNELS);
+    *handle = reinterpret_cast<AudioEffectHandle>(effect);
+    return 0;
+}
+
+int32_t MockReleaseEffect(AudioEffectHandle handle)
+{
+    delete reinterpret_cast<MockEffect *>(handle);
+    return 0;
+}
+
+AudioEffectLibrary g_mockLibrary = {
+    0, "mock_effect_lib", "benchmark", MockCheckEffect, MockCreateEffect, MockReleaseEffect
+};
+} // namespace
+
+AudioEffectLibrary *GetMockEffectLibrary()
+{
+    return &g_mockLibrary;
+}
+} // namespace AudioStandard
+} // namespace OHOS
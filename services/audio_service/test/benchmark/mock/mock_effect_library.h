@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_MOCK_EFFECT_LIBRARY_H
+#define BENCHMARK_MOCK_EFFECT_LIBRARY_H
+
+#include "audio_effect.h"
+
+namespace OHOS {
+namespace AudioStandard {
+/**
+ * Effect library standing in for the vendor ones, it creates the effects mock_gain, mock_eq and mock_reverb, whose
+ * cost grows in that order. Every library of the benchmark config is bound to it.
+*/
+AudioEffectLibrary *GetMockEffectLibrary();
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // BENCHMARK_MOCK_EFFECT_LIBRARY_H
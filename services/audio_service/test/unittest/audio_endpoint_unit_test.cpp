@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include "audio_endpoint.h"
+#include "audio_errors.h"
+#include "audio_process_in_server.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+constexpr int32_t DEFAULT_APP_ID = 10;
+constexpr uint64_t DEFAULT_ENDPOINT_ID = 0;
+constexpr uint32_t SPAN_10_MS = 480; // 10ms at 48k
+constexpr uint32_t SPAN_5_MS = 240; // 5ms at 48k
+constexpr uint32_t SPAN_COUNT = 4;
+
+class TestProcessReleaseCallback : public ProcessReleaseCallback {
+public:
+    int32_t OnProcessRelease(IAudioProcessStream *process) override
+    {
+        return SUCCESS;
+    }
+};
+
+class AudioEndpointUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+protected:
+    static AudioProcessConfig InitProcessConfig(int32_t originalFlag);
+    sptr<AudioProcessInServer> CreateProcess(const AudioProcessConfig &config, uint32_t totalSizeInframe,
+        uint32_t spanSizeInframe);
+
+    DeviceInfo deviceInfo_;
+    std::shared_ptr<AudioEndpoint> endpoint_ = nullptr;
+    TestProcessReleaseCallback releaseCallback_;
+};
+
+void AudioEndpointUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void AudioEndpointUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void AudioEndpointUnitTest::SetUp(void)
+{
+    deviceInfo_.deviceId = 6; // 6 for test, as AudioService::GetDeviceInfoForProcess
+    deviceInfo_.networkId = LOCAL_NETWORK_ID;
+    deviceInfo_.deviceRole = OUTPUT_DEVICE;
+    deviceInfo_.deviceType = DEVICE_TYPE_SPEAKER;
+    deviceInfo_.audioStreamInfo = AudioStreamInfo {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, STEREO};
+    deviceInfo_.deviceName = "mmap_device";
+    endpoint_ = AudioEndpoint::CreateEndpoint(AudioEndpoint::TYPE_MMAP, DEFAULT_ENDPOINT_ID,
+        InitProcessConfig(AUDIO_FLAG_MMAP), deviceInfo_);
+}
+
+void AudioEndpointUnitTest::TearDown(void)
+{
+    if (endpoint_ != nullptr) {
+        endpoint_->Release();
+        endpoint_ = nullptr;
+    }
+}
+
+AudioProcessConfig AudioEndpointUnitTest::InitProcessConfig(int32_t originalFlag)
+{
+    AudioProcessConfig config;
+    config.appInfo.appUid = DEFAULT_APP_ID;
+    config.appInfo.appPid = DEFAULT_APP_ID;
+    config.streamInfo.format = SAMPLE_S16LE;
+    config.streamInfo.samplingRate = SAMPLE_RATE_48000;
+    config.streamInfo.channels = STEREO;
+    config.streamInfo.channelLayout = AudioChannelLayout::CH_LAYOUT_STEREO;
+    config.audioMode = AudioMode::AUDIO_MODE_PLAYBACK;
+    config.streamType = AudioStreamType::STREAM_MUSIC;
+    config.rendererInfo.originalFlag = originalFlag;
+    config.deviceType = DEVICE_TYPE_SPEAKER;
+    return config;
+}
+
+sptr<AudioProcessInServer> AudioEndpointUnitTest::CreateProcess(const AudioProcessConfig &config,
+    uint32_t totalSizeInframe, uint32_t spanSizeInframe)
+{
+    sptr<AudioProcessInServer> process = AudioProcessInServer::Create(config, &releaseCallback_);
+    if (process == nullptr ||
+        process->ConfigProcessBuffer(totalSizeInframe, spanSizeInframe, deviceInfo_.audioStreamInfo) != SUCCESS) {
+        return nullptr;
+    }
+    return process;
+}
+
+/**
+ * @tc.name  : Test AudioEndpoint NegotiateSpan
+ * @tc.type  : FUNC
+ * @tc.number: AudioEndpointNegotiateSpan_001
+ * @tc.desc  : Test the first process decides the span, the processes linked later share it.
+ */
+HWTEST_F(AudioEndpointUnitTest, AudioEndpointNegotiateSpan_001, TestSize.Level1)
+{
+    if (endpoint_ == nullptr) {
+        GTEST_SKIP() << "no fast device on this board";
+    }
+    uint32_t hdiTotalSizeInframe = 0;
+    uint32_t hdiSpanSizeInframe = 0;
+    AudioProcessConfig normalConfig = InitProcessConfig(AUDIO_FLAG_NORMAL);
+    EXPECT_EQ(SUCCESS, endpoint_->NegotiateSpan(normalConfig));
+    EXPECT_EQ(SUCCESS, endpoint_->GetPreferBufferInfo(hdiTotalSizeInframe, hdiSpanSizeInframe));
+
+    uint32_t totalSizeInframe = 0;
+    uint32_t spanSizeInframe = 0;
+    AudioProcessConfig fastConfig = InitProcessConfig(AUDIO_FLAG_MMAP);
+    EXPECT_EQ(SUCCESS, endpoint_->NegotiateSpan(fastConfig));
+    EXPECT_EQ(SUCCESS, endpoint_->GetPreferBufferInfo(totalSizeInframe, spanSizeInframe));
+    EXPECT_EQ(hdiTotalSizeInframe, totalSizeInframe);
+    ASSERT_NE(0, spanSizeInframe);
+    EXPECT_LE(spanSizeInframe, hdiSpanSizeInframe);
+    EXPECT_EQ(0, totalSizeInframe % spanSizeInframe);
+    EXPECT_GE(totalSizeInframe / spanSizeInframe, 2); // 2 spans at least
+
+    sptr<AudioProcessInServer> fastProcess = CreateProcess(fastConfig, totalSizeInframe, spanSizeInframe);
+    ASSERT_NE(nullptr, fastProcess);
+    EXPECT_EQ(SUCCESS, endpoint_->LinkProcessStream(fastProcess));
+
+    // a linked process keeps the span for the next ones, whatever they ask for
+    uint32_t sharedSpanSizeInframe = 0;
+    EXPECT_EQ(SUCCESS, endpoint_->NegotiateSpan(normalConfig));
+    EXPECT_EQ(SUCCESS, endpoint_->GetPreferBufferInfo(totalSizeInframe, sharedSpanSizeInframe));
+    EXPECT_EQ(spanSizeInframe, sharedSpanSizeInframe);
+    sptr<AudioProcessInServer> normalProcess = CreateProcess(normalConfig, totalSizeInframe, sharedSpanSizeInframe);
+    ASSERT_NE(nullptr, normalProcess);
+    EXPECT_EQ(SUCCESS, endpoint_->LinkProcessStream(normalProcess));
+
+    EXPECT_EQ(SUCCESS, endpoint_->UnlinkProcessStream(normalProcess));
+    EXPECT_EQ(SUCCESS, endpoint_->UnlinkProcessStream(fastProcess));
+    EXPECT_EQ(AudioEndpoint::UNLINKED, endpoint_->GetStatus());
+
+    // with no process linked the span follows the next one again
+    EXPECT_EQ(SUCCESS, endpoint_->NegotiateSpan(normalConfig));
+    EXPECT_EQ(SUCCESS, endpoint_->GetPreferBufferInfo(totalSizeInframe, spanSizeInframe));
+    EXPECT_EQ(hdiSpanSizeInframe, spanSizeInframe);
+}
+
+/**
+ * @tc.name  : Test AudioEndpoint LinkProcessStream
+ * @tc.type  : FUNC
+ * @tc.number: AudioEndpointLinkProcessStream_001
+ * @tc.desc  : Test a process whose buffer has another span than the endpoint is not linked while others are.
+ */
+HWTEST_F(AudioEndpointUnitTest, AudioEndpointLinkProcessStream_001, TestSize.Level1)
+{
+    if (endpoint_ == nullptr) {
+        GTEST_SKIP() << "no fast device on this board";
+    }
+    uint32_t totalSizeInframe = 0;
+    uint32_t spanSizeInframe = 0;
+    AudioProcessConfig fastConfig = InitProcessConfig(AUDIO_FLAG_MMAP);
+    EXPECT_EQ(SUCCESS, endpoint_->NegotiateSpan(fastConfig));
+    EXPECT_EQ(SUCCESS, endpoint_->GetPreferBufferInfo(totalSizeInframe, spanSizeInframe));
+    sptr<AudioProcessInServer> process = CreateProcess(fastConfig, totalSizeInframe, spanSizeInframe);
+    ASSERT_NE(nullptr, process);
+    EXPECT_EQ(SUCCESS, endpoint_->LinkProcessStream(process));
+
+    // as a process relinked after a reset of the endpoint, created with another span level
+    uint32_t otherSpanSizeInframe = spanSizeInframe == SPAN_10_MS ? SPAN_5_MS : SPAN_10_MS;
+    sptr<AudioProcessInServer> mismatched = CreateProcess(fastConfig, otherSpanSizeInframe * SPAN_COUNT,
+        otherSpanSizeInframe);
+    ASSERT_NE(nullptr, mismatched);
+    EXPECT_EQ(ERR_OPERATION_FAILED, endpoint_->LinkProcessStream(mismatched));
+
+    uint32_t currentSpanSizeInframe = 0;
+    EXPECT_EQ(SUCCESS, endpoint_->GetPreferBufferInfo(totalSizeInframe, currentSpanSizeInframe));
+    EXPECT_EQ(spanSizeInframe, currentSpanSizeInframe);
+    EXPECT_EQ(SUCCESS, endpoint_->UnlinkProcessStream(process));
+}
+} // namespace AudioStandard
+} // namespace OHOS
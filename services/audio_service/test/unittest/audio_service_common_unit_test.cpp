@@ -16,10 +16,20 @@
 #include "audio_errors.h"
 #include "audio_service_log.h"
 #include "audio_info.h"
+#include "audio_mix_kernel.h"
+#include "audio_polyphase_resampler.h"
 #include "audio_ring_cache.h"
+#include "audio_utils.h"
 #include "audio_process_config.h"
+#include "audio_wakeup_scheduler.h"
+#include "futex_tool.h"
 #include "linear_pos_time_model.h"
 #include "oh_audio_buffer.h"
+#include "volume_tools.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 using namespace testing::ext;
@@ -347,6 +357,30 @@ HWTEST(AudioServiceCommonUnitTest, OHAudioBuffer_008, TestSize.Level1)
     EXPECT_NE(nullptr, oHAudioBuffer);
 }
 
+/**
+* @tc.name  : Test OHAudioBuffer API
+* @tc.type  : FUNC
+* @tc.number: OHAudioBuffer_009
+* @tc.desc  : Test RequestPositionUpdate and TakePositionUpdateRequest.
+*/
+HWTEST(AudioServiceCommonUnitTest, OHAudioBuffer_009, TestSize.Level1)
+{
+    uint32_t totalSizeInFrame = 1920;
+    uint32_t spanSizeInFrame = 960;
+    uint32_t byteSizePerFrame = 4;
+    std::shared_ptr<OHAudioBuffer> buffer = OHAudioBuffer::CreateFromLocal(totalSizeInFrame, spanSizeInFrame,
+        byteSizePerFrame);
+    ASSERT_NE(nullptr, buffer);
+
+    EXPECT_EQ(true, buffer->TakePositionUpdateRequest()); // first write is always requested
+    EXPECT_EQ(false, buffer->TakePositionUpdateRequest());
+
+    buffer->RequestPositionUpdate();
+    buffer->RequestPositionUpdate();
+    EXPECT_EQ(true, buffer->TakePositionUpdateRequest());
+    EXPECT_EQ(false, buffer->TakePositionUpdateRequest());
+}
+
 /**
 * @tc.name  : Test AudioRingCache API
 * @tc.type  : FUNC
@@ -674,5 +708,676 @@ HWTEST(AudioServiceCommonUnitTest, AudioRingCache_008, TestSize.Level1)
         EXPECT_EQ(writeBuffer[index], readBuffer[index]);
     }
 }
+
+/**
+* @tc.name  : Test AudioSpscRingCache API
+* @tc.type  : FUNC
+* @tc.number: AudioSpscRingCache_001
+* @tc.desc  : Test cross spsc ring cache with Enqueue/Dequeue and Reserve/Commit.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioSpscRingCache_001, TestSize.Level1)
+{
+    size_t cacheSize = 480;
+    std::unique_ptr<AudioSpscRingCache> ringCache = AudioSpscRingCache::Create(cacheSize);
+    ASSERT_NE(nullptr, ringCache);
+
+    size_t tempSize = 19200;
+    std::vector<uint8_t> writeBuffer(tempSize);
+    std::vector<uint8_t> readBuffer(tempSize);
+    for (size_t index = 0; index < tempSize; index++) {
+        writeBuffer[index] = index % UINT8_MAX;
+    }
+
+    size_t spanSize = 320; // 480 * 2 /3
+    for (size_t offset = 0; offset < tempSize; offset += spanSize) {
+        OptResult result = ringCache->Enqueue({writeBuffer.data() + offset, spanSize});
+        EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+        EXPECT_EQ(ringCache->GetWritableSize().size, cacheSize - spanSize);
+        EXPECT_EQ(ringCache->Enqueue({writeBuffer.data(), spanSize}).ret, INDEX_OUT_OF_RANGE);
+
+        RingSpan span;
+        result = ringCache->ReserveRead(spanSize, span);
+        EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+        EXPECT_EQ(result.size, spanSize);
+        EXPECT_EQ(span.first.dataSize + span.second.dataSize, spanSize);
+        std::copy(span.first.dataPtr, span.first.dataPtr + span.first.dataSize, readBuffer.data() + offset);
+        if (span.second.dataSize > 0) {
+            std::copy(span.second.dataPtr, span.second.dataPtr + span.second.dataSize,
+                readBuffer.data() + offset + span.first.dataSize);
+        }
+        EXPECT_EQ(ringCache->CommitRead(spanSize).ret, OPERATION_SUCCESS);
+        EXPECT_EQ(ringCache->GetReadableSize().size, 0);
+    }
+    EXPECT_EQ(writeBuffer, readBuffer);
+    EXPECT_EQ(ringCache->CommitRead(1).ret, INVALID_OPERATION);
+}
+
+/**
+* @tc.name  : Test AudioSpscRingCache API
+* @tc.type  : FUNC
+* @tc.number: AudioSpscRingCache_002
+* @tc.desc  : Test spsc ring cache with one producer thread and one consumer thread.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioSpscRingCache_002, TestSize.Level1)
+{
+    size_t cacheSize = 1000;
+    std::unique_ptr<AudioSpscRingCache> ringCache = AudioSpscRingCache::Create(cacheSize);
+    ASSERT_NE(nullptr, ringCache);
+
+    size_t tempSize = 256 * 1024;
+    std::vector<uint8_t> writeBuffer(tempSize);
+    std::vector<uint8_t> readBuffer(tempSize);
+    for (size_t index = 0; index < tempSize; index++) {
+        writeBuffer[index] = (index * 7) % UINT8_MAX; // 7 for a pattern not aligned with the cache size
+    }
+
+    std::thread producer([&ringCache, &writeBuffer, tempSize] {
+        size_t offset = 0;
+        while (offset < tempSize) {
+            RingSpan span;
+            OptResult result = ringCache->ReserveWrite(std::min<size_t>(tempSize - offset, 333), span); // 333 bytes
+            std::copy(writeBuffer.data() + offset, writeBuffer.data() + offset + span.first.dataSize,
+                span.first.dataPtr);
+            std::copy(writeBuffer.data() + offset + span.first.dataSize, writeBuffer.data() + offset + result.size,
+                span.second.dataPtr);
+            ringCache->CommitWrite(result.size);
+            offset += result.size;
+        }
+    });
+
+    size_t offset = 0;
+    while (offset < tempSize) {
+        OptResult result = ringCache->GetReadableSize();
+        size_t readSize = std::min<size_t>(result.size, 256); // 256 bytes
+        if (readSize > 0) {
+            EXPECT_EQ(ringCache->Dequeue({readBuffer.data() + offset, readSize}).ret, OPERATION_SUCCESS);
+            offset += readSize;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(writeBuffer, readBuffer);
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_001
+* @tc.desc  : Test every supported isa mixes the same as the scalar kernel.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_001, TestSize.Level1)
+{
+    size_t sampleCount = 963; // not aligned with any vector width
+    size_t srcCount = 4;
+    std::vector<std::vector<int16_t>> srcBuffers(srcCount, std::vector<int16_t>(sampleCount));
+    std::vector<MixSourceS16> sources(srcCount);
+    for (size_t i = 0; i < srcCount; i++) {
+        for (size_t index = 0; index < sampleCount; index++) {
+            srcBuffers[i][index] = static_cast<int16_t>((index * 7919 + i * 104729) % UINT16_MAX + INT16_MIN);
+        }
+        sources[i] = { srcBuffers[i].data(), static_cast<int32_t>(16384 * (i + 1)) }; // 0.25, 0.5, 0.75, 1.0
+    }
+
+    MixKernelIsa defaultIsa = AudioMixKernel::GetIsa();
+    std::vector<int16_t> expect(sampleCount);
+    EXPECT_TRUE(AudioMixKernel::SetIsa(MIX_ISA_SCALAR));
+    AudioMixKernel::MixS16(sources.data(), srcCount, expect.data(), sampleCount);
+
+    MixKernelIsa isaList[] = { MIX_ISA_NEON, MIX_ISA_SSE41, MIX_ISA_AVX2 };
+    for (MixKernelIsa isa : isaList) {
+        if (!AudioMixKernel::SetIsa(isa)) {
+            continue;
+        }
+        std::vector<int16_t> result(sampleCount);
+        AudioMixKernel::MixS16(sources.data(), srcCount, result.data(), sampleCount);
+        EXPECT_EQ(expect, result);
+    }
+    AudioMixKernel::SetIsa(defaultIsa);
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_002
+* @tc.desc  : Test volume and accumulate kernels saturate to int16.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_002, TestSize.Level1)
+{
+    size_t sampleCount = 19;
+    std::vector<int16_t> src(sampleCount, INT16_MAX);
+    std::vector<int16_t> dst(sampleCount, INT16_MAX);
+    AudioMixKernel::AccumulateS16(src.data(), dst.data(), sampleCount);
+    for (size_t index = 0; index < sampleCount; index++) {
+        EXPECT_EQ(dst[index], INT16_MAX);
+    }
+
+    std::fill(src.begin(), src.end(), INT16_MIN);
+    AudioMixKernel::ApplyVolumeS16(src.data(), 1 << 15, dst.data(), sampleCount); // 1 << 15 for half volume
+    for (size_t index = 0; index < sampleCount; index++) {
+        EXPECT_EQ(dst[index], INT16_MIN / 2); // 2 for half volume
+    }
+
+    MixSourceS16 sources[] = { { src.data(), 1 << 16 }, { src.data(), 1 << 16 } }; // 1 << 16 for unity gain
+    AudioMixKernel::MixS16(sources, 2, dst.data(), sampleCount); // 2 sources
+    for (size_t index = 0; index < sampleCount; index++) {
+        EXPECT_EQ(dst[index], INT16_MIN);
+    }
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_003
+* @tc.desc  : Test format-generic mix of S16/S24/S32/F32 sources into float and back.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_003, TestSize.Level1)
+{
+    EXPECT_TRUE(AudioMixKernel::IsFormatSupported(SAMPLE_F32LE, CHANNEL_8));
+    EXPECT_FALSE(AudioMixKernel::IsFormatSupported(SAMPLE_U8, STEREO));
+    EXPECT_FALSE(AudioMixKernel::IsFormatSupported(SAMPLE_S16LE, CHANNEL_16));
+
+    size_t frameCount = 4;
+    int16_t s16[] = { 16384, 16384, 16384, 16384 }; // mono, 0.5
+    uint8_t s24[] = { 0x00, 0x00, 0xC0, 0x00, 0x00, 0xC0, 0x00, 0x00, 0xC0, 0x00, 0x00, 0xC0 }; // mono, -0.5
+    float f32[] = { 0.25f, -0.25f, 0.25f, -0.25f, 0.25f, -0.25f, 0.25f, -0.25f }; // stereo
+    std::vector<float> acc(frameCount * STEREO, 0.0f);
+    MixSourceDesc sources[] = {
+        { reinterpret_cast<const uint8_t *>(s16), SAMPLE_S16LE, MONO, 1 << 16 }, // 1 << 16 for unity gain
+        { s24, SAMPLE_S24LE, MONO, 1 << 15 }, // 1 << 15 for half volume
+        { reinterpret_cast<const uint8_t *>(f32), SAMPLE_F32LE, STEREO, 1 << 16 },
+    };
+    for (const MixSourceDesc &src : sources) {
+        EXPECT_EQ(SUCCESS, AudioMixKernel::AccumulateToFloat(src, STEREO, CH_LAYOUT_STEREO, acc.data(), frameCount));
+    }
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        EXPECT_FLOAT_EQ(acc[frame * STEREO], 0.5f); // 0.5 - 0.25 + 0.25
+        EXPECT_FLOAT_EQ(acc[frame * STEREO + 1], 0.0f); // 0.5 - 0.25 - 0.25
+    }
+
+    std::vector<int32_t> s32(acc.size());
+    EXPECT_EQ(SUCCESS, AudioMixKernel::FloatToFormat(acc.data(), SAMPLE_S32LE, reinterpret_cast<uint8_t *>(s32.data()),
+        acc.size()));
+    EXPECT_EQ(s32[0], 1 << 30); // 0.5 in S32
+    EXPECT_EQ(s32[1], 0);
+
+    acc[0] = 2.0f; // out of range, clamp to max
+    EXPECT_EQ(SUCCESS, AudioMixKernel::FloatToFormat(acc.data(), SAMPLE_S32LE, reinterpret_cast<uint8_t *>(s32.data()),
+        acc.size()));
+    EXPECT_EQ(s32[0], INT32_MAX);
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_004
+* @tc.desc  : Test 5.1 source fold down to stereo and quad by speaker, center at -3dB to both sides and LFE dropped.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_004, TestSize.Level1)
+{
+    float frame[] = { 0.1f, 0.2f, 0.4f, 1.0f, 0.3f, 0.5f }; // FL FR FC LFE SL SR
+    float acc[STEREO] = {};
+    MixSourceDesc src = { reinterpret_cast<const uint8_t *>(frame), SAMPLE_F32LE, CHANNEL_6, 1 << 16 };
+    EXPECT_EQ(SUCCESS, AudioMixKernel::AccumulateToFloat(src, STEREO, CH_LAYOUT_STEREO, acc, 1));
+    const float foldGain = 0.70710678f; // -3dB
+    EXPECT_NEAR(acc[0], 0.1f + (0.4f + 0.3f) * foldGain, 1e-6);
+    EXPECT_NEAR(acc[1], 0.2f + (0.4f + 0.5f) * foldGain, 1e-6);
+
+    float quad[CHANNEL_4] = {}; // FL FR BL BR
+    EXPECT_EQ(SUCCESS, AudioMixKernel::AccumulateToFloat(src, CHANNEL_4, CH_LAYOUT_QUAD, quad, 1));
+    EXPECT_NEAR(quad[0], 0.1f + 0.4f * foldGain, 1e-6);
+    EXPECT_NEAR(quad[1], 0.2f + 0.4f * foldGain, 1e-6);
+    EXPECT_NEAR(quad[2], 0.3f, 1e-6); // SL to BL
+    EXPECT_NEAR(quad[3], 0.5f, 1e-6); // SR to BR
+
+    float out[STEREO] = {};
+    EXPECT_EQ(ERR_INVALID_PARAM, AudioMixKernel::AccumulateToFloat(src, CHANNEL_16, CH_LAYOUT_UNKNOWN, out, 1));
+    MixSourceDesc topSrc = { reinterpret_cast<const uint8_t *>(frame), SAMPLE_F32LE, CHANNEL_4, 1 << 16,
+        CH_LAYOUT_2POINT0POINT2 };
+    EXPECT_EQ(ERR_NOT_SUPPORTED, AudioMixKernel::AccumulateToFloat(topSrc, STEREO, CH_LAYOUT_STEREO, out, 1));
+    EXPECT_EQ(0.0f, out[0]);
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_005
+* @tc.desc  : Test every supported isa applies per-sample volumes the same as the scalar kernel.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_005, TestSize.Level1)
+{
+    size_t sampleCount = 963; // not aligned with any vector width
+    std::vector<int16_t> s16Buffer(sampleCount);
+    std::vector<float> f32Buffer(sampleCount);
+    std::vector<int32_t> vols(sampleCount);
+    for (size_t index = 0; index < sampleCount; index++) {
+        s16Buffer[index] = static_cast<int16_t>((index * 7919) % UINT16_MAX + INT16_MIN);
+        f32Buffer[index] = static_cast<float>(s16Buffer[index]) / INT16_MAX;
+        vols[index] = static_cast<int32_t>((index * 104729) % (INT32_VOLUME_MAX + 1));
+    }
+
+    MixKernelIsa defaultIsa = AudioMixKernel::GetIsa();
+    std::vector<int16_t> expectS16 = s16Buffer;
+    std::vector<float> expectF32 = f32Buffer;
+    EXPECT_TRUE(AudioMixKernel::SetIsa(MIX_ISA_SCALAR));
+    AudioMixKernel::ApplyVolumesS16(expectS16.data(), vols.data(), sampleCount);
+    AudioMixKernel::ApplyVolumesF32(expectF32.data(), vols.data(), sampleCount);
+
+    MixKernelIsa isaList[] = { MIX_ISA_NEON, MIX_ISA_SSE41, MIX_ISA_AVX2 };
+    for (MixKernelIsa isa : isaList) {
+        if (!AudioMixKernel::SetIsa(isa)) {
+            continue;
+        }
+        std::vector<int16_t> resultS16 = s16Buffer;
+        std::vector<float> resultF32 = f32Buffer;
+        AudioMixKernel::ApplyVolumesS16(resultS16.data(), vols.data(), sampleCount);
+        AudioMixKernel::ApplyVolumesF32(resultF32.data(), vols.data(), sampleCount);
+        EXPECT_EQ(expectS16, resultS16);
+        EXPECT_EQ(expectF32, resultF32);
+    }
+    AudioMixKernel::SetIsa(defaultIsa);
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_006
+* @tc.desc  : Test ConvertToFloat keeps the sign of every format and round trips with FloatToFormat.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_006, TestSize.Level1)
+{
+    float out[CHANNEL_16] = {};
+    uint8_t u8Buffer[] = { 0, 0x80, 0xc0 };
+    EXPECT_EQ(SUCCESS, AudioMixKernel::ConvertToFloat(u8Buffer, SAMPLE_U8, 1.0f, out, 3)); // 3 samples
+    EXPECT_EQ(-1.0f, out[0]);
+    EXPECT_EQ(0.0f, out[1]);
+    EXPECT_EQ(0.5f, out[2]);
+
+    // any channel count is fine, the samples are converted one by one
+    std::vector<int16_t> s16Buffer(CHANNEL_16, INT16_MIN);
+    s16Buffer[1] = -16384; // -0.5
+    EXPECT_EQ(SUCCESS, AudioMixKernel::ConvertToFloat(reinterpret_cast<const uint8_t *>(s16Buffer.data()),
+        SAMPLE_S16LE, 0.5f, out, CHANNEL_16));
+    EXPECT_EQ(-0.5f, out[0]);
+    EXPECT_EQ(-0.25f, out[1]);
+    EXPECT_EQ(-0.5f, out[CHANNEL_16 - 1]);
+
+    uint8_t s24Buffer[] = { 0x00, 0x00, 0xc0 }; // -0.5
+    EXPECT_EQ(SUCCESS, AudioMixKernel::ConvertToFloat(s24Buffer, SAMPLE_S24LE, 1.0f, out, 1));
+    EXPECT_EQ(-0.5f, out[0]);
+
+    int32_t s32Buffer[] = { INT32_MIN, 0x40000000 };
+    EXPECT_EQ(SUCCESS, AudioMixKernel::ConvertToFloat(reinterpret_cast<const uint8_t *>(s32Buffer), SAMPLE_S32LE,
+        1.0f, out, STEREO));
+    EXPECT_EQ(-1.0f, out[0]);
+    EXPECT_EQ(0.5f, out[1]);
+    int32_t s32Result[STEREO] = {};
+    EXPECT_EQ(SUCCESS, AudioMixKernel::FloatToFormat(out, SAMPLE_S32LE, reinterpret_cast<uint8_t *>(s32Result),
+        STEREO));
+    EXPECT_EQ(INT32_MIN, s32Result[0]);
+    EXPECT_EQ(0x40000000, s32Result[1]);
+
+    EXPECT_EQ(ERR_INVALID_PARAM, AudioMixKernel::ConvertToFloat(nullptr, SAMPLE_S16LE, 1.0f, out, 1));
+    EXPECT_EQ(ERR_NOT_SUPPORTED, AudioMixKernel::ConvertToFloat(u8Buffer, INVALID_WIDTH, 1.0f, out, 1));
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_007
+* @tc.desc  : Test every supported isa gives the same dot product as the scalar kernel.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_007, TestSize.Level1)
+{
+    size_t count = 67; // not aligned with any vector width
+    std::vector<float> a(count);
+    std::vector<float> b(count);
+    for (size_t index = 0; index < count; index++) {
+        a[index] = static_cast<float>((index * 7919) % 1000) / 1000 - 0.5f; // [-0.5, 0.5)
+        b[index] = static_cast<float>((index * 104729) % 1000) / 1000 - 0.5f; // [-0.5, 0.5)
+    }
+    MixKernelIsa defaultIsa = AudioMixKernel::GetIsa();
+    EXPECT_TRUE(AudioMixKernel::SetIsa(MIX_ISA_SCALAR));
+    float expect = AudioMixKernel::DotProductF32(a.data(), b.data(), count);
+    double reference = 0.0;
+    for (size_t index = 0; index < count; index++) {
+        reference += static_cast<double>(a[index]) * b[index];
+    }
+    EXPECT_NEAR(reference, expect, 1e-5);
+
+    MixKernelIsa isaList[] = { MIX_ISA_NEON, MIX_ISA_SSE41, MIX_ISA_AVX2 };
+    for (MixKernelIsa isa : isaList) {
+        if (!AudioMixKernel::SetIsa(isa)) {
+            continue;
+        }
+        EXPECT_EQ(expect, AudioMixKernel::DotProductF32(a.data(), b.data(), count));
+    }
+    AudioMixKernel::SetIsa(defaultIsa);
+    EXPECT_EQ(0.0f, AudioMixKernel::DotProductF32(nullptr, b.data(), count));
+}
+
+/**
+* @tc.name  : Test AudioMixKernel API
+* @tc.type  : FUNC
+* @tc.number: AudioMixKernel_008
+* @tc.desc  : Test a volume of -65536 on INT16_MIN saturates on every isa instead of overflowing int32.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioMixKernel_008, TestSize.Level1)
+{
+    size_t sampleCount = 35; // vector body and scalar tail
+    std::vector<int16_t> src(sampleCount, INT16_MIN);
+    MixSourceS16 sources[] = { { src.data(), -(1 << 16) } }; // -(1 << 16) for inverted unity gain
+
+    MixKernelIsa defaultIsa = AudioMixKernel::GetIsa();
+    MixKernelIsa isaList[] = { MIX_ISA_SCALAR, MIX_ISA_NEON, MIX_ISA_SSE41, MIX_ISA_AVX2 };
+    for (MixKernelIsa isa : isaList) {
+        if (!AudioMixKernel::SetIsa(isa)) {
+            continue;
+        }
+        std::vector<int16_t> dst(sampleCount, 0);
+        AudioMixKernel::MixS16(sources, 1, dst.data(), sampleCount);
+        for (size_t index = 0; index < sampleCount; index++) {
+            EXPECT_EQ(dst[index], INT16_MAX);
+        }
+        AudioMixKernel::ApplyVolumeS16(src.data(), -(1 << 16) + 1, dst.data(), sampleCount); // still vectorized
+        for (size_t index = 0; index < sampleCount; index++) {
+            EXPECT_EQ(dst[index], INT16_MAX);
+        }
+    }
+    AudioMixKernel::SetIsa(defaultIsa);
+}
+
+/**
+* @tc.name  : Test AudioPolyphaseResampler API
+* @tc.type  : FUNC
+* @tc.number: AudioPolyphaseResampler_001
+* @tc.desc  : Test a sine keeps its level through 44.1k->48k and 48k->16k, with any chunk size.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioPolyphaseResampler_001, TestSize.Level1)
+{
+    EXPECT_TRUE(AudioPolyphaseResampler::IsRateSupported(SAMPLE_RATE_44100, SAMPLE_RATE_48000));
+    EXPECT_TRUE(AudioPolyphaseResampler::IsRateSupported(SAMPLE_RATE_192000, SAMPLE_RATE_16000));
+    EXPECT_FALSE(AudioPolyphaseResampler::IsRateSupported(SAMPLE_RATE_48000, 47999)); // 47999 phases
+    EXPECT_FALSE(AudioPolyphaseResampler(STEREO, SAMPLE_RATE_48000, 47999, RESAMPLE_QUALITY_LOW).IsInit());
+
+    const uint32_t rates[][STEREO] = {
+        { SAMPLE_RATE_44100, SAMPLE_RATE_48000 },
+        { SAMPLE_RATE_48000, SAMPLE_RATE_16000 },
+    };
+    for (const auto &rate : rates) {
+        uint32_t inFrames = rate[0] / 10; // 100ms
+        std::vector<float> input(inFrames * STEREO);
+        for (uint32_t index = 0; index < inFrames; index++) {
+            float value = 0.5f * std::sin(2 * M_PI * 1000 * index / rate[0]); // 0.5 of 1kHz
+            input[index * STEREO] = value;
+            input[index * STEREO + 1] = -value;
+        }
+        AudioPolyphaseResampler whole(STEREO, rate[0], rate[1], RESAMPLE_QUALITY_HIGH);
+        ASSERT_TRUE(whole.IsInit());
+        uint32_t consumed = inFrames;
+        uint32_t capacity = rate[1] / 10 + 1; // 100ms and one more frame
+        uint32_t produced = capacity;
+        std::vector<float> expect(capacity * STEREO);
+        EXPECT_EQ(SUCCESS, whole.Process(input.data(), consumed, expect.data(), produced));
+        EXPECT_EQ(inFrames, consumed);
+        EXPECT_NEAR(static_cast<double>(inFrames - whole.GetLatencyFrames()) * rate[1] / rate[0], produced, 1);
+
+        float peak = 0.0f;
+        for (uint32_t index = produced / 2; index < produced; index++) { // 2 for the second half
+            peak = std::max(peak, expect[index * STEREO]);
+            EXPECT_EQ(expect[index * STEREO], -expect[index * STEREO + 1]);
+        }
+        EXPECT_NEAR(0.5f, peak, 0.01f);
+
+        // the same output when the input comes in odd chunks and the output room is small
+        AudioPolyphaseResampler chunked(STEREO, rate[0], rate[1], RESAMPLE_QUALITY_HIGH);
+        std::vector<float> result(capacity * STEREO);
+        uint32_t inOffset = 0;
+        uint32_t outOffset = 0;
+        uint32_t inCount = 0;
+        uint32_t outCount = 0;
+        do {
+            inCount = std::min(inFrames - inOffset, 37u); // 37 frames at most
+            outCount = std::min(capacity - outOffset, 29u); // 29 frames at most
+            EXPECT_EQ(SUCCESS, chunked.Process(input.data() + inOffset * STEREO, inCount,
+                result.data() + outOffset * STEREO, outCount));
+            inOffset += inCount;
+            outOffset += outCount;
+        } while (inCount > 0 || outCount > 0);
+        EXPECT_EQ(produced, outOffset);
+        EXPECT_EQ(expect, result); // both are zero after produced frames
+    }
+}
+
+/**
+* @tc.name  : Test VolumeTools API
+* @tc.type  : FUNC
+* @tc.number: VolumeTools_001
+* @tc.desc  : Test Process ramps every format from volStart to volEnd with linear and smooth curve.
+*/
+HWTEST(AudioServiceCommonUnitTest, VolumeTools_001, TestSize.Level1)
+{
+    size_t frameCount = 1025; // more than one volume block
+    std::vector<int16_t> s16Buffer(frameCount * STEREO, INT16_MAX);
+    BufferDesc s16Desc = { reinterpret_cast<uint8_t *>(s16Buffer.data()), s16Buffer.size() * sizeof(int16_t),
+        s16Buffer.size() * sizeof(int16_t) };
+    ChannelVolumes vols = VolumeTools::GetChannelVolumes(STEREO, 1.0f, 0.0f);
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(s16Desc, SAMPLE_S16LE, vols));
+    EXPECT_EQ(INT16_MAX, s16Buffer[0]);
+    EXPECT_EQ(0, s16Buffer[frameCount * STEREO - 1]);
+    size_t middle = frameCount / 2 * STEREO; // the ramp is at 0.5 in the middle frame
+    EXPECT_NEAR(INT16_MAX / 2, s16Buffer[middle], 1);
+    EXPECT_EQ(s16Buffer[middle], s16Buffer[middle + 1]);
+
+    std::vector<float> f32Buffer(frameCount, 1.0f);
+    BufferDesc f32Desc = { reinterpret_cast<uint8_t *>(f32Buffer.data()), f32Buffer.size() * sizeof(float),
+        f32Buffer.size() * sizeof(float) };
+    vols = VolumeTools::GetChannelVolumes(MONO, 0.0f, 1.0f);
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(f32Desc, SAMPLE_F32LE, vols, VOLUME_RAMP_SMOOTH));
+    EXPECT_EQ(0.0f, f32Buffer[0]);
+    EXPECT_EQ(1.0f, f32Buffer[frameCount - 1]);
+    EXPECT_NEAR(0.5f, f32Buffer[frameCount / 2], 0.001f); // smoothstep is 0.5 in the middle
+    EXPECT_LT(f32Buffer[frameCount / 4], 0.25f); // and slower than linear at the start
+
+    std::vector<int32_t> s32Buffer(frameCount * CHANNEL_6, INT32_MIN);
+    BufferDesc s32Desc = { reinterpret_cast<uint8_t *>(s32Buffer.data()), s32Buffer.size() * sizeof(int32_t),
+        s32Buffer.size() * sizeof(int32_t) };
+    vols = VolumeTools::GetChannelVolumes(CHANNEL_6, 1.0f, 1.0f);
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(s32Desc, SAMPLE_S32LE, vols));
+    EXPECT_EQ(std::vector<int32_t>(frameCount * CHANNEL_6, INT32_MIN), s32Buffer);
+    vols.volEnd[CHANNEL_6 - 1] = 0;
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(s32Desc, SAMPLE_S32LE, vols));
+    EXPECT_EQ(INT32_MIN, s32Buffer[frameCount * CHANNEL_6 - CHANNEL_6]);
+    EXPECT_EQ(0, s32Buffer[frameCount * CHANNEL_6 - 1]);
+}
+
+/**
+* @tc.name  : Test VolumeTools API
+* @tc.type  : FUNC
+* @tc.number: VolumeTools_002
+* @tc.desc  : Test CountVolumeLevel counts the average level of each channel.
+*/
+HWTEST(AudioServiceCommonUnitTest, VolumeTools_002, TestSize.Level1)
+{
+    size_t frameCount = 481; // not aligned with the lanes
+    AudioChannel channels[] = { MONO, STEREO, CHANNEL_3, CHANNEL_6, CHANNEL_7 };
+    for (AudioChannel channel : channels) {
+        std::vector<int16_t> buffer(frameCount * channel);
+        for (size_t frame = 0; frame < frameCount; frame++) {
+            for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+                int16_t level = static_cast<int16_t>(1000 * (channelIdx + 1)); // 1000 for each channel
+                buffer[frame * channel + channelIdx] = frame % 2 == 0 ? level : -level;
+            }
+        }
+        BufferDesc desc = { reinterpret_cast<uint8_t *>(buffer.data()), buffer.size() * sizeof(int16_t),
+            buffer.size() * sizeof(int16_t) };
+        ChannelVolumes vols = VolumeTools::CountVolumeLevel(desc, SAMPLE_S16LE, channel);
+        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+            EXPECT_EQ(static_cast<int32_t>(1000 * (channelIdx + 1)), vols.volStart[channelIdx]);
+        }
+    }
+}
+
+// A span of one format, every sample at the positive full scale of the format.
+static std::vector<uint8_t> MakeFullScaleSpan(AudioSampleFormat format, size_t sampleCount)
+{
+    std::vector<uint8_t> span;
+    for (size_t i = 0; i < sampleCount; i++) {
+        if (format == SAMPLE_U8) {
+            span.push_back(UINT8_MAX);
+        } else if (format == SAMPLE_S16LE) {
+            int16_t sample = INT16_MAX;
+            span.insert(span.end(), reinterpret_cast<uint8_t *>(&sample), reinterpret_cast<uint8_t *>(&sample + 1));
+        } else if (format == SAMPLE_S24LE) {
+            span.insert(span.end(), { 0xff, 0xff, 0x7f }); // 0x7fffff little endian
+        } else if (format == SAMPLE_S32LE) {
+            int32_t sample = INT32_MAX;
+            span.insert(span.end(), reinterpret_cast<uint8_t *>(&sample), reinterpret_cast<uint8_t *>(&sample + 1));
+        } else {
+            float sample = 1.0f;
+            span.insert(span.end(), reinterpret_cast<uint8_t *>(&sample), reinterpret_cast<uint8_t *>(&sample + 1));
+        }
+    }
+    return span;
+}
+
+// The sample at index, scaled to [-1, 1].
+static double ReadSample(const std::vector<uint8_t> &span, AudioSampleFormat format, size_t index)
+{
+    const double u8Scale = 128.0;
+    const double s16Scale = 32768.0;
+    const double s24Scale = 8388608.0;
+    const double s32Scale = 2147483648.0;
+    switch (format) {
+        case SAMPLE_U8:
+            return (span[index] - u8Scale) / u8Scale;
+        case SAMPLE_S16LE:
+            return reinterpret_cast<const int16_t *>(span.data())[index] / s16Scale;
+        case SAMPLE_S24LE: {
+            const uint8_t *p = span.data() + index * 3; // 3 bytes per sample
+            int32_t sample = static_cast<int32_t>((p[2] << 24) | (p[1] << 16) | (p[0] << 8)) >> 8; // sign extend
+            return sample / s24Scale;
+        }
+        case SAMPLE_S32LE:
+            return reinterpret_cast<const int32_t *>(span.data())[index] / s32Scale;
+        default:
+            return reinterpret_cast<const float *>(span.data())[index];
+    }
+}
+
+/**
+* @tc.name  : Test VolumeTools API
+* @tc.type  : FUNC
+* @tc.number: VolumeTools_003
+* @tc.desc  : Test a client volume change ramps over one span with no step, for every format of the fast path.
+*/
+HWTEST(AudioServiceCommonUnitTest, VolumeTools_003, TestSize.Level1)
+{
+    const int32_t volumeMax = 1 << 16; // PROCESS_VOLUME_MAX of the client
+    const int32_t targetVolume = volumeMax / 4;
+    const double targetGain = 0.25;
+    const size_t frameCount = 480; // 10ms at 48k
+    AudioSampleFormat formats[] = { SAMPLE_U8, SAMPLE_S16LE, SAMPLE_S24LE, SAMPLE_S32LE, SAMPLE_F32LE };
+    for (AudioSampleFormat format : formats) {
+        // one quantization step of U8 is 1 / 128
+        const double tolerance = format == SAMPLE_U8 ? 2.0 / 128 : 0.001;
+        size_t sampleCount = frameCount * STEREO;
+        std::vector<uint8_t> steady = MakeFullScaleSpan(format, sampleCount);
+        std::vector<uint8_t> ramp = steady;
+        std::vector<uint8_t> target = steady;
+        // the spans before, during and after the change, as AudioProcessInClientInner::ApplyVolume sends them
+        std::pair<std::vector<uint8_t> *, ChannelVolumes> spans[] = {
+            { &steady, VolumeTools::GetChannelVolumes(STEREO, volumeMax, volumeMax) },
+            { &ramp, VolumeTools::GetChannelVolumes(STEREO, volumeMax, targetVolume) },
+            { &target, VolumeTools::GetChannelVolumes(STEREO, targetVolume, targetVolume) },
+        };
+        for (auto &[span, vols] : spans) {
+            BufferDesc desc = { span->data(), span->size(), span->size() };
+            EXPECT_EQ(SUCCESS, VolumeTools::Process(desc, format, vols));
+        }
+
+        double fullScale = ReadSample(MakeFullScaleSpan(format, 1), format, 0);
+        EXPECT_NEAR(fullScale, ReadSample(steady, format, sampleCount - 1), tolerance);
+        EXPECT_NEAR(ReadSample(steady, format, sampleCount - 1), ReadSample(ramp, format, 0), tolerance);
+        for (size_t i = STEREO; i < sampleCount; i++) {
+            EXPECT_LE(ReadSample(ramp, format, i), ReadSample(ramp, format, i - STEREO)) << "format " << format;
+        }
+        EXPECT_NEAR(fullScale * targetGain, ReadSample(ramp, format, sampleCount - 1), tolerance);
+        for (size_t i = 0; i < sampleCount; i++) {
+            EXPECT_NEAR(ReadSample(ramp, format, sampleCount - 1), ReadSample(target, format, i), tolerance);
+        }
+    }
+}
+
+/**
+* @tc.name  : Test AudioWakeupScheduler API
+* @tc.type  : FUNC
+* @tc.number: AudioWakeupScheduler_001
+* @tc.desc  : Test the margin shrinks on a quiet device, widens on a miss and stays in its range.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioWakeupScheduler_001, TestSize.Level1)
+{
+    const int64_t initMargin = 2000000; // 2ms
+    const int64_t minMargin = 500000; // 0.5ms
+    const int64_t maxMargin = 5000000; // 5ms
+    AudioWakeupScheduler scheduler;
+    EXPECT_FALSE(scheduler.Config(initMargin, maxMargin, minMargin));
+    EXPECT_TRUE(scheduler.Config(initMargin, minMargin, maxMargin));
+    EXPECT_EQ(initMargin, scheduler.GetMargin());
+
+    // quiet device, 0.6ms of demand: the margin goes down toward 0.75ms
+    const int64_t quietDemand = 600000;
+    const size_t windowNum = 30;
+    for (size_t i = 0; i < AudioWakeupScheduler::WINDOW_SIZE * windowNum; i++) {
+        scheduler.Record(quietDemand, false);
+    }
+    int64_t quietMargin = scheduler.GetMargin();
+    EXPECT_LT(quietMargin, initMargin);
+    EXPECT_GE(quietMargin, quietDemand + quietDemand / 4); // 4 for 25% headroom
+    EXPECT_EQ(0, scheduler.GetMissCount());
+
+    // a miss widens the margin at once
+    const int64_t busyDemand = 3000000;
+    EXPECT_FALSE(scheduler.Record(busyDemand, true));
+    EXPECT_GE(scheduler.GetMargin(), busyDemand);
+    EXPECT_EQ(1, scheduler.GetMissCount());
+    EXPECT_FLOAT_EQ(1.0f / scheduler.GetCycleCount(), scheduler.GetMissRate());
+
+    // a loaded device widens the margin at the end of the window, never above the max
+    size_t adaptCount = 0;
+    for (size_t i = 0; i < AudioWakeupScheduler::WINDOW_SIZE; i++) {
+        adaptCount += scheduler.Record(maxMargin * 2, false) ? 1 : 0;
+    }
+    EXPECT_EQ(1, adaptCount);
+    EXPECT_EQ(maxMargin, scheduler.GetMargin());
+
+    scheduler.Reset();
+    EXPECT_EQ(0, scheduler.GetCycleCount());
+    EXPECT_EQ(maxMargin, scheduler.GetMargin());
+}
+
+/**
+* @tc.name  : Test FutexTool API
+* @tc.type  : FUNC
+* @tc.number: FutexTool_001
+* @tc.desc  : Test FutexWaitUntil returns at the deadline, or before it when the futex is waked.
+*/
+HWTEST(AudioServiceCommonUnitTest, FutexTool_001, TestSize.Level1)
+{
+    const int64_t waitTime = 2000000; // 2ms
+    std::atomic<uint32_t> futex = IS_NOT_READY;
+    int64_t start = ClockTime::GetCurNano();
+    EXPECT_EQ(FUTEX_TIMEOUT, FutexTool::FutexWaitUntil(&futex, start + waitTime));
+    EXPECT_GE(ClockTime::GetCurNano(), start + waitTime);
+
+    std::thread waker([&futex] {
+        ClockTime::RelativeSleep(1000000); // 1ms
+        FutexTool::FutexWake(&futex);
+    });
+    EXPECT_EQ(FUTEX_SUCCESS, FutexTool::FutexWaitUntil(&futex, ClockTime::GetCurNano() + NANO_COUNT_PER_SECOND));
+    EXPECT_EQ(IS_READY, futex.load());
+    waker.join();
+
+    // not armed, returns at once
+    EXPECT_EQ(FUTEX_SUCCESS, FutexTool::FutexWaitUntil(&futex, ClockTime::GetCurNano() + NANO_COUNT_PER_SECOND));
+}
 } // namespace AudioStandard
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
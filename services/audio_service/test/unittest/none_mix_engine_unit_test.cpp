@@ -16,6 +16,8 @@
 #include "none_mix_engine.h"
 #include "pro_renderer_stream_impl.h"
 #include "audio_errors.h"
+#include "audio_mix_kernel.h"
+#include "audio_resample.h"
 
 using namespace testing::ext;
 namespace OHOS {
@@ -509,5 +511,66 @@ HWTEST_F(NoneMixEngineUnitTest, DirectAudioPlayBackEngineSetConfig_012, TestSize
     ret = rendererStream->Release();
     EXPECT_EQ(SUCCESS, ret);
 }
+
+/**
+ * @tc.name  : Test ProRendererStreamImpl resample
+ * @tc.type  : FUNC
+ * @tc.number: ProRendererStreamResample_001
+ * @tc.desc  : Test the tiled float path fills every sink buffer with the same frames as one resample of the whole
+ *             input, with no gap between the buffers.
+ */
+HWTEST_F(NoneMixEngineUnitTest, ProRendererStreamResample_001, TestSize.Level1)
+{
+    AudioProcessConfig config = InitProcessConfig();
+    config.streamInfo.samplingRate = SAMPLE_RATE_44100;
+    config.streamInfo.format = SAMPLE_F32LE;
+    std::shared_ptr<ProRendererStreamImpl> rendererStream = std::make_shared<ProRendererStreamImpl>(config, true);
+    ASSERT_EQ(SUCCESS, rendererStream->InitParams());
+    EXPECT_EQ(SUCCESS, rendererStream->Start());
+    size_t spanFrames = 0;
+    rendererStream->GetSpanSizePerFrame(spanFrames);
+    ASSERT_GT(spanFrames, 0u);
+
+    const size_t spanCount = 3; // less than the sink buffers of the stream
+    std::vector<float> input(spanFrames * STEREO * spanCount);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<float>((i * 7919) % 1000) / 1000 - 0.5f; // [-0.5, 0.5)
+    }
+    std::vector<int32_t> output;
+    for (size_t span = 0; span < spanCount; span++) {
+        size_t spanSize = spanFrames * STEREO * sizeof(float);
+        BufferDesc bufferDesc = { reinterpret_cast<uint8_t *>(input.data() + span * spanFrames * STEREO), spanSize,
+            spanSize };
+        EXPECT_EQ(SUCCESS, rendererStream->EnqueueBuffer(bufferDesc));
+        std::vector<char> audioBuffer;
+        int32_t index = -1;
+        EXPECT_EQ(SUCCESS, rendererStream->Peek(&audioBuffer, index));
+        const int32_t *samples = reinterpret_cast<const int32_t *>(audioBuffer.data());
+        output.insert(output.end(), samples, samples + audioBuffer.size() / sizeof(int32_t));
+        rendererStream->ReturnIndex(index);
+    }
+    size_t desSpanFrames = spanFrames * SAMPLE_RATE_48000 / SAMPLE_RATE_44100;
+    EXPECT_EQ(desSpanFrames * STEREO * spanCount, output.size());
+
+    // the stream feeds one span of silence on init, then the whole input goes through in one call
+    AudioResample resample(STEREO, SAMPLE_RATE_44100, SAMPLE_RATE_48000, 2); // 2 is the quality of the stream
+    std::vector<float> silence(spanFrames * STEREO, 0.0f);
+    std::vector<float> resampled(input.size() * 2, 0.0f); // 2 for room
+    uint32_t inFrames = spanFrames;
+    uint32_t outFrames = resampled.size() / STEREO;
+    EXPECT_EQ(SUCCESS, resample.ProcessFloatResample(silence.data(), inFrames, resampled.data(), outFrames));
+    inFrames = spanFrames * spanCount;
+    outFrames = resampled.size() / STEREO;
+    EXPECT_EQ(SUCCESS, resample.ProcessFloatResample(input.data(), inFrames, resampled.data(), outFrames));
+    std::vector<int32_t> expect(outFrames * STEREO);
+    AudioMixKernel::FloatToFormat(resampled.data(), SAMPLE_S32LE, reinterpret_cast<uint8_t *>(expect.data()),
+        expect.size());
+    size_t compareSize = std::min(expect.size(), output.size());
+    for (size_t i = 0; i < compareSize; i++) {
+        ASSERT_EQ(expect[i], output[i]) << "at sample " << i;
+    }
+    rendererStream->Stop();
+    rendererStream->Release();
+}
 } // namespace AudioStandard
 } // namespace OHOS
\ No newline at end of file